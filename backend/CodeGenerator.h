@@ -15,6 +15,7 @@
 ///
 #pragma once
 
+#include <cstdint>
 #include <cstdio>
 #include <string>
 
@@ -45,6 +46,24 @@ public:
         this->showLinearIR = show;
     }
 
+    ///
+    /// @brief 设置代码生成所用的线程数，输出内容与线程数无关
+    /// @param num 线程数，不大于1时单线程执行
+    ///
+    void setThreadNum(int32_t num)
+    {
+        this->threadNum = num;
+    }
+
+    ///
+    /// @brief 设置优化级别，决定寄存器分配等采用的算法
+    /// @param level 优化级别，0为不优化
+    ///
+    void setOptLevel(int32_t level)
+    {
+        this->optLevel = level;
+    }
+
 protected:
     /// @brief 代码产生器运行，结果保存到指定的文件中
     /// @param fp 输出内容所在文件的指针
@@ -63,4 +82,14 @@ protected:
     /// @brief 显示IR指令内容
     ///
     bool showLinearIR = false;
+
+    ///
+    /// @brief 代码生成所用的线程数
+    ///
+    int32_t threadNum = 1;
+
+    ///
+    /// @brief 优化级别
+    ///
+    int32_t optLevel = 0;
 };
@@ -13,10 +13,15 @@
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
 /// </table>
 ///
+#include <string>
+#include <vector>
+
 #include "CodeGenerator.h"
 #include "CodeGeneratorAsm.h"
 #include "Module.h"
 #include "Function.h"
+#include "ParallelFor.h"
+#include "TimeReport.h"
 
 /// @brief 构造函数
 CodeGeneratorAsm::CodeGeneratorAsm(Module * _module) : CodeGenerator(_module)
@@ -25,18 +30,28 @@ CodeGeneratorAsm::CodeGeneratorAsm(Module * _module) : CodeGenerator(_module)
 /// @brief .text代码段，主要存放CPU指令，以函数为单位
 void CodeGeneratorAsm::genCodeSection()
 {
-    // 重新设置为0
-    labelIndex = 0;
-
-    // 遍历所有的函数，以函数为单位，产生指令
+    // 需要产生指令的函数，内置函数除外
+    std::vector<Function *> funcs;
     for (auto func: module->getFunctionList()) {
-
         if (!func->isBuiltin()) {
-
-            // 针对func产生汇编指令
-            genCodeSection(func);
+            funcs.push_back(func);
         }
     }
+
+    // 寄存器分配会修改指令的操作数，而常量等Value是模块级共享的，其use链表不能并发修改，这里顺序执行
+    for (auto func: funcs) {
+        registerAllocation(func);
+    }
+
+    // 以函数为单位并行产生指令，每个函数的汇编单独保存
+    std::vector<std::string> codes(funcs.size());
+    parallelFor(funcs.size(), threadNum, [&](std::size_t i) { genCodeSection(funcs[i], codes[i]); });
+
+    // 按函数的次序输出，保证输出与线程数无关
+    TimeScope scope("asm emission");
+    for (auto & code: codes) {
+        fputs(code.c_str(), fp);
+    }
 }
 
 /// @brief 产生汇编文件
@@ -44,11 +59,15 @@ void CodeGeneratorAsm::genCodeSection()
 /// @return true:成功，false:失败
 bool CodeGeneratorAsm::run()
 {
-    // 产生头
-    genHeader();
+    {
+        TimeScope scope("asm emission");
 
-    // 产生数据段，含初始化和未初始化数据
-    genDataSection();
+        // 产生头
+        genHeader();
+
+        // 产生数据段，含初始化和未初始化数据
+        genDataSection();
+    }
 
     // 产生代码段，即CPU指令，以函数为单位
     genCodeSection();
@@ -13,8 +13,11 @@
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
 /// </table>
 ///
+#pragma once
+
 #include <cstdio>
 #include <cstring>
+#include <string>
 
 #include "CodeGenerator.h"
 
@@ -38,9 +41,11 @@ public:
     /// @brief 全局变量Section，主要包含初始化的和未初始化过的
     virtual void genDataSection() = 0;
 
-    /// @brief 针对函数进行汇编指令生成，放到.text代码段中
-    /// @param func 要处理的函数
-    virtual void genCodeSection(Function * func) = 0;
+    /// @brief 针对函数进行汇编指令生成，放到.text代码段中。
+    /// 不同的函数可能在不同的线程中同时执行，只能修改本函数内的数据
+    /// @param func 要处理的函数，寄存器分配已完成
+    /// @param code 函数的汇编代码，追加到尾部
+    virtual void genCodeSection(Function * func, std::string & code) = 0;
 
     /// @brief 寄存器分配
     /// @param func 要处理的函数
@@ -51,11 +56,6 @@ protected:
     /// @return true:成功，false:失败
     bool run() override;
 
-    /// @brief 汇编指令生成，放到.text代码段中
+    /// @brief 汇编指令生成，放到.text代码段中。各函数可并行生成，按函数的次序输出
     void genCodeSection();
-
-    ///
-    /// @brief Label索引编号，要求文件级别的编号，而不是函数级别的编号
-    ///
-    int64_t labelIndex = 0;
 };
@@ -25,11 +25,14 @@
 #include "CodeGeneratorArm32.h"
 #include "InstSelectorArm32.h"
 #include "SimpleRegisterAllocator.h"
+#include "LinearScanRegisterAllocator.h"
+#include "GraphColoringRegisterAllocator.h"
 #include "ILocArm32.h"
 #include "RegVariable.h"
 #include "FuncCallInstruction.h"
 #include "ArgInstruction.h"
 #include "MoveInstruction.h"
+#include "TimeReport.h"
 
 /// @brief 构造函数
 /// @param tab 符号表
@@ -112,47 +115,86 @@ void CodeGeneratorArm32::getIRValueStr(Value * val, std::string & str)
 
 /// @brief 针对函数进行汇编指令生成，放到.text代码段中
 /// @param func 要处理的函数
-void CodeGeneratorArm32::genCodeSection(Function * func)
+/// @param code 函数的汇编代码
+void CodeGeneratorArm32::genCodeSection(Function * func, std::string & code)
 {
-    // 寄存器分配以及栈内局部变量的站内地址重新分配
-    registerAllocation(func);
+    TimeScope funcScope("function codegen", [func] { return func->getName(); });
 
     // 获取函数的指令列表
-    std::vector<Instruction *> & IrInsts = func->getInterCode().getInsts();
+    InstList & IrInsts = func->getInterCode().getInsts();
 
-    // 汇编指令输出前要确保Label的名字有效，必须是程序级别的唯一，而不是函数内的唯一。要全局编号。
+    // ILOC代码序列
+    ILocArm32 iloc(module, func);
+
+    // 指令选择生成汇编指令，每个函数使用独立的寄存器分配器
+    SimpleRegisterAllocator simpleRegisterAllocator;
+
+    // 已分配给变量、临时变量以及形参的寄存器在整个函数内占用，指令选择不能再作为临时寄存器
+    auto reserveReg = [&simpleRegisterAllocator](Value * val) {
+        int32_t regId = val->getRegId();
+        if ((regId >= 0) && (regId < ARM32_TMP_REG_NO)) {
+            simpleRegisterAllocator.Allocate(regId);
+        }
+    };
+
+    for (auto param: func->getParams()) {
+        reserveReg(param);
+    }
+    for (auto localVar: func->getVarValues()) {
+        reserveReg(localVar);
+    }
     for (auto inst: IrInsts) {
-        if (inst->getOp() == IRInstOperator::IRINST_OP_LABEL) {
-            inst->setName(IR_LABEL_PREFIX + std::to_string(labelIndex++));
+        if (inst->hasResultValue()) {
+            reserveReg(inst);
         }
     }
 
-    // ILOC代码序列
-    ILocArm32 iloc(module);
-
-    // 指令选择生成汇编指令
     InstSelectorArm32 instSelector(IrInsts, iloc, func, simpleRegisterAllocator);
     instSelector.setShowLinearIR(this->showLinearIR);
+
+    // 优化时r0-r8都可能被变量占用，其中r4-r8只有用到的才保护，临时寄存器固定用r9，由registerAllocation决定是否保护
+    if (optLevel >= 1) {
+        instSelector.setScratchReg(ARM32_SCRATCH_REG_NO);
+    }
     instSelector.run();
 
-    // 删除无用的Label指令
-    iloc.deleteUnusedLabel();
+    {
+        TimeScope scope("label cleanup", [func] { return func->getName(); });
+
+        // 删除无用的Label指令
+        iloc.deleteUnusedLabel();
+    }
+
+    TimeScope emitScope("asm emission", [func] { return func->getName(); });
 
     // ILOC代码输出为汇编代码
-    fprintf(fp, ".align %d\n", func->getAlignment());
-    fprintf(fp, ".global %s\n", func->getName().c_str());
-    fprintf(fp, ".type %s, %%function\n", func->getName().c_str());
-    fprintf(fp, "%s:\n", func->getName().c_str());
+    code += ".align " + std::to_string(func->getAlignment()) + "\n";
+    code += ".global " + func->getName() + "\n";
+    code += ".type " + func->getName() + ", %function\n";
+    code += func->getName() + ":\n";
 
     // 开启时输出IR指令作为注释
     if (this->showLinearIR) {
 
+        // 输出寄存器分配的统计：溢出次数、合并的传送、寄存器间的mov、栈内变量的读写以及指令的条数
+        auto statsIter = regAllocStats.find(func);
+        code += "\t@ ";
+        if (statsIter != regAllocStats.end()) {
+            code += "spills: " + std::to_string(statsIter->second.spillCount) + ", ";
+            if (statsIter->second.coalescedMoveCount >= 0) {
+                code += "coalesced moves: " + std::to_string(statsIter->second.coalescedMoveCount) + ", ";
+            }
+        }
+        code += "moves: " + std::to_string(iloc.countRegisterMoves()) + ", ";
+        code += "stack memory operations: " + std::to_string(iloc.countStackAccesses()) + ", ";
+        code += "instructions: " + std::to_string(iloc.countInsts()) + "\n";
+
         // 输出有关局部变量的注释，便于查找问题
         for (auto localVar: func->getVarValues()) {
             std::string str;
             getIRValueStr(localVar, str);
             if (!str.empty()) {
-                fprintf(fp, "%s\n", str.c_str());
+                code += str + "\n";
             }
         }
 
@@ -162,13 +204,28 @@ void CodeGeneratorArm32::genCodeSection(Function * func)
                 std::string str;
                 getIRValueStr(inst, str);
                 if (!str.empty()) {
-                    fprintf(fp, "%s\n", str.c_str());
+                    code += str + "\n";
                 }
             }
         }
     }
 
-    iloc.outPut(fp);
+    iloc.outPut(code);
+}
+
+/// @brief 指令选择是否需要临时寄存器，即是否有两个操作数都不在寄存器中的赋值指令
+/// @param func 函数指针
+/// @return true：需要 false：不需要
+static bool needScratchReg(Function * func)
+{
+    for (auto inst: func->getInterCode().getInsts()) {
+        if ((inst->getOp() == IRInstOperator::IRINST_OP_ASSIGN) && (inst->getOperand(0)->getRegId() == -1) &&
+            (inst->getOperand(1)->getRegId() == -1)) {
+            return true;
+        }
+    }
+
+    return false;
 }
 
 /// @brief 寄存器分配
@@ -180,6 +237,8 @@ void CodeGeneratorArm32::registerAllocation(Function * func)
         return;
     }
 
+    TimeScope scope("register allocation", [func] { return func->getName(); });
+
     // 最简单/朴素的寄存器分配简单，但性能差，具体如下：
     // (1) 局部变量都保存在内存栈中（含简单变量、下标变量等）
     // (2) 全局变量在静态存储.data区中
@@ -208,8 +267,44 @@ void CodeGeneratorArm32::registerAllocation(Function * func)
     // 当然也可以不做处理，不过性能更差。这个处理是可选的。
     adjustFuncCallInsts(func);
 
+    // 优化时把局部变量和临时变量分配到寄存器，-O1采用线性扫描，-O2及以上采用图着色
+    // 溢出的栈槽在栈内其它变量之前
+    int32_t spillSize = 0;
+
+    auto applyAllocation = [&protectedRegNo, &spillSize](auto & allocator, RegAllocStats & stats) {
+        // 用到的需要被调用者保护的寄存器在入口保存
+        for (int32_t regNo: allocator.getUsedCalleeSavedRegs()) {
+            protectedRegNo.push_back(regNo);
+        }
+
+        spillSize = allocator.getSpillSize();
+        stats.spillCount = allocator.getSpillCount();
+    };
+
+    if (optLevel >= 2) {
+
+        GraphColoringRegisterAllocator allocator(func);
+        allocator.run();
+
+        RegAllocStats & stats = regAllocStats[func];
+        applyAllocation(allocator, stats);
+        stats.coalescedMoveCount = allocator.getCoalescedMoveCount();
+
+    } else if (optLevel == 1) {
+
+        LinearScanRegisterAllocator allocator(func);
+        allocator.run();
+
+        applyAllocation(allocator, regAllocStats[func]);
+    }
+
+    // 指令选择的临时寄存器r9不参与分配，是被调用者保护的寄存器，用到时在入口保存
+    if ((optLevel >= 1) && needScratchReg(func)) {
+        protectedRegNo.push_back(ARM32_SCRATCH_REG_NO);
+    }
+
     // 为局部变量和临时变量在栈内分配空间，指定偏移，进行栈空间的分配
-    stackAlloc(func);
+    stackAlloc(func, spillSize);
 
     // 函数形参要求前四个寄存器分配，后面的参数采用栈传递，实现实参的值传递给形参
     // 这一步是必须的
@@ -254,9 +349,7 @@ void CodeGeneratorArm32::adjustFormalParamInsts(Function * func)
 /// @param func 要处理的函数
 void CodeGeneratorArm32::adjustFuncCallInsts(Function * func)
 {
-    std::vector<Instruction *> newInsts;
-
-    // 当前函数的指令列表
+    // 当前函数的指令列表，链表插入为O(1)，插入后已有的迭代器仍有效
     auto & insts = func->getInterCode().getInsts();
 
     // 函数返回值用R0寄存器，若函数调用有返回值，则赋值R0到对应寄存器
@@ -264,7 +357,7 @@ void CodeGeneratorArm32::adjustFuncCallInsts(Function * func)
     for (auto pIter = insts.begin(); pIter != insts.end(); pIter++) {
 
         // 检查是否是函数调用指令，并且含有返回值
-        if (Instanceof(callInst, FuncCallInstruction *, *pIter)) {
+        if (auto * callInst = dyn_cast<FuncCallInstruction>(*pIter)) {
 
             // 实参前四个要寄存器传值，其它参数通过栈传递
 
@@ -292,15 +385,14 @@ void CodeGeneratorArm32::adjustFuncCallInsts(Function * func)
                 esp += 4;
 
                 // 引入赋值指令，把实参的值保存到内存变量上
-                Instruction * assignInst = new MoveInstruction(func, newVal, arg);
+                Instruction * assignInst = new (func) MoveInstruction(func, newVal, arg);
 
                 // 更换实参变量为内存变量
                 callInst->setOperand(k, newVal);
 
                 // 赋值指令插入到函数调用指令的前面
                 // 函数调用指令前插入后，pIter仍指向函数调用指令
-                pIter = insts.insert(pIter, assignInst);
-                pIter++;
+                (void) insts.insert(pIter, assignInst);
             }
 
             // ARM32的函数调用约定，前四个参数通过寄存器传递
@@ -310,13 +402,12 @@ void CodeGeneratorArm32::adjustFuncCallInsts(Function * func)
 
                 auto arg = callInst->getOperand(k);
 
-                Instruction * assignInst = new MoveInstruction(func, PlatformArm32::intRegVal[k], arg);
+                Instruction * assignInst = new (func) MoveInstruction(func, PlatformArm32::intRegVal(func, k), arg);
 
-                callInst->setOperand(k, PlatformArm32::intRegVal[k]);
+                callInst->setOperand(k, PlatformArm32::intRegVal(func, k));
 
                 // 函数调用指令前插入后，pIter仍指向函数调用指令
-                pIter = insts.insert(pIter, assignInst);
-                pIter++;
+                (void) insts.insert(pIter, assignInst);
             }
 
 #if 0
@@ -325,8 +416,7 @@ void CodeGeneratorArm32::adjustFuncCallInsts(Function * func)
                 auto arg = callInst->getOperand(k);
 
                 // 产生ARG指令
-                pIter = insts.insert(pIter, new ArgInstruction(func, arg));
-                pIter++;
+                (void) insts.insert(pIter, new (func) ArgInstruction(func, arg));
             }
 #endif
 
@@ -342,10 +432,10 @@ void CodeGeneratorArm32::adjustFuncCallInsts(Function * func)
                 } else {
                     // 其它情况，需要产生赋值指令
                     // 新建一个赋值操作
-                    Instruction * assignInst = new MoveInstruction(func, callInst, PlatformArm32::intRegVal[0]);
+                    Instruction * assignInst = new (func) MoveInstruction(func, callInst, PlatformArm32::intRegVal(func, 0));
 
-                    // 函数调用指令的下一个指令的前面插入指令，因为有Exit指令，+1肯定有效
-                    pIter = insts.insert(pIter + 1, assignInst);
+                    // 函数调用指令的下一个指令的前面插入指令，因为有Exit指令，下一条肯定有效
+                    pIter = insts.insertAfter(pIter, assignInst);
                 }
             }
         }
@@ -354,8 +444,11 @@ void CodeGeneratorArm32::adjustFuncCallInsts(Function * func)
 
 /// @brief 栈空间分配
 /// @param func 要处理的函数
-void CodeGeneratorArm32::stackAlloc(Function * func)
+/// @param spillSize 寄存器分配溢出的栈槽已占用的空间大小
+void CodeGeneratorArm32::stackAlloc(Function * func, int32_t spillSize)
 {
+    TimeScope scope("stack allocation", [func] { return func->getName(); });
+
     // 栈内分配的空间除了寄存器保护所分配的空间之外，还需要管理如下的空间
     // (1) 没有指派寄存器的局部变量、形参或临时变量的栈内分配
     // (2) 函数调用时需要栈内传递的实参
@@ -375,7 +468,8 @@ void CodeGeneratorArm32::stackAlloc(Function * func)
 
     // 这里对临时变量和局部变量都在栈上进行分配，采用FP+偏移的寻址方式，偏移为负数
 
-    int32_t sp_esp = 0;
+    // 寄存器分配溢出的栈槽紧靠fp，其它变量接续分配
+    int32_t sp_esp = spillSize;
 
     // 遍历函数变量列表
     for (auto var: func->getVarValues()) {
@@ -411,8 +505,8 @@ void CodeGeneratorArm32::stackAlloc(Function * func)
     // 遍历包含有值的指令，也就是临时变量
     for (auto inst: func->getInterCode().getInsts()) {
 
-        if (inst->hasResultValue() && (inst->getRegId() == -1)) {
-            // 有值，并且没有分配寄存器
+        if (inst->hasResultValue() && (inst->getRegId() == -1) && (!inst->getMemoryAddr())) {
+            // 有值，并且没有分配寄存器和栈槽
 
             int32_t size = inst->getType()->getSize();
 
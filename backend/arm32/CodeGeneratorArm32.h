@@ -13,8 +13,11 @@
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
 /// </table>
 ///
+#pragma once
+
+#include <unordered_map>
+
 #include "CodeGeneratorAsm.h"
-#include "SimpleRegisterAllocator.h"
 
 class CodeGeneratorArm32 : public CodeGeneratorAsm {
 
@@ -35,7 +38,8 @@ protected:
 
     /// @brief 针对函数进行汇编指令生成，放到.text代码段中
     /// @param func 要处理的函数
-    void genCodeSection(Function * func) override;
+    /// @param code 函数的汇编代码
+    void genCodeSection(Function * func, std::string & code) override;
 
     /// @brief 寄存器分配
     /// @param func 要处理的函数
@@ -43,7 +47,8 @@ protected:
 
     /// @brief 栈空间分配
     /// @param func 要处理的函数
-    void stackAlloc(Function * func);
+    /// @param spillSize 寄存器分配溢出的栈槽已占用的空间大小
+    void stackAlloc(Function * func, int32_t spillSize = 0);
 
     /// @brief 寄存器分配前对函数内的指令进行调整，以便方便寄存器分配
     /// @param func 要处理的函数
@@ -59,9 +64,20 @@ protected:
     ///
     void getIRValueStr(Value * val, std::string & str);
 
-private:
     ///
-    /// @brief 简单的朴素寄存器分配方法
+    /// @brief 寄存器分配的统计
+    ///
+    struct RegAllocStats {
+
+        /// @brief 溢出次数
+        int32_t spillCount = 0;
+
+        /// @brief 被合并的传送指令条数，-1表示分配器不做合并
+        int32_t coalescedMoveCount = -1;
+    };
+
+    ///
+    /// @brief 优化时各函数寄存器分配的统计，寄存器分配阶段写入，代码生成阶段只读
     ///
-    SimpleRegisterAllocator simpleRegisterAllocator;
+    std::unordered_map<Function *, RegAllocStats> regAllocStats;
 };
@@ -0,0 +1,939 @@
+///
+/// @file GraphColoringRegisterAllocator.cpp
+/// @brief 图着色寄存器分配器的实现
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#include <algorithm>
+#include <cmath>
+
+#include "GraphColoringRegisterAllocator.h"
+#include "Casting.h"
+#include "ControlFlowGraph.h"
+#include "DominatorTree.h"
+#include "FuncCallInstruction.h"
+#include "Function.h"
+#include "MoveInstruction.h"
+#include "PlatformArm32.h"
+#include "RegAllocLiveness.h"
+#include "Values/LocalVariable.h"
+
+/// @brief 颜色数，即可分配的寄存器r0-r8
+static const int32_t colorNum = ARM32_SCRATCH_REG_NO;
+
+/// @brief 由调用者保护的寄存器个数，即r0-r3
+static const int32_t callerSavedRegNum = 4;
+
+/// @brief 循环深度的上限，避免代价溢出
+static const int32_t maxLoopDepth = 8;
+
+/// @brief 冲突图用位矩阵的结点数上限，此时位矩阵约4MB，超过后改用散列的边集合
+static const std::size_t maxDenseNodeNum = 8192;
+
+/// @brief 构造函数
+/// @param _func 要分配的函数
+GraphColoringRegisterAllocator::GraphColoringRegisterAllocator(Function * _func) : func(_func)
+{}
+
+/// @brief 运行分配
+void GraphColoringRegisterAllocator::run()
+{
+    // 控制流图只用于活跃性与循环深度，不改变块的布局
+    ControlFlowGraph graph(func);
+    cfg = &graph;
+
+    // 预着色结点
+    nodes.resize(colorNum);
+    for (int32_t reg = 0; reg < colorNum; reg++) {
+        nodes[(std::size_t) reg].state = NodeState::Precolored;
+        nodes[(std::size_t) reg].color = reg;
+    }
+
+    collectOperands();
+    computeLiveness();
+    build();
+    makeWorklist();
+
+    for (;;) {
+        if (trimWorklist(simplifyWorklist, NodeState::Simplify)) {
+            simplify();
+        } else if (trimWorklistMoves()) {
+            coalesce();
+        } else if (trimWorklist(freezeWorklist, NodeState::Freeze)) {
+            freeze();
+        } else if (trimWorklist(spillWorklist, NodeState::Spill)) {
+            selectSpill();
+        } else {
+            break;
+        }
+    }
+
+    assignColors();
+    assignSpillSlots();
+
+    for (std::size_t n = colorNum; n < nodes.size(); n++) {
+
+        Node & node = nodes[n];
+        if (node.state != NodeState::Colored) {
+            continue;
+        }
+
+        usedRegMask |= 1U << node.color;
+
+        if (auto * var = dyn_cast<LocalVariable>(node.value)) {
+            var->setRegId(node.color);
+        } else {
+            cast<Instruction>(node.value)->setRegId(node.color);
+        }
+    }
+
+    cfg = nullptr;
+}
+
+/// @brief 获取使用过的需要被调用者保护的寄存器
+/// @return std::vector<int32_t> 寄存器编号
+std::vector<int32_t> GraphColoringRegisterAllocator::getUsedCalleeSavedRegs() const
+{
+    return usedCalleeSavedRegs(usedRegMask);
+}
+
+/// @brief 获取值对应的结点
+/// @param val 值
+/// @return int32_t 结点编号，不参与分配的值为-1
+int32_t GraphColoringRegisterAllocator::nodeOf(Value * val)
+{
+    auto iter = nodeIndex.find(val);
+    if (iter != nodeIndex.end()) {
+        return iter->second;
+    }
+
+    int32_t index = -1;
+
+    if (isa<RegVariable>(val)) {
+        // 寄存器变量对应预着色结点
+        int32_t regId = val->getRegId();
+        index = ((regId >= 0) && (regId < colorNum)) ? regId : -1;
+    } else {
+
+        bool candidate = false;
+
+        if (auto * var = dyn_cast<LocalVariable>(val)) {
+            candidate = var->getType()->isInt32Type() && (var->getRegId() == -1) && !var->getMemoryAddr();
+        } else if (auto * inst = dyn_cast<Instruction>(val)) {
+            candidate = inst->hasResultValue() && (inst->getRegId() == -1) && !inst->getMemoryAddr();
+        }
+
+        if (candidate) {
+            index = (int32_t) nodes.size();
+            nodes.emplace_back().value = val;
+        }
+    }
+
+    nodeIndex.emplace(val, index);
+
+    return index;
+}
+
+/// @brief 收集各指令读取与定值的结点，计算各块的循环深度与结点的溢出代价
+void GraphColoringRegisterAllocator::collectOperands()
+{
+    auto blockCount = (std::size_t) cfg->getBlockCount();
+
+    // 循环深度：回边n->h（h支配n）的自然循环内的块深度加一
+    loopDepth.assign(blockCount, 0);
+
+    {
+        DominatorTree domTree(*cfg);
+        std::vector<int32_t> inLoop(blockCount, -1);
+        std::vector<BasicBlock *> worklist;
+        int32_t loopCount = 0;
+
+        for (BasicBlock * block: cfg->getBlocks()) {
+            for (BasicBlock * header: block->getSuccessors()) {
+
+                if (!domTree.dominates(header, block)) {
+                    continue;
+                }
+
+                int32_t mark = loopCount++;
+                std::vector<int32_t> body;
+
+                inLoop[(std::size_t) header->getIndex()] = mark;
+                body.push_back(header->getIndex());
+                worklist.push_back(block);
+
+                while (!worklist.empty()) {
+
+                    BasicBlock * member = worklist.back();
+                    worklist.pop_back();
+
+                    auto m = (std::size_t) member->getIndex();
+                    if (inLoop[m] == mark) {
+                        continue;
+                    }
+
+                    inLoop[m] = mark;
+                    body.push_back((int32_t) m);
+
+                    for (BasicBlock * pred: member->getPredecessors()) {
+                        worklist.push_back(pred);
+                    }
+                }
+
+                for (int32_t b: body) {
+                    loopDepth[(std::size_t) b]++;
+                }
+            }
+        }
+    }
+
+    blockInsts.assign(blockCount, {0, 0});
+
+    for (BasicBlock * block: cfg->getBlocks()) {
+
+        auto b = (std::size_t) block->getIndex();
+        double weight = std::pow(10.0, std::min(loopDepth[b], maxLoopDepth));
+
+        blockInsts[b].first = (int32_t) instUses.size();
+
+        for (Instruction * inst: block->getInsts()) {
+
+            std::vector<int32_t> & uses = instUses.emplace_back();
+            std::vector<int32_t> & defs = instDefs.emplace_back();
+            bool isMove = false;
+
+            if (isa<MoveInstruction>(inst)) {
+
+                // 两端都是结点且不同时为传送指令
+                int32_t dst = nodeOf(inst->getOperand(0));
+                int32_t src = nodeOf(inst->getOperand(1));
+
+                if (src >= 0) {
+                    uses.push_back(src);
+                }
+                if (dst >= 0) {
+                    defs.push_back(dst);
+                }
+
+                isMove = (dst >= 0) && (src >= 0) && (dst != src);
+
+            } else {
+
+                for (int32_t k = 0; k < inst->getOperandsNum(); k++) {
+                    int32_t use = nodeOf(inst->getOperand(k));
+                    if ((use >= 0) && (std::find(uses.begin(), uses.end(), use) == uses.end())) {
+                        uses.push_back(use);
+                    }
+                }
+
+                if (isa<FuncCallInstruction>(inst)) {
+                    // 调用破坏r0-r3，返回值由之后的赋值指令从r0取出
+                    for (int32_t reg = 0; reg < callerSavedRegNum; reg++) {
+                        defs.push_back(reg);
+                    }
+                } else if (inst->hasResultValue()) {
+                    int32_t def = nodeOf(inst);
+                    if (def >= 0) {
+                        defs.push_back(def);
+                    }
+                }
+            }
+
+            instIsMove.push_back(isMove);
+
+            for (int32_t n: uses) {
+                nodes[(std::size_t) n].cost += weight;
+            }
+            for (int32_t n: defs) {
+                nodes[(std::size_t) n].cost += weight;
+            }
+        }
+
+        blockInsts[b].second = (int32_t) instUses.size();
+    }
+}
+
+/// @brief 计算各块出口活跃的结点
+void GraphColoringRegisterAllocator::computeLiveness()
+{
+    RegAllocLiveness liveness(cfg);
+
+    for (BasicBlock * block: cfg->getBlocks()) {
+
+        int32_t b = block->getIndex();
+
+        for (int32_t k = blockInsts[(std::size_t) b].first; k < blockInsts[(std::size_t) b].second; k++) {
+
+            for (int32_t n: instUses[(std::size_t) k]) {
+                liveness.addUse(n, b);
+            }
+
+            for (int32_t n: instDefs[(std::size_t) k]) {
+                liveness.addDef(n, b);
+            }
+        }
+    }
+
+    liveOut.assign((std::size_t) cfg->getBlockCount(), {});
+
+    liveness.propagate([](int32_t, int32_t) {},
+                       [this](int32_t n, int32_t b) { liveOut[(std::size_t) b].push_back(n); });
+}
+
+/// @brief 逆序遍历各块的指令建立冲突图，并收集传送指令
+void GraphColoringRegisterAllocator::build()
+{
+    std::size_t nodeCount = nodes.size();
+
+    // 位矩阵的大小与结点数的平方成正比，结点多时改用散列的边集合
+    adjSet.clear();
+    adjHash.clear();
+    denseAdj = nodeCount <= maxDenseNodeNum;
+
+    if (denseAdj) {
+        adjSet.assign((nodeCount * nodeCount / 2 + 63) / 64, 0);
+    }
+    visitMark.assign(nodeCount, -1);
+
+    // 活跃集合：结点列表以及结点在列表中的下标，删除时与末尾交换
+    std::vector<int32_t> live;
+    std::vector<int32_t> livePos(nodeCount, -1);
+
+    auto addLive = [&live, &livePos](int32_t n) {
+        if (livePos[(std::size_t) n] < 0) {
+            livePos[(std::size_t) n] = (int32_t) live.size();
+            live.push_back(n);
+        }
+    };
+
+    auto removeLive = [&live, &livePos](int32_t n) {
+        int32_t pos = livePos[(std::size_t) n];
+        if (pos >= 0) {
+            live[(std::size_t) pos] = live.back();
+            livePos[(std::size_t) live.back()] = pos;
+            live.pop_back();
+            livePos[(std::size_t) n] = -1;
+        }
+    };
+
+    for (BasicBlock * block: cfg->getBlocks()) {
+
+        auto b = (std::size_t) block->getIndex();
+
+        for (int32_t n: live) {
+            livePos[(std::size_t) n] = -1;
+        }
+        live.clear();
+
+        for (int32_t n: liveOut[b]) {
+            addLive(n);
+        }
+
+        for (int32_t k = blockInsts[b].second - 1; k >= blockInsts[b].first; k--) {
+
+            std::vector<int32_t> & uses = instUses[(std::size_t) k];
+            std::vector<int32_t> & defs = instDefs[(std::size_t) k];
+
+            if (instIsMove[(std::size_t) k]) {
+
+                // 传送的源与目标不因这条指令冲突
+                removeLive(uses.front());
+
+                auto m = (int32_t) moves.size();
+                moves.push_back({defs.front(), uses.front()});
+                nodes[(std::size_t) defs.front()].moves.push_back(m);
+                nodes[(std::size_t) uses.front()].moves.push_back(m);
+                worklistMoves.push_back(m);
+            }
+
+            for (int32_t d: defs) {
+                addLive(d);
+            }
+
+            for (int32_t d: defs) {
+                for (int32_t l: live) {
+                    addEdge(l, d);
+                }
+            }
+
+            for (int32_t d: defs) {
+                removeLive(d);
+            }
+
+            for (int32_t u: uses) {
+                addLive(u);
+            }
+        }
+    }
+
+    // 寄存器传递的形参在整个函数内占用其寄存器
+    auto paramNum = (int32_t) func->getParams().size();
+
+    for (int32_t reg = 0; (reg < paramNum) && (reg < callerSavedRegNum); reg++) {
+
+        usedRegMask |= 1U << reg;
+
+        for (auto n = (int32_t) colorNum; n < (int32_t) nodeCount; n++) {
+            addEdge(n, reg);
+        }
+    }
+}
+
+/// @brief 两结点是否相邻
+/// @param u 结点
+/// @param v 结点
+/// @return true：相邻 false：不相邻
+bool GraphColoringRegisterAllocator::isAdjacent(int32_t u, int32_t v) const
+{
+    if (u == v) {
+        return false;
+    }
+
+    auto i = (std::size_t) std::max(u, v);
+    auto j = (std::size_t) std::min(u, v);
+
+    if (!denseAdj) {
+        return adjHash.count(((uint64_t) i << 32) | j) != 0;
+    }
+
+    std::size_t bit = i * (i - 1) / 2 + j;
+
+    return (adjSet[bit / 64] >> (bit % 64)) & 1U;
+}
+
+/// @brief 添加冲突边
+/// @param u 结点
+/// @param v 结点
+void GraphColoringRegisterAllocator::addEdge(int32_t u, int32_t v)
+{
+    if ((u == v) || isAdjacent(u, v)) {
+        return;
+    }
+
+    auto i = (std::size_t) std::max(u, v);
+    auto j = (std::size_t) std::min(u, v);
+
+    if (denseAdj) {
+        std::size_t bit = i * (i - 1) / 2 + j;
+        adjSet[bit / 64] |= (uint64_t) 1 << (bit % 64);
+    } else {
+        adjHash.insert(((uint64_t) i << 32) | j);
+    }
+
+    // 预着色结点的度数视为无穷大，不记录邻接表
+    for (auto [from, to]: {std::pair{u, v}, std::pair{v, u}}) {
+        Node & node = nodes[(std::size_t) from];
+        if (node.state != NodeState::Precolored) {
+            node.adjList.push_back(to);
+            node.degree++;
+        }
+    }
+}
+
+/// @brief 把初始结点分配到各工作表
+void GraphColoringRegisterAllocator::makeWorklist()
+{
+    for (auto n = (int32_t) colorNum; n < (int32_t) nodes.size(); n++) {
+
+        Node & node = nodes[(std::size_t) n];
+
+        if (node.degree >= colorNum) {
+            node.state = NodeState::Spill;
+            spillWorklist.push_back(n);
+        } else if (isMoveRelated(n)) {
+            node.state = NodeState::Freeze;
+            freezeWorklist.push_back(n);
+        } else {
+            node.state = NodeState::Simplify;
+            simplifyWorklist.push_back(n);
+        }
+    }
+}
+
+/// @brief 去掉工作表末尾已移出的结点
+/// @param worklist 工作表
+/// @param state 工作表对应的状态
+/// @return true：工作表非空 false：工作表为空
+bool GraphColoringRegisterAllocator::trimWorklist(std::vector<int32_t> & worklist, NodeState state)
+{
+    while (!worklist.empty() && (nodes[(std::size_t) worklist.back()].state != state)) {
+        worklist.pop_back();
+    }
+
+    return !worklist.empty();
+}
+
+/// @brief 去掉传送指令工作表末尾已移出的传送指令
+/// @return true：工作表非空 false：工作表为空
+bool GraphColoringRegisterAllocator::trimWorklistMoves()
+{
+    while (!worklistMoves.empty() && (moves[(std::size_t) worklistMoves.back()].state != MoveState::Worklist)) {
+        worklistMoves.pop_back();
+    }
+
+    return !worklistMoves.empty();
+}
+
+/// @brief 获取仍在图中的邻居
+/// @param n 结点
+/// @param result 邻居
+void GraphColoringRegisterAllocator::adjacent(int32_t n, std::vector<int32_t> & result) const
+{
+    result.clear();
+
+    for (int32_t m: nodes[(std::size_t) n].adjList) {
+        NodeState state = nodes[(std::size_t) m].state;
+        if ((state != NodeState::SelectStack) && (state != NodeState::Coalesced)) {
+            result.push_back(m);
+        }
+    }
+}
+
+/// @brief 结点是否还有可能合并的传送指令
+/// @param n 结点
+/// @return true：有 false：没有
+bool GraphColoringRegisterAllocator::isMoveRelated(int32_t n) const
+{
+    for (int32_t m: nodes[(std::size_t) n].moves) {
+        MoveState state = moves[(std::size_t) m].state;
+        if ((state == MoveState::Worklist) || (state == MoveState::Active)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/// @brief 简化一个结点
+void GraphColoringRegisterAllocator::simplify()
+{
+    int32_t n = simplifyWorklist.back();
+    simplifyWorklist.pop_back();
+
+    nodes[(std::size_t) n].state = NodeState::SelectStack;
+    selectStack.push_back(n);
+
+    std::vector<int32_t> neighbors;
+    adjacent(n, neighbors);
+
+    for (int32_t m: neighbors) {
+        decrementDegree(m);
+    }
+}
+
+/// @brief 度数减一
+/// @param m 结点
+void GraphColoringRegisterAllocator::decrementDegree(int32_t m)
+{
+    Node & node = nodes[(std::size_t) m];
+
+    if (node.state == NodeState::Precolored) {
+        return;
+    }
+
+    int32_t degree = node.degree--;
+
+    if ((degree != colorNum) || (node.state != NodeState::Spill)) {
+        return;
+    }
+
+    // 从高度数变为低度数，自身与邻居上的传送指令可能可以合并了
+    enableMoves(m);
+
+    std::vector<int32_t> neighbors;
+    adjacent(m, neighbors);
+
+    for (int32_t n: neighbors) {
+        enableMoves(n);
+    }
+
+    if (isMoveRelated(m)) {
+        node.state = NodeState::Freeze;
+        freezeWorklist.push_back(m);
+    } else {
+        node.state = NodeState::Simplify;
+        simplifyWorklist.push_back(m);
+    }
+}
+
+/// @brief 结点上暂不能合并的传送指令重新加入工作表
+/// @param n 结点
+void GraphColoringRegisterAllocator::enableMoves(int32_t n)
+{
+    for (int32_t m: nodes[(std::size_t) n].moves) {
+        if (moves[(std::size_t) m].state == MoveState::Active) {
+            moves[(std::size_t) m].state = MoveState::Worklist;
+            worklistMoves.push_back(m);
+        }
+    }
+}
+
+/// @brief 获取结点合并到的结点
+/// @param n 结点
+/// @return int32_t 结点
+int32_t GraphColoringRegisterAllocator::getAlias(int32_t n) const
+{
+    while (nodes[(std::size_t) n].state == NodeState::Coalesced) {
+        n = nodes[(std::size_t) n].alias;
+    }
+
+    return n;
+}
+
+/// @brief 不再传送相关的低度数结点从冻结表移到简化表
+/// @param u 结点
+void GraphColoringRegisterAllocator::addWorkList(int32_t u)
+{
+    Node & node = nodes[(std::size_t) u];
+
+    if ((node.state == NodeState::Freeze) && !isMoveRelated(u) && (node.degree < colorNum)) {
+        node.state = NodeState::Simplify;
+        simplifyWorklist.push_back(u);
+    }
+}
+
+/// @brief George条件
+/// @param t 结点
+/// @param r 预着色结点
+/// @return true：可以 false：不可以
+bool GraphColoringRegisterAllocator::georgeOk(int32_t t, int32_t r) const
+{
+    const Node & node = nodes[(std::size_t) t];
+
+    return (node.state == NodeState::Precolored) || (node.degree < colorNum) || isAdjacent(t, r);
+}
+
+/// @brief Briggs条件
+/// @param u 结点
+/// @param v 结点
+/// @return true：可以 false：不可以
+bool GraphColoringRegisterAllocator::briggsOk(int32_t u, int32_t v)
+{
+    // 两结点的邻居去重后统计高度数的个数
+    visitStamp++;
+
+    int32_t significant = 0;
+    std::vector<int32_t> neighbors;
+
+    for (int32_t n: {u, v}) {
+
+        adjacent(n, neighbors);
+
+        for (int32_t m: neighbors) {
+
+            if (visitMark[(std::size_t) m] == visitStamp) {
+                continue;
+            }
+
+            visitMark[(std::size_t) m] = visitStamp;
+
+            const Node & node = nodes[(std::size_t) m];
+            if ((node.state == NodeState::Precolored) || (node.degree >= colorNum)) {
+                significant++;
+            }
+        }
+    }
+
+    return significant < colorNum;
+}
+
+/// @brief 尝试合并一条传送指令
+void GraphColoringRegisterAllocator::coalesce()
+{
+    int32_t m = worklistMoves.back();
+    worklistMoves.pop_back();
+
+    Move & move = moves[(std::size_t) m];
+    int32_t x = getAlias(move.dst);
+    int32_t y = getAlias(move.src);
+
+    // 有预着色结点时放在u上
+    int32_t u = x;
+    int32_t v = y;
+    if (nodes[(std::size_t) y].state == NodeState::Precolored) {
+        u = y;
+        v = x;
+    }
+
+    if (u == v) {
+        move.state = MoveState::Coalesced;
+        coalescedMoveCount++;
+        addWorkList(u);
+        return;
+    }
+
+    if ((nodes[(std::size_t) v].state == NodeState::Precolored) || isAdjacent(u, v)) {
+        // 两端冲突，不能合并
+        move.state = MoveState::Constrained;
+        addWorkList(u);
+        addWorkList(v);
+        return;
+    }
+
+    bool canCoalesce;
+
+    if (nodes[(std::size_t) u].state == NodeState::Precolored) {
+
+        // 与预着色结点合并用George条件：v的每个邻居都不妨碍u
+        std::vector<int32_t> neighbors;
+        adjacent(v, neighbors);
+
+        canCoalesce = std::all_of(neighbors.begin(), neighbors.end(), [this, u](int32_t t) {
+            return georgeOk(t, u);
+        });
+
+    } else {
+        canCoalesce = briggsOk(u, v);
+    }
+
+    if (canCoalesce) {
+        move.state = MoveState::Coalesced;
+        coalescedMoveCount++;
+        combine(u, v);
+        addWorkList(u);
+    } else {
+        move.state = MoveState::Active;
+    }
+}
+
+/// @brief 把v合并到u
+/// @param u 结点
+/// @param v 结点
+void GraphColoringRegisterAllocator::combine(int32_t u, int32_t v)
+{
+    Node & nodeV = nodes[(std::size_t) v];
+
+    nodeV.state = NodeState::Coalesced;
+    nodeV.alias = u;
+
+    std::vector<int32_t> & movesU = nodes[(std::size_t) u].moves;
+    movesU.insert(movesU.end(), nodeV.moves.begin(), nodeV.moves.end());
+
+    enableMoves(v);
+
+    std::vector<int32_t> neighbors;
+    adjacent(v, neighbors);
+
+    for (int32_t t: neighbors) {
+        addEdge(t, u);
+        decrementDegree(t);
+    }
+
+    Node & nodeU = nodes[(std::size_t) u];
+
+    if ((nodeU.degree >= colorNum) && (nodeU.state == NodeState::Freeze)) {
+        nodeU.state = NodeState::Spill;
+        spillWorklist.push_back(u);
+    }
+}
+
+/// @brief 冻结一个低度数的传送相关结点
+void GraphColoringRegisterAllocator::freeze()
+{
+    int32_t u = freezeWorklist.back();
+    freezeWorklist.pop_back();
+
+    nodes[(std::size_t) u].state = NodeState::Simplify;
+    simplifyWorklist.push_back(u);
+
+    freezeMoves(u);
+}
+
+/// @brief 放弃结点上的所有传送指令
+/// @param u 结点
+void GraphColoringRegisterAllocator::freezeMoves(int32_t u)
+{
+    for (int32_t m: nodes[(std::size_t) u].moves) {
+
+        Move & move = moves[(std::size_t) m];
+
+        if ((move.state != MoveState::Worklist) && (move.state != MoveState::Active)) {
+            continue;
+        }
+
+        int32_t x = getAlias(move.dst);
+        int32_t y = getAlias(move.src);
+        int32_t v = (y == getAlias(u)) ? x : y;
+
+        move.state = MoveState::Frozen;
+
+        Node & node = nodes[(std::size_t) v];
+
+        if ((node.state == NodeState::Freeze) && !isMoveRelated(v) && (node.degree < colorNum)) {
+            node.state = NodeState::Simplify;
+            simplifyWorklist.push_back(v);
+        }
+    }
+}
+
+/// @brief 选择代价/度数最小的结点作为潜在溢出
+void GraphColoringRegisterAllocator::selectSpill()
+{
+    int32_t best = -1;
+    double bestPriority = 0;
+
+    for (int32_t n: spillWorklist) {
+
+        const Node & node = nodes[(std::size_t) n];
+        if (node.state != NodeState::Spill) {
+            continue;
+        }
+
+        double priority = node.cost / node.degree;
+
+        if ((best < 0) || (priority < bestPriority)) {
+            best = n;
+            bestPriority = priority;
+        }
+    }
+
+    nodes[(std::size_t) best].state = NodeState::Simplify;
+    simplifyWorklist.push_back(best);
+
+    freezeMoves(best);
+}
+
+/// @brief 按出栈次序着色
+void GraphColoringRegisterAllocator::assignColors()
+{
+    while (!selectStack.empty()) {
+
+        int32_t n = selectStack.back();
+        selectStack.pop_back();
+
+        // 邻居已用的颜色
+        uint32_t usedColors = 0;
+
+        for (int32_t w: nodes[(std::size_t) n].adjList) {
+
+            const Node & alias = nodes[(std::size_t) getAlias(w)];
+
+            if ((alias.state == NodeState::Colored) || (alias.state == NodeState::Precolored)) {
+                usedColors |= 1U << alias.color;
+            }
+        }
+
+        Node & node = nodes[(std::size_t) n];
+        node.state = NodeState::Spilled;
+
+        // 优先使用编号小的寄存器，r0-r3不需要保护
+        for (int32_t reg = 0; reg < colorNum; reg++) {
+            if (!(usedColors & (1U << reg))) {
+                node.state = NodeState::Colored;
+                node.color = reg;
+                break;
+            }
+        }
+
+        if (node.state == NodeState::Spilled) {
+            spillCount++;
+        }
+    }
+
+    // 被合并的结点取其代表结点的颜色，代表结点溢出时也溢出
+    for (std::size_t n = colorNum; n < nodes.size(); n++) {
+
+        if (nodes[n].state != NodeState::Coalesced) {
+            continue;
+        }
+
+        const Node & alias = nodes[(std::size_t) getAlias((int32_t) n)];
+
+        if (alias.state == NodeState::Spilled) {
+            nodes[n].alias = getAlias((int32_t) n);
+        } else {
+            nodes[n].color = alias.color;
+        }
+    }
+
+    for (std::size_t n = colorNum; n < nodes.size(); n++) {
+        if ((nodes[n].state == NodeState::Coalesced) && (nodes[n].color >= 0)) {
+            nodes[n].state = NodeState::Colored;
+        }
+    }
+}
+
+/// @brief 为实际溢出的结点分配栈槽，不冲突的结点共享栈槽
+void GraphColoringRegisterAllocator::assignSpillSlots()
+{
+    // 合并时只把当时仍在图中的邻居加到代表结点上，冲突关系要看代表结点及其所有成员的邻接表
+    std::vector<std::vector<int32_t>> members(nodes.size());
+
+    for (std::size_t n = colorNum; n < nodes.size(); n++) {
+        if (nodes[n].state == NodeState::Spilled) {
+            members[n].push_back((int32_t) n);
+        } else if (nodes[n].state == NodeState::Coalesced) {
+            members[(std::size_t) nodes[n].alias].push_back((int32_t) n);
+        }
+    }
+
+    // 溢出的代表结点之间按冲突关系贪心着色，颜色即栈槽
+    std::vector<int32_t> slotOf(nodes.size(), -1);
+    std::vector<int32_t> slotMark;
+    int32_t slotNum = 0;
+
+    for (std::size_t n = colorNum; n < nodes.size(); n++) {
+
+        if (nodes[n].state != NodeState::Spilled) {
+            continue;
+        }
+
+        for (int32_t member: members[n]) {
+            for (int32_t w: nodes[(std::size_t) member].adjList) {
+                int32_t slot = slotOf[(std::size_t) getAlias(w)];
+                if (slot >= 0) {
+                    slotMark[(std::size_t) slot] = (int32_t) n;
+                }
+            }
+        }
+
+        int32_t slot = 0;
+
+        while ((slot < slotNum) && (slotMark[(std::size_t) slot] == (int32_t) n)) {
+            slot++;
+        }
+
+        if (slot == slotNum) {
+            slotNum++;
+            slotMark.push_back(-1);
+        }
+
+        slotOf[n] = slot;
+    }
+
+    // 溢出的结点以及合并到溢出结点的结点放到栈槽上，栈槽在fp之下
+    for (std::size_t n = colorNum; n < nodes.size(); n++) {
+
+        Node & node = nodes[n];
+        int32_t slot = -1;
+
+        if (node.state == NodeState::Spilled) {
+            slot = slotOf[n];
+        } else if (node.state == NodeState::Coalesced) {
+            slot = slotOf[(std::size_t) node.alias];
+        }
+
+        if (slot < 0) {
+            continue;
+        }
+
+        int32_t offset = -4 * (slot + 1);
+
+        if (auto * var = dyn_cast<LocalVariable>(node.value)) {
+            var->setMemoryAddr(ARM32_FP_REG_NO, offset);
+        } else {
+            cast<Instruction>(node.value)->setMemoryAddr(ARM32_FP_REG_NO, offset);
+        }
+    }
+
+    spillSize = 4 * slotNum;
+}
@@ -0,0 +1,394 @@
+///
+/// @file GraphColoringRegisterAllocator.h
+/// @brief 图着色寄存器分配器
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+/// 按George与Appel的迭代合并（Iterated Register Coalescing）着色：由活跃性建立冲突图，
+/// 冲突图以下三角位矩阵判断两结点是否相邻，以邻接表遍历邻居；位矩阵的大小与结点数的平方成正比，
+/// 结点数超过上限时改用以两端编号为键的散列集合。之后反复进行
+/// 简化（删除度数小于K的非传送相关结点）、合并（Briggs或George条件下合并传送的两端）、
+/// 冻结（放弃低度数结点上的传送）与潜在溢出（按代价/度数选择），最后按出栈次序着色。
+///
+/// 颜色为r0-r8，K=9，每个寄存器是一个预着色结点；r9留作指令选择的临时寄存器。
+/// adjustFuncCallInsts插入的实参与返回值传送连接普通结点与r0-r3预着色结点，合并后不再产生mov。
+/// 函数调用定值r0-r3，与跨越调用的值冲突；寄存器传递的形参与所有结点冲突。
+///
+/// 溢出代价为各次读取与定值按所在块的循环深度加权（10的深度次方）之和。
+/// 实际溢出的结点直接作为栈内变量，指令选择可直接访问内存操作数，因此不改写代码重新分配。
+/// 溢出结点之间按冲突关系共享栈槽。
+///
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+class BasicBlock;
+class ControlFlowGraph;
+class Function;
+class Instruction;
+class Value;
+
+///
+/// @brief 图着色寄存器分配器，每个函数一个
+///
+class GraphColoringRegisterAllocator {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _func 要分配的函数，函数调用的实参已调整到寄存器或栈上
+    ///
+    explicit GraphColoringRegisterAllocator(Function * _func);
+
+    ///
+    /// @brief 运行分配，着色的值设置寄存器编号，溢出的值设置栈槽
+    ///
+    void run();
+
+    ///
+    /// @brief 获取实际溢出的结点个数，合并后的结点计一次
+    /// @return int32_t 个数
+    ///
+    [[nodiscard]] int32_t getSpillCount() const
+    {
+        return spillCount;
+    }
+
+    ///
+    /// @brief 获取被合并的传送指令条数
+    /// @return int32_t 条数
+    ///
+    [[nodiscard]] int32_t getCoalescedMoveCount() const
+    {
+        return coalescedMoveCount;
+    }
+
+    ///
+    /// @brief 获取溢出栈槽占用的空间大小，其它栈内变量从该偏移之后分配
+    /// @return int32_t 字节数
+    ///
+    [[nodiscard]] int32_t getSpillSize() const
+    {
+        return spillSize;
+    }
+
+    ///
+    /// @brief 获取使用过的需要被调用者保护的寄存器，按编号从小到大。r0-r8全部被占用时包括r9
+    /// @return std::vector<int32_t> 寄存器编号
+    ///
+    [[nodiscard]] std::vector<int32_t> getUsedCalleeSavedRegs() const;
+
+private:
+    ///
+    /// @brief 结点所在的集合，每个结点任一时刻只在一个集合中
+    ///
+    enum class NodeState : uint8_t {
+        Precolored,
+        Initial,
+        Simplify,
+        Freeze,
+        Spill,
+        SelectStack,
+        Coalesced,
+        Colored,
+        Spilled,
+    };
+
+    ///
+    /// @brief 传送指令所在的集合
+    ///
+    enum class MoveState : uint8_t {
+        Worklist,
+        Active,
+        Coalesced,
+        Constrained,
+        Frozen,
+    };
+
+    ///
+    /// @brief 冲突图的结点
+    ///
+    struct Node {
+
+        /// @brief 对应的值，预着色结点为空
+        Value * value = nullptr;
+
+        /// @brief 所在的集合
+        NodeState state = NodeState::Initial;
+
+        /// @brief 度数，预着色结点视为无穷大
+        int32_t degree = 0;
+
+        /// @brief 合并到的结点
+        int32_t alias = -1;
+
+        /// @brief 颜色，即寄存器编号
+        int32_t color = -1;
+
+        /// @brief 溢出代价
+        double cost = 0;
+
+        /// @brief 邻接表，预着色结点不记录
+        std::vector<int32_t> adjList;
+
+        /// @brief 相关的传送指令
+        std::vector<int32_t> moves;
+    };
+
+    ///
+    /// @brief 传送指令，即两端都是结点的赋值
+    ///
+    struct Move {
+
+        /// @brief 目标结点
+        int32_t dst;
+
+        /// @brief 源结点
+        int32_t src;
+
+        /// @brief 所在的集合
+        MoveState state = MoveState::Worklist;
+    };
+
+    ///
+    /// @brief 获取值对应的结点，不参与分配的值返回-1
+    /// @param val 值
+    /// @return int32_t 结点编号
+    ///
+    int32_t nodeOf(Value * val);
+
+    ///
+    /// @brief 收集各指令读取与定值的结点，计算各块的循环深度与结点的溢出代价
+    ///
+    void collectOperands();
+
+    ///
+    /// @brief 计算各块出口活跃的结点
+    ///
+    void computeLiveness();
+
+    ///
+    /// @brief 逆序遍历各块的指令建立冲突图，并收集传送指令
+    ///
+    void build();
+
+    ///
+    /// @brief 添加冲突边
+    /// @param u 结点
+    /// @param v 结点
+    ///
+    void addEdge(int32_t u, int32_t v);
+
+    ///
+    /// @brief 两结点是否相邻
+    /// @param u 结点
+    /// @param v 结点
+    /// @return true：相邻 false：不相邻
+    ///
+    [[nodiscard]] bool isAdjacent(int32_t u, int32_t v) const;
+
+    ///
+    /// @brief 把初始结点分配到各工作表
+    ///
+    void makeWorklist();
+
+    ///
+    /// @brief 获取仍在图中的邻居，即不在选择栈中且未被合并
+    /// @param n 结点
+    /// @param result 邻居
+    ///
+    void adjacent(int32_t n, std::vector<int32_t> & result) const;
+
+    ///
+    /// @brief 结点是否还有可能合并的传送指令
+    /// @param n 结点
+    /// @return true：有 false：没有
+    ///
+    [[nodiscard]] bool isMoveRelated(int32_t n) const;
+
+    ///
+    /// @brief 去掉工作表末尾已移出的结点
+    /// @param worklist 工作表
+    /// @param state 工作表对应的状态
+    /// @return true：工作表非空 false：工作表为空
+    ///
+    bool trimWorklist(std::vector<int32_t> & worklist, NodeState state);
+
+    ///
+    /// @brief 去掉传送指令工作表末尾已移出的传送指令
+    /// @return true：工作表非空 false：工作表为空
+    ///
+    bool trimWorklistMoves();
+
+    ///
+    /// @brief 简化一个结点
+    ///
+    void simplify();
+
+    ///
+    /// @brief 度数减一，降到K-1时结点可以简化或冻结
+    /// @param m 结点
+    ///
+    void decrementDegree(int32_t m);
+
+    ///
+    /// @brief 结点及其邻居上暂不能合并的传送指令重新加入工作表
+    /// @param n 结点
+    ///
+    void enableMoves(int32_t n);
+
+    ///
+    /// @brief 尝试合并一条传送指令
+    ///
+    void coalesce();
+
+    ///
+    /// @brief 不再传送相关的低度数结点从冻结表移到简化表
+    /// @param u 结点
+    ///
+    void addWorkList(int32_t u);
+
+    ///
+    /// @brief George条件：t与预着色结点r合并不会增加问题
+    /// @param t 结点
+    /// @param r 预着色结点
+    /// @return true：可以 false：不可以
+    ///
+    [[nodiscard]] bool georgeOk(int32_t t, int32_t r) const;
+
+    ///
+    /// @brief Briggs条件：合并后高度数邻居少于K个
+    /// @param u 结点
+    /// @param v 结点
+    /// @return true：可以 false：不可以
+    ///
+    bool briggsOk(int32_t u, int32_t v);
+
+    ///
+    /// @brief 获取结点合并到的结点
+    /// @param n 结点
+    /// @return int32_t 结点
+    ///
+    [[nodiscard]] int32_t getAlias(int32_t n) const;
+
+    ///
+    /// @brief 把v合并到u
+    /// @param u 结点
+    /// @param v 结点
+    ///
+    void combine(int32_t u, int32_t v);
+
+    ///
+    /// @brief 冻结一个低度数的传送相关结点
+    ///
+    void freeze();
+
+    ///
+    /// @brief 放弃结点上的所有传送指令
+    /// @param u 结点
+    ///
+    void freezeMoves(int32_t u);
+
+    ///
+    /// @brief 选择代价/度数最小的结点作为潜在溢出
+    ///
+    void selectSpill();
+
+    ///
+    /// @brief 按出栈次序着色
+    ///
+    void assignColors();
+
+    ///
+    /// @brief 为实际溢出的结点分配栈槽，不冲突的结点共享栈槽
+    ///
+    void assignSpillSlots();
+
+    /// @brief 函数
+    Function * func;
+
+    /// @brief 控制流图，分配期间存在
+    ControlFlowGraph * cfg = nullptr;
+
+    /// @brief 所有结点，前K个为预着色结点
+    std::vector<Node> nodes;
+
+    /// @brief 值到结点编号的映射
+    std::unordered_map<Value *, int32_t> nodeIndex;
+
+    /// @brief 所有传送指令
+    std::vector<Move> moves;
+
+    /// @brief 冲突图的下三角位矩阵，结点数不超过上限时使用
+    std::vector<uint64_t> adjSet;
+
+    /// @brief 冲突图的边集合，键为较大编号左移32位与较小编号的组合，结点数超过上限时使用
+    std::unordered_set<uint64_t> adjHash;
+
+    /// @brief 是否使用位矩阵
+    bool denseAdj = true;
+
+    /// @brief 按块编号的循环深度
+    std::vector<int32_t> loopDepth;
+
+    /// @brief 各指令读取的结点，按布局次序
+    std::vector<std::vector<int32_t>> instUses;
+
+    /// @brief 各指令定值的结点，按布局次序
+    std::vector<std::vector<int32_t>> instDefs;
+
+    /// @brief 各指令是否为传送指令
+    std::vector<bool> instIsMove;
+
+    /// @brief 各块指令的编号范围[first, last)，按块编号
+    std::vector<std::pair<int32_t, int32_t>> blockInsts;
+
+    /// @brief 各块出口活跃的结点，按块编号
+    std::vector<std::vector<int32_t>> liveOut;
+
+    /// @brief 简化工作表，含已移出的结点，取出时按状态检查
+    std::vector<int32_t> simplifyWorklist;
+
+    /// @brief 冻结工作表，含已移出的结点
+    std::vector<int32_t> freezeWorklist;
+
+    /// @brief 溢出工作表，含已移出的结点
+    std::vector<int32_t> spillWorklist;
+
+    /// @brief 传送指令工作表，含已移出的传送指令
+    std::vector<int32_t> worklistMoves;
+
+    /// @brief 选择栈
+    std::vector<int32_t> selectStack;
+
+    /// @brief 计算Briggs条件时的去重标记
+    std::vector<int32_t> visitMark;
+
+    /// @brief 去重标记的当前值
+    int32_t visitStamp = 0;
+
+    /// @brief 使用过的寄存器，第i位表示寄存器ri
+    uint32_t usedRegMask = 0;
+
+    /// @brief 实际溢出的结点个数
+    int32_t spillCount = 0;
+
+    /// @brief 被合并的传送指令条数
+    int32_t coalescedMoveCount = 0;
+
+    /// @brief 溢出栈槽占用的空间大小
+    int32_t spillSize = 0;
+};
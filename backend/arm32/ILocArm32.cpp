@@ -13,233 +13,259 @@
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
 /// </table>
 ///
-#include <cstdio>
+#include <iterator>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "ILocArm32.h"
 #include "Common.h"
 #include "Function.h"
+#include "IRConstant.h"
 #include "PlatformArm32.h"
 #include "Module.h"
 
-ArmInst::ArmInst(std::string _opcode,
-                 std::string _result,
-                 std::string _arg1,
-                 std::string _arg2,
-                 std::string _cond,
-                 std::string _addition)
-    : opcode(_opcode), cond(_cond), result(_result), arg1(_arg1), arg2(_arg2), addition(_addition), dead(false)
-{}
+/// @brief 操作码的名字，与ArmOp的次序一致
+static const char * const armOpName[] = {
+    "",     // Nop
+    "",     // Label
+    "@",    // Comment
+    "mov",  // Mov
+    "movw", // Movw
+    "movt", // Movt
+    "ldr",  // Ldr
+    "str",  // Str
+    "add",  // Add
+    "sub",  // Sub
+    "push", // Push
+    "pop",  // Pop
+    "b",    // B
+    "bl",   // Bl
+    "bx",   // Bx
+};
+
+/// @brief 条件的后缀，与ArmCond的次序一致，AL不输出
+static const char * const armCondName[] = {
+    "", "eq", "ne", "cs", "cc", "mi", "pl", "vs", "vc", "hi", "ls", "ge", "lt", "gt", "le"};
 
-/*
-    指令内容替换
-*/
-void ArmInst::replace(std::string _opcode,
-                      std::string _result,
-                      std::string _arg1,
-                      std::string _arg2,
-                      std::string _cond,
-                      std::string _addition)
+/// @brief 构造函数
+/// @param _module 符号表
+/// @param func 所属的函数
+ILocArm32::ILocArm32(Module * _module, Function * func)
 {
-    opcode = _opcode;
-    result = _result;
-    arg1 = _arg1;
-    arg2 = _arg2;
-    cond = _cond;
-    addition = _addition;
-
-#if 0
-    // 空操作，则设置为dead
-    if (op == "") {
-        dead = true;
-    }
-#endif
+    this->module = _module;
+    this->labelPrefix = IR_LABEL_PREFIX + func->getName() + "_";
 }
 
-/*
-    设置为无效指令
-*/
-void ArmInst::setDead()
+/// @brief 删除无用的Label指令。连续的Label合并为第一个，删除跳转到紧随其后的Label的跳转指令，
+/// 再删除没有跳转指令使用的Label。Label按函数内的编号比较，整个过程与指令数成线性关系
+void ILocArm32::deleteUnusedLabel()
 {
-    dead = true;
-}
+    // 连续的Label只保留第一个，记录被合并的Label对应的保留Label
+    std::unordered_map<int32_t, int32_t> labelAlias;
 
-/*
-    输出函数
-*/
-std::string ArmInst::outPut()
-{
-    // 无用代码，什么都不输出
-    if (dead) {
-        return "";
-    }
+    const ArmInst * headLabel = nullptr;
 
-    // 占位指令,可能需要输出一个空操作，看是否支持 FIXME
-    if (opcode.empty()) {
-        return "";
-    }
+    for (ArmInst & arm: code) {
 
-    std::string ret = opcode;
+        if (arm.isTransparent()) {
+            continue;
+        }
 
-    if (!cond.empty()) {
-        ret += cond;
-    }
+        if (!arm.isLabel()) {
+            headLabel = nullptr;
+            continue;
+        }
 
-    // 结果输出
-    if (!result.empty()) {
-        if (result == ":") {
-            ret += result;
+        if (headLabel) {
+            labelAlias.emplace(arm.dst.value, headLabel->dst.value);
+            arm.setDead();
         } else {
-            ret += " " + result;
+            headLabel = &arm;
         }
     }
 
-    // 第一元参数输出
-    if (!arg1.empty()) {
-        ret += "," + arg1;
-    }
+    // 逆序处理跳转指令，后面的跳转先删除，前面的跳转才能看到紧随其后的Label
+    std::unordered_set<int32_t> usedLabels;
 
-    // 第二元参数输出
-    if (!arg2.empty()) {
-        ret += "," + arg2;
-    }
+    for (std::size_t pos = code.size(); pos-- > 0;) {
 
-    // 其他附加信息输出
-    if (!addition.empty()) {
-        ret += "," + addition;
-    }
+        ArmInst & arm = code[pos];
 
-    return ret;
-}
+        if (arm.dead || !arm.isLabelBranch()) {
+            continue;
+        }
 
-#define emit(...) code.push_back(new ArmInst(__VA_ARGS__))
+        // 目标若是被合并的Label，改为保留的Label
+        auto aliasIter = labelAlias.find(arm.dst.value);
+        if (aliasIter != labelAlias.end()) {
+            arm.dst.value = aliasIter->second;
+        }
 
-/// @brief 构造函数
-/// @param _module 符号表
-ILocArm32::ILocArm32(Module * _module)
-{
-    this->module = _module;
-}
+        // 紧随其后的有效指令就是目标Label时，跳转指令没有作用
+        std::size_t next = pos + 1;
+        while ((next < code.size()) && code[next].isTransparent()) {
+            ++next;
+        }
 
-/// @brief 析构函数
-ILocArm32::~ILocArm32()
-{
-    std::list<ArmInst *>::iterator pIter;
+        if ((next < code.size()) && code[next].isLabel() && (code[next].dst.value == arm.dst.value)) {
+            arm.setDead();
+            continue;
+        }
 
-    for (pIter = code.begin(); pIter != code.end(); ++pIter) {
-        delete (*pIter);
+        usedLabels.insert(arm.dst.value);
     }
-}
 
-/// @brief 删除无用的Label指令
-void ILocArm32::deleteUnusedLabel()
-{
-    std::list<ArmInst *> labelInsts;
-    for (ArmInst * arm: code) {
-        if ((!arm->dead) && (arm->opcode[0] == '.') && (arm->result == ":")) {
-            labelInsts.push_back(arm);
+    // 没有跳转指令使用的Label设置为dead
+    for (ArmInst & arm: code) {
+        if ((!arm.dead) && arm.isLabel() && !usedLabels.count(arm.dst.value)) {
+            arm.setDead();
         }
     }
+}
 
-    // 检测Label指令是否在被使用，也就是是否有跳转到该Label的指令
-    // 如果没有使用，则设置为dead
-    for (ArmInst * labelArm: labelInsts) {
-        bool labelUsed = false;
-
-        for (ArmInst * arm: code) {
-            // TODO 转移语句的指令标识符根据定义修改判断
-            if ((!arm->dead) && (arm->opcode[0] == 'b') && (arm->result == labelArm->opcode)) {
-                labelUsed = true;
-                break;
+/// @brief 一个操作数的文本追加到输出中
+/// @param str 输出
+/// @param op 指令的操作码，movw与movt的立即数与符号加上重定位的前缀
+/// @param opnd 操作数
+void ILocArm32::outPutOperand(std::string & str, ArmOp op, const ArmOperand & opnd) const
+{
+    switch (opnd.kind) {
+        case ArmOperand::Kind::Reg:
+            str += PlatformArm32::regName[opnd.reg];
+            break;
+        case ArmOperand::Kind::Imm:
+        case ArmOperand::Kind::Symbol:
+            if (op == ArmOp::Movw) {
+                str += "#:lower16:";
+            } else if (op == ArmOp::Movt) {
+                str += "#:upper16:";
+            } else if (opnd.kind == ArmOperand::Kind::Imm) {
+                str += "#";
             }
+            if (opnd.kind == ArmOperand::Kind::Imm) {
+                str += std::to_string(opnd.value);
+            } else {
+                str += symbolName((Symbol) opnd.value);
+            }
+            break;
+        case ArmOperand::Kind::Label:
+            str += labelPrefix + std::to_string(opnd.value);
+            break;
+        case ArmOperand::Kind::MemImm:
+            // [fp,#-16] [fp]
+            str += "[" + PlatformArm32::regName[opnd.reg];
+            if (opnd.value) {
+                str += ",#" + std::to_string(opnd.value);
+            }
+            str += "]";
+            break;
+        case ArmOperand::Kind::MemReg:
+            // [fp,r8]
+            str += "[" + PlatformArm32::regName[opnd.reg] + "," + PlatformArm32::regName[opnd.index] + "]";
+            break;
+        case ArmOperand::Kind::RegList: {
+            // {r10,fp,lr}
+            str += "{";
+            bool first = true;
+            for (int regNo = 0; regNo < PlatformArm32::maxRegNum; regNo++) {
+                if ((uint32_t) opnd.value & (1u << regNo)) {
+                    if (!first) {
+                        str += ",";
+                    }
+                    str += PlatformArm32::regName[regNo];
+                    first = false;
+                }
+            }
+            str += "}";
+            break;
         }
-
-        if (!labelUsed) {
-            labelArm->setDead();
-        }
+        case ArmOperand::Kind::Comment:
+            str += comments[(std::size_t) opnd.value];
+            break;
+        case ArmOperand::Kind::None:
+        default:
+            break;
     }
 }
 
-/// @brief 输出汇编
-/// @param file 输出的文件指针
+/// @brief 输出汇编，指令的文本在这里才产生
+/// @param str 汇编文本，追加到尾部
 /// @param outputEmpty 是否输出空语句
-void ILocArm32::outPut(FILE * file, bool outputEmpty)
+void ILocArm32::outPut(std::string & str, bool outputEmpty)
 {
-    for (auto arm: code) {
+    for (const ArmInst & arm: code) {
 
-        std::string s = arm->outPut();
+        if (arm.dead) {
+            // 无用代码，Label不输出，其它指令按需输出空行
+            if (outputEmpty && !arm.isLabel()) {
+                str += "\n";
+            }
+            continue;
+        }
 
-        if (arm->result == ":") {
+        if (arm.op == ArmOp::Label) {
             // Label指令，不需要Tab输出
-            fprintf(file, "%s\n", s.c_str());
+            outPutOperand(str, arm.op, arm.dst);
+            str += ":\n";
             continue;
         }
 
-        if (!s.empty()) {
-            fprintf(file, "\t%s\n", s.c_str());
-        } else if ((outputEmpty)) {
-            fprintf(file, "\n");
+        if (arm.op == ArmOp::Nop) {
+            // 占位指令，可能需要输出一个空操作，看是否支持 FIXME
+            if (outputEmpty) {
+                str += "\n";
+            }
+            continue;
+        }
+
+        str += "\t";
+        str += armOpName[(int) arm.op];
+        str += armCondName[(int) arm.cond];
+
+        if (arm.dst.kind != ArmOperand::Kind::None) {
+            str += " ";
+            outPutOperand(str, arm.op, arm.dst);
+        }
+
+        if (arm.src1.kind != ArmOperand::Kind::None) {
+            str += ",";
+            outPutOperand(str, arm.op, arm.src1);
+        }
+
+        if (arm.src2.kind != ArmOperand::Kind::None) {
+            str += ",";
+            outPutOperand(str, arm.op, arm.src2);
         }
+
+        str += "\n";
     }
 }
 
 /// @brief 获取当前的代码序列
 /// @return 代码序列
-std::list<ArmInst *> & ILocArm32::getCode()
+std::vector<ArmInst> & ILocArm32::getCode()
 {
     return code;
 }
 
-/**
- * 数字变字符串，若flag为真，则变为立即数寻址（加#）
- */
-std::string ILocArm32::toStr(int num, bool flag)
-{
-    std::string ret;
-
-    if (flag) {
-        ret = "#";
-    }
-
-    ret += std::to_string(num);
-
-    return ret;
-}
-
 /*
     产生标签
 */
-void ILocArm32::label(std::string name)
+void ILocArm32::label(int32_t labelIndex)
 {
     // .L1:
-    emit(name, ":");
-}
-
-/// @brief 0个源操作数指令
-/// @param op 操作码
-/// @param rs 操作数
-void ILocArm32::inst(std::string op, std::string rs)
-{
-    emit(op, rs);
-}
-
-/// @brief 一个操作数指令
-/// @param op 操作码
-/// @param rs 操作数
-/// @param arg1 源操作数
-void ILocArm32::inst(std::string op, std::string rs, std::string arg1)
-{
-    emit(op, rs, arg1);
+    emit(ArmOp::Label, ArmOperand::makeLabel(labelIndex));
 }
 
-/// @brief 一个操作数指令
+/// @brief 通用的指令
 /// @param op 操作码
-/// @param rs 操作数
-/// @param arg1 源操作数
-/// @param arg2 源操作数
-void ILocArm32::inst(std::string op, std::string rs, std::string arg1, std::string arg2)
+/// @param dst 结果操作数
+/// @param src1 源操作数1
+/// @param src2 源操作数2
+void ILocArm32::inst(ArmOp op, ArmOperand dst, ArmOperand src1, ArmOperand src2)
 {
-    emit(op, rs, arg1, arg2);
+    emit(op, dst, src1, src2);
 }
 
 ///
@@ -247,7 +273,13 @@ void ILocArm32::inst(std::string op, std::string rs, std::string arg1, std::stri
 ///
 void ILocArm32::comment(std::string str)
 {
-    emit("@", str);
+    ArmOperand text;
+    text.kind = ArmOperand::Kind::Comment;
+    text.value = (int32_t) comments.size();
+
+    comments.push_back(std::move(str));
+
+    emit(ArmOp::Comment, text);
 }
 
 /*
@@ -257,25 +289,25 @@ void ILocArm32::load_imm(int rs_reg_no, int constant)
 {
     // movw:把 16 位立即数放到寄存器的低16位，高16位清0
     // movt:把 16 位立即数放到寄存器的高16位，低 16位不影响
-    if (0 == ((constant >> 16) & 0xFFFF)) {
-        // 如果高16位本来就为0，直接movw
-        emit("movw", PlatformArm32::regName[rs_reg_no], "#:lower16:" + std::to_string(constant));
-    } else {
+    emit(ArmOp::Movw, ArmOperand::makeReg(rs_reg_no), ArmOperand::makeImm(constant));
+
+    if (0 != ((constant >> 16) & 0xFFFF)) {
         // 如果高16位不为0，先movw，然后movt
-        emit("movw", PlatformArm32::regName[rs_reg_no], "#:lower16:" + std::to_string(constant));
-        emit("movt", PlatformArm32::regName[rs_reg_no], "#:upper16:" + std::to_string(constant));
+        emit(ArmOp::Movt, ArmOperand::makeReg(rs_reg_no), ArmOperand::makeImm(constant));
     }
 }
 
 /// @brief 加载符号值 ldr r0,=g ldr r0,=.L1
 /// @param rs_reg_no 结果寄存器编号
 /// @param name 符号名
-void ILocArm32::load_symbol(int rs_reg_no, std::string name)
+void ILocArm32::load_symbol(int rs_reg_no, const std::string & name)
 {
     // movw r10, #:lower16:a
     // movt r10, #:upper16:a
-    emit("movw", PlatformArm32::regName[rs_reg_no], "#:lower16:" + name);
-    emit("movt", PlatformArm32::regName[rs_reg_no], "#:upper16:" + name);
+    ArmOperand sym = ArmOperand::makeSymbol(internSymbol(name));
+
+    emit(ArmOp::Movw, ArmOperand::makeReg(rs_reg_no), sym);
+    emit(ArmOp::Movt, ArmOperand::makeReg(rs_reg_no), sym);
 }
 
 /// @brief 基址寻址 ldr r0,[fp,#100]
@@ -284,30 +316,18 @@ void ILocArm32::load_symbol(int rs_reg_no, std::string name)
 /// @param offset 偏移
 void ILocArm32::load_base(int rs_reg_no, int base_reg_no, int offset)
 {
-    std::string rsReg = PlatformArm32::regName[rs_reg_no];
-    std::string base = PlatformArm32::regName[base_reg_no];
-
     if (PlatformArm32::isDisp(offset)) {
         // 有效的偏移常量
-        if (offset) {
-            // [fp,#-16] [fp]
-            base += "," + toStr(offset);
-        }
+        // ldr r8,[fp,#-16]
+        emit(ArmOp::Ldr, ArmOperand::makeReg(rs_reg_no), ArmOperand::makeMem(base_reg_no, offset));
     } else {
 
         // ldr r8,=-4096
         load_imm(rs_reg_no, offset);
 
-        // fp,r8
-        base += "," + rsReg;
+        // ldr r8,[fp,r8]
+        emit(ArmOp::Ldr, ArmOperand::makeReg(rs_reg_no), ArmOperand::makeMemReg(base_reg_no, rs_reg_no));
     }
-
-    // 内存寻址
-    base = "[" + base + "]";
-
-    // ldr r8,[fp,#-16]
-    // ldr r8,[fp,r8]
-    emit("ldr", rsReg, base);
 }
 
 /// @brief 基址寻址 str r0,[fp,#100]
@@ -317,32 +337,19 @@ void ILocArm32::load_base(int rs_reg_no, int base_reg_no, int offset)
 /// @param tmp_reg_no 可能需要临时寄存器编号
 void ILocArm32::store_base(int src_reg_no, int base_reg_no, int disp, int tmp_reg_no)
 {
-    std::string base = PlatformArm32::regName[base_reg_no];
-
     if (PlatformArm32::isDisp(disp)) {
-        // 有效的偏移常量
-
-        // 若disp为0，则直接采用基址，否则采用基址+偏移
-        // [fp,#-16] [fp]
-        if (disp) {
-            base += "," + toStr(disp);
-        }
+        // 有效的偏移常量，若disp为0，则直接采用基址，否则采用基址+偏移
+        // str r8,[fp,#-16]
+        emit(ArmOp::Str, ArmOperand::makeReg(src_reg_no), ArmOperand::makeMem(base_reg_no, disp));
     } else {
         // 先把立即数赋值给指定的寄存器tmpReg，然后采用基址+寄存器的方式进行
 
         // ldr r9,=-4096
         load_imm(tmp_reg_no, disp);
 
-        // fp,r9
-        base += "," + PlatformArm32::regName[tmp_reg_no];
+        // str r8,[fp,r9]
+        emit(ArmOp::Str, ArmOperand::makeReg(src_reg_no), ArmOperand::makeMemReg(base_reg_no, tmp_reg_no));
     }
-
-    // 内存间接寻址
-    base = "[" + base + "]";
-
-    // str r8,[fp,#-16]
-    // str r8,[fp,r9]
-    emit("str", PlatformArm32::regName[src_reg_no], base);
 }
 
 /// @brief 寄存器Mov操作
@@ -350,7 +357,7 @@ void ILocArm32::store_base(int src_reg_no, int base_reg_no, int disp, int tmp_re
 /// @param src_reg_no 源寄存器
 void ILocArm32::mov_reg(int rs_reg_no, int src_reg_no)
 {
-    emit("mov", PlatformArm32::regName[rs_reg_no], PlatformArm32::regName[src_reg_no]);
+    emit(ArmOp::Mov, ArmOperand::makeReg(rs_reg_no), ArmOperand::makeReg(src_reg_no));
 }
 
 /// @brief 加载变量到寄存器，保证将变量放到reg中
@@ -359,7 +366,7 @@ void ILocArm32::mov_reg(int rs_reg_no, int src_reg_no)
 void ILocArm32::load_var(int rs_reg_no, Value * src_var)
 {
 
-    if (Instanceof(constVal, ConstInt *, src_var)) {
+    if (auto * constVal = dyn_cast<ConstInt>(src_var)) {
         // 整型常量
 
         // TODO 目前只考虑整数类型 100
@@ -373,9 +380,9 @@ void ILocArm32::load_var(int rs_reg_no, Value * src_var)
         if (src_regId != rs_reg_no) {
 
             // mov r8,r2 | 这里有优化空间——消除r8
-            emit("mov", PlatformArm32::regName[rs_reg_no], PlatformArm32::regName[src_regId]);
+            mov_reg(rs_reg_no, src_regId);
         }
-    } else if (Instanceof(globalVar, GlobalVariable *, src_var)) {
+    } else if (auto * globalVar = dyn_cast<GlobalVariable>(src_var)) {
         // 全局变量
 
         // 读取全局变量的地址
@@ -384,7 +391,7 @@ void ILocArm32::load_var(int rs_reg_no, Value * src_var)
         load_symbol(rs_reg_no, globalVar->getName());
 
         // ldr r8, [r8]
-        emit("ldr", PlatformArm32::regName[rs_reg_no], "[" + PlatformArm32::regName[rs_reg_no] + "]");
+        emit(ArmOp::Ldr, ArmOperand::makeReg(rs_reg_no), ArmOperand::makeMem(rs_reg_no, 0));
 
     } else {
 
@@ -449,17 +456,17 @@ void ILocArm32::store_var(int src_reg_no, Value * dest_var, int tmp_reg_no)
         if (src_reg_no != dest_reg_id) {
 
             // mov r2,r8 | 这里有优化空间——消除r8
-            emit("mov", PlatformArm32::regName[dest_reg_id], PlatformArm32::regName[src_reg_no]);
+            mov_reg(dest_reg_id, src_reg_no);
         }
 
-    } else if (Instanceof(globalVar, GlobalVariable *, dest_var)) {
+    } else if (auto * globalVar = dyn_cast<GlobalVariable>(dest_var)) {
         // 全局变量
 
         // 读取符号的地址到寄存器r10
         load_symbol(tmp_reg_no, globalVar->getName());
 
         // str r8, [r10]
-        emit("str", PlatformArm32::regName[src_reg_no], "[" + PlatformArm32::regName[tmp_reg_no] + "]");
+        emit(ArmOp::Str, ArmOperand::makeReg(src_reg_no), ArmOperand::makeMem(tmp_reg_no, 0));
 
     } else {
 
@@ -488,18 +495,18 @@ void ILocArm32::store_var(int src_reg_no, Value * dest_var, int tmp_reg_no)
 /// @param off 偏移
 void ILocArm32::leaStack(int rs_reg_no, int base_reg_no, int off)
 {
-    std::string rs_reg_name = PlatformArm32::regName[rs_reg_no];
-    std::string base_reg_name = PlatformArm32::regName[base_reg_no];
-
     if (PlatformArm32::constExpr(off))
         // add r8,fp,#-16
-        emit("add", rs_reg_name, base_reg_name, toStr(off));
+        emit(ArmOp::Add, ArmOperand::makeReg(rs_reg_no), ArmOperand::makeReg(base_reg_no), ArmOperand::makeImm(off));
     else {
         // ldr r8,=-257
         load_imm(rs_reg_no, off);
 
         // add r8,fp,r8
-        emit("add", rs_reg_name, base_reg_name, rs_reg_name);
+        emit(ArmOp::Add,
+             ArmOperand::makeReg(rs_reg_no),
+             ArmOperand::makeReg(base_reg_no),
+             ArmOperand::makeReg(rs_reg_no));
     }
 }
 
@@ -519,38 +526,94 @@ void ILocArm32::allocStack(Function * func, int tmp_reg_no)
     // 保存SP寄存器到FP寄存器中
     mov_reg(ARM32_FP_REG_NO, ARM32_SP_REG_NO);
 
+    ArmOperand sp = ArmOperand::makeReg(ARM32_SP_REG_NO);
+
     if (PlatformArm32::constExpr(off)) {
         // sub sp,sp,#16
-        emit("sub", "sp", "sp", toStr(off));
+        emit(ArmOp::Sub, sp, sp, ArmOperand::makeImm(off));
     } else {
         // ldr r8,=257
         load_imm(tmp_reg_no, off);
 
         // sub sp,sp,r8
-        emit("sub", "sp", "sp", PlatformArm32::regName[tmp_reg_no]);
+        emit(ArmOp::Sub, sp, sp, ArmOperand::makeReg(tmp_reg_no));
     }
 }
 
 /// @brief 调用函数fun
 /// @param fun
-void ILocArm32::call_fun(std::string name)
+void ILocArm32::call_fun(const std::string & name)
 {
     // 函数返回值在r0,不需要保护
-    emit("bl", name);
+    emit(ArmOp::Bl, ArmOperand::makeSymbol(internSymbol(name)));
 }
 
 /// @brief NOP操作
 void ILocArm32::nop()
 {
     // FIXME 无操作符，要确认是否用nop指令
-    emit("");
+    emit(ArmOp::Nop);
 }
 
 ///
 /// @brief 无条件跳转指令
-/// @param label 目标Label名称
+/// @param labelIndex 目标Label在函数内的编号
 ///
-void ILocArm32::jump(std::string label)
+void ILocArm32::jump(int32_t labelIndex)
+{
+    emit(ArmOp::B, ArmOperand::makeLabel(labelIndex));
+}
+
+/// @brief 统计以fp或sp为基址的ldr/str指令条数
+/// @return int32_t 指令条数
+int32_t ILocArm32::countStackAccesses() const
+{
+    int32_t count = 0;
+
+    for (const ArmInst & armInst: code) {
+
+        if (armInst.dead || ((armInst.op != ArmOp::Ldr) && (armInst.op != ArmOp::Str))) {
+            continue;
+        }
+
+        const ArmOperand & mem = armInst.src1;
+        bool isMem = (mem.kind == ArmOperand::Kind::MemImm) || (mem.kind == ArmOperand::Kind::MemReg);
+
+        if (isMem && ((mem.reg == ARM32_FP_REG_NO) || (mem.reg == ARM32_SP_REG_NO))) {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+/// @brief 统计寄存器之间的mov指令条数
+/// @return int32_t 指令条数
+int32_t ILocArm32::countRegisterMoves() const
 {
-    emit("b", label);
+    int32_t count = 0;
+
+    for (const ArmInst & armInst: code) {
+        if (!armInst.dead && (armInst.op == ArmOp::Mov) && (armInst.src1.kind == ArmOperand::Kind::Reg)) {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+/// @brief 统计输出的指令条数
+/// @return int32_t 指令条数
+int32_t ILocArm32::countInsts() const
+{
+    int32_t count = 0;
+
+    for (const ArmInst & armInst: code) {
+        if (!armInst.dead && (armInst.op != ArmOp::Nop) && (armInst.op != ArmOp::Label) &&
+            (armInst.op != ArmOp::Comment)) {
+            count++;
+        }
+    }
+
+    return count;
 }
@@ -15,89 +15,271 @@
 ///
 #pragma once
 
-#include <list>
+#include <cstdint>
 #include <string>
+#include <vector>
 
 #include "Module.h"
+#include "StringInterner.h"
 
-#define Instanceof(res, type, var) auto res = dynamic_cast<type>(var)
+/// @brief ARM32指令的操作码，Label、注释以及空操作也作为指令保存
+enum class ArmOp : uint8_t {
 
-/// @brief 底层汇编指令：ARM32
+    /// @brief 空操作，不输出
+    Nop,
+
+    /// @brief Label，.L1:
+    Label,
+
+    /// @brief 注释，@ xxx
+    Comment,
+
+    /// @brief mov rd,rm
+    Mov,
+
+    /// @brief movw rd,#:lower16:imm
+    Movw,
+
+    /// @brief movt rd,#:upper16:imm
+    Movt,
+
+    /// @brief ldr rd,[rn,#off]
+    Ldr,
+
+    /// @brief str rd,[rn,#off]
+    Str,
+
+    /// @brief add rd,rn,op2
+    Add,
+
+    /// @brief sub rd,rn,op2
+    Sub,
+
+    /// @brief push {reglist}
+    Push,
+
+    /// @brief pop {reglist}
+    Pop,
+
+    /// @brief b label，可带条件
+    B,
+
+    /// @brief bl symbol
+    Bl,
+
+    /// @brief bx rm
+    Bx,
+};
+
+/// @brief ARM32指令的执行条件
+enum class ArmCond : uint8_t {
+    AL,
+    EQ,
+    NE,
+    CS,
+    CC,
+    MI,
+    PL,
+    VS,
+    VC,
+    HI,
+    LS,
+    GE,
+    LT,
+    GT,
+    LE,
+};
+
+/// @brief ARM32指令的操作数
+struct ArmOperand {
+
+    /// @brief 操作数的种类
+    enum class Kind : uint8_t {
+
+        /// @brief 无操作数
+        None,
+
+        /// @brief 寄存器，reg
+        Reg,
+
+        /// @brief 立即数，value
+        Imm,
+
+        /// @brief 函数内的Label，value为函数内的编号，输出时才加上函数名形成.L<函数名>_<编号>
+        Label,
+
+        /// @brief 全局符号，如全局变量或函数名，value为名字在字符串池中的编号
+        Symbol,
+
+        /// @brief 基址+偏移的内存寻址[reg,#value]
+        MemImm,
+
+        /// @brief 基址+寄存器的内存寻址[reg,index]
+        MemReg,
+
+        /// @brief 寄存器列表，value的第i位表示寄存器ri
+        RegList,
+
+        /// @brief 注释，value为注释在指令序列的注释表中的下标
+        Comment,
+    };
+
+    /// @brief 种类
+    Kind kind = Kind::None;
+
+    /// @brief 寄存器或基址寄存器的编号
+    int8_t reg = -1;
+
+    /// @brief 变址寄存器的编号
+    int8_t index = -1;
+
+    /// @brief 立即数、偏移、编号或位图
+    int32_t value = 0;
+
+    /// @brief 寄存器操作数
+    static ArmOperand makeReg(int regNo)
+    {
+        return ArmOperand{Kind::Reg, (int8_t) regNo, -1, 0};
+    }
+
+    /// @brief 立即数操作数
+    static ArmOperand makeImm(int32_t imm)
+    {
+        return ArmOperand{Kind::Imm, -1, -1, imm};
+    }
+
+    /// @brief Label操作数
+    static ArmOperand makeLabel(int32_t labelIndex)
+    {
+        return ArmOperand{Kind::Label, -1, -1, labelIndex};
+    }
+
+    /// @brief 全局符号操作数
+    static ArmOperand makeSymbol(Symbol sym)
+    {
+        return ArmOperand{Kind::Symbol, -1, -1, (int32_t) sym};
+    }
+
+    /// @brief 基址+偏移的内存操作数
+    static ArmOperand makeMem(int baseRegNo, int32_t offset)
+    {
+        return ArmOperand{Kind::MemImm, (int8_t) baseRegNo, -1, offset};
+    }
+
+    /// @brief 基址+寄存器的内存操作数
+    static ArmOperand makeMemReg(int baseRegNo, int indexRegNo)
+    {
+        return ArmOperand{Kind::MemReg, (int8_t) baseRegNo, (int8_t) indexRegNo, 0};
+    }
+
+    /// @brief 寄存器列表操作数
+    static ArmOperand makeRegList(uint32_t regMask)
+    {
+        return ArmOperand{Kind::RegList, -1, -1, (int32_t) regMask};
+    }
+
+    /// @brief 是否是指定的寄存器
+    [[nodiscard]] bool isReg(int regNo) const
+    {
+        return (kind == Kind::Reg) && (reg == regNo);
+    }
+
+    /// @brief 两个操作数是否相同
+    bool operator==(const ArmOperand & other) const
+    {
+        return (kind == other.kind) && (reg == other.reg) && (index == other.index) && (value == other.value);
+    }
+};
+
+/// @brief 底层汇编指令：ARM32。只保存操作码、条件与操作数，文本在输出时才产生
 struct ArmInst {
 
     /// @brief 操作码
-    std::string opcode;
+    ArmOp op;
 
     /// @brief 条件
-    std::string cond;
+    ArmCond cond = ArmCond::AL;
+
+    /// @brief 标识指令是否无效
+    bool dead = false;
 
-    /// @brief 结果
-    std::string result;
+    /// @brief 结果操作数，或Label、跳转目标、寄存器列表等唯一的操作数
+    ArmOperand dst;
 
     /// @brief 源操作数1
-    std::string arg1;
+    ArmOperand src1;
 
     /// @brief 源操作数2
-    std::string arg2;
-
-    /// @brief 附加信息
-    std::string addition;
-
-    /// @brief 标识指令是否无效
-    bool dead;
+    ArmOperand src2;
 
     /// @brief 构造函数
-    /// @param op
-    /// @param rs
-    /// @param s1
-    /// @param s2
-    /// @param add
-    ArmInst(std::string op,
-            std::string rs = "",
-            std::string s1 = "",
-            std::string s2 = "",
-            std::string cond = "",
-            std::string extra = "");
-
-    /// @brief 指令更新
-    /// @param op
-    /// @param rs
-    /// @param s1
-    /// @param s2
-    /// @param add
-    void replace(std::string op,
-                 std::string rs = "",
-                 std::string s1 = "",
-                 std::string s2 = "",
-                 std::string cond = "",
-                 std::string extra = "");
+    /// @param _op 操作码
+    /// @param _dst 结果操作数
+    /// @param _src1 源操作数1
+    /// @param _src2 源操作数2
+    explicit ArmInst(ArmOp _op, ArmOperand _dst = {}, ArmOperand _src1 = {}, ArmOperand _src2 = {})
+        : op(_op), dst(_dst), src1(_src1), src2(_src2)
+    {}
 
     /// @brief 设置死指令
-    void setDead();
-
-    /// @brief 指令字符串输出函数
-    /// @return
-    std::string outPut();
+    void setDead()
+    {
+        dead = true;
+    }
+
+    /// @brief 是否是Label
+    [[nodiscard]] bool isLabel() const
+    {
+        return op == ArmOp::Label;
+    }
+
+    /// @brief 是否是跳转到Label的指令，含条件跳转
+    [[nodiscard]] bool isLabelBranch() const
+    {
+        return (op == ArmOp::B) && (dst.kind == ArmOperand::Kind::Label);
+    }
+
+    /// @brief 是否不产生代码，包括无效指令、注释以及空操作，判断指令是否相邻时跳过
+    [[nodiscard]] bool isTransparent() const
+    {
+        return dead || (op == ArmOp::Nop) || (op == ArmOp::Comment);
+    }
 };
 
-/// @brief 底层汇编序列-ARM32
+/// @brief 底层汇编序列-ARM32，函数的指令连续存放
 class ILocArm32 {
 
     /// @brief ARM汇编序列
-    std::list<ArmInst *> code;
+    std::vector<ArmInst> code;
+
+    /// @brief 注释的文本，注释指令通过下标引用
+    std::vector<std::string> comments;
 
     /// @brief 符号表
     Module * module;
 
-    /// @brief 加载立即数 ldr r0,=#100
+    /// @brief 函数内Label的前缀.L<函数名>_，Label只在函数内编号，不进入全局的字符串池
+    std::string labelPrefix;
+
+    /// @brief 加入一条指令
+    /// @param op 操作码
+    /// @param dst 结果操作数
+    /// @param src1 源操作数1
+    /// @param src2 源操作数2
+    void emit(ArmOp op, ArmOperand dst = {}, ArmOperand src1 = {}, ArmOperand src2 = {})
+    {
+        code.emplace_back(op, dst, src1, src2);
+    }
+
+    /// @brief 加载立即数 movw r0,#:lower16:100
     /// @param rs_reg_no 结果寄存器号
     /// @param num 立即数
     void load_imm(int rs_reg_no, int num);
 
-    /// @brief 加载符号值 ldr r0,=g; ldr r0,[r0]
+    /// @brief 加载符号的地址 movw r0,#:lower16:g
     /// @param rsReg 结果寄存器号
-    /// @param name Label名字
-    void load_symbol(int rs_reg_no, std::string name);
+    /// @param name 符号名
+    void load_symbol(int rs_reg_no, const std::string & name);
 
     /// @brief 加载栈内变量地址
     /// @param rsReg 结果寄存器号
@@ -105,13 +287,17 @@ class ILocArm32 {
     /// @param off 偏移
     void leaStack(int rs_reg_no, int base_reg_no, int offset);
 
+    /// @brief 一个操作数的文本追加到输出中
+    /// @param str 输出
+    /// @param op 指令的操作码，决定立即数的格式
+    /// @param opnd 操作数
+    void outPutOperand(std::string & str, ArmOp op, const ArmOperand & opnd) const;
+
 public:
     /// @brief 构造函数
     /// @param _module 符号表-模块
-    ILocArm32(Module * _module);
-
-    /// @brief 析构函数
-    ~ILocArm32();
+    /// @param func 所属的函数，其名字作为Label的前缀
+    ILocArm32(Module * _module, Function * func);
 
     ///
     /// @brief 注释指令，不包含分号
@@ -119,15 +305,9 @@ public:
     ///
     void comment(std::string str);
 
-    /// @brief 数字变字符串，若flag为真，则变为立即数寻址（加#）
-    /// @param num 立即数
-    /// @param flag 是否家#
-    /// @return 字符串
-    std::string toStr(int num, bool flag = true);
-
     /// @brief 获取当前的代码序列
     /// @return 代码序列
-    std::list<ArmInst *> & getCode();
+    std::vector<ArmInst> & getCode();
 
     /// @brief Load指令，基址寻址 ldr r0,[fp,#100]
     /// @param rs_reg_no 结果寄存器
@@ -143,26 +323,15 @@ public:
     void store_base(int src_reg_no, int base_reg_no, int disp, int tmp_reg_no);
 
     /// @brief 标签指令
-    /// @param name
-    void label(std::string name);
-
-    /// @brief 一个操作数指令
-    /// @param op 操作码
-    /// @param rs 操作数
-    void inst(std::string op, std::string rs);
-
-    /// @brief 一个操作数指令
-    /// @param op 操作码
-    /// @param rs 操作数
-    /// @param arg1 源操作数
-    void inst(std::string op, std::string rs, std::string arg1);
+    /// @param labelIndex 函数内Label的编号
+    void label(int32_t labelIndex);
 
-    /// @brief 一个操作数指令
+    /// @brief 通用的指令
     /// @param op 操作码
-    /// @param rs 操作数
-    /// @param arg1 源操作数
-    /// @param arg2 源操作数
-    void inst(std::string op, std::string rs, std::string arg1, std::string arg2);
+    /// @param dst 结果操作数
+    /// @param src1 源操作数1
+    /// @param src2 源操作数2
+    void inst(ArmOp op, ArmOperand dst, ArmOperand src1 = {}, ArmOperand src2 = {});
 
     /// @brief 加载变量到寄存器
     /// @param rs_reg_no 结果寄存器
@@ -187,31 +356,45 @@ public:
 
     /// @brief 调用函数fun
     /// @param fun
-    void call_fun(std::string name);
+    void call_fun(const std::string & name);
 
     /// @brief 分配栈帧
     /// @param func 函数
     /// @param tmp_reg_No
     void allocStack(Function * func, int tmp_reg_No);
 
-    /// @brief 加载函数的参数到寄存器
-    /// @param fun
-    void ldr_args(Function * fun);
-
     /// @brief NOP操作
     void nop();
 
     ///
     /// @brief 无条件跳转指令
-    /// @param label 目标Label名称
+    /// @param labelIndex 目标Label在函数内的编号
     ///
-    void jump(std::string label);
+    void jump(int32_t labelIndex);
 
     /// @brief 输出汇编
-    /// @param file 输出的文件指针
+    /// @param str 汇编文本，追加到尾部
     /// @param outputEmpty 是否输出空语句
-    void outPut(FILE * file, bool outputEmpty = false);
+    void outPut(std::string & str, bool outputEmpty = false);
 
-    /// @brief 删除无用的Label指令
+    /// @brief 删除无用的Label指令，同时删除跳转到紧随其后的Label的跳转指令，并合并连续的Label
     void deleteUnusedLabel();
+
+    ///
+    /// @brief 统计以fp或sp为基址的ldr/str指令条数，即栈内变量的读写次数
+    /// @return int32_t 指令条数
+    ///
+    [[nodiscard]] int32_t countStackAccesses() const;
+
+    ///
+    /// @brief 统计寄存器之间的mov指令条数
+    /// @return int32_t 指令条数
+    ///
+    [[nodiscard]] int32_t countRegisterMoves() const;
+
+    ///
+    /// @brief 统计输出的指令条数，不含Label与注释
+    /// @return int32_t 指令条数
+    ///
+    [[nodiscard]] int32_t countInsts() const;
 };
@@ -22,6 +22,7 @@
 
 #include "PointerType.h"
 #include "RegVariable.h"
+#include "TimeReport.h"
 #include "Function.h"
 
 #include "LabelInstruction.h"
@@ -33,7 +34,7 @@
 /// @param _irCode 指令
 /// @param _iloc ILoc
 /// @param _func 函数
-InstSelectorArm32::InstSelectorArm32(vector<Instruction *> & _irCode,
+InstSelectorArm32::InstSelectorArm32(InstList & _irCode,
                                      ILocArm32 & _iloc,
                                      Function * _func,
                                      SimpleRegisterAllocator & allocator)
@@ -57,6 +58,16 @@ InstSelectorArm32::~InstSelectorArm32()
 /// @brief 指令选择执行
 void InstSelectorArm32::run()
 {
+    TimeScope scope("instruction selection", [this] { return func->getName(); });
+
+    // 汇编的Label须在程序内唯一，由ILocArm32输出时加上函数名，这里只在函数内编号
+    int32_t index = 0;
+    for (auto inst: ir) {
+        if (inst->getOp() == IRInstOperator::IRINST_OP_LABEL) {
+            labelIndex.emplace(inst, index++);
+        }
+    }
+
     for (auto inst: ir) {
 
         // 逐个指令进行翻译
@@ -113,19 +124,17 @@ void InstSelectorArm32::translate_nop(Instruction * inst)
 /// @param inst IR指令
 void InstSelectorArm32::translate_label(Instruction * inst)
 {
-    Instanceof(labelInst, LabelInstruction *, inst);
-
-    iloc.label(labelInst->getName());
+    iloc.label(labelIndex.at(inst));
 }
 
 /// @brief goto指令指令翻译成ARM32汇编
 /// @param inst IR指令
 void InstSelectorArm32::translate_goto(Instruction * inst)
 {
-    Instanceof(gotoInst, GotoInstruction *, inst);
+    auto * gotoInst = cast<GotoInstruction>(inst);
 
     // 无条件跳转
-    iloc.jump(gotoInst->getTarget()->getName());
+    iloc.jump(labelIndex.at(gotoInst->getTarget()));
 }
 
 /// @brief 函数入口指令翻译成ARM32汇编
@@ -133,21 +142,10 @@ void InstSelectorArm32::translate_goto(Instruction * inst)
 void InstSelectorArm32::translate_entry(Instruction * inst)
 {
     // 查看保护的寄存器
-    auto & protectedRegNo = func->getProtectedReg();
-    auto & protectedRegStr = func->getProtectedRegStr();
-
-    bool first = true;
-    for (auto regno: protectedRegNo) {
-        if (first) {
-            protectedRegStr = PlatformArm32::regName[regno];
-            first = false;
-        } else {
-            protectedRegStr += "," + PlatformArm32::regName[regno];
-        }
-    }
+    uint32_t protectedRegMask = protectedRegList();
 
-    if (!protectedRegStr.empty()) {
-        iloc.inst("push", "{" + protectedRegStr + "}");
+    if (protectedRegMask) {
+        iloc.inst(ArmOp::Push, ArmOperand::makeRegList(protectedRegMask));
     }
 
     // 为fun分配栈帧，含局部变量、函数调用值传递的空间等
@@ -166,16 +164,31 @@ void InstSelectorArm32::translate_exit(Instruction * inst)
         iloc.load_var(0, retVal);
     }
 
-    // 恢复栈空间
-    iloc.inst("mov", "sp", "fp");
+    // 恢复栈空间，没有分配栈空间时入口未设置FP，SP也未改变
+    if (func->getMaxDep() != 0) {
+        iloc.mov_reg(ARM32_SP_REG_NO, ARM32_FP_REG_NO);
+    }
 
     // 保护寄存器的恢复
-    auto & protectedRegStr = func->getProtectedRegStr();
-    if (!protectedRegStr.empty()) {
-        iloc.inst("pop", "{" + protectedRegStr + "}");
+    uint32_t protectedRegMask = protectedRegList();
+    if (protectedRegMask) {
+        iloc.inst(ArmOp::Pop, ArmOperand::makeRegList(protectedRegMask));
+    }
+
+    iloc.inst(ArmOp::Bx, ArmOperand::makeReg(ARM32_LX_REG_NO));
+}
+
+/// @brief 函数要保护的寄存器，push与pop的寄存器列表
+/// @return uint32_t 寄存器列表，第i位表示寄存器ri
+uint32_t InstSelectorArm32::protectedRegList()
+{
+    uint32_t regMask = 0;
+
+    for (auto regno: func->getProtectedReg()) {
+        regMask |= 1u << regno;
     }
 
-    iloc.inst("bx", "lr");
+    return regMask;
 }
 
 /// @brief 赋值指令翻译成ARM32汇编
@@ -201,7 +214,7 @@ void InstSelectorArm32::translate_assign(Instruction * inst)
     } else {
         // 内存变量 => 内存变量
 
-        int32_t temp_regno = simpleRegisterAllocator.Allocate();
+        int32_t temp_regno = scratchRegNo >= 0 ? scratchRegNo : simpleRegisterAllocator.Allocate();
 
         // arg1 -> r8
         iloc.load_var(temp_regno, arg1);
@@ -209,6 +222,8 @@ void InstSelectorArm32::translate_assign(Instruction * inst)
         // r8 -> rs 可能用到r9
         iloc.store_var(temp_regno, result, ARM32_TMP_REG_NO);
 
-        simpleRegisterAllocator.free(temp_regno);
+        if (scratchRegNo < 0) {
+            simpleRegisterAllocator.free(temp_regno);
+        }
     }
 }
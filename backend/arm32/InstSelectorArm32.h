@@ -16,6 +16,7 @@
 #pragma once
 
 #include <map>
+#include <unordered_map>
 #include <vector>
 
 #include "Function.h"
@@ -31,7 +32,7 @@ using namespace std;
 class InstSelectorArm32 {
 
     /// @brief 所有的IR指令
-    std::vector<Instruction *> & ir;
+    InstList & ir;
 
     /// @brief 指令变换
     ILocArm32 & iloc;
@@ -73,6 +74,10 @@ protected:
     ///
     void outputIRInstruction(Instruction * inst);
 
+    /// @brief 函数要保护的寄存器，push与pop的寄存器列表
+    /// @return uint32_t 寄存器列表，第i位表示寄存器ri
+    uint32_t protectedRegList();
+
     /// @brief IR翻译动作函数原型
     typedef void (InstSelectorArm32::*translate_handler)(Instruction *);
 
@@ -89,12 +94,22 @@ protected:
     ///
     bool showLinearIR = false;
 
+    ///
+    /// @brief 固定的临时寄存器，-1时由simpleRegisterAllocator分配
+    ///
+    int32_t scratchRegNo = -1;
+
+    ///
+    /// @brief Label指令在函数内的编号，按指令次序编号，与函数的处理次序无关
+    ///
+    std::unordered_map<Instruction *, int32_t> labelIndex;
+
 public:
     /// @brief 构造函数
     /// @param _irCode IR指令
     /// @param _func 函数
     /// @param _iloc 后端指令
-    InstSelectorArm32(std::vector<Instruction *> & _irCode,
+    InstSelectorArm32(InstList & _irCode,
                       ILocArm32 & _iloc,
                       Function * _func,
                       SimpleRegisterAllocator & allocator);
@@ -113,6 +128,15 @@ public:
         showLinearIR = show;
     }
 
+    ///
+    /// @brief 设置固定的临时寄存器，寄存器分配后其余寄存器都可能被变量占用时使用
+    /// @param regNo 寄存器编号
+    ///
+    void setScratchReg(int32_t regNo)
+    {
+        scratchRegNo = regNo;
+    }
+
     /// @brief 指令选择
     void run();
 };
@@ -0,0 +1,569 @@
+///
+/// @file LinearScanRegisterAllocator.cpp
+/// @brief 线性扫描寄存器分配器的实现
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#include <algorithm>
+
+#include "LinearScanRegisterAllocator.h"
+#include "Casting.h"
+#include "ControlFlowGraph.h"
+#include "FuncCallInstruction.h"
+#include "Function.h"
+#include "MoveInstruction.h"
+#include "PlatformArm32.h"
+#include "RegAllocLiveness.h"
+#include "Values/LocalVariable.h"
+
+/// @brief 可分配的寄存器个数，即r0-r8
+static const int32_t allocatableRegNum = ARM32_SCRATCH_REG_NO;
+
+/// @brief 由调用者保护的寄存器个数，即r0-r3
+static const int32_t callerSavedRegNum = 4;
+
+/// @brief 构造函数
+/// @param _func 要分配的函数
+LinearScanRegisterAllocator::LinearScanRegisterAllocator(Function * _func) : func(_func)
+{}
+
+/// @brief 运行分配
+void LinearScanRegisterAllocator::run()
+{
+    // 控制流图只用于活跃性与插入赋值，块的布局不变，析构时线性化不会引入新的跳转
+    ControlFlowGraph graph(func);
+    cfg = &graph;
+
+    RegAllocLiveness blockLiveness(cfg);
+    liveness = &blockLiveness;
+
+    numberInstructions();
+    computeLiveness();
+    buildFixedRanges();
+    allocate();
+
+    for (Interval & interval: intervals) {
+
+        if (interval.fixed || (interval.reg < 0)) {
+            continue;
+        }
+
+        if (auto * var = dyn_cast<LocalVariable>(interval.value)) {
+            var->setRegId(interval.reg);
+        } else {
+            cast<Instruction>(interval.value)->setRegId(interval.reg);
+        }
+    }
+
+    applySplits();
+    assignSpillSlots();
+
+    liveness = nullptr;
+    cfg = nullptr;
+}
+
+/// @brief 获取使用过的需要被调用者保护的寄存器
+/// @return std::vector<int32_t> 寄存器编号
+std::vector<int32_t> LinearScanRegisterAllocator::getUsedCalleeSavedRegs() const
+{
+    return usedCalleeSavedRegs(usedRegMask);
+}
+
+/// @brief 获取值对应的区间
+/// @param val 值
+/// @return int32_t 区间编号，不参与分配的值为-1
+int32_t LinearScanRegisterAllocator::intervalOf(Value * val)
+{
+    auto iter = intervalIndex.find(val);
+    if (iter != intervalIndex.end()) {
+        return iter->second;
+    }
+
+    // 参与分配的是没有寄存器与栈空间的整型局部变量与临时变量，寄存器变量作为固定区间
+    bool fixed = false;
+    bool candidate = false;
+
+    if (isa<RegVariable>(val)) {
+        fixed = true;
+    } else if (auto * var = dyn_cast<LocalVariable>(val)) {
+        candidate = var->getType()->isInt32Type() && (var->getRegId() == -1) && !var->getMemoryAddr();
+    } else if (auto * inst = dyn_cast<Instruction>(val)) {
+        candidate = inst->hasResultValue() && (inst->getRegId() == -1) && !inst->getMemoryAddr();
+    }
+
+    if (!fixed && !candidate) {
+        intervalIndex.emplace(val, -1);
+        return -1;
+    }
+
+    auto index = (int32_t) intervals.size();
+    Interval & interval = intervals.emplace_back();
+    interval.value = val;
+    interval.fixed = fixed;
+    interval.reg = fixed ? val->getRegId() : -1;
+
+    intervalIndex.emplace(val, index);
+
+    return index;
+}
+
+/// @brief 记录值在位置pos的读取
+/// @param val 值
+/// @param pos 位置
+/// @param block 所在的块
+void LinearScanRegisterAllocator::addUse(Value * val, int32_t pos, int32_t block)
+{
+    int32_t index = intervalOf(val);
+    if (index < 0) {
+        return;
+    }
+
+    Interval & interval = intervals[(std::size_t) index];
+    interval.uses.push_back(pos);
+    interval.extend(pos);
+
+    liveness->addUse(index, block);
+}
+
+/// @brief 记录值在位置pos的定值
+/// @param val 值
+/// @param pos 位置
+/// @param block 所在的块
+void LinearScanRegisterAllocator::addDef(Value * val, int32_t pos, int32_t block)
+{
+    int32_t index = intervalOf(val);
+    if (index < 0) {
+        return;
+    }
+
+    Interval & interval = intervals[(std::size_t) index];
+    interval.defs.push_back(pos);
+    interval.extend(pos);
+
+    liveness->addDef(index, block);
+}
+
+/// @brief 对指令编号，收集各值的读取与定值
+void LinearScanRegisterAllocator::numberInstructions()
+{
+    auto blockCount = (std::size_t) cfg->getBlockCount();
+
+    blockOf.assign(blockCount, nullptr);
+    blockStart.assign(blockCount, 0);
+    blockEnd.assign(blockCount, -1);
+
+    auto index = (int32_t) 0;
+
+    for (BasicBlock * block: cfg->getBlocks()) {
+
+        // 块有多个后继时，拆分所需的赋值没有合适的插入位置
+        if (block->getSuccessors().size() > 1) {
+            splitAllowed = false;
+        }
+
+        int32_t b = block->getIndex();
+        blockOf[(std::size_t) b] = block;
+        blockStart[(std::size_t) b] = 2 * index;
+
+        for (Instruction * inst: block->getInsts()) {
+
+            int32_t pos = 2 * index;
+
+            insts.push_back(inst);
+            instBlocks.push_back(block);
+
+            if (isa<MoveInstruction>(inst)) {
+
+                // 赋值的第一个操作数是目标
+                addUse(inst->getOperand(1), pos, b);
+                addDef(inst->getOperand(0), pos + 1, b);
+
+            } else {
+
+                for (int32_t k = 0; k < inst->getOperandsNum(); k++) {
+                    addUse(inst->getOperand(k), pos, b);
+                }
+
+                if (auto * call = dyn_cast<FuncCallInstruction>(inst)) {
+
+                    // 调用破坏r0-r3，返回值在r0中，由之后的赋值指令取出
+                    callPositions.push_back(pos + 1);
+
+                    if (call->hasResultValue()) {
+                        addDef(PlatformArm32::intRegVal(func, 0), pos + 1, b);
+                    }
+
+                } else if (inst->hasResultValue()) {
+                    addDef(inst, pos + 1, b);
+                }
+            }
+
+            index++;
+        }
+
+        blockEnd[(std::size_t) b] = 2 * index - 1;
+    }
+}
+
+/// @brief 计算活跃性，把区间扩展到活跃的块
+void LinearScanRegisterAllocator::computeLiveness()
+{
+    liveness->propagate(
+        [this](int32_t v, int32_t b) {
+            Interval & interval = intervals[(std::size_t) v];
+            interval.liveInBlocks.push_back(b);
+            interval.extend(blockStart[(std::size_t) b]);
+        },
+        [this](int32_t v, int32_t b) { intervals[(std::size_t) v].extend(blockEnd[(std::size_t) b]); });
+}
+
+/// @brief 把固定区间、函数调用以及形参占用的寄存器整理为各寄存器上不可用的范围
+void LinearScanRegisterAllocator::buildFixedRanges()
+{
+    fixedRanges.assign(allocatableRegNum, {});
+
+    for (Interval & interval: intervals) {
+        if (interval.fixed && (interval.reg >= 0) && (interval.reg < allocatableRegNum) &&
+            (interval.start <= interval.end)) {
+            fixedRanges[(std::size_t) interval.reg].emplace_back(interval.start, interval.end);
+        }
+    }
+
+    for (int32_t pos: callPositions) {
+        for (int32_t reg = 0; reg < callerSavedRegNum; reg++) {
+            fixedRanges[(std::size_t) reg].emplace_back(pos, pos);
+        }
+    }
+
+    // 寄存器传递的形参在整个函数内占用其寄存器
+    auto paramNum = (int32_t) func->getParams().size();
+    auto lastPos = (int32_t) (2 * insts.size());
+
+    for (int32_t k = 0; (k < paramNum) && (k < callerSavedRegNum); k++) {
+        fixedRanges[(std::size_t) k].emplace_back(0, lastPos);
+        usedRegMask |= 1U << k;
+    }
+
+    // 排序并合并重叠的范围
+    for (auto & ranges: fixedRanges) {
+
+        std::sort(ranges.begin(), ranges.end());
+
+        std::size_t kept = 0;
+
+        for (auto & range: ranges) {
+            if ((kept > 0) && (range.first <= ranges[kept - 1].second + 1)) {
+                ranges[kept - 1].second = std::max(ranges[kept - 1].second, range.second);
+            } else {
+                ranges[kept++] = range;
+            }
+        }
+
+        ranges.resize(kept);
+    }
+}
+
+/// @brief 寄存器在[start, end]内是否被固定区间占用
+/// @param reg 寄存器
+/// @param start 开始位置
+/// @param end 结束位置
+/// @return true：占用 false：空闲
+bool LinearScanRegisterAllocator::isBlocked(int32_t reg, int32_t start, int32_t end) const
+{
+    const auto & ranges = fixedRanges[(std::size_t) reg];
+
+    // 范围互不重叠，结束位置也是递增的，找第一个结束不早于start的范围
+    auto iter = std::lower_bound(ranges.begin(),
+                                 ranges.end(),
+                                 start,
+                                 [](const std::pair<int32_t, int32_t> & range, int32_t pos) {
+                                     return range.second < pos;
+                                 });
+
+    return (iter != ranges.end()) && (iter->first <= end);
+}
+
+/// @brief 获取区间在位置pos及之后的第一次读取
+/// @param interval 区间
+/// @param pos 位置
+/// @return int32_t 读取位置，没有时为INT32_MAX
+int32_t LinearScanRegisterAllocator::nextUse(const Interval & interval, int32_t pos)
+{
+    auto iter = std::lower_bound(interval.uses.begin(), interval.uses.end(), pos);
+
+    return (iter == interval.uses.end()) ? INT32_MAX : *iter;
+}
+
+/// @brief 按开始位置依次分配寄存器
+void LinearScanRegisterAllocator::allocate()
+{
+    std::vector<int32_t> order;
+
+    for (std::size_t v = 0; v < intervals.size(); v++) {
+        if (!intervals[v].fixed && (intervals[v].start <= intervals[v].end)) {
+            order.push_back((int32_t) v);
+        }
+    }
+
+    std::stable_sort(order.begin(), order.end(), [this](int32_t a, int32_t b) {
+        return intervals[(std::size_t) a].start < intervals[(std::size_t) b].start;
+    });
+
+    // 占用寄存器的区间，以及各寄存器当前被哪个区间占用
+    std::vector<int32_t> active;
+    std::vector<int32_t> owner(allocatableRegNum, -1);
+
+    for (int32_t index: order) {
+
+        Interval & current = intervals[(std::size_t) index];
+
+        // 结束的区间释放寄存器
+        for (std::size_t k = 0; k < active.size();) {
+
+            Interval & other = intervals[(std::size_t) active[k]];
+
+            if (other.end < current.start) {
+                owner[(std::size_t) other.reg] = -1;
+                active[k] = active.back();
+                active.pop_back();
+            } else {
+                k++;
+            }
+        }
+
+        int32_t reg = -1;
+
+        for (int32_t r = 0; r < allocatableRegNum; r++) {
+            if ((owner[(std::size_t) r] == -1) && !isBlocked(r, current.start, current.end)) {
+                reg = r;
+                break;
+            }
+        }
+
+        if (reg < 0) {
+
+            // 寄存器不足，在当前区间与寄存器可以让给当前区间的活跃区间中，溢出下一次使用最远的
+            spillCount++;
+
+            int32_t farthest = nextUse(current, current.start);
+            std::size_t victim = active.size();
+
+            for (std::size_t k = 0; k < active.size(); k++) {
+
+                Interval & other = intervals[(std::size_t) active[k]];
+
+                if (isBlocked(other.reg, current.start, current.end)) {
+                    continue;
+                }
+
+                int32_t use = nextUse(other, current.start);
+                if (use > farthest) {
+                    farthest = use;
+                    victim = k;
+                }
+            }
+
+            if (victim == active.size()) {
+                spilled.push_back({current.value, current.start, current.end});
+                continue;
+            }
+
+            auto victimIndex = active[victim];
+            Interval & other = intervals[(std::size_t) victimIndex];
+            reg = other.reg;
+
+            if (splitAllowed && (other.start < current.start)) {
+                // 拆分：之前的部分保留寄存器
+                splits.push_back({victimIndex, current.start, other.end});
+            } else {
+                other.reg = -1;
+                spilled.push_back({other.value, other.start, other.end});
+            }
+
+            active[victim] = active.back();
+            active.pop_back();
+        }
+
+        current.reg = reg;
+        owner[(std::size_t) reg] = index;
+        active.push_back(index);
+        usedRegMask |= 1U << reg;
+    }
+}
+
+/// @brief 按拆分的记录改写指令，并补充保存与恢复的赋值
+void LinearScanRegisterAllocator::applySplits()
+{
+    std::vector<Instruction *> users;
+
+    for (Split & split: splits) {
+
+        Interval & interval = intervals[(std::size_t) split.interval];
+        Value * val = interval.value;
+        LocalVariable * slot = func->newLocalVarValue(val->getType());
+
+        // 拆分位置及之后的读取与定值改用栈变量，指令k的读取位置为2k，不早于拆分位置即在其后。
+        // 读取与定值的位置都是递增的，从后向前取到拆分位置为止
+        users.clear();
+
+        for (auto iter = interval.uses.rbegin(); (iter != interval.uses.rend()) && (*iter >= split.pos); ++iter) {
+            users.push_back(insts[(std::size_t) (*iter / 2)]);
+        }
+
+        for (auto iter = interval.defs.rbegin(); (iter != interval.defs.rend()) && (*iter - 1 >= split.pos); ++iter) {
+            users.push_back(insts[(std::size_t) (*iter / 2)]);
+        }
+
+        for (Instruction * user: users) {
+            for (int32_t k = 0; k < user->getOperandsNum(); k++) {
+                if (user->getOperand(k) == val) {
+                    user->setOperand(k, slot);
+                }
+            }
+        }
+
+        // 拆分位置为奇数时在块中间，在该位置的指令之前保存；偶数时在块的开始，由入边处理。
+        // 区间覆盖的是活跃点的最小范围，拆分位置可能落在空洞中，这时值无意义，不能保存
+        auto k = (std::size_t) (split.pos / 2);
+        if ((split.pos % 2 == 1) && isLiveAfter(interval, k, slot)) {
+            InstList & blockInsts = instBlocks[k]->getInsts();
+            (void) blockInsts.insert(InstList::iteratorOf(insts[k]),
+                                     new (func) MoveInstruction(func, slot, val));
+        }
+
+        // 跨越拆分位置的边：前驱在之前而后继在之后时保存，反之时恢复
+        for (int32_t b: interval.liveInBlocks) {
+
+            int32_t succStart = blockStart[(std::size_t) b];
+
+            for (BasicBlock * pred: blockOf[(std::size_t) b]->getPredecessors()) {
+
+                int32_t predEnd = blockEnd[(std::size_t) pred->getIndex()];
+
+                if ((predEnd < split.pos) && (succStart >= split.pos)) {
+                    insertMoveAtEnd(pred, slot, val);
+                } else if ((predEnd >= split.pos) && (succStart < split.pos)) {
+                    insertMoveAtEnd(pred, val, slot);
+                }
+            }
+        }
+
+        // 边上的保存可能早于拆分位置，栈槽在整个原区间内占用
+        spilled.push_back({slot, interval.start, split.end});
+    }
+}
+
+/// @brief 拆分后的值在第k条指令之后是否活跃
+/// @param interval 被拆分的区间
+/// @param k 指令编号
+/// @param slot 拆分后使用的栈变量，k之后的读取与定值已改用它
+/// @return true：活跃 false：不活跃
+bool LinearScanRegisterAllocator::isLiveAfter(const Interval & interval, std::size_t k, Value * slot) const
+{
+    BasicBlock * block = instBlocks[k];
+
+    // 块内之后先读取则活跃，先定值则不活跃
+    for (std::size_t j = k + 1; (j < insts.size()) && (instBlocks[j] == block); j++) {
+
+        Instruction * inst = insts[j];
+        int32_t first = 0;
+
+        if (isa<MoveInstruction>(inst)) {
+            if (inst->getOperand(1) == slot) {
+                return true;
+            }
+            if (inst->getOperand(0) == slot) {
+                return false;
+            }
+            first = inst->getOperandsNum();
+        }
+
+        for (int32_t n = first; n < inst->getOperandsNum(); n++) {
+            if (inst->getOperand(n) == slot) {
+                return true;
+            }
+        }
+    }
+
+    // 到达块末尾时，看是否在某个后继的入口活跃
+    for (BasicBlock * succ: block->getSuccessors()) {
+        if (std::find(interval.liveInBlocks.begin(), interval.liveInBlocks.end(), succ->getIndex()) !=
+            interval.liveInBlocks.end()) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/// @brief 在块末尾的跳转之前插入赋值
+/// @param block 基本块
+/// @param dst 目标
+/// @param src 源
+void LinearScanRegisterAllocator::insertMoveAtEnd(BasicBlock * block, Value * dst, Value * src)
+{
+    InstList & blockInsts = block->getInsts();
+    Instruction * terminator = block->getTerminator();
+    auto * move = new (func) MoveInstruction(func, dst, src);
+
+    if (terminator) {
+        (void) blockInsts.insert(InstList::iteratorOf(terminator), move);
+    } else {
+        blockInsts.push_back(move);
+    }
+}
+
+/// @brief 为溢出的值分配栈槽，区间不重叠的值共享栈槽
+void LinearScanRegisterAllocator::assignSpillSlots()
+{
+    std::stable_sort(spilled.begin(), spilled.end(), [](const SpilledValue & a, const SpilledValue & b) {
+        return a.start < b.start;
+    });
+
+    // 占用中的栈槽(结束位置, 偏移)，以及空闲的栈槽偏移
+    std::vector<std::pair<int32_t, int32_t>> active;
+    std::vector<int32_t> freeSlots;
+    int32_t slotNum = 0;
+
+    for (SpilledValue & spill: spilled) {
+
+        for (std::size_t k = 0; k < active.size();) {
+            if (active[k].first < spill.start) {
+                freeSlots.push_back(active[k].second);
+                active[k] = active.back();
+                active.pop_back();
+            } else {
+                k++;
+            }
+        }
+
+        int32_t offset;
+
+        if (freeSlots.empty()) {
+            offset = 4 * (++slotNum);
+        } else {
+            offset = freeSlots.back();
+            freeSlots.pop_back();
+        }
+
+        active.emplace_back(spill.end, offset);
+
+        // 栈槽在fp之下
+        if (auto * var = dyn_cast<LocalVariable>(spill.value)) {
+            var->setMemoryAddr(ARM32_FP_REG_NO, -offset);
+        } else {
+            cast<Instruction>(spill.value)->setMemoryAddr(ARM32_FP_REG_NO, -offset);
+        }
+    }
+
+    spillSize = 4 * slotNum;
+}
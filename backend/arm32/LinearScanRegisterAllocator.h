@@ -0,0 +1,295 @@
+///
+/// @file LinearScanRegisterAllocator.h
+/// @brief 线性扫描寄存器分配器
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+/// 按Poletto与Sarkar的线性扫描分配寄存器：指令按线性次序编号，第i条指令读操作数的位置为2i，
+/// 产生结果的位置为2i+1。由控制流图上的活跃性得到每个值的活跃区间，区间为覆盖所有活跃点的最小范围，
+/// 按开始位置依次分配寄存器。
+///
+/// 可分配r0-r8：r0-r3由调用者保护，跨越函数调用的区间不能使用；r4-r8由被调用者保护，使用时在入口保存。
+/// r9留给指令选择在两个操作数都在内存时作临时寄存器，r10为立即数等预留的临时寄存器。
+/// 传参用的r0-r3、形参所在的寄存器等作为固定区间，其它区间不能与之重叠。
+///
+/// 寄存器不足时，在当前区间与占用寄存器的区间中选择下一次使用最远的溢出。溢出的是已占用的区间时，
+/// 在当前位置拆分：之前的部分留在寄存器中，之后的部分改用新的栈变量，并在拆分点以及跨越拆分点的边上
+/// 补充保存与恢复的赋值。块有多个后继时边上无处插入，这时整个区间溢出。
+///
+/// 溢出的值按区间共享栈槽，栈槽的大小由stackAlloc接续分配其它的栈内变量。
+///
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class BasicBlock;
+class ControlFlowGraph;
+class Function;
+class Instruction;
+class RegAllocLiveness;
+class Value;
+
+///
+/// @brief 线性扫描寄存器分配器，每个函数一个
+///
+class LinearScanRegisterAllocator {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _func 要分配的函数，函数调用的实参已调整到寄存器或栈上
+    ///
+    explicit LinearScanRegisterAllocator(Function * _func);
+
+    ///
+    /// @brief 运行分配，分配到寄存器的值设置寄存器编号，溢出的值设置栈槽
+    ///
+    void run();
+
+    ///
+    /// @brief 获取溢出的次数，整个区间溢出与拆分各计一次
+    /// @return int32_t 次数
+    ///
+    [[nodiscard]] int32_t getSpillCount() const
+    {
+        return spillCount;
+    }
+
+    ///
+    /// @brief 获取溢出栈槽占用的空间大小，其它栈内变量从该偏移之后分配
+    /// @return int32_t 字节数
+    ///
+    [[nodiscard]] int32_t getSpillSize() const
+    {
+        return spillSize;
+    }
+
+    ///
+    /// @brief 获取使用过的需要被调用者保护的寄存器，按编号从小到大。r0-r8全部被占用时包括r9
+    /// @return std::vector<int32_t> 寄存器编号
+    ///
+    [[nodiscard]] std::vector<int32_t> getUsedCalleeSavedRegs() const;
+
+private:
+    ///
+    /// @brief 值的活跃区间
+    ///
+    struct Interval {
+
+        /// @brief 值
+        Value * value = nullptr;
+
+        /// @brief 开始位置
+        int32_t start = INT32_MAX;
+
+        /// @brief 结束位置（含）
+        int32_t end = -1;
+
+        /// @brief 分配的寄存器，-1表示溢出；固定区间为其所在的寄存器
+        int32_t reg = -1;
+
+        /// @brief 是否是固定在某个寄存器上的区间
+        bool fixed = false;
+
+        /// @brief 读取的位置，从小到大
+        std::vector<int32_t> uses;
+
+        /// @brief 定值的位置，从小到大
+        std::vector<int32_t> defs;
+
+        /// @brief 活跃进入的块
+        std::vector<int32_t> liveInBlocks;
+
+        ///
+        /// @brief 把区间扩展到包含位置pos
+        /// @param pos 位置
+        ///
+        void extend(int32_t pos)
+        {
+            start = pos < start ? pos : start;
+            end = pos > end ? pos : end;
+        }
+    };
+
+    ///
+    /// @brief 区间的拆分
+    ///
+    struct Split {
+
+        /// @brief 被拆分的区间
+        int32_t interval;
+
+        /// @brief 拆分位置，之后使用栈变量
+        int32_t pos;
+
+        /// @brief 拆分前区间的结束位置
+        int32_t end;
+    };
+
+    ///
+    /// @brief 溢出到栈上的值
+    ///
+    struct SpilledValue {
+
+        /// @brief 值
+        Value * value;
+
+        /// @brief 栈槽被占用的开始位置
+        int32_t start;
+
+        /// @brief 栈槽被占用的结束位置（含）
+        int32_t end;
+    };
+
+    ///
+    /// @brief 对指令编号，收集各值的读取与定值
+    ///
+    void numberInstructions();
+
+    ///
+    /// @brief 获取值对应的区间，不参与分配的值返回-1
+    /// @param val 值
+    /// @return int32_t 区间编号
+    ///
+    int32_t intervalOf(Value * val);
+
+    ///
+    /// @brief 记录值在位置pos的读取
+    /// @param val 值
+    /// @param pos 位置
+    /// @param block 所在的块
+    ///
+    void addUse(Value * val, int32_t pos, int32_t block);
+
+    ///
+    /// @brief 记录值在位置pos的定值
+    /// @param val 值
+    /// @param pos 位置
+    /// @param block 所在的块
+    ///
+    void addDef(Value * val, int32_t pos, int32_t block);
+
+    ///
+    /// @brief 计算活跃性，把区间扩展到活跃的块
+    ///
+    void computeLiveness();
+
+    ///
+    /// @brief 把固定区间、函数调用以及形参占用的寄存器整理为各寄存器上不可用的范围
+    ///
+    void buildFixedRanges();
+
+    ///
+    /// @brief 寄存器在[start, end]内是否被固定区间占用
+    /// @param reg 寄存器
+    /// @param start 开始位置
+    /// @param end 结束位置
+    /// @return true：占用 false：空闲
+    ///
+    [[nodiscard]] bool isBlocked(int32_t reg, int32_t start, int32_t end) const;
+
+    ///
+    /// @brief 获取区间在位置pos及之后的第一次读取
+    /// @param interval 区间
+    /// @param pos 位置
+    /// @return int32_t 读取位置，没有时为INT32_MAX
+    ///
+    [[nodiscard]] static int32_t nextUse(const Interval & interval, int32_t pos);
+
+    ///
+    /// @brief 按开始位置依次分配寄存器
+    ///
+    void allocate();
+
+    ///
+    /// @brief 按拆分的记录改写指令，并补充保存与恢复的赋值
+    ///
+    void applySplits();
+
+    ///
+    /// @brief 拆分后的值在第k条指令之后是否活跃
+    /// @param interval 被拆分的区间
+    /// @param k 指令编号
+    /// @param slot 拆分后使用的栈变量，k之后的读取与定值已改用它
+    /// @return true：活跃 false：不活跃
+    ///
+    [[nodiscard]] bool isLiveAfter(const Interval & interval, std::size_t k, Value * slot) const;
+
+    ///
+    /// @brief 为溢出的值分配栈槽，区间不重叠的值共享栈槽
+    ///
+    void assignSpillSlots();
+
+    ///
+    /// @brief 在块末尾的跳转之前插入赋值
+    /// @param block 基本块
+    /// @param dst 目标
+    /// @param src 源
+    ///
+    void insertMoveAtEnd(BasicBlock * block, Value * dst, Value * src);
+
+    /// @brief 函数
+    Function * func;
+
+    /// @brief 控制流图，分配期间存在
+    ControlFlowGraph * cfg = nullptr;
+
+    /// @brief 块级活跃性，分配期间存在，编号时记录各区间的读取与定值
+    RegAllocLiveness * liveness = nullptr;
+
+    /// @brief 按线性次序排列的指令，下标为指令编号
+    std::vector<Instruction *> insts;
+
+    /// @brief 指令所在的块
+    std::vector<BasicBlock *> instBlocks;
+
+    /// @brief 按编号排列的块
+    std::vector<BasicBlock *> blockOf;
+
+    /// @brief 块的开始与结束位置，按块编号
+    std::vector<int32_t> blockStart;
+    std::vector<int32_t> blockEnd;
+
+    /// @brief 所有的区间
+    std::vector<Interval> intervals;
+
+    /// @brief 值到区间编号的映射
+    std::unordered_map<Value *, int32_t> intervalIndex;
+
+    /// @brief 函数调用的位置
+    std::vector<int32_t> callPositions;
+
+    /// @brief 各寄存器上被固定区间占用的范围，按开始位置排列且互不重叠
+    std::vector<std::vector<std::pair<int32_t, int32_t>>> fixedRanges;
+
+    /// @brief 溢出的值，包括拆分后使用的栈变量
+    std::vector<SpilledValue> spilled;
+
+    /// @brief 拆分的记录
+    std::vector<Split> splits;
+
+    /// @brief 是否允许拆分，块有多个后继时不允许
+    bool splitAllowed = true;
+
+    /// @brief 使用过的寄存器，第i位表示寄存器ri
+    uint32_t usedRegMask = 0;
+
+    /// @brief 溢出的次数
+    int32_t spillCount = 0;
+
+    /// @brief 溢出栈槽占用的空间大小
+    int32_t spillSize = 0;
+};
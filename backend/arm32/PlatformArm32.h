@@ -17,11 +17,15 @@
 
 #include <string>
 
+#include "Function.h"
 #include "RegVariable.h"
 
 // 在操作过程中临时借助的寄存器为ARM32_TMP_REG_NO
 #define ARM32_TMP_REG_NO 10
 
+// 优化时r0-r8参与寄存器分配，指令选择需要的临时寄存器固定为ARM32_SCRATCH_REG_NO
+#define ARM32_SCRATCH_REG_NO 9
+
 // 栈寄存器SP和FP
 #define ARM32_SP_REG_NO 13
 #define ARM32_FP_REG_NO 11
@@ -66,6 +70,9 @@ public:
     /// @brief 寄存器的名字，r0-r15
     static const std::string regName[maxRegNum];
 
-    /// @brief 对寄存器R0分配Value，记录位置
-    static RegVariable * intRegVal[PlatformArm32::maxRegNum];
+    /// @brief 获取函数内代表整型寄存器的Value，各函数有各自的寄存器Value
+    /// @param func 函数
+    /// @param regNo 寄存器编号
+    /// @return 寄存器Value
+    static RegVariable * intRegVal(Function * func, int32_t regNo);
 };
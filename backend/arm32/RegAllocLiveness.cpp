@@ -0,0 +1,53 @@
+///
+/// @file RegAllocLiveness.cpp
+/// @brief 寄存器分配器共用的块级活跃性的实现
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#include "RegAllocLiveness.h"
+#include "ControlFlowGraph.h"
+#include "PlatformArm32.h"
+
+/// @brief 由调用者保护的寄存器个数，即r0-r3
+static const int32_t callerSavedRegNum = 4;
+
+/// @brief 获取使用过的需要被调用者保护的寄存器，即可分配寄存器中r4及以上的
+/// @param usedRegMask 使用过的寄存器，第i位表示寄存器ri
+/// @return std::vector<int32_t> 寄存器编号，从小到大
+std::vector<int32_t> usedCalleeSavedRegs(uint32_t usedRegMask)
+{
+    std::vector<int32_t> regs;
+
+    for (int32_t reg = callerSavedRegNum; reg < ARM32_SCRATCH_REG_NO; reg++) {
+        if (usedRegMask & (1U << reg)) {
+            regs.push_back(reg);
+        }
+    }
+
+    return regs;
+}
+
+/// @brief 构造函数
+/// @param cfg 控制流图，只在构造时读取前驱关系
+RegAllocLiveness::RegAllocLiveness(ControlFlowGraph * cfg)
+{
+    preds.resize((std::size_t) cfg->getBlockCount());
+
+    for (BasicBlock * block: cfg->getBlocks()) {
+
+        auto & list = preds[(std::size_t) block->getIndex()];
+
+        for (BasicBlock * pred: block->getPredecessors()) {
+            list.push_back(pred->getIndex());
+        }
+    }
+}
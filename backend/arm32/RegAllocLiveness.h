@@ -0,0 +1,165 @@
+///
+/// @file RegAllocLiveness.h
+/// @brief 寄存器分配器共用的块级活跃性与被调用者保护寄存器的整理
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+/// 线性扫描与图着色分配器按同样的方法计算活跃性：按布局次序遍历指令时记录每个值有定值的块，
+/// 以及读取早于块内定值的块（入口活跃的起点）；之后逐个值从这些块沿前驱向上传播，前驱出口活跃，
+/// 前驱内没有定值时入口也活跃。每个值只访问其活跃的块，标记以值编号区分，不必每个值重新清空。
+///
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class ControlFlowGraph;
+
+///
+/// @brief 获取使用过的需要被调用者保护的寄存器，即可分配寄存器中r4及以上的
+/// @param usedRegMask 使用过的寄存器，第i位表示寄存器ri
+/// @return std::vector<int32_t> 寄存器编号，从小到大
+///
+std::vector<int32_t> usedCalleeSavedRegs(uint32_t usedRegMask);
+
+///
+/// @brief 块级活跃性，值以从0开始的编号表示
+///
+class RegAllocLiveness {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param cfg 控制流图，只在构造时读取前驱关系
+    ///
+    explicit RegAllocLiveness(ControlFlowGraph * cfg);
+
+    ///
+    /// @brief 记录值在块内的读取，须按块内指令次序、与addDef交替调用
+    /// @param value 值的编号
+    /// @param block 块编号
+    ///
+    void addUse(int32_t value, int32_t block)
+    {
+        grow(value);
+
+        auto v = (std::size_t) value;
+
+        // 块内在定值之前的读取，值在块入口活跃
+        if ((lastDef[v] != block) && (lastUpward[v] != block)) {
+            lastUpward[v] = block;
+            upwardBlocks[v].push_back(block);
+        }
+    }
+
+    ///
+    /// @brief 记录值在块内的定值
+    /// @param value 值的编号
+    /// @param block 块编号
+    ///
+    void addDef(int32_t value, int32_t block)
+    {
+        grow(value);
+
+        auto v = (std::size_t) value;
+
+        if (lastDef[v] != block) {
+            lastDef[v] = block;
+            defBlocks[v].push_back(block);
+        }
+    }
+
+    ///
+    /// @brief 逐个值传播活跃性，每个(值, 块)只回调一次
+    /// @param onLiveIn 值在块入口活跃时调用，参数为值与块的编号
+    /// @param onLiveOut 值在块出口活跃时调用，参数为值与块的编号
+    ///
+    template <typename OnLiveIn, typename OnLiveOut>
+    void propagate(OnLiveIn onLiveIn, OnLiveOut onLiveOut)
+    {
+        std::vector<int32_t> defMark(preds.size(), -1);
+        std::vector<int32_t> liveInMark(preds.size(), -1);
+        std::vector<int32_t> liveOutMark(preds.size(), -1);
+        std::vector<int32_t> worklist;
+
+        for (std::size_t v = 0; v < defBlocks.size(); v++) {
+
+            auto mark = (int32_t) v;
+
+            for (int32_t b: defBlocks[v]) {
+                defMark[(std::size_t) b] = mark;
+            }
+
+            for (int32_t b: upwardBlocks[v]) {
+                if (liveInMark[(std::size_t) b] != mark) {
+                    liveInMark[(std::size_t) b] = mark;
+                    onLiveIn(mark, b);
+                    worklist.push_back(b);
+                }
+            }
+
+            while (!worklist.empty()) {
+
+                int32_t b = worklist.back();
+                worklist.pop_back();
+
+                for (int32_t p: preds[(std::size_t) b]) {
+
+                    if (liveOutMark[(std::size_t) p] == mark) {
+                        continue;
+                    }
+
+                    liveOutMark[(std::size_t) p] = mark;
+                    onLiveOut(mark, p);
+
+                    if ((defMark[(std::size_t) p] != mark) && (liveInMark[(std::size_t) p] != mark)) {
+                        liveInMark[(std::size_t) p] = mark;
+                        onLiveIn(mark, p);
+                        worklist.push_back(p);
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    ///
+    /// @brief 保证值的编号在范围内
+    /// @param value 值的编号
+    ///
+    void grow(int32_t value)
+    {
+        auto size = (std::size_t) value + 1;
+        if (size > defBlocks.size()) {
+            defBlocks.resize(size);
+            upwardBlocks.resize(size);
+            lastDef.resize(size, -1);
+            lastUpward.resize(size, -1);
+        }
+    }
+
+    /// @brief 各块前驱的编号，按块编号
+    std::vector<std::vector<int32_t>> preds;
+
+    /// @brief 各值有定值的块
+    std::vector<std::vector<int32_t>> defBlocks;
+
+    /// @brief 各值读取在块内定值之前的块
+    std::vector<std::vector<int32_t>> upwardBlocks;
+
+    /// @brief 各值最近一次定值所在的块
+    std::vector<int32_t> lastDef;
+
+    /// @brief 各值最近一次加入upwardBlocks的块
+    std::vector<int32_t> lastUpward;
+};
@@ -0,0 +1,551 @@
+///
+/// @file BackEndBench.cpp
+/// @brief IR产生、IR输出以及后端的性能测试项
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+/// 从源程序开始的测试项用递归下降前端准备AST，前端的时间不计入。
+/// 文法目前只能表达一个函数，多函数与多线程的测试通过buildIRProgram直接构造IR。
+///
+#include <vector>
+
+#include "AST.h"
+#include "Benchmarks.h"
+#include "Casting.h"
+#include "CodeGeneratorArm32.h"
+#include "ControlFlowGraph.h"
+#include "DominatorTree.h"
+#include "FrontEndExecutor.h"
+#include "IRGenerator.h"
+#include "IntegerType.h"
+#include "Module.h"
+#include "MoveInstruction.h"
+#include "ProgramGenerator.h"
+
+/// @brief 源程序规模的参数，即语句数
+static const std::vector<int64_t> sourceSizes = {1000, 10000, 100000};
+
+///
+/// @brief 统计Module中所有函数的IR指令数
+/// @param module 符号表
+/// @return uint64_t 指令数
+///
+uint64_t countIRInstructions(Module * module)
+{
+    uint64_t count = 0;
+
+    for (auto func: module->getFunctionList()) {
+        count += func->getInterCode().getInsts().size();
+    }
+
+    return count;
+}
+
+///
+/// @brief 由源程序产生AST
+/// @param src 源程序
+/// @return ast_node* AST的根，失败时为空指针
+///
+static ast_node * parseSource(const GeneratedSource & src)
+{
+    std::string file = writeBenchFile("backend.c", src.text);
+    if (file.empty()) {
+        return nullptr;
+    }
+
+    FrontEndExecutor * executor = newBenchFrontEnd(BenchFrontEnd::RecursiveDescent, file);
+
+    ast_node * root = executor->run() ? executor->getASTRoot() : nullptr;
+
+    delete executor;
+
+    return root;
+}
+
+///
+/// @brief 由源程序产生线性IR
+/// @param src 源程序
+/// @return Module* 符号表，失败时为空指针
+///
+static Module * generateIR(const GeneratedSource & src)
+{
+    ast_node * root = parseSource(src);
+    if (!root) {
+        return nullptr;
+    }
+
+    Module * module = new Module("bench");
+
+    IRGenerator ast2IR(root, module);
+    bool result = ast2IR.run();
+
+    // AST上残留的指令来自函数的IR内存池，需在符号表释放前清理
+    free_ast(root);
+
+    if (!result) {
+        module->Delete();
+        delete module;
+        return nullptr;
+    }
+
+    return module;
+}
+
+///
+/// @brief 释放符号表
+/// @param module 符号表
+///
+static void deleteModule(Module * module)
+{
+    module->Delete();
+    delete module;
+}
+
+///
+/// @brief IRGenerator的测试，AST到线性IR
+/// @param state 测试状态
+///
+static void benchIRGenerator(BenchState & state)
+{
+    SourceShape shape;
+    shape.statements = state.getArg();
+    GeneratedSource src = generateSource(shape);
+
+    uint64_t nodes = 0;
+
+    while (state.keepRunning()) {
+
+        state.pauseTiming();
+        ast_node * root = parseSource(src);
+        if (!root) {
+            state.fail("frontend failed");
+            break;
+        }
+        if (nodes == 0) {
+            nodes = countASTNodes(root);
+        }
+        Module * module = new Module("bench");
+        state.resumeTiming();
+
+        IRGenerator ast2IR(root, module);
+        bool result = ast2IR.run();
+
+        state.pauseTiming();
+        free_ast(root);
+        deleteModule(module);
+        state.resumeTiming();
+
+        if (!result) {
+            state.fail("IR generation failed");
+            break;
+        }
+    }
+
+    state.setLines(src.lines);
+    state.setNodes(nodes);
+}
+
+///
+/// @brief Module::outputIR的测试，线性IR输出到文件
+/// @param state 测试状态
+///
+static void benchOutputIR(BenchState & state)
+{
+    SourceShape shape;
+    shape.statements = state.getArg();
+    GeneratedSource src = generateSource(shape);
+
+    Module * module = generateIR(src);
+    if (!module) {
+        state.fail("IR generation failed");
+        return;
+    }
+
+    // 输出前要对IR的名字重命名，重复输出时名字不变
+    module->renameIR();
+
+    std::string file = benchFilePath("output.ir");
+
+    while (state.keepRunning()) {
+        module->outputIR(file);
+    }
+
+    state.setLines(src.lines);
+    state.setNodes(countIRInstructions(module));
+
+    deleteModule(module);
+}
+
+///
+/// @brief CodeGeneratorArm32的测试，由源程序产生的线性IR到汇编文件
+/// @param state 测试状态
+///
+static void benchCodeGenSource(BenchState & state)
+{
+    SourceShape shape;
+    shape.statements = state.getArg();
+    GeneratedSource src = generateSource(shape);
+
+    std::string file = benchFilePath("output.s");
+    uint64_t nodes = 0;
+
+    while (state.keepRunning()) {
+
+        // 后端会修改IR，每次迭代重新产生
+        state.pauseTiming();
+        Module * module = generateIR(src);
+        if (!module) {
+            state.fail("IR generation failed");
+            break;
+        }
+        nodes = countIRInstructions(module);
+        state.resumeTiming();
+
+        CodeGenerator * generator = new CodeGeneratorArm32(module);
+        bool result = generator->run(file);
+        delete generator;
+
+        state.pauseTiming();
+        deleteModule(module);
+        state.resumeTiming();
+
+        if (!result) {
+            state.fail("code generation failed");
+            break;
+        }
+    }
+
+    state.setLines(src.lines);
+    state.setNodes(nodes);
+}
+
+///
+/// @brief CodeGeneratorArm32的测试，直接构造的多函数IR到汇编文件
+/// @param state 测试状态
+/// @param shape IR的规模
+/// @param threadNum 后端的线程数
+///
+static void benchCodeGenIR(BenchState & state, const IRShape & shape, int threadNum)
+{
+    std::string file = benchFilePath("output.s");
+    uint64_t nodes = 0;
+
+    while (state.keepRunning()) {
+
+        state.pauseTiming();
+        Module * module = new Module("bench");
+        buildIRProgram(module, shape);
+        nodes = countIRInstructions(module);
+        state.resumeTiming();
+
+        CodeGenerator * generator = new CodeGeneratorArm32(module);
+        generator->setThreadNum(threadNum);
+        bool result = generator->run(file);
+        delete generator;
+
+        state.pauseTiming();
+        deleteModule(module);
+        state.resumeTiming();
+
+        if (!result) {
+            state.fail("code generation failed");
+            break;
+        }
+    }
+
+    state.setNodes(nodes);
+}
+
+///
+/// @brief CodeGeneratorArm32::adjustFuncCallInsts的测试，在函数调用前插入实参的赋值指令
+/// @param state 测试状态
+///
+static void benchAdjustFuncCall(BenchState & state)
+{
+    IRShape shape;
+    shape.statements = state.getArg();
+    shape.callEvery = 4;
+
+    uint64_t nodes = 0;
+
+    while (state.keepRunning()) {
+
+        state.pauseTiming();
+        Module * module = new Module("bench");
+        buildIRProgram(module, shape);
+        nodes = countIRInstructions(module);
+        BenchCodeGeneratorArm32 * generator = new BenchCodeGeneratorArm32(module);
+        state.resumeTiming();
+
+        for (auto func: module->getFunctionList()) {
+            generator->adjustFuncCallInsts(func);
+        }
+
+        state.pauseTiming();
+        delete generator;
+        deleteModule(module);
+        state.resumeTiming();
+    }
+
+    state.setNodes(nodes);
+}
+
+///
+/// @brief 寄存器分配的测试，含adjustFuncCallInsts与栈空间分配，局部变量多于可分配的寄存器且有函数调用
+/// @param state 测试状态
+/// @param optLevel 优化级别，1为线性扫描，2为图着色
+///
+static void benchRegisterAllocation(BenchState & state, int32_t optLevel)
+{
+    IRShape shape;
+    shape.statements = state.getArg();
+    shape.locals = 16;
+    shape.callEvery = 16;
+
+    uint64_t nodes = 0;
+
+    while (state.keepRunning()) {
+
+        state.pauseTiming();
+        Module * module = new Module("bench");
+        buildIRProgram(module, shape);
+        nodes = countIRInstructions(module);
+        BenchCodeGeneratorArm32 * generator = new BenchCodeGeneratorArm32(module);
+        generator->setOptLevel(optLevel);
+        state.resumeTiming();
+
+        for (auto func: module->getFunctionList()) {
+            generator->registerAllocation(func);
+        }
+
+        state.pauseTiming();
+        delete generator;
+        deleteModule(module);
+        state.resumeTiming();
+    }
+
+    state.setNodes(nodes);
+}
+
+///
+/// @brief 被大量指令使用的常量的测试：把常量的所有使用替换为另一个常量，再释放所有指令
+/// @param state 测试状态
+///
+static void benchHotConstant(BenchState & state)
+{
+    IRShape shape;
+    shape.statements = state.getArg();
+    shape.constants = 1;
+    shape.blockSize = 0;
+
+    uint64_t nodes = 0;
+
+    while (state.keepRunning()) {
+
+        state.pauseTiming();
+        Module * module = new Module("bench");
+        buildIRProgram(module, shape);
+        nodes = countIRInstructions(module);
+        ConstInt * hot = module->newConstInt(1);
+        ConstInt * other = module->newConstInt(2);
+        state.resumeTiming();
+
+        hot->replaceAllUsesWith(other);
+        module->Delete();
+
+        state.pauseTiming();
+        delete module;
+        state.resumeTiming();
+    }
+
+    state.setNodes(nodes);
+}
+
+///
+/// @brief 基于类型标记的类型判断的测试，遍历所有指令判断是否为赋值指令
+/// @param state 测试状态
+///
+static void benchIsaScan(BenchState & state)
+{
+    IRShape shape;
+    shape.statements = state.getArg();
+
+    Module * module = new Module("bench");
+    buildIRProgram(module, shape);
+
+    uint64_t moves = 0;
+
+    while (state.keepRunning()) {
+        moves = 0;
+        for (auto func: module->getFunctionList()) {
+            for (auto inst: func->getInterCode().getInsts()) {
+                if (isa<MoveInstruction>(inst)) {
+                    moves++;
+                }
+            }
+        }
+    }
+
+    if (moves == 0 && shape.statements > 0) {
+        state.fail("no move instructions found");
+    }
+
+    state.setNodes(countIRInstructions(module));
+
+    deleteModule(module);
+}
+
+///
+/// @brief ControlFlowGraph的测试：由线性IR构建基本块与边并计算逆后序，再线性化
+/// @param state 测试状态
+///
+static void benchCFG(BenchState & state)
+{
+    IRShape shape;
+    shape.statements = state.getArg();
+
+    Module * module = new Module("bench");
+    buildIRProgram(module, shape);
+
+    Function * func = module->findFunction(internSymbol("f0"));
+    InstList & insts = func->getInterCode().getInsts();
+
+    // 线性化后指令的次序应与构建前的相同，记录首尾指令与指令数用于检查
+    std::size_t instCount = insts.size();
+    Instruction * first = insts.front();
+    Instruction * last = insts.back();
+
+    while (state.keepRunning()) {
+        ControlFlowGraph cfg(func);
+        cfg.linearize();
+    }
+
+    if ((insts.size() != instCount) || (insts.front() != first) || (insts.back() != last)) {
+        state.fail("linearized IR differs from the original");
+    }
+
+    state.setNodes(instCount);
+
+    deleteModule(module);
+}
+
+///
+/// @brief DominatorTree的测试：在指定形状的控制流图上计算支配树与后支配树，含支配边界
+/// @param state 测试状态
+/// @param shape 控制流图的形状
+///
+static void benchDominators(BenchState & state, CFGShape shape)
+{
+    Module * module = new Module("bench");
+    Function * func = module->newFunction(internSymbol("f0"), IntegerType::getTypeInt());
+
+    {
+        ControlFlowGraph cfg(func);
+        buildCFGShape(cfg, func, shape, state.getArg());
+
+        while (state.keepRunning()) {
+            DominatorTree domTree(cfg);
+            DominatorTree postDomTree(cfg, true);
+
+            if (!domTree.dominates(cfg.getEntry(), cfg.getBlocks().back())) {
+                state.fail("the entry does not dominate the last block");
+            }
+        }
+
+        state.setNodes((uint64_t) cfg.getBlockCount());
+    }
+
+    deleteModule(module);
+}
+
+///
+/// @brief 登记IR产生、IR输出以及后端的测试项与复杂度检查项
+/// @param runner 测试运行框架
+///
+void registerBackEndBenchmarks(BenchRunner & runner)
+{
+    runner.add("ir/IRGenerator", sourceSizes, benchIRGenerator);
+    runner.add("ir/outputIR", sourceSizes, benchOutputIR);
+    runner.add("ir/hot-constant-uses", {1000, 10000, 100000}, benchHotConstant);
+    runner.add("ir/isa-scan", {10000, 100000}, benchIsaScan);
+    runner.add("ir/cfg-build", {10000, 100000}, benchCFG);
+    runner.add("ir/dominators/deep", {10000, 100000}, [](BenchState & state) {
+        benchDominators(state, CFGShape::Deep);
+    });
+    runner.add("ir/dominators/wide", {10000, 100000}, [](BenchState & state) {
+        benchDominators(state, CFGShape::Wide);
+    });
+    runner.add("ir/dominators/irreducible", {10000, 100000}, [](BenchState & state) {
+        benchDominators(state, CFGShape::Irreducible);
+    });
+
+    runner.add("codegen/arm32", sourceSizes, benchCodeGenSource);
+
+    // 函数数增加而每个函数的规模不变，总时间应线性增长
+    runner.add("codegen/arm32-functions", {16, 128, 1024}, [](BenchState & state) {
+        IRShape shape;
+        shape.functions = (int) state.getArg();
+        shape.statements = 64;
+        benchCodeGenIR(state, shape, 1);
+    });
+
+    // 后端按函数并行，参数为线程数
+    runner.add("codegen/arm32-threads", {1, 2, 4, 8}, [](BenchState & state) {
+        IRShape shape;
+        shape.functions = 256;
+        shape.statements = 512;
+        benchCodeGenIR(state, shape, (int) state.getArg());
+    });
+
+    runner.add("codegen/adjustFuncCallInsts", {10000, 100000}, benchAdjustFuncCall);
+    runner.add("codegen/linear-scan", {10000, 100000}, [](BenchState & state) { benchRegisterAllocation(state, 1); });
+    runner.add("codegen/graph-coloring", {10000, 100000}, [](BenchState & state) {
+        benchRegisterAllocation(state, 2);
+    });
+
+    // 复杂度检查，各阶段都应与指令数成线性关系
+    runner.addScaling("ir/IRGenerator", 20000, benchIRGenerator);
+    runner.addScaling("ir/outputIR", 20000, benchOutputIR);
+    runner.addScaling("ir/hot-constant-uses", 20000, benchHotConstant);
+    // 每条语句的IR较多，规模较小时工作集正跨越缓存的边界，从较大的规模开始
+    runner.addScaling("codegen/adjustFuncCallInsts", 40000, benchAdjustFuncCall);
+    // 寄存器分配先建立控制流图，与ir/cfg-build相同在8万条语句附近越过缓存的边界
+    runner.addScaling("codegen/linear-scan", 80000, [](BenchState & state) { benchRegisterAllocation(state, 1); });
+    // 结点多时冲突图改用散列的边集合，不再有与结点数平方成正比的位矩阵
+    runner.addScaling("codegen/graph-coloring", 80000, [](BenchState & state) { benchRegisterAllocation(state, 2); });
+    // 遍历指令链表本身在8万条语句附近越过缓存的边界，从边界之后开始
+    runner.addScaling("ir/cfg-build", 160000, benchCFG);
+    runner.addScaling("ir/dominators/deep", 20000, [](BenchState & state) {
+        benchDominators(state, CFGShape::Deep);
+    });
+    runner.addScaling("ir/dominators/wide", 20000, [](BenchState & state) {
+        benchDominators(state, CFGShape::Wide);
+    });
+    runner.addScaling("ir/dominators/irreducible", 20000, [](BenchState & state) {
+        benchDominators(state, CFGShape::Irreducible);
+    });
+
+    // 单个函数的规模增长，含指令选择、Label清理等函数内的各步骤
+    runner.addScaling("codegen/arm32-function-size", 4000, [](BenchState & state) {
+        IRShape shape;
+        shape.statements = state.getArg();
+        benchCodeGenIR(state, shape, 1);
+    });
+
+    // 函数数增长，检查函数间共享的数据结构
+    runner.addScaling("codegen/arm32-functions", 64, [](BenchState & state) {
+        IRShape shape;
+        shape.functions = (int) state.getArg();
+        shape.statements = 64;
+        benchCodeGenIR(state, shape, 1);
+    });
+}
@@ -0,0 +1,764 @@
+///
+/// @file BenchHarness.cpp
+/// @brief 编译器性能测试的运行框架的实现
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#include <chrono>
+#include <cinttypes>
+#include <cmath>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "BenchHarness.h"
+
+///
+/// @brief 获取单调递增的墙上时间
+/// @return int64_t 纳秒
+///
+static int64_t wallClockNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+///
+/// @brief 获取进程的CPU时间，含所有线程，后端多线程时可与墙上时间对比
+/// @return int64_t 纳秒
+///
+static int64_t processCpuNs()
+{
+#ifdef _WIN32
+    FILETIME creationTime, exitTime, kernelTime, userTime;
+    if (!GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime)) {
+        return 0;
+    }
+
+    // FILETIME的单位为100纳秒
+    uint64_t kernel = ((uint64_t) kernelTime.dwHighDateTime << 32) | kernelTime.dwLowDateTime;
+    uint64_t user = ((uint64_t) userTime.dwHighDateTime << 32) | userTime.dwLowDateTime;
+
+    return (int64_t) (kernel + user) * 100;
+#else
+    struct timespec ts;
+    if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts) != 0) {
+        return 0;
+    }
+
+    return (int64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+#endif
+}
+
+///
+/// @brief 构造函数
+/// @param _arg 测试项的参数
+/// @param _iterations 要执行的迭代次数
+///
+BenchState::BenchState(int64_t _arg, uint64_t _iterations) : arg(_arg), iterations(_iterations)
+{}
+
+///
+/// @brief 是否继续迭代，首次调用时开始计时，迭代次数用完时停止计时
+/// @return true：继续 false：结束
+///
+bool BenchState::keepRunning()
+{
+    if (started == 0 && !failed) {
+        resumeTiming();
+    }
+
+    if (started < iterations && !failed) {
+        started++;
+        return true;
+    }
+
+    if (timing) {
+        pauseTiming();
+    }
+
+    return false;
+}
+
+///
+/// @brief 暂停计时，之后的时间与内存申请不计入结果
+///
+void BenchState::pauseTiming()
+{
+    wallNs += wallClockNs() - wallStart;
+    cpuNs += processCpuNs() - cpuStart;
+
+    AllocCounter now = AllocCounter::current();
+    alloc.count += now.count - allocStart.count;
+    alloc.bytes += now.bytes - allocStart.bytes;
+
+    timing = false;
+}
+
+///
+/// @brief 恢复计时
+///
+void BenchState::resumeTiming()
+{
+    timing = true;
+
+    allocStart = AllocCounter::current();
+    cpuStart = processCpuNs();
+    wallStart = wallClockNs();
+}
+
+///
+/// @brief 标记测试失败
+/// @param msg 失败的原因
+///
+void BenchState::fail(const std::string & msg)
+{
+    failed = true;
+    failMessage = msg;
+}
+
+///
+/// @brief 登记测试项
+/// @param name 名字
+/// @param args 参数列表
+/// @param func 测试函数
+///
+void BenchRunner::add(const std::string & name, std::vector<int64_t> args, std::function<void(BenchState &)> func)
+{
+    benches.push_back(BenchDef{name, std::move(args), std::move(func)});
+}
+
+///
+/// @brief 登记复杂度检查项
+/// @param name 名字
+/// @param baseN 最小的规模N
+/// @param func 测试函数，参数为规模
+/// @param maxExponent 允许的最大指数
+///
+void BenchRunner::addScaling(const std::string & name,
+                             int64_t baseN,
+                             std::function<void(BenchState &)> func,
+                             double maxExponent)
+{
+    scalings.push_back(ScalingDef{name, baseN, maxExponent, std::move(func)});
+}
+
+///
+/// @brief 登记随机检查项
+/// @param name 名字
+/// @param func 检查函数，参数为种子
+///
+void BenchRunner::addCheck(const std::string & name, std::function<bool(uint32_t, std::string &)> func)
+{
+    checks.push_back(CheckDef{name, std::move(func)});
+}
+
+///
+/// @brief 运行一个测试项的一个参数，迭代次数自动增加直到总时间达到最小测试时间
+/// @param def 测试项
+/// @param arg 参数
+/// @return BenchResult 结果
+///
+BenchResult BenchRunner::run(const BenchDef & def, int64_t arg)
+{
+    BenchResult result;
+    result.name = def.name + "/" + std::to_string(arg);
+    result.arg = arg;
+
+    uint64_t iterations = 1;
+
+    for (;;) {
+        BenchState state(arg, iterations);
+        def.func(state);
+
+        if (state.failed) {
+            result.failed = true;
+            result.failMessage = state.failMessage;
+            return result;
+        }
+
+        double seconds = (double) state.wallNs / 1e9;
+
+        // 时间足够或者迭代次数过多时结束，否则按已用时间估算需要的次数，与Google Benchmark的做法相同
+        if (seconds >= minTime || iterations >= 1000000000) {
+
+            double n = (double) iterations;
+
+            result.iterations = iterations;
+            result.wallNs = (double) state.wallNs / n;
+            result.cpuNs = (double) state.cpuNs / n;
+            result.allocsPerIter = (double) state.alloc.count / n;
+            result.allocBytesPerIter = (double) state.alloc.bytes / n;
+
+            if (seconds > 0) {
+                result.linesPerSec = (double) state.lines * n / seconds;
+                result.nodesPerSec = (double) state.nodes * n / seconds;
+                result.bytesPerSec = (double) state.bytes * n / seconds;
+            }
+
+            return result;
+        }
+
+        double multiplier = seconds > 0 ? minTime * 1.4 / seconds : 10;
+        if (multiplier > 10) {
+            multiplier = 10;
+        }
+
+        uint64_t next = (uint64_t) ((double) iterations * multiplier);
+        iterations = next > iterations ? next : iterations + 1;
+    }
+}
+
+///
+/// @brief 按合适的单位输出时间
+/// @param ns 纳秒
+/// @return std::string 带单位的时间
+///
+static std::string formatTime(double ns)
+{
+    char buf[32];
+
+    if (ns >= 1e9) {
+        snprintf(buf, sizeof(buf), "%.3f s", ns / 1e9);
+    } else if (ns >= 1e6) {
+        snprintf(buf, sizeof(buf), "%.3f ms", ns / 1e6);
+    } else if (ns >= 1e3) {
+        snprintf(buf, sizeof(buf), "%.3f us", ns / 1e3);
+    } else {
+        snprintf(buf, sizeof(buf), "%.1f ns", ns);
+    }
+
+    return buf;
+}
+
+///
+/// @brief 按k、M、G输出较大的数
+/// @param value 数值
+/// @return std::string 带单位的数值，为0时输出-
+///
+static std::string formatRate(double value)
+{
+    char buf[32];
+
+    if (value <= 0) {
+        return "-";
+    } else if (value >= 1e9) {
+        snprintf(buf, sizeof(buf), "%.2fG", value / 1e9);
+    } else if (value >= 1e6) {
+        snprintf(buf, sizeof(buf), "%.2fM", value / 1e6);
+    } else if (value >= 1e3) {
+        snprintf(buf, sizeof(buf), "%.2fk", value / 1e3);
+    } else {
+        snprintf(buf, sizeof(buf), "%.0f", value);
+    }
+
+    return buf;
+}
+
+///
+/// @brief 测试项的名字是否与过滤条件匹配
+/// @param name 名字，含参数
+/// @param filter 过滤条件，逗号分隔的多个子串，任一子串出现在名字中即匹配。
+/// 子串以^开头时须出现在名字的开始，以$结尾时须出现在名字的结尾
+/// @return true：匹配 false：不匹配
+///
+static bool matchFilter(const std::string & name, const std::string & filter)
+{
+    if (filter.empty()) {
+        return true;
+    }
+
+    std::size_t start = 0;
+    while (start <= filter.size()) {
+
+        std::size_t comma = filter.find(',', start);
+        if (comma == std::string::npos) {
+            comma = filter.size();
+        }
+
+        std::string pattern = filter.substr(start, comma - start);
+        start = comma + 1;
+
+        bool atBegin = !pattern.empty() && pattern.front() == '^';
+        if (atBegin) {
+            pattern.erase(0, 1);
+        }
+
+        bool atEnd = !pattern.empty() && pattern.back() == '$';
+        if (atEnd) {
+            pattern.pop_back();
+        }
+
+        if (pattern.empty() || pattern.size() > name.size()) {
+            continue;
+        }
+
+        if (atBegin && atEnd) {
+            if (name == pattern) {
+                return true;
+            }
+        } else if (atBegin) {
+            if (name.compare(0, pattern.size(), pattern) == 0) {
+                return true;
+            }
+        } else if (atEnd) {
+            if (name.compare(name.size() - pattern.size(), pattern.size(), pattern) == 0) {
+                return true;
+            }
+        } else if (name.find(pattern) != std::string::npos) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+///
+/// @brief 运行名字与过滤条件匹配的所有测试项，并输出结果
+/// @param filter 过滤条件，为空时运行全部
+/// @param json 是否按JSON格式输出，否则输出表格
+/// @param fp 输出的文件
+/// @return int 失败的测试项数
+///
+int BenchRunner::runAll(const std::string & filter, bool json, FILE * fp)
+{
+    int failures = 0;
+    bool first = true;
+
+    if (json) {
+        fprintf(fp, "{\n  \"benchmarks\": [");
+    } else {
+        fprintf(fp,
+                "%-40s %12s %12s %10s %9s %9s %9s %10s %12s\n",
+                "Benchmark",
+                "Time",
+                "CPU",
+                "Iterations",
+                "lines/s",
+                "nodes/s",
+                "bytes/s",
+                "allocs/it",
+                "allocB/it");
+        fprintf(fp, "%s\n", std::string(129, '-').c_str());
+    }
+
+    for (auto & def: benches) {
+        for (int64_t arg: def.args) {
+
+            if (!matchFilter(def.name + "/" + std::to_string(arg), filter)) {
+                continue;
+            }
+
+            BenchResult r = run(def, arg);
+
+            if (r.failed) {
+                failures++;
+            }
+
+            if (json) {
+                fprintf(fp,
+                        "%s\n    {\"name\": \"%s\", \"arg\": %" PRId64 ", \"failed\": %s, \"iterations\": %" PRIu64
+                        ", \"real_time_ns\": %.1f, \"cpu_time_ns\": %.1f, \"lines_per_second\": %.1f"
+                        ", \"nodes_per_second\": %.1f, \"bytes_per_second\": %.1f, \"allocs_per_iteration\": %.1f"
+                        ", \"alloc_bytes_per_iteration\": %.1f}",
+                        first ? "" : ",",
+                        r.name.c_str(),
+                        r.arg,
+                        r.failed ? "true" : "false",
+                        r.iterations,
+                        r.wallNs,
+                        r.cpuNs,
+                        r.linesPerSec,
+                        r.nodesPerSec,
+                        r.bytesPerSec,
+                        r.allocsPerIter,
+                        r.allocBytesPerIter);
+            } else if (r.failed) {
+                fprintf(fp, "%-40s ERROR: %s\n", r.name.c_str(), r.failMessage.c_str());
+            } else {
+                fprintf(fp,
+                        "%-40s %12s %12s %10" PRIu64 " %9s %9s %9s %10.1f %12.0f\n",
+                        r.name.c_str(),
+                        formatTime(r.wallNs).c_str(),
+                        formatTime(r.cpuNs).c_str(),
+                        r.iterations,
+                        formatRate(r.linesPerSec).c_str(),
+                        formatRate(r.nodesPerSec).c_str(),
+                        formatRate(r.bytesPerSec).c_str(),
+                        r.allocsPerIter,
+                        r.allocBytesPerIter);
+            }
+
+            fflush(fp);
+            first = false;
+        }
+    }
+
+    if (json) {
+        fprintf(fp, "\n  ]\n}\n");
+    }
+
+    return failures;
+}
+
+///
+/// @brief 列出所有测试项的名字
+/// @param fp 输出的文件
+///
+void BenchRunner::list(FILE * fp)
+{
+    for (auto & def: benches) {
+        for (int64_t arg: def.args) {
+            fprintf(fp, "%s/%" PRId64 "\n", def.name.c_str(), arg);
+        }
+    }
+}
+
+///
+/// @brief 列出所有复杂度检查项的名字与规模
+/// @param fp 输出的文件
+///
+void BenchRunner::listScaling(FILE * fp)
+{
+    for (auto & def: scalings) {
+        fprintf(fp, "%s N=%" PRId64 "\n", def.name.c_str(), def.baseN);
+    }
+}
+
+///
+/// @brief 列出所有随机检查项的名字
+/// @param fp 输出的文件
+///
+void BenchRunner::listChecks(FILE * fp)
+{
+    for (auto & def: checks) {
+        fprintf(fp, "%s\n", def.name.c_str());
+    }
+}
+
+///
+/// @brief 用最小二乘法拟合log(时间)与log(规模)的直线，斜率即时间随规模增长的指数
+/// @param sizes 规模
+/// @param times 时间
+/// @return double 指数，时间无效时为0
+///
+static double fitExponent(const std::vector<int64_t> & sizes, const std::vector<double> & times)
+{
+    std::size_t n = sizes.size();
+    if (n < 2) {
+        return 0;
+    }
+
+    double sumX = 0, sumY = 0;
+    for (std::size_t i = 0; i < n; i++) {
+        if (sizes[i] <= 0 || times[i] <= 0) {
+            return 0;
+        }
+        sumX += std::log((double) sizes[i]);
+        sumY += std::log(times[i]);
+    }
+
+    double meanX = sumX / (double) n;
+    double meanY = sumY / (double) n;
+
+    double sxy = 0, sxx = 0;
+    for (std::size_t i = 0; i < n; i++) {
+        double dx = std::log((double) sizes[i]) - meanX;
+        sxy += dx * (std::log(times[i]) - meanY);
+        sxx += dx * dx;
+    }
+
+    return sxx > 0 ? sxy / sxx : 0;
+}
+
+///
+/// @brief 运行一个复杂度检查项
+/// @param def 复杂度检查项
+/// @return ScalingResult 结果
+///
+ScalingResult BenchRunner::checkScaling(const ScalingDef & def)
+{
+    // 每个规模的重复次数，取最小的时间，调度与缓存的干扰只会让时间变长
+    const int repetitions = 5;
+
+    ScalingResult result;
+    result.name = def.name;
+    result.maxExponent = def.maxExponent;
+
+    BenchDef bench{def.name, {}, def.func};
+
+    for (int64_t factor = 1; factor <= 8; factor *= 2) {
+
+        int64_t size = def.baseN * factor;
+        double best = 0;
+
+        for (int rep = 0; rep < repetitions; rep++) {
+
+            BenchResult r = run(bench, size);
+            if (r.failed) {
+                result.failed = true;
+                result.failMessage = r.failMessage;
+                return result;
+            }
+
+            if (rep == 0 || r.wallNs < best) {
+                best = r.wallNs;
+            }
+        }
+
+        result.sizes.push_back(size);
+        result.wallNs.push_back(best);
+    }
+
+    result.exponent = fitExponent(result.sizes, result.wallNs);
+    result.failed = result.exponent > def.maxExponent;
+
+    return result;
+}
+
+///
+/// @brief 运行名字与过滤条件匹配的所有复杂度检查项，并输出结果
+/// @param filter 过滤条件，为空时运行全部
+/// @param json 是否按JSON格式输出，否则输出表格
+/// @param fp 输出的文件
+/// @return int 失败的检查项数
+///
+int BenchRunner::checkAll(const std::string & filter, bool json, FILE * fp)
+{
+    int failures = 0;
+    bool first = true;
+
+    if (json) {
+        fprintf(fp, "{\n  \"scaling_checks\": [");
+    } else {
+        fprintf(fp,
+                "%-32s %8s %12s %12s %12s %12s %8s %6s  %s\n",
+                "Scaling check",
+                "N",
+                "T(N)",
+                "T(2N)",
+                "T(4N)",
+                "T(8N)",
+                "Exponent",
+                "Limit",
+                "Result");
+        fprintf(fp, "%s\n", std::string(120, '-').c_str());
+    }
+
+    for (auto & def: scalings) {
+
+        if (!matchFilter(def.name, filter)) {
+            continue;
+        }
+
+        ScalingResult r = checkScaling(def);
+
+        if (r.failed) {
+            failures++;
+        }
+
+        if (json) {
+            std::string sizes, times;
+            for (std::size_t i = 0; i < r.sizes.size(); i++) {
+                sizes += (i ? ", " : "") + std::to_string(r.sizes[i]);
+                char buf[32];
+                snprintf(buf, sizeof(buf), "%s%.1f", i ? ", " : "", r.wallNs[i]);
+                times += buf;
+            }
+
+            fprintf(fp,
+                    "%s\n    {\"name\": \"%s\", \"sizes\": [%s], \"real_time_ns\": [%s], \"exponent\": %.3f"
+                    ", \"max_exponent\": %.3f, \"failed\": %s, \"error\": \"%s\"}",
+                    first ? "" : ",",
+                    r.name.c_str(),
+                    sizes.c_str(),
+                    times.c_str(),
+                    r.exponent,
+                    r.maxExponent,
+                    r.failed ? "true" : "false",
+                    r.failMessage.c_str());
+        } else if (!r.failMessage.empty()) {
+            fprintf(fp, "%-32s %8" PRId64 " ERROR: %s\n", r.name.c_str(), def.baseN, r.failMessage.c_str());
+        } else {
+            fprintf(fp,
+                    "%-32s %8" PRId64 " %12s %12s %12s %12s %8.2f %6.2f  %s\n",
+                    r.name.c_str(),
+                    def.baseN,
+                    formatTime(r.wallNs[0]).c_str(),
+                    formatTime(r.wallNs[1]).c_str(),
+                    formatTime(r.wallNs[2]).c_str(),
+                    formatTime(r.wallNs[3]).c_str(),
+                    r.exponent,
+                    r.maxExponent,
+                    r.failed ? "FAIL" : "ok");
+        }
+
+        fflush(fp);
+        first = false;
+    }
+
+    if (json) {
+        fprintf(fp, "\n  ]\n}\n");
+    }
+
+    return failures;
+}
+
+///
+/// @brief 运行名字与过滤条件匹配的所有随机检查项，并输出结果
+/// @param filter 过滤条件，为空时运行全部
+/// @param iterations 每个检查项的迭代次数
+/// @param seed 第一次迭代的种子
+/// @param json 是否按JSON格式输出，否则输出表格
+/// @param fp 输出的文件
+/// @return int 失败的检查项数
+///
+int BenchRunner::runChecks(const std::string & filter, uint64_t iterations, uint32_t seed, bool json, FILE * fp)
+{
+    int failures = 0;
+    bool first = true;
+
+    if (json) {
+        fprintf(fp, "{\n  \"pass_checks\": [");
+    } else {
+        fprintf(fp, "%-40s %10s %12s  %s\n", "Pass check", "Iterations", "Time", "Result");
+        fprintf(fp, "%s\n", std::string(80, '-').c_str());
+    }
+
+    for (auto & def: checks) {
+
+        if (!matchFilter(def.name, filter)) {
+            continue;
+        }
+
+        std::string error;
+        uint64_t done = 0;
+        uint32_t failedSeed = 0;
+        bool failed = false;
+
+        int64_t start = wallClockNs();
+
+        for (; done < iterations; done++) {
+            uint32_t s = seed + (uint32_t) done;
+            if (!def.func(s, error)) {
+                failed = true;
+                failedSeed = s;
+                done++;
+                break;
+            }
+        }
+
+        double ns = (double) (wallClockNs() - start);
+
+        if (failed) {
+            failures++;
+        }
+
+        if (json) {
+            fprintf(fp,
+                    "%s\n    {\"name\": \"%s\", \"iterations\": %" PRIu64 ", \"real_time_ns\": %.1f, \"failed\": %s"
+                    ", \"seed\": %u, \"error\": \"%s\"}",
+                    first ? "" : ",",
+                    def.name.c_str(),
+                    done,
+                    ns,
+                    failed ? "true" : "false",
+                    failed ? failedSeed : 0,
+                    error.c_str());
+        } else if (failed) {
+            fprintf(fp,
+                    "%-40s %10" PRIu64 " %12s  FAIL seed=%u: %s\n",
+                    def.name.c_str(),
+                    done,
+                    formatTime(ns).c_str(),
+                    failedSeed,
+                    error.c_str());
+        } else {
+            fprintf(fp, "%-40s %10" PRIu64 " %12s  ok\n", def.name.c_str(), done, formatTime(ns).c_str());
+        }
+
+        fflush(fp);
+        first = false;
+    }
+
+    if (json) {
+        fprintf(fp, "\n  ]\n}\n");
+    }
+
+    return failures;
+}
+
+///
+/// @brief 获取本进程专用的临时目录，不存在时创建
+/// @return std::filesystem::path 目录
+///
+static std::filesystem::path benchDir()
+{
+#ifdef _WIN32
+    unsigned long pid = GetCurrentProcessId();
+#else
+    unsigned long pid = (unsigned long) getpid();
+#endif
+
+    std::filesystem::path dir = std::filesystem::temp_directory_path() / ("minic-bench-" + std::to_string(pid));
+
+    std::error_code ec;
+    std::filesystem::create_directories(dir, ec);
+
+    return dir;
+}
+
+///
+/// @brief 把内容写入测试用的临时文件
+/// @param name 文件名，不含目录
+/// @param content 内容
+/// @return std::string 文件的路径，失败时为空串
+///
+std::string writeBenchFile(const std::string & name, const std::string & content)
+{
+    std::string path = benchFilePath(name);
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        return "";
+    }
+
+    out.write(content.data(), (std::streamsize) content.size());
+    out.close();
+
+    return out ? path : "";
+}
+
+///
+/// @brief 获取测试用的临时文件的路径，不创建文件
+/// @param name 文件名，不含目录
+/// @return std::string 文件的路径
+///
+std::string benchFilePath(const std::string & name)
+{
+    return (benchDir() / name).string();
+}
+
+///
+/// @brief 删除测试用的临时目录及其中的文件
+///
+void removeBenchFiles()
+{
+    std::error_code ec;
+    std::filesystem::remove_all(benchDir(), ec);
+}
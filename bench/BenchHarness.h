@@ -0,0 +1,421 @@
+///
+/// @file BenchHarness.h
+/// @brief 编译器性能测试的运行框架，用法与Google Benchmark类似，但不依赖第三方库
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+/// 每个测试项是一个函数，在keepRunning()的循环中执行一次被测的操作，循环外做准备工作：
+/// @code
+/// static void benchXxx(BenchState & state)
+/// {
+///     准备输入...
+///     while (state.keepRunning()) {
+///         被测的操作...
+///     }
+///     state.setLines(行数);
+/// }
+/// @endcode
+/// 框架自动增加迭代次数，直到总时间达到最小测试时间，然后输出每次迭代的时间与吞吐率。
+///
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "AllocCounter.h"
+
+///
+/// @brief 一个测试项一次运行的状态，控制迭代与计时，并收集每次迭代处理的数据量
+///
+class BenchState {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _arg 测试项的参数，如语句数、线程数等
+    /// @param _iterations 要执行的迭代次数
+    ///
+    BenchState(int64_t _arg, uint64_t _iterations);
+
+    ///
+    /// @brief 是否继续迭代，首次调用时开始计时，迭代次数用完时停止计时
+    /// @return true：继续 false：结束
+    ///
+    bool keepRunning();
+
+    ///
+    /// @brief 暂停计时，之后的时间与内存申请不计入结果，用于每次迭代的准备与清理
+    ///
+    void pauseTiming();
+
+    ///
+    /// @brief 恢复计时
+    ///
+    void resumeTiming();
+
+    ///
+    /// @brief 测试项的参数
+    /// @return int64_t 参数
+    ///
+    [[nodiscard]] int64_t getArg() const
+    {
+        return arg;
+    }
+
+    ///
+    /// @brief 设置每次迭代处理的源代码行数
+    /// @param n 行数
+    ///
+    void setLines(uint64_t n)
+    {
+        lines = n;
+    }
+
+    ///
+    /// @brief 设置每次迭代处理的节点数，按阶段不同为Token、AST节点或IR指令
+    /// @param n 节点数
+    ///
+    void setNodes(uint64_t n)
+    {
+        nodes = n;
+    }
+
+    ///
+    /// @brief 设置每次迭代处理的字节数
+    /// @param n 字节数
+    ///
+    void setBytes(uint64_t n)
+    {
+        bytes = n;
+    }
+
+    ///
+    /// @brief 标记测试失败，调用后应退出迭代循环
+    /// @param msg 失败的原因
+    ///
+    void fail(const std::string & msg);
+
+    /// @brief 测试项的参数
+    int64_t arg;
+
+    /// @brief 要执行的迭代次数
+    uint64_t iterations;
+
+    /// @brief 已开始的迭代次数
+    uint64_t started = 0;
+
+    /// @brief 是否正在计时
+    bool timing = false;
+
+    /// @brief 计时期间累计的墙上时间，纳秒
+    int64_t wallNs = 0;
+
+    /// @brief 计时期间累计的进程CPU时间，纳秒
+    int64_t cpuNs = 0;
+
+    /// @brief 计时期间本线程的内存申请
+    AllocCounter alloc;
+
+    /// @brief 每次迭代处理的行数
+    uint64_t lines = 0;
+
+    /// @brief 每次迭代处理的节点数
+    uint64_t nodes = 0;
+
+    /// @brief 每次迭代处理的字节数
+    uint64_t bytes = 0;
+
+    /// @brief 是否失败
+    bool failed = false;
+
+    /// @brief 失败的原因
+    std::string failMessage;
+
+private:
+    /// @brief 本段计时开始时的墙上时间
+    int64_t wallStart = 0;
+
+    /// @brief 本段计时开始时的进程CPU时间
+    int64_t cpuStart = 0;
+
+    /// @brief 本段计时开始时本线程的内存申请
+    AllocCounter allocStart;
+};
+
+///
+/// @brief 测试项，名字与参数组合成"名字/参数"的形式，每个参数单独运行
+///
+struct BenchDef {
+
+    /// @brief 名字，如frontend/flexbison
+    std::string name;
+
+    /// @brief 参数列表
+    std::vector<int64_t> args;
+
+    /// @brief 测试函数
+    std::function<void(BenchState &)> func;
+};
+
+///
+/// @brief 一个测试项在一个参数下的结果
+///
+struct BenchResult {
+
+    /// @brief 名字，含参数
+    std::string name;
+
+    /// @brief 参数
+    int64_t arg = 0;
+
+    /// @brief 迭代次数
+    uint64_t iterations = 0;
+
+    /// @brief 每次迭代的墙上时间，纳秒
+    double wallNs = 0;
+
+    /// @brief 每次迭代的进程CPU时间，纳秒
+    double cpuNs = 0;
+
+    /// @brief 每秒处理的行数
+    double linesPerSec = 0;
+
+    /// @brief 每秒处理的节点数
+    double nodesPerSec = 0;
+
+    /// @brief 每秒处理的字节数
+    double bytesPerSec = 0;
+
+    /// @brief 每次迭代的内存申请次数
+    double allocsPerIter = 0;
+
+    /// @brief 每次迭代的内存申请字节数
+    double allocBytesPerIter = 0;
+
+    /// @brief 是否失败
+    bool failed = false;
+
+    /// @brief 失败的原因
+    std::string failMessage;
+};
+
+///
+/// @brief 复杂度检查项，在N、2N、4N、8N的规模下运行，拟合时间随规模增长的指数
+///
+struct ScalingDef {
+
+    /// @brief 名字，一般与被检查的阶段对应，如codegen/adjustFuncCallInsts
+    std::string name;
+
+    /// @brief 最小的规模N，作为测试函数的参数
+    int64_t baseN;
+
+    /// @brief 允许的最大指数，拟合出的指数超过时检查失败
+    double maxExponent;
+
+    /// @brief 测试函数，与测试项的测试函数相同，参数为规模
+    std::function<void(BenchState &)> func;
+};
+
+///
+/// @brief 一个复杂度检查项的结果
+///
+struct ScalingResult {
+
+    /// @brief 名字
+    std::string name;
+
+    /// @brief 各次运行的规模
+    std::vector<int64_t> sizes;
+
+    /// @brief 各规模下每次迭代的墙上时间，纳秒
+    std::vector<double> wallNs;
+
+    /// @brief 拟合出的指数，时间约为c * N^exponent
+    double exponent = 0;
+
+    /// @brief 允许的最大指数
+    double maxExponent = 0;
+
+    /// @brief 是否失败，运行出错或指数超过上限
+    bool failed = false;
+
+    /// @brief 运行出错的原因，指数超限时为空
+    std::string failMessage;
+};
+
+///
+/// @brief 随机检查项，每次迭代以不同的种子产生随机输入，与参考实现或解释执行的结果比较
+///
+struct CheckDef {
+
+    /// @brief 名字，一般与被检查的Pass对应，如ir/dominators
+    std::string name;
+
+    /// @brief 检查函数，参数为种子，不一致时返回false并通过error给出原因
+    std::function<bool(uint32_t seed, std::string & error)> func;
+};
+
+/// @brief 复杂度检查默认允许的最大指数。N log N在8倍的规模范围内拟合出的指数约为1.1，
+/// 工作集超出缓存与TLB后线性的阶段也可达1.3左右，平方级的阶段拟合出的指数接近2，可明显区分
+constexpr double defaultMaxScalingExponent = 1.4;
+
+///
+/// @brief 运行测试项并输出结果
+///
+class BenchRunner {
+
+public:
+    ///
+    /// @brief 登记测试项
+    /// @param name 名字
+    /// @param args 参数列表
+    /// @param func 测试函数
+    ///
+    void add(const std::string & name, std::vector<int64_t> args, std::function<void(BenchState &)> func);
+
+    ///
+    /// @brief 设置每个测试的最小时间
+    /// @param seconds 秒数
+    ///
+    void setMinTime(double seconds)
+    {
+        minTime = seconds;
+    }
+
+    ///
+    /// @brief 运行一个测试项的一个参数，迭代次数自动增加直到总时间达到最小测试时间
+    /// @param def 测试项
+    /// @param arg 参数
+    /// @return BenchResult 结果
+    ///
+    BenchResult run(const BenchDef & def, int64_t arg);
+
+    ///
+    /// @brief 运行名字(含参数)与过滤条件匹配的所有测试项，并输出结果
+    /// @param filter 过滤条件，逗号分隔的多个子串，子串可以^开头、以$结尾表示须出现在名字的开始或结尾，为空时运行全部
+    /// @param json 是否按JSON格式输出，否则输出表格
+    /// @param fp 输出的文件
+    /// @return int 失败的测试项数
+    ///
+    int runAll(const std::string & filter, bool json, FILE * fp);
+
+    ///
+    /// @brief 登记复杂度检查项，新增的Pass可通过它登记自己的检查
+    /// @param name 名字
+    /// @param baseN 最小的规模N，依次在N、2N、4N、8N的规模下运行
+    /// @param func 测试函数，参数为规模
+    /// @param maxExponent 允许的最大指数
+    ///
+    void addScaling(const std::string & name,
+                    int64_t baseN,
+                    std::function<void(BenchState &)> func,
+                    double maxExponent = defaultMaxScalingExponent);
+
+    ///
+    /// @brief 运行一个复杂度检查项，每个规模运行多次取最小的时间，以减少干扰
+    /// @param def 复杂度检查项
+    /// @return ScalingResult 结果
+    ///
+    ScalingResult checkScaling(const ScalingDef & def);
+
+    ///
+    /// @brief 运行名字与过滤条件匹配的所有复杂度检查项，并输出结果
+    /// @param filter 过滤条件，与runAll的相同，只匹配名字，不含参数
+    /// @param json 是否按JSON格式输出，否则输出表格
+    /// @param fp 输出的文件
+    /// @return int 失败的检查项数
+    ///
+    int checkAll(const std::string & filter, bool json, FILE * fp);
+
+    ///
+    /// @brief 登记随机检查项，新增的Pass可通过它登记与参考实现的比较
+    /// @param name 名字
+    /// @param func 检查函数，参数为种子
+    ///
+    void addCheck(const std::string & name, std::function<bool(uint32_t, std::string &)> func);
+
+    ///
+    /// @brief 运行名字与过滤条件匹配的所有随机检查项，并输出结果。每个检查项在第一次失败时停止，
+    /// 输出失败的种子，以便用--seed与--iterations=1重现
+    /// @param filter 过滤条件，与runAll的相同，只匹配名字
+    /// @param iterations 每个检查项的迭代次数
+    /// @param seed 第一次迭代的种子，之后依次加1
+    /// @param json 是否按JSON格式输出，否则输出表格
+    /// @param fp 输出的文件
+    /// @return int 失败的检查项数
+    ///
+    int runChecks(const std::string & filter, uint64_t iterations, uint32_t seed, bool json, FILE * fp);
+
+    ///
+    /// @brief 列出所有测试项的名字
+    /// @param fp 输出的文件
+    ///
+    void list(FILE * fp);
+
+    ///
+    /// @brief 列出所有随机检查项的名字
+    /// @param fp 输出的文件
+    ///
+    void listChecks(FILE * fp);
+
+    ///
+    /// @brief 列出所有复杂度检查项的名字与规模
+    /// @param fp 输出的文件
+    ///
+    void listScaling(FILE * fp);
+
+    ///
+    /// @brief 获取所有的测试项
+    /// @return std::vector<BenchDef>&
+    ///
+    std::vector<BenchDef> & getBenches()
+    {
+        return benches;
+    }
+
+private:
+    /// @brief 测试项
+    std::vector<BenchDef> benches;
+
+    /// @brief 复杂度检查项
+    std::vector<ScalingDef> scalings;
+
+    /// @brief 随机检查项
+    std::vector<CheckDef> checks;
+
+    /// @brief 每个测试的最小时间，秒
+    double minTime = 0.5;
+};
+
+///
+/// @brief 把内容写入测试用的临时文件，文件位于本进程专用的临时目录中，进程退出前由removeBenchFiles删除
+/// @param name 文件名，不含目录
+/// @param content 内容
+/// @return std::string 文件的路径，失败时为空串
+///
+std::string writeBenchFile(const std::string & name, const std::string & content);
+
+///
+/// @brief 获取测试用的临时文件的路径，不创建文件，可作为输出文件
+/// @param name 文件名，不含目录
+/// @return std::string 文件的路径
+///
+std::string benchFilePath(const std::string & name);
+
+///
+/// @brief 删除测试用的临时目录及其中的文件
+///
+void removeBenchFiles();
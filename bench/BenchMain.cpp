@@ -0,0 +1,242 @@
+///
+/// @file BenchMain.cpp
+/// @brief 编译器性能测试程序minic-bench的主程序
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <getopt.h>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#include "Benchmarks.h"
+#include "ProgramGenerator.h"
+
+/// @brief 只有长格式的选项的编号
+#define OPTION_FILTER 256
+#define OPTION_MIN_TIME 257
+#define OPTION_FORMAT 258
+#define OPTION_LIST 259
+#define OPTION_GENERATE 260
+#define OPTION_STATEMENTS 261
+#define OPTION_DIGITS 262
+#define OPTION_PER_LINE 263
+#define OPTION_NAME_LENGTH 264
+#define OPTION_SEED 265
+#define OPTION_CHECK_COMPLEXITY 266
+#define OPTION_MINIC 267
+#define OPTION_CHECK_PASSES 268
+#define OPTION_ITERATIONS 269
+
+static struct option long_options[] = {
+    {"help", no_argument, 0, 'h'},
+    {"output", required_argument, 0, 'o'},
+    {"filter", required_argument, 0, OPTION_FILTER},
+    {"min-time", required_argument, 0, OPTION_MIN_TIME},
+    {"format", required_argument, 0, OPTION_FORMAT},
+    {"list", no_argument, 0, OPTION_LIST},
+    {"generate", no_argument, 0, OPTION_GENERATE},
+    {"statements", required_argument, 0, OPTION_STATEMENTS},
+    {"digits", required_argument, 0, OPTION_DIGITS},
+    {"per-line", required_argument, 0, OPTION_PER_LINE},
+    {"name-length", required_argument, 0, OPTION_NAME_LENGTH},
+    {"seed", required_argument, 0, OPTION_SEED},
+    {"check-complexity", no_argument, 0, OPTION_CHECK_COMPLEXITY},
+    {"minic", required_argument, 0, OPTION_MINIC},
+    {"check-passes", no_argument, 0, OPTION_CHECK_PASSES},
+    {"iterations", required_argument, 0, OPTION_ITERATIONS},
+    {0, 0, 0, 0}
+};
+
+/// @brief 显示帮助
+/// @param exeName
+static void showHelp(const std::string & exeName)
+{
+    std::cout << exeName + " [--filter=PATTERN] [--min-time=SECONDS] [--format=console|json] [--minic=PATH] [-o FILE]\n";
+    std::cout << exeName + " --check-complexity [--filter=PATTERN] [--min-time=SECONDS] [--format=console|json] [-o FILE]\n";
+    std::cout << exeName + " --check-passes [--filter=PATTERN] [--iterations=N] [--seed=N] [--format=console|json] [-o FILE]\n";
+    std::cout << exeName + " --list [--check-complexity|--check-passes]\n";
+    std::cout << exeName + " --generate [--statements=N] [--digits=N] [--per-line=N] [--name-length=N] [--seed=N] [-o FILE]\n";
+    std::cout << "Options:\n";
+    std::cout << "  -h, --help                 Show this help message\n";
+    std::cout << "  -o, --output=FILE          Write the results or the generated program to FILE instead of stdout\n";
+    std::cout << "      --filter=PATTERN       Run only the benchmarks whose name/arg contains one of the comma separated\n";
+    std::cout << "                             substrings of PATTERN; ^ and $ anchor a substring at the start or the end\n";
+    std::cout << "      --min-time=SECONDS     Minimum run time of each benchmark, default 0.5, 0.1 for --check-complexity\n";
+    std::cout << "      --format=console|json  Output format of the results\n";
+    std::cout << "      --list                 List the benchmarks, the scaling checks or the pass checks without running them\n";
+    std::cout << "      --check-complexity     Run every phase at sizes N, 2N, 4N and 8N, fit the growth exponent of the time\n";
+    std::cout << "                             and fail when it exceeds the limit of the phase (about N log N)\n";
+    std::cout << "      --check-passes         Run the passes on random inputs and compare them with a brute-force reference\n";
+    std::cout << "                             or an interpreter; a failure prints the seed that reproduces it\n";
+    std::cout << "      --iterations=N         Random inputs of each pass check, default 1000\n";
+    std::cout << "      --minic=PATH           Also run driver/process and driver/batch, which compile small files with\n";
+    std::cout << "                             PATH once per file by fork/exec and once with --batch\n";
+    std::cout << "      --generate             Write a synthetic MiniC program instead of running benchmarks\n";
+    std::cout << "      --statements=N         Statements in the generated function, default 1000\n";
+    std::cout << "      --digits=N             Maximum digits of the integer literals, 1 to 9, default 3\n";
+    std::cout << "      --per-line=N           Statements per source line, default 1\n";
+    std::cout << "      --name-length=N        Length of the function name, default 4\n";
+    std::cout << "      --seed=N               Seed of the generator or of the first pass check input, default 1\n";
+    std::cout << "Columns: Time and CPU are per iteration, CPU is the process CPU time of all threads.\n";
+    std::cout << "nodes are tokens for lexer/*, AST nodes for frontend/* and ir/IRGenerator, source files for driver/*,\n";
+    std::cout << "IR instructions otherwise.\n";
+    std::cout << "allocs/it and allocB/it count operator new and arena slabs on the benchmark thread only.\n";
+}
+
+/// @brief 主程序
+/// @param argc
+/// @param argv
+/// @return 0：成功 1：有失败的测试项、复杂度检查项或随机检查项 -1：参数错误
+int main(int argc, char * argv[])
+{
+    std::string filter;
+    std::string outputFile;
+    std::string minic;
+    double minTime = -1;
+    bool json = false;
+    bool listOnly = false;
+    bool generate = false;
+    bool checkComplexity = false;
+    bool checkPasses = false;
+    uint64_t iterations = 1000;
+    SourceShape shape;
+
+    int ch;
+    while ((ch = getopt_long(argc, argv, "ho:", long_options, nullptr)) != -1) {
+        switch (ch) {
+            case 'h':
+                showHelp(argv[0]);
+                return 0;
+            case 'o':
+                outputFile = optarg;
+                break;
+            case OPTION_FILTER:
+                filter = optarg;
+                break;
+            case OPTION_MIN_TIME:
+                minTime = std::stod(optarg);
+                break;
+            case OPTION_FORMAT:
+                json = std::string(optarg) == "json";
+                if (!json && std::string(optarg) != "console") {
+                    showHelp(argv[0]);
+                    return -1;
+                }
+                break;
+            case OPTION_LIST:
+                listOnly = true;
+                break;
+            case OPTION_GENERATE:
+                generate = true;
+                break;
+            case OPTION_STATEMENTS:
+                shape.statements = std::stoll(optarg);
+                break;
+            case OPTION_DIGITS:
+                shape.literalDigits = std::stoi(optarg);
+                break;
+            case OPTION_PER_LINE:
+                shape.statementsPerLine = std::stoi(optarg);
+                break;
+            case OPTION_NAME_LENGTH:
+                shape.nameLength = std::stoi(optarg);
+                break;
+            case OPTION_SEED:
+                shape.seed = (uint32_t) std::stoul(optarg);
+                break;
+            case OPTION_CHECK_COMPLEXITY:
+                checkComplexity = true;
+                break;
+            case OPTION_MINIC:
+                minic = optarg;
+                break;
+            case OPTION_CHECK_PASSES:
+                checkPasses = true;
+                break;
+            case OPTION_ITERATIONS:
+                iterations = std::stoull(optarg);
+                break;
+            default:
+                showHelp(argv[0]);
+                return -1;
+        }
+    }
+
+    FILE * fp = stdout;
+    if (!outputFile.empty()) {
+        fp = fopen(outputFile.c_str(), "w");
+        if (fp == nullptr) {
+            fprintf(stderr, "can't open %s\n", outputFile.c_str());
+            return -1;
+        }
+    }
+
+    int result = 0;
+
+    if (generate) {
+        // 只产生源程序，可用于命令行编译器的测试
+        GeneratedSource src = generateSource(shape);
+        fwrite(src.text.data(), 1, src.text.size(), fp);
+    } else {
+
+        // 复杂度检查每个阶段要运行4个规模且重复多次，每次的最小时间缺省较短
+        if (minTime < 0) {
+            minTime = checkComplexity ? 0.1 : 0.5;
+        }
+
+#ifdef __GLIBC__
+        // 大块内存不再每次向内核申请与归还，否则每次迭代的缺页开销随规模增长，掩盖算法本身的增长
+        if (checkComplexity) {
+            mallopt(M_MMAP_THRESHOLD, 1 << 30);
+            mallopt(M_TRIM_THRESHOLD, 1 << 30);
+        }
+#endif
+
+        BenchRunner runner;
+        runner.setMinTime(minTime);
+
+        registerFrontEndBenchmarks(runner);
+        registerBackEndBenchmarks(runner);
+        registerDriverBenchmarks(runner, minic);
+        registerIRChecks(runner);
+        registerRegAllocChecks(runner);
+
+        if (listOnly) {
+            if (checkPasses) {
+                runner.listChecks(fp);
+            } else if (checkComplexity) {
+                runner.listScaling(fp);
+            } else {
+                runner.list(fp);
+            }
+        } else if (checkPasses) {
+            result = runner.runChecks(filter, iterations, shape.seed, json, fp) ? 1 : 0;
+        } else if (checkComplexity) {
+            result = runner.checkAll(filter, json, fp) ? 1 : 0;
+        } else {
+            result = runner.runAll(filter, json, fp) ? 1 : 0;
+        }
+
+        removeBenchFiles();
+    }
+
+    if (fp != stdout) {
+        fclose(fp);
+    }
+
+    return result;
+}
@@ -0,0 +1,114 @@
+///
+/// @file Benchmarks.h
+/// @brief 各阶段性能测试项的登记，以及测试项共用的辅助函数
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "BenchHarness.h"
+#include "CodeGeneratorArm32.h"
+
+struct ast_node;
+class FrontEndExecutor;
+class Module;
+
+///
+/// @brief 可从外部调用后端各步骤的ARM32代码生成器，用于单独测试或检查某一步骤
+///
+class BenchCodeGeneratorArm32 : public CodeGeneratorArm32 {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _module 符号表
+    ///
+    explicit BenchCodeGeneratorArm32(Module * _module) : CodeGeneratorArm32(_module)
+    {}
+
+    using CodeGeneratorArm32::adjustFuncCallInsts;
+    using CodeGeneratorArm32::registerAllocation;
+};
+
+///
+/// @brief 测试所用的前端
+///
+enum class BenchFrontEnd {
+
+    /// @brief flex+bison
+    FlexBison,
+
+    /// @brief 递归下降分析，表驱动的词法分析
+    RecursiveDescent,
+
+    /// @brief 递归下降分析，逐字符的词法分析
+    RecursiveDescentSimple,
+
+    /// @brief Antlr4
+    Antlr4,
+};
+
+///
+/// @brief 创建前端的执行器
+/// @param kind 前端
+/// @param file 源文件
+/// @return FrontEndExecutor* 执行器，由调用者释放
+///
+FrontEndExecutor * newBenchFrontEnd(BenchFrontEnd kind, const std::string & file);
+
+///
+/// @brief 统计抽象语法树的节点数
+/// @param root 根节点
+/// @return uint64_t 节点数
+///
+uint64_t countASTNodes(ast_node * root);
+
+///
+/// @brief 统计Module中所有函数的IR指令数
+/// @param module 符号表
+/// @return uint64_t 指令数
+///
+uint64_t countIRInstructions(Module * module);
+
+///
+/// @brief 登记词法分析与前端的测试项与复杂度检查项
+/// @param runner 测试运行框架
+///
+void registerFrontEndBenchmarks(BenchRunner & runner);
+
+///
+/// @brief 登记IR产生、IR输出以及后端的测试项与复杂度检查项
+/// @param runner 测试运行框架
+///
+void registerBackEndBenchmarks(BenchRunner & runner);
+
+///
+/// @brief 登记命令行编译器的测试项，比较批量编译与每个文件一个进程的开销
+/// @param runner 测试运行框架
+/// @param minic 编译器的路径，为空时不登记
+///
+void registerDriverBenchmarks(BenchRunner & runner, const std::string & minic);
+
+///
+/// @brief 登记IR上各Pass的随机检查项，与暴力的参考实现或解释执行的结果比较
+/// @param runner 测试运行框架
+///
+void registerIRChecks(BenchRunner & runner);
+
+///
+/// @brief 登记寄存器分配的随机检查项，在ARM32子集的模拟器上执行生成的汇编，并检查分配结果的冲突
+/// @param runner 测试运行框架
+///
+void registerRegAllocChecks(BenchRunner & runner);
@@ -0,0 +1,172 @@
+///
+/// @file DriverBench.cpp
+/// @brief 命令行编译器的性能测试项，比较批量编译与每个文件一个进程时每个文件的开销
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+/// 测试项的参数为源文件的个数，每个源文件都是较小的合成程序，使进程的启动与退出占主要部分。
+/// driver/process每个文件用fork/exec执行一次minic，driver/batch用一次minic --batch编译所有文件，
+/// 节点数为源文件数，nodes/s即每秒编译的文件数。只在通过--minic指定了编译器时登记。
+///
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "Benchmarks.h"
+#include "ProgramGenerator.h"
+
+/// @brief 源文件个数的参数
+static const std::vector<int64_t> fileCounts = {10, 100};
+
+/// @brief 每个源文件的语句数
+static constexpr int64_t statementsPerFile = 100;
+
+#ifndef _WIN32
+
+///
+/// @brief 用fork/exec执行一次命令行的编译器
+/// @param argv 参数，第一个为编译器的路径
+/// @return 编译器的退出码，执行失败时为-1
+///
+static int runProcess(const std::vector<std::string> & argv)
+{
+    std::vector<char *> args;
+    for (auto & arg: argv) {
+        args.push_back(const_cast<char *>(arg.c_str()));
+    }
+    args.push_back(nullptr);
+
+    pid_t pid = fork();
+    if (pid < 0) {
+        return -1;
+    }
+
+    if (pid == 0) {
+        execv(args[0], args.data());
+        _exit(127);
+    }
+
+    int status;
+    if (waitpid(pid, &status, 0) < 0 || !WIFEXITED(status)) {
+        return -1;
+    }
+
+    return WEXITSTATUS(status);
+}
+
+///
+/// @brief 产生测试用的源文件
+/// @param count 文件个数
+/// @param lines 返回所有文件的总行数
+/// @param bytes 返回所有文件的总字节数
+/// @return std::vector<std::string> 文件的路径，失败时为空
+///
+static std::vector<std::string> writeDriverSources(int64_t count, uint64_t & lines, uint64_t & bytes)
+{
+    std::vector<std::string> files;
+    lines = 0;
+    bytes = 0;
+
+    for (int64_t i = 0; i < count; i++) {
+
+        SourceShape shape;
+        shape.statements = statementsPerFile;
+        shape.seed = (uint32_t) (i + 1);
+        GeneratedSource src = generateSource(shape);
+
+        std::string file = writeBenchFile("driver" + std::to_string(i) + ".c", src.text);
+        if (file.empty()) {
+            return {};
+        }
+
+        files.push_back(file);
+        lines += src.lines;
+        bytes += src.text.size();
+    }
+
+    return files;
+}
+
+///
+/// @brief 编译器的测试，每次迭代编译所有源文件
+/// @param state 测试状态
+/// @param minic 编译器的路径
+/// @param batch true：一个进程批量编译 false：每个文件一个进程
+///
+static void benchDriver(BenchState & state, const std::string & minic, bool batch)
+{
+    uint64_t lines;
+    uint64_t bytes;
+    std::vector<std::string> files = writeDriverSources(state.getArg(), lines, bytes);
+    if (files.empty()) {
+        state.fail("can't write the source files");
+        return;
+    }
+
+    std::string output = benchFilePath("driver.s");
+
+    // 批量编译时输出到测试临时目录，与源文件同名
+    std::vector<std::string> batchArgv = {minic, "-S", "-D", "--batch", "-o", benchFilePath("")};
+    batchArgv.insert(batchArgv.end(), files.begin(), files.end());
+
+    while (state.keepRunning()) {
+
+        if (batch) {
+            if (runProcess(batchArgv) != 0) {
+                state.fail("minic --batch failed");
+                break;
+            }
+            continue;
+        }
+
+        for (auto & file: files) {
+            if (runProcess({minic, "-S", "-D", "-o", output, file}) != 0) {
+                state.fail("minic failed on " + file);
+                break;
+            }
+        }
+
+        if (state.failed) {
+            break;
+        }
+    }
+
+    state.setLines(lines);
+    state.setNodes(files.size());
+    state.setBytes(bytes);
+}
+
+#endif
+
+///
+/// @brief 登记命令行编译器的测试项
+/// @param runner 测试运行框架
+/// @param minic 编译器的路径，为空时不登记
+///
+void registerDriverBenchmarks(BenchRunner & runner, const std::string & minic)
+{
+#ifndef _WIN32
+    if (minic.empty()) {
+        return;
+    }
+
+    runner.add("driver/process", fileCounts, [minic](BenchState & state) { benchDriver(state, minic, false); });
+    runner.add("driver/batch", fileCounts, [minic](BenchState & state) { benchDriver(state, minic, true); });
+#else
+    (void) runner;
+    (void) minic;
+#endif
+}
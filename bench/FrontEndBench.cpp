@@ -0,0 +1,259 @@
+///
+/// @file FrontEndBench.cpp
+/// @brief 词法分析与前端的性能测试项
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+/// 前端的测试从源文件开始，含读入文件、词法语法分析以及AST的构建与释放，与编译器的前端阶段一致。
+///
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "AST.h"
+#include "Antlr4Executor.h"
+#include "Benchmarks.h"
+#include "FlexBisonExecutor.h"
+#include "MappedFile.h"
+#include "ProgramGenerator.h"
+#include "RecursiveDescentContext.h"
+#include "RecursiveDescentExecutor.h"
+#include "RecursiveDescentFlex.h"
+#include "StdioLexer.h"
+
+/// @brief 源程序规模的参数，即语句数
+static const std::vector<int64_t> sourceSizes = {1000, 10000, 100000};
+
+///
+/// @brief 创建前端的执行器
+/// @param kind 前端
+/// @param file 源文件
+/// @return FrontEndExecutor* 执行器，由调用者释放
+///
+FrontEndExecutor * newBenchFrontEnd(BenchFrontEnd kind, const std::string & file)
+{
+    switch (kind) {
+        case BenchFrontEnd::FlexBison:
+            return new FlexBisonExecutor(file);
+        case BenchFrontEnd::RecursiveDescent:
+            return new RecursiveDescentExecutor(file, true);
+        case BenchFrontEnd::RecursiveDescentSimple:
+            return new RecursiveDescentExecutor(file, false);
+        case BenchFrontEnd::Antlr4:
+        default:
+            return new Antlr4Executor(file);
+    }
+}
+
+///
+/// @brief 统计抽象语法树的节点数
+/// @param root 根节点
+/// @return uint64_t 节点数
+///
+uint64_t countASTNodes(ast_node * root)
+{
+    uint64_t count = 0;
+
+    std::vector<ast_node *> stack;
+    if (root) {
+        stack.push_back(root);
+    }
+
+    while (!stack.empty()) {
+        ast_node * node = stack.back();
+        stack.pop_back();
+
+        count++;
+
+        for (auto son: node->sons) {
+            stack.push_back(son);
+        }
+    }
+
+    return count;
+}
+
+///
+/// @brief 词法分析的测试，只扫描Token，不做语法分析
+/// @param state 测试状态
+/// @param dfa true：表驱动的词法分析 false：逐字符的词法分析
+///
+static void benchLexer(BenchState & state, bool dfa)
+{
+    SourceShape shape;
+    shape.statements = state.getArg();
+    GeneratedSource src = generateSource(shape);
+
+    std::string file = writeBenchFile("lexer.c", src.text);
+
+    // 与递归下降前端一样按内存映射读入
+    MappedFile input;
+    if (file.empty() || !input.open(file)) {
+        state.fail("can't write the source file");
+        return;
+    }
+
+    uint64_t tokens = 0;
+
+    while (state.keepRunning()) {
+
+        RDContext ctx;
+        ctx.inputCur = input.begin();
+        ctx.inputEnd = input.end();
+
+        tokens = 0;
+        for (;;) {
+            int tag = dfa ? rd_flex_dfa(ctx) : rd_flex(ctx);
+            if (tag == RDTokenType::T_EOF || tag == RDTokenType::T_ERR) {
+                break;
+            }
+            tokens++;
+        }
+    }
+
+    state.setLines(src.lines);
+    state.setNodes(tokens);
+    state.setBytes(src.text.size());
+}
+
+///
+/// @brief 改为内存映射之前按fgetc/ungetc逐字符读入的词法分析，作为lexer/rd-*的对照
+/// @param state 测试状态
+///
+static void benchStdioLexer(BenchState & state)
+{
+    SourceShape shape;
+    shape.statements = state.getArg();
+    GeneratedSource src = generateSource(shape);
+
+    std::string file = writeBenchFile("lexer.c", src.text);
+    if (file.empty()) {
+        state.fail("can't write the source file");
+        return;
+    }
+
+    uint64_t tokens = 0;
+
+    while (state.keepRunning()) {
+
+        StdioLexer lexer;
+        lexer.fp = fopen(file.c_str(), "r");
+        if (lexer.fp == nullptr) {
+            state.fail("can't open the source file");
+            break;
+        }
+
+        tokens = 0;
+        for (;;) {
+            int tag = stdio_flex(lexer);
+            if (tag == RDTokenType::T_EOF || tag == RDTokenType::T_ERR) {
+                break;
+            }
+            if (lexer.id) {
+                free(lexer.id);
+                lexer.id = nullptr;
+            }
+            tokens++;
+        }
+
+        fclose(lexer.fp);
+    }
+
+    state.setLines(src.lines);
+    state.setNodes(tokens);
+    state.setBytes(src.text.size());
+}
+
+///
+/// @brief 前端的测试，源文件到AST
+/// @param state 测试状态
+/// @param kind 前端
+///
+static void benchFrontEnd(BenchState & state, BenchFrontEnd kind)
+{
+    SourceShape shape;
+    shape.statements = state.getArg();
+    GeneratedSource src = generateSource(shape);
+
+    std::string file = writeBenchFile("frontend.c", src.text);
+    if (file.empty()) {
+        state.fail("can't write the source file");
+        return;
+    }
+
+    uint64_t nodes = 0;
+
+    while (state.keepRunning()) {
+
+        FrontEndExecutor * executor = newBenchFrontEnd(kind, file);
+        if (!executor->run()) {
+            delete executor;
+            state.fail("frontend failed");
+            break;
+        }
+
+        ast_node * root = executor->getASTRoot();
+
+        if (nodes == 0) {
+            state.pauseTiming();
+            nodes = countASTNodes(root);
+            state.resumeTiming();
+        }
+
+        free_ast(root);
+        delete executor;
+    }
+
+    state.setLines(src.lines);
+    state.setNodes(nodes);
+    state.setBytes(src.text.size());
+}
+
+///
+/// @brief 登记词法分析与前端的测试项与复杂度检查项
+/// @param runner 测试运行框架
+///
+void registerFrontEndBenchmarks(BenchRunner & runner)
+{
+    runner.add("lexer/stdio", sourceSizes, benchStdioLexer);
+    runner.add("lexer/rd-simple", sourceSizes, [](BenchState & state) { benchLexer(state, false); });
+    runner.add("lexer/rd-dfa", sourceSizes, [](BenchState & state) { benchLexer(state, true); });
+
+    runner.add("frontend/flexbison", sourceSizes, [](BenchState & state) {
+        benchFrontEnd(state, BenchFrontEnd::FlexBison);
+    });
+    runner.add("frontend/rd-simple", sourceSizes, [](BenchState & state) {
+        benchFrontEnd(state, BenchFrontEnd::RecursiveDescentSimple);
+    });
+    runner.add("frontend/rd-dfa", sourceSizes, [](BenchState & state) {
+        benchFrontEnd(state, BenchFrontEnd::RecursiveDescent);
+    });
+    runner.add("frontend/antlr4", sourceSizes, [](BenchState & state) {
+        benchFrontEnd(state, BenchFrontEnd::Antlr4);
+    });
+
+    // 复杂度检查，词法分析与前端都应与源程序的长度成线性关系
+    runner.addScaling("lexer/rd-simple", 20000, [](BenchState & state) { benchLexer(state, false); });
+    runner.addScaling("lexer/rd-dfa", 20000, [](BenchState & state) { benchLexer(state, true); });
+    runner.addScaling("frontend/flexbison", 20000, [](BenchState & state) {
+        benchFrontEnd(state, BenchFrontEnd::FlexBison);
+    });
+    runner.addScaling("frontend/rd-simple", 20000, [](BenchState & state) {
+        benchFrontEnd(state, BenchFrontEnd::RecursiveDescentSimple);
+    });
+    runner.addScaling("frontend/rd-dfa", 20000, [](BenchState & state) {
+        benchFrontEnd(state, BenchFrontEnd::RecursiveDescent);
+    });
+    runner.addScaling("frontend/antlr4", 20000, [](BenchState & state) {
+        benchFrontEnd(state, BenchFrontEnd::Antlr4);
+    });
+}
@@ -0,0 +1,510 @@
+///
+/// @file IRChecks.cpp
+/// @brief IR上各Pass的随机检查项，在随机产生的控制流图上与暴力的参考实现比较
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+/// 每个检查项以种子产生一个小的随机输入，块数不超过十几个，使暴力的参考实现足够快，
+/// 又能覆盖不可达块、多出口、无出口的循环以及不可归约的图。
+///
+#include <algorithm>
+#include <random>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Benchmarks.h"
+#include "BinaryInstruction.h"
+#include "Casting.h"
+#include "ConstInt.h"
+#include "ControlFlowGraph.h"
+#include "DominatorTree.h"
+#include "IntegerType.h"
+#include "LabelInstruction.h"
+#include "LocalVariable.h"
+#include "Mem2Reg.h"
+#include "Module.h"
+#include "MoveInstruction.h"
+#include "OutOfSSA.h"
+#include "PhiInstruction.h"
+#include "StringInterner.h"
+
+/// @brief 以块编号为节点的图，每个节点的后继或前驱
+using BlockGraph = std::vector<std::vector<int>>;
+
+///
+/// @brief 去掉一个节点后从根出发的可达性
+/// @param graph 图
+/// @param roots 根
+/// @param removed 去掉的节点，-1表示不去掉
+/// @return std::vector<bool> 各节点是否可达
+///
+static std::vector<bool> reachable(const BlockGraph & graph, const std::vector<int> & roots, int removed)
+{
+    std::vector<bool> visited(graph.size(), false);
+    std::vector<int> stack;
+
+    for (int root: roots) {
+        if (root != removed) {
+            visited[root] = true;
+            stack.push_back(root);
+        }
+    }
+
+    while (!stack.empty()) {
+        int v = stack.back();
+        stack.pop_back();
+        for (int s: graph[v]) {
+            if (s != removed && !visited[s]) {
+                visited[s] = true;
+                stack.push_back(s);
+            }
+        }
+    }
+
+    return visited;
+}
+
+///
+/// @brief 比较块的集合，同时检查结果中没有重复的块
+/// @param range 被检查的结果
+/// @param expected 期望的集合
+/// @return true：相同 false：不同
+///
+static bool sameBlocks(BlockRange range, const std::set<BasicBlock *> & expected)
+{
+    std::set<BasicBlock *> got(range.begin(), range.end());
+
+    return got == expected && range.size() == expected.size();
+}
+
+///
+/// @brief 按暴力的定义检查一个方向的支配树：去掉a后根不可达b时a支配b
+/// @param cfg 控制流图
+/// @param blocks 按编号排列的块
+/// @param succs 各块的后继
+/// @param preds 各块的前驱
+/// @param post true：后支配树 false：支配树
+/// @param error 不一致的原因
+/// @return true：一致 false：不一致
+///
+static bool checkDominatorTree(ControlFlowGraph & cfg,
+                               const std::vector<BasicBlock *> & blocks,
+                               const BlockGraph & succs,
+                               const BlockGraph & preds,
+                               bool post,
+                               std::string & error)
+{
+    int n = (int) blocks.size();
+    DominatorTree dt(cfg, post);
+
+    // 后支配树沿前驱方向计算，根为所有没有后继的块
+    const BlockGraph & forward = post ? preds : succs;
+    const BlockGraph & backward = post ? succs : preds;
+
+    std::vector<int> roots;
+    if (post) {
+        for (int i = 0; i < n; i++) {
+            if (succs[i].empty()) {
+                roots.push_back(i);
+            }
+        }
+    } else {
+        roots.push_back(0);
+    }
+
+    std::string kind = post ? "post-dominator " : "dominator ";
+
+    std::vector<bool> live = reachable(forward, roots, -1);
+    std::vector<std::vector<bool>> dom(n, std::vector<bool>(n, false));
+    for (int a = 0; a < n; a++) {
+        std::vector<bool> without = reachable(forward, roots, a);
+        for (int b = 0; b < n; b++) {
+            dom[a][b] = live[a] && live[b] && (a == b || !without[b]);
+        }
+    }
+
+    // 直接支配者是被其它所有严格支配者支配的严格支配者
+    std::vector<int> idoms(n, -1);
+    for (int a = 0; a < n; a++) {
+        for (int c = 0; c < n; c++) {
+            if (c == a || !dom[c][a]) {
+                continue;
+            }
+            bool closest = true;
+            for (int d = 0; d < n; d++) {
+                if (d != a && d != c && dom[d][a] && !dom[d][c]) {
+                    closest = false;
+                }
+            }
+            if (closest) {
+                idoms[a] = c;
+            }
+        }
+    }
+
+    for (int a = 0; a < n; a++) {
+
+        if (dt.contains(blocks[a]) != live[a]) {
+            error = kind + "contains(" + std::to_string(a) + ")";
+            return false;
+        }
+
+        for (int b = 0; b < n; b++) {
+            if (dt.dominates(blocks[a], blocks[b]) != dom[a][b]) {
+                error = kind + "dominates(" + std::to_string(a) + ", " + std::to_string(b) + ")";
+                return false;
+            }
+        }
+
+        if (dt.getIDom(blocks[a]) != (idoms[a] < 0 ? nullptr : blocks[idoms[a]])) {
+            error = kind + "getIDom(" + std::to_string(a) + ")";
+            return false;
+        }
+
+        // 支配边界：a支配b的某个前驱，且a不严格支配b
+        std::set<BasicBlock *> frontier;
+        for (int b = 0; live[a] && b < n; b++) {
+            if (!live[b] || (a != b && dom[a][b])) {
+                continue;
+            }
+            for (int p: backward[b]) {
+                if (live[p] && dom[a][p]) {
+                    frontier.insert(blocks[b]);
+                    break;
+                }
+            }
+        }
+
+        if (!sameBlocks(dt.getFrontier(blocks[a]), frontier)) {
+            error = kind + "getFrontier(" + std::to_string(a) + ")";
+            return false;
+        }
+
+        std::set<BasicBlock *> children;
+        for (int b = 0; b < n; b++) {
+            if (idoms[b] == a) {
+                children.insert(blocks[b]);
+            }
+        }
+
+        if (!sameBlocks(dt.getChildren(blocks[a]), children)) {
+            error = kind + "getChildren(" + std::to_string(a) + ")";
+            return false;
+        }
+    }
+
+    std::set<BasicBlock *> treeRoots;
+    for (int b = 0; b < n; b++) {
+        if (live[b] && idoms[b] < 0) {
+            treeRoots.insert(blocks[b]);
+        }
+    }
+
+    if (!sameBlocks(dt.getRoots(), treeRoots) || (!post && treeRoots != std::set<BasicBlock *>{blocks[0]})) {
+        error = kind + "getRoots()";
+        return false;
+    }
+
+    // 先序中含所有可达块，父节点排在子节点之前
+    std::vector<int> position(n, -1);
+    int k = 0;
+    for (BasicBlock * block: dt.getPreOrder()) {
+        position[block->getIndex()] = k++;
+    }
+
+    for (int a = 0; a < n; a++) {
+        if (live[a] != (position[a] >= 0)) {
+            error = kind + "getPreOrder() membership of " + std::to_string(a);
+            return false;
+        }
+        BasicBlock * idom = dt.getIDom(blocks[a]);
+        if (live[a] && idom && position[idom->getIndex()] > position[a]) {
+            error = kind + "getPreOrder() order of " + std::to_string(a);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+///
+/// @brief 支配树与后支配树的检查：随机的图，块的布局随机打乱，与暴力的定义比较
+/// @param seed 种子
+/// @param error 不一致的原因
+/// @return true：一致 false：不一致
+///
+static bool checkDominators(uint32_t seed, std::string & error)
+{
+    std::mt19937 rng(seed);
+
+    Module * module = new Module("check");
+    Function * func = module->newFunction(internSymbol("check"), IntegerType::getTypeInt());
+
+    bool ok = true;
+    {
+        ControlFlowGraph cfg(func);
+
+        int n = 1 + (int) (rng() % 14);
+        std::vector<BasicBlock *> blocks;
+        for (int i = 0; i < n; i++) {
+            BasicBlock * block = cfg.newBlock();
+            block->getInsts().push_back(new (func) LabelInstruction(func));
+            blocks.push_back(block);
+        }
+
+        // 边不指向入口块，允许自环、回边以及多个入口的环
+        BlockGraph succs(n), preds(n);
+        int edges = n > 1 ? (int) (rng() % (2 * n + 1)) : 0;
+        for (int e = 0; e < edges; e++) {
+            int a = (int) (rng() % n);
+            int b = 1 + (int) (rng() % (n - 1));
+            if (std::find(succs[a].begin(), succs[a].end(), b) != succs[a].end()) {
+                continue;
+            }
+            succs[a].push_back(b);
+            preds[b].push_back(a);
+            blocks[a]->addSuccessor(blocks[b]);
+        }
+
+        // 块的编号与布局次序无关，打乱入口之外的块
+        std::shuffle(cfg.getBlocks().begin() + 1, cfg.getBlocks().end(), rng);
+
+        ok = checkDominatorTree(cfg, blocks, succs, preds, false, error) &&
+             checkDominatorTree(cfg, blocks, succs, preds, true, error);
+    }
+
+    module->Delete();
+    delete module;
+
+    return ok;
+}
+
+/// @brief 解释执行时每条路径最多经过的块数，拆分关键边产生的块不计
+static constexpr int interpretSteps = 300;
+
+/// @brief 每个随机函数解释执行的路径数
+static constexpr uint32_t interpretPaths = 8;
+
+///
+/// @brief 解释执行时求值，常量取其值，没有赋值过的变量为0
+/// @param env 各变量与指令的值
+/// @param value 操作数
+/// @return int64_t 值
+///
+static int64_t evaluate(std::unordered_map<Value *, int64_t> & env, Value * value)
+{
+    if (auto * constInt = dyn_cast<ConstInt>(value)) {
+        return constInt->getVal();
+    }
+
+    auto it = env.find(value);
+
+    return it == env.end() ? 0 : it->second;
+}
+
+///
+/// @brief 沿一条随机路径解释执行控制流图，记录每条二元运算指令的结果。
+/// 二元运算按不可交换的式子求值，使操作数的次序错误也能发现
+/// @param cfg 控制流图
+/// @param seed 选择分支的种子
+/// @param originalBlocks 原来的块数，编号不小于它的块为Pass新增的块，不计入步数
+/// @param trace 返回运算结果的序列
+/// @return true：成功 false：遇到了Phi指令
+///
+static bool interpret(ControlFlowGraph & cfg, uint32_t seed, int32_t originalBlocks, std::vector<int64_t> & trace)
+{
+    std::mt19937 rng(seed);
+    std::unordered_map<Value *, int64_t> env;
+
+    BasicBlock * block = cfg.getEntry();
+    for (int step = 0; block && step < interpretSteps;) {
+
+        if (block->getIndex() < originalBlocks) {
+            step++;
+        }
+
+        for (Instruction * inst: block->getInsts()) {
+            if (isa<PhiInstruction>(inst)) {
+                return false;
+            }
+            if (auto * move = dyn_cast<MoveInstruction>(inst)) {
+                env[move->getOperand(0)] = evaluate(env, move->getOperand(1));
+            } else if (auto * binary = dyn_cast<BinaryInstruction>(inst)) {
+                int64_t result = (evaluate(env, binary->getOperand(0)) * 31 + evaluate(env, binary->getOperand(1))) % 1000003;
+                env[binary] = result;
+                trace.push_back(result);
+            }
+        }
+
+        auto & succs = block->getSuccessors();
+        if (succs.empty()) {
+            break;
+        }
+
+        // 只有一个后继时不取随机数，使拆分关键边新增的块不改变之后的路径
+        block = succs.size() == 1 ? succs[0] : succs[rng() % succs.size()];
+    }
+
+    return true;
+}
+
+///
+/// @brief 产生随机的函数体：每块若干对局部变量的赋值与加法，一到两个后继，部分块为出口
+/// @param module 符号表
+/// @param func 函数
+/// @param cfg 控制流图
+/// @param vars 局部变量
+/// @param rng 随机数发生器
+///
+static void buildRandomBlocks(Module * module,
+                              Function * func,
+                              ControlFlowGraph & cfg,
+                              const std::vector<LocalVariable *> & vars,
+                              std::mt19937 & rng)
+{
+    int n = 2 + (int) (rng() % 12);
+    int nv = (int) vars.size();
+
+    std::vector<BasicBlock *> blocks;
+    for (int i = 0; i < n; i++) {
+        BasicBlock * block = cfg.newBlock();
+        block->getInsts().push_back(new (func) LabelInstruction(func));
+        blocks.push_back(block);
+    }
+
+    for (int i = 0; i < n; i++) {
+
+        int succCount = (i == n - 1) || (i > 0 && rng() % 6 == 0) ? 0 : 1 + (int) (rng() % 2);
+        for (int k = 0; k < succCount; k++) {
+            int target = 1 + (int) (rng() % (n - 1));
+            if (k == 0 && rng() % 2) {
+                target = i + 1 < n ? i + 1 : target;
+            }
+            auto & succs = blocks[i]->getSuccessors();
+            if (std::find(succs.begin(), succs.end(), blocks[target]) == succs.end()) {
+                blocks[i]->addSuccessor(blocks[target]);
+            }
+        }
+
+        auto & insts = blocks[i]->getInsts();
+        Instruction * last = nullptr;
+        int instCount = (int) (rng() % 12);
+        for (int k = 0; k < instCount; k++) {
+            Value * dst = vars[rng() % nv];
+            switch (rng() % 4) {
+                case 0:
+                    insts.push_back(new (func) MoveInstruction(func, dst, module->newConstInt((int32_t) (rng() % 100))));
+                    break;
+                case 1:
+                    insts.push_back(new (func) MoveInstruction(func, dst, vars[rng() % nv]));
+                    break;
+                case 2:
+                    last = new (func) BinaryInstruction(func,
+                                                        IRInstOperator::IRINST_OP_ADD_I,
+                                                        vars[rng() % nv],
+                                                        vars[rng() % nv],
+                                                        IntegerType::getTypeInt());
+                    insts.push_back(last);
+                    break;
+                default:
+                    if (last) {
+                        insts.push_back(new (func) MoveInstruction(func, dst, last));
+                    }
+                    break;
+            }
+        }
+    }
+
+    cfg.computeReversePostOrder();
+    cfg.removeUnreachableBlocks();
+}
+
+///
+/// @brief mem2reg与出SSA的检查：随机的函数在两个Pass前后沿相同的随机路径解释执行，
+/// 运算结果的序列须相同，且之后不再有Phi指令，也不再使用被提升的局部变量
+/// @param seed 种子
+/// @param error 不一致的原因
+/// @return true：一致 false：不一致
+///
+static bool checkMem2Reg(uint32_t seed, std::string & error)
+{
+    std::mt19937 rng(seed);
+
+    Module * module = new Module("check");
+    Function * func = module->newFunction(internSymbol("check"), IntegerType::getTypeInt());
+
+    std::vector<LocalVariable *> vars;
+    int nv = 1 + (int) (rng() % 4);
+    for (int k = 0; k < nv; k++) {
+        vars.push_back(func->newLocalVarValue(IntegerType::getTypeInt()));
+    }
+
+    bool ok = true;
+    {
+        ControlFlowGraph cfg(func);
+        buildRandomBlocks(module, func, cfg, vars, rng);
+
+        int32_t originalBlocks = cfg.getBlockCount();
+
+        std::vector<std::vector<int64_t>> before(interpretPaths);
+        for (uint32_t path = 0; path < interpretPaths; path++) {
+            interpret(cfg, path, originalBlocks, before[path]);
+        }
+
+        {
+            DominatorTree dt(cfg);
+            Mem2Reg(module, cfg, dt).run();
+        }
+
+        OutOfSSA(cfg).run();
+
+        for (BasicBlock * block: cfg.getBlocks()) {
+            for (Instruction * inst: block->getInsts()) {
+                for (int32_t k = 0; k < inst->getOperandsNum(); k++) {
+                    if (std::find(vars.begin(), vars.end(), inst->getOperand(k)) != vars.end()) {
+                        error = "a promoted local variable is still used";
+                        ok = false;
+                    }
+                }
+            }
+        }
+
+        for (uint32_t path = 0; ok && path < interpretPaths; path++) {
+            std::vector<int64_t> after;
+            if (!interpret(cfg, path, originalBlocks, after)) {
+                error = "phi instruction left after out-of-SSA";
+                ok = false;
+            } else if (after != before[path]) {
+                error = "results differ on path " + std::to_string(path);
+                ok = false;
+            }
+        }
+    }
+
+    func->removeUnusedVarValues();
+    module->Delete();
+    delete module;
+
+    return ok;
+}
+
+///
+/// @brief 登记IR上各Pass的随机检查项
+/// @param runner 测试运行框架
+///
+void registerIRChecks(BenchRunner & runner)
+{
+    runner.addCheck("ir/dominators", checkDominators);
+    runner.addCheck("optimizer/mem2reg", checkMem2Reg);
+}
@@ -0,0 +1,261 @@
+///
+/// @file ProgramGenerator.cpp
+/// @brief 性能测试用的合成程序生成器的实现
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#include <vector>
+
+#include "ProgramGenerator.h"
+#include "Module.h"
+#include "ControlFlowGraph.h"
+#include "Function.h"
+#include "IntegerType.h"
+#include "EntryInstruction.h"
+#include "ExitInstruction.h"
+#include "FuncCallInstruction.h"
+#include "GotoInstruction.h"
+#include "LabelInstruction.h"
+#include "MoveInstruction.h"
+#include "LocalVariable.h"
+#include "StringInterner.h"
+
+///
+/// @brief 确定性的伪随机数，线性同余法，与平台和标准库无关
+///
+class BenchRandom {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param seed 种子
+    ///
+    explicit BenchRandom(uint32_t seed) : state(seed ? seed : 1)
+    {}
+
+    ///
+    /// @brief 产生[0, bound)内的随机数
+    /// @param bound 上界，需大于0
+    /// @return uint32_t 随机数
+    ///
+    uint32_t next(uint32_t bound)
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+
+        return (uint32_t) (state >> 33) % bound;
+    }
+
+private:
+    /// @brief 当前状态
+    uint64_t state;
+};
+
+///
+/// @brief 按规模参数产生MiniC源程序
+/// @param shape 规模参数
+/// @return GeneratedSource 源程序
+///
+GeneratedSource generateSource(const SourceShape & shape)
+{
+    GeneratedSource src;
+    BenchRandom random(shape.seed);
+
+    static const uint32_t limits[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+
+    int digits = shape.literalDigits < 1 ? 1 : (shape.literalDigits > 9 ? 9 : shape.literalDigits);
+    int perLine = shape.statementsPerLine < 1 ? 1 : shape.statementsPerLine;
+
+    // 函数名，以字母开头，后面为字母与数字
+    std::string name = "f";
+    for (int i = 1; i < shape.nameLength; i++) {
+        name += "abcdefghijklmnopqrstuvwxyz0123456789_"[random.next(37)];
+    }
+
+    src.text.reserve((std::size_t) shape.statements * (std::size_t) (digits + 13) + 64);
+
+    src.text += "int " + name + "()\n{\n";
+    src.lines = 2;
+
+    for (int64_t i = 0; i < shape.statements; i++) {
+
+        src.text += (i % perLine == 0) ? "    " : " ";
+
+        // 字面量的位数在1到digits之间变化，不产生前导0
+        uint32_t width = random.next((uint32_t) digits) + 1;
+        uint32_t value;
+        if (width == 1) {
+            value = random.next(10);
+        } else {
+            value = limits[width - 1] + random.next(limits[width] - limits[width - 1]);
+        }
+
+        src.text += "return " + std::to_string(value) + ";";
+
+        if ((i + 1) % perLine == 0 || i + 1 == shape.statements) {
+            src.text += "\n";
+            src.lines++;
+        }
+    }
+
+    src.text += "}\n";
+    src.lines++;
+
+    return src;
+}
+
+///
+/// @brief 按规模参数在Module中构造函数f0、f1...的线性IR
+/// @param module 符号表
+/// @param shape 规模参数
+///
+void buildIRProgram(Module * module, const IRShape & shape)
+{
+    BenchRandom random(shape.seed);
+    Type * intType = IntegerType::getTypeInt();
+
+    // 常量在Module中唯一，所有函数共用，用于产生被大量使用的常量
+    int constantNum = shape.constants < 1 ? 1 : shape.constants;
+    std::vector<ConstInt *> constants;
+    for (int i = 0; i < constantNum; i++) {
+        constants.push_back(module->newConstInt(i * 7 + 1));
+    }
+
+    int localNum = shape.locals < 1 ? 1 : shape.locals;
+
+    // 所有的函数调用都调用f0，f0自身为递归调用
+    Function * callee = nullptr;
+
+    for (int f = 0; f < shape.functions; f++) {
+
+        // 与IRGenerator::ir_function_define的次序相同
+        Function * func = module->newFunction(internSymbol("f" + std::to_string(f)), intType);
+        module->setCurrentFunction(func);
+        module->enterScope();
+
+        if (!callee) {
+            callee = func;
+        }
+
+        InterCode & irCode = func->getInterCode();
+        irCode.addInst(new (func) EntryInstruction(func));
+
+        LabelInstruction * exitLabel = new (func) LabelInstruction(func);
+        func->setExitLabel(exitLabel);
+
+        LocalVariable * retValue = static_cast<LocalVariable *>(module->newVarValue(intType));
+        func->setReturnValue(retValue);
+
+        std::vector<Value *> locals;
+        for (int i = 0; i < localNum; i++) {
+            locals.push_back(module->newVarValue(intType, internSymbol("v" + std::to_string(i))));
+        }
+
+        for (int64_t i = 0; i < shape.statements; i++) {
+
+            // 跳转到紧随其后的Label，形成基本块的边界
+            if (shape.blockSize > 0 && i > 0 && i % shape.blockSize == 0) {
+                LabelInstruction * label = new (func) LabelInstruction(func);
+                irCode.addInst(new (func) GotoInstruction(func, label));
+                irCode.addInst(label);
+            }
+
+            Value * dst = locals[random.next((uint32_t) localNum)];
+            Value * src = constants[random.next((uint32_t) constantNum)];
+            irCode.addInst(new (func) MoveInstruction(func, dst, src));
+
+            if (shape.callEvery > 0 && (i + 1) % shape.callEvery == 0) {
+
+                std::vector<Value *> args;
+                for (int k = 0; k < shape.callArgs; k++) {
+                    args.push_back(locals[random.next((uint32_t) localNum)]);
+                }
+
+                Instruction * callInst = new (func) FuncCallInstruction(func, callee, args, intType);
+                irCode.addInst(callInst);
+                irCode.addInst(new (func) MoveInstruction(func, locals[random.next((uint32_t) localNum)], callInst));
+
+                func->setExistFuncCall(true);
+                if (shape.callArgs > func->getMaxFuncCallArgCnt()) {
+                    func->setMaxFuncCallArgCnt(shape.callArgs);
+                }
+            }
+        }
+
+        // 返回第一个局部变量
+        irCode.addInst(new (func) MoveInstruction(func, retValue, locals[0]));
+        irCode.addInst(new (func) GotoInstruction(func, exitLabel));
+        irCode.addInst(exitLabel);
+        irCode.addInst(new (func) ExitInstruction(func, retValue));
+
+        module->setCurrentFunction(nullptr);
+        module->leaveScope();
+    }
+}
+
+/// @brief 在空函数的控制流图中构造指定形状的块与边
+/// @param cfg 控制流图
+/// @param func 函数
+/// @param shape 形状
+/// @param blocks 块数
+void buildCFGShape(ControlFlowGraph & cfg, Function * func, CFGShape shape, int64_t blocks)
+{
+    // 每个块以Label开头，线性化时可作为跳转的目标
+    std::vector<BasicBlock *> block;
+    for (int64_t i = 0; i < (blocks < 3 ? 3 : blocks); i++) {
+        BasicBlock * newBlock = cfg.newBlock();
+        newBlock->getInsts().push_back(new (func) LabelInstruction(func));
+        block.push_back(newBlock);
+    }
+
+    std::size_t n = block.size();
+
+    switch (shape) {
+        case CFGShape::Deep:
+            // 0->1->2->3->4...，每4个块含一个循环：3->1为回边，0->4跳过整个循环
+            for (std::size_t i = 0; i + 1 < n; i++) {
+                block[i]->addSuccessor(block[i + 1]);
+                if (i % 4 == 3) {
+                    block[i]->addSuccessor(block[i - 2]);
+                }
+                if ((i % 4 == 0) && (i + 4 < n)) {
+                    block[i]->addSuccessor(block[i + 4]);
+                }
+            }
+            break;
+
+        case CFGShape::Wide:
+            // 0->1..n-2->n-1
+            for (std::size_t i = 1; i + 1 < n; i++) {
+                block[0]->addSuccessor(block[i]);
+                block[i]->addSuccessor(block[n - 1]);
+            }
+            break;
+
+        case CFGShape::Irreducible:
+            // 每3个块h、a、b为一组：h->a、h->b，a与b互为后继，形成两个入口的循环，a再进入下一组
+            for (std::size_t i = 0; i + 2 < n; i += 3) {
+                block[i]->addSuccessor(block[i + 1]);
+                block[i]->addSuccessor(block[i + 2]);
+                block[i + 1]->addSuccessor(block[i + 2]);
+                block[i + 2]->addSuccessor(block[i + 1]);
+                if (i + 3 < n) {
+                    block[i + 1]->addSuccessor(block[i + 3]);
+                }
+            }
+
+            // 不足一组的块顺序连接
+            for (std::size_t i = n / 3 * 3 + 1; i < n; i++) {
+                block[i - 1]->addSuccessor(block[i]);
+            }
+            break;
+    }
+}
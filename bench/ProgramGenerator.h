@@ -0,0 +1,129 @@
+///
+/// @file ProgramGenerator.h
+/// @brief 性能测试用的合成程序生成器，按规模参数确定性地产生MiniC源程序或者线性IR
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+/// 目前的文法只接受一个函数，函数体内只有return语句，表达式只有无符号整数。
+/// 源程序的规模因此只能通过语句数、字面量的位数、每行的语句数以及函数名的长度调整。
+/// 函数数、表达式深度以及变量数目前在源程序中无法表达，后端的测试直接通过IR接口构造多函数的程序，
+/// 文法扩充后可在SourceShape中增加相应的参数。
+///
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+class ControlFlowGraph;
+class Function;
+class Module;
+
+///
+/// @brief 源程序的规模参数
+///
+struct SourceShape {
+
+    /// @brief 函数体内的语句数
+    int64_t statements = 1000;
+
+    /// @brief 每行的语句数
+    int statementsPerLine = 1;
+
+    /// @brief 整数字面量的最大位数，1到9
+    int literalDigits = 3;
+
+    /// @brief 函数名的长度
+    int nameLength = 4;
+
+    /// @brief 随机数种子，相同的参数与种子产生相同的程序
+    uint32_t seed = 1;
+};
+
+///
+/// @brief 生成的源程序
+///
+struct GeneratedSource {
+
+    /// @brief 源程序的内容
+    std::string text;
+
+    /// @brief 行数
+    uint64_t lines = 0;
+};
+
+///
+/// @brief 按规模参数产生MiniC源程序
+/// @param shape 规模参数
+/// @return GeneratedSource 源程序
+///
+GeneratedSource generateSource(const SourceShape & shape);
+
+///
+/// @brief 直接构造的线性IR程序的规模参数
+///
+struct IRShape {
+
+    /// @brief 函数数
+    int functions = 1;
+
+    /// @brief 每个函数的赋值语句数
+    int64_t statements = 1000;
+
+    /// @brief 每个函数的局部变量数
+    int locals = 8;
+
+    /// @brief 所用的不同常量数，所有函数共用，常量越少每个常量的使用越多
+    int constants = 16;
+
+    /// @brief 每多少条语句插入一个Label并以Goto跳转到该Label，为0时不插入
+    int blockSize = 8;
+
+    /// @brief 每多少条语句插入一次对f0的函数调用，调用结果赋值给局部变量，为0时不插入
+    int callEvery = 0;
+
+    /// @brief 函数调用的实参个数，超过4个时多出的实参经栈传递
+    int callArgs = 6;
+
+    /// @brief 随机数种子
+    uint32_t seed = 1;
+};
+
+///
+/// @brief 按规模参数在Module中构造函数f0、f1...的线性IR，与IRGenerator产生的IR结构相同
+/// @param module 符号表
+/// @param shape 规模参数
+///
+void buildIRProgram(Module * module, const IRShape & shape);
+
+///
+/// @brief 支配树等控制流分析测试用的控制流图形状。IR没有条件跳转，多后继的块只能直接构造
+///
+enum class CFGShape {
+
+    /// @brief 支配树很深：顺序排列的小循环，每个循环带一条跳过循环的边
+    Deep,
+
+    /// @brief 支配树很宽：入口分叉到所有的块，再全部汇合到出口
+    Wide,
+
+    /// @brief 不可归约：顺序排列的双入口循环
+    Irreducible,
+};
+
+///
+/// @brief 在空函数的控制流图中构造指定形状的块与边，每个块只含一条Label指令
+/// @param cfg 控制流图，由没有指令的函数构建
+/// @param func 函数
+/// @param shape 形状
+/// @param blocks 块数
+///
+void buildCFGShape(ControlFlowGraph & cfg, Function * func, CFGShape shape, int64_t blocks);
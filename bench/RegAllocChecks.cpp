@@ -0,0 +1,743 @@
+///
+/// @file RegAllocChecks.cpp
+/// @brief 寄存器分配的随机检查项，在ARM32子集的模拟器上执行生成的汇编，并在IR上检查分配结果的冲突
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+/// 随机函数由局部变量、全局变量与常量之间的赋值以及跳转组成，局部变量多于可分配的寄存器时产生溢出，
+/// 全局变量之间的赋值在寄存器较空闲时也要用到指令选择的临时寄存器。
+/// 模拟器只实现后端对这些指令产生的ARM32子集，返回时检查r0的值与IR解释执行的结果相同，
+/// 且r4-r11与sp恢复为进入时的值。冲突检查在寄存器分配后的线性IR上计算活跃变量，
+/// 定值的位置（寄存器或栈槽）不能与定值之后仍活跃的其它变量相同，函数调用之后仍活跃的变量不能在r0-r3中。
+/// -O1检查线性扫描，-O2检查图着色：实参与返回值的传送与r0-r3合并、局部变量之间的传送合并后两端位置相同，
+/// 溢出结点共享栈槽，这些都由同一冲突检查覆盖。
+///
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <map>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Benchmarks.h"
+#include "Casting.h"
+#include "ConstInt.h"
+#include "EntryInstruction.h"
+#include "ExitInstruction.h"
+#include "FuncCallInstruction.h"
+#include "GotoInstruction.h"
+#include "IntegerType.h"
+#include "LabelInstruction.h"
+#include "LocalVariable.h"
+#include "Module.h"
+#include "MoveInstruction.h"
+#include "PlatformArm32.h"
+#include "RegVariable.h"
+#include "StringInterner.h"
+
+/// @brief 模拟执行的最大指令条数，只有向前的跳转，超过时说明跳转目标错误
+static constexpr int simulateSteps = 100000;
+
+/// @brief 模拟器中全局变量的起始地址，与栈的地址不重叠
+static constexpr int64_t symbolBase = 1 << 24;
+
+///
+/// @brief 汇编指令的寄存器名转换为编号
+/// @param name 寄存器名，可带有[]与空格
+/// @return int 编号，不是寄存器时为-1
+///
+static int regNumber(std::string name)
+{
+    while (!name.empty() && (name.back() == ']' || name.back() == ' ')) {
+        name.pop_back();
+    }
+    while (!name.empty() && (name.front() == '[' || name.front() == ' ')) {
+        name.erase(0, 1);
+    }
+
+    if (name == "fp") {
+        return ARM32_FP_REG_NO;
+    }
+    if (name == "ip") {
+        return 12;
+    }
+    if (name == "sp") {
+        return ARM32_SP_REG_NO;
+    }
+    if (name == "lr") {
+        return ARM32_LX_REG_NO;
+    }
+    if (name.size() > 1 && name[0] == 'r') {
+        return std::stoi(name.substr(1));
+    }
+
+    return -1;
+}
+
+///
+/// @brief ARM32子集的模拟器，支持后端对赋值、跳转、入口与出口产生的指令
+///
+class ArmSimulator {
+
+public:
+    ///
+    /// @brief 构造函数，解析汇编文本，只保留指令与Label
+    /// @param text 汇编文本
+    ///
+    explicit ArmSimulator(const std::string & text)
+    {
+        std::istringstream in(text);
+        std::string line;
+
+        while (std::getline(in, line)) {
+
+            std::size_t comment = line.find('@');
+            if (comment != std::string::npos) {
+                line.erase(comment);
+            }
+
+            std::size_t start = line.find_first_not_of(" \t");
+            std::size_t end = line.find_last_not_of(" \t\r");
+            if (start == std::string::npos) {
+                continue;
+            }
+            line = line.substr(start, end - start + 1);
+
+            if (line.back() == ':') {
+                // 函数名与Label，只有Label会作为跳转目标
+                labels[line.substr(0, line.size() - 1)] = code.size();
+                continue;
+            }
+
+            if (line[0] == '.') {
+                continue;
+            }
+
+            // 操作码之后按不在{}与[]内的逗号分开操作数，并去掉空白
+            std::vector<std::string> tokens;
+            std::size_t space = line.find_first_of(" \t");
+            tokens.push_back(line.substr(0, space));
+
+            if (space != std::string::npos) {
+                std::string operand;
+                int depth = 0;
+                for (char ch: line.substr(space + 1)) {
+                    if (ch == '{' || ch == '[') {
+                        depth++;
+                    } else if (ch == '}' || ch == ']') {
+                        depth--;
+                    }
+                    if (ch == ',' && depth == 0) {
+                        tokens.push_back(operand);
+                        operand.clear();
+                    } else if (ch != ' ' && ch != '\t') {
+                        operand += ch;
+                    }
+                }
+                if (!operand.empty()) {
+                    tokens.push_back(operand);
+                }
+            }
+
+            code.push_back(tokens);
+        }
+    }
+
+    ///
+    /// @brief 从第一条指令开始执行到bx
+    /// @param result 返回r0的值
+    /// @param error 出错的原因
+    /// @return true：成功 false：出错
+    ///
+    bool run(int64_t & result, std::string & error)
+    {
+        int64_t initial[16];
+        for (int i = 0; i < 16; i++) {
+            regs[i] = 1000 + i * 7;
+        }
+        regs[ARM32_SP_REG_NO] = 1 << 20;
+        std::copy(regs, regs + 16, initial);
+
+        std::size_t pc = 0;
+        for (int step = 0; step < simulateSteps && pc < code.size(); step++) {
+
+            const std::vector<std::string> & inst = code[pc++];
+            const std::string & op = inst[0];
+
+            if (op == "bx") {
+
+                for (int i = 4; i <= ARM32_FP_REG_NO; i++) {
+                    if (regs[i] != initial[i]) {
+                        error = "callee-saved r" + std::to_string(i) + " is clobbered";
+                        return false;
+                    }
+                }
+
+                if (regs[ARM32_SP_REG_NO] != initial[ARM32_SP_REG_NO]) {
+                    error = "sp is not restored";
+                    return false;
+                }
+
+                result = regs[0];
+                return true;
+            }
+
+            if (op == "b") {
+                auto iter = labels.find(inst[1]);
+                if (iter == labels.end()) {
+                    error = "undefined label " + inst[1];
+                    return false;
+                }
+                pc = iter->second;
+            } else if (!execute(inst, error)) {
+                return false;
+            }
+        }
+
+        error = "no bx reached";
+        return false;
+    }
+
+private:
+    ///
+    /// @brief 执行跳转以外的一条指令
+    /// @param inst 操作码与操作数
+    /// @param error 出错的原因
+    /// @return true：成功 false：出错
+    ///
+    bool execute(const std::vector<std::string> & inst, std::string & error)
+    {
+        const std::string & op = inst[0];
+
+        if (op == "push") {
+            std::vector<int> list = regList(inst[1]);
+            for (auto iter = list.rbegin(); iter != list.rend(); ++iter) {
+                regs[ARM32_SP_REG_NO] -= 4;
+                memory[regs[ARM32_SP_REG_NO]] = regs[*iter];
+            }
+        } else if (op == "pop") {
+            for (int reg: regList(inst[1])) {
+                regs[reg] = memory[regs[ARM32_SP_REG_NO]];
+                regs[ARM32_SP_REG_NO] += 4;
+            }
+        } else if (op == "mov") {
+            regs[regNumber(inst[1])] = operand(inst[2]);
+        } else if (op == "movw") {
+            regs[regNumber(inst[1])] = operand(inst[2]) & 0xffff;
+        } else if (op == "movt") {
+            int reg = regNumber(inst[1]);
+            regs[reg] = (regs[reg] & 0xffff) | (operand(inst[2]) & 0xffff0000);
+        } else if (op == "ldr") {
+            int reg = regNumber(inst[1]);
+            if (inst[2][0] == '=') {
+                regs[reg] = std::stoll(inst[2].substr(1));
+            } else {
+                int64_t addr = address(inst[2]);
+                auto iter = memory.find(addr);
+                if (iter == memory.end()) {
+                    error = "load from an address never stored";
+                    return false;
+                }
+                regs[reg] = iter->second;
+            }
+        } else if (op == "str") {
+            memory[address(inst[2])] = regs[regNumber(inst[1])];
+        } else if (op == "add" || op == "sub") {
+            int64_t a = regs[regNumber(inst[2])];
+            int64_t b = operand(inst[3]);
+            regs[regNumber(inst[1])] = op == "add" ? a + b : a - b;
+        } else {
+            error = "unsupported instruction " + op;
+            return false;
+        }
+
+        return true;
+    }
+
+    ///
+    /// @brief 求操作数的值：寄存器、#立即数或#:lower16:/#:upper16:符号
+    /// @param text 操作数
+    /// @return int64_t 值，符号时为其地址，movw与movt的立即数也带有重定位的前缀
+    ///
+    int64_t operand(const std::string & text)
+    {
+        if (text[0] != '#') {
+            return regs[regNumber(text)];
+        }
+
+        std::size_t colon = text.rfind(':');
+        if (colon == std::string::npos) {
+            return std::stoll(text.substr(1));
+        }
+
+        std::string name = text.substr(colon + 1);
+        if (isdigit((unsigned char) name[0]) || name[0] == '-') {
+            return std::stoll(name);
+        }
+
+        auto iter = symbols.find(name);
+        if (iter == symbols.end()) {
+            iter = symbols.emplace(name, symbolBase + 16 * (int64_t) symbols.size()).first;
+        }
+
+        return iter->second;
+    }
+
+    ///
+    /// @brief 求[base]或[base,#offset]、[base,reg]的地址
+    /// @param text 操作数
+    /// @return int64_t 地址
+    ///
+    int64_t address(const std::string & text)
+    {
+        std::string inner = text.substr(1, text.size() - 2);
+        std::size_t comma = inner.find(',');
+
+        int64_t addr = regs[regNumber(inner.substr(0, comma))];
+        if (comma != std::string::npos) {
+            addr += operand(inner.substr(comma + 1));
+        }
+
+        return addr;
+    }
+
+    ///
+    /// @brief 解析push与pop的寄存器列表，按编号从小到大排列
+    /// @param text {r4,r5,fp,lr}形式的列表
+    /// @return std::vector<int> 寄存器编号
+    ///
+    static std::vector<int> regList(const std::string & text)
+    {
+        std::vector<int> list;
+        std::stringstream in(text.substr(1, text.size() - 2));
+        std::string name;
+
+        while (std::getline(in, name, ',')) {
+            list.push_back(regNumber(name));
+        }
+
+        std::sort(list.begin(), list.end());
+
+        return list;
+    }
+
+    /// @brief 指令，第一个为操作码
+    std::vector<std::vector<std::string>> code;
+
+    /// @brief Label到指令序号的映射
+    std::map<std::string, std::size_t> labels;
+
+    /// @brief 全局变量的地址
+    std::map<std::string, int64_t> symbols;
+
+    /// @brief 寄存器
+    int64_t regs[16];
+
+    /// @brief 内存，按4字节的地址存放
+    std::unordered_map<int64_t, int64_t> memory;
+};
+
+///
+/// @brief 随机函数的形状
+///
+struct RandomFunction {
+
+    /// @brief 函数
+    Function * func = nullptr;
+
+    /// @brief 局部变量
+    std::vector<LocalVariable *> locals;
+
+    /// @brief 局部变量与全局变量，赋值的操作数从中选择
+    std::vector<Value *> vars;
+};
+
+///
+/// @brief 产生随机的函数main：先为所有变量赋初值，再分成若干块，块内为变量与常量之间的赋值，
+/// 块末可跳转到其它块，跳转之后的赋值为死代码
+/// @param module 符号表
+/// @param rng 随机数发生器
+/// @param calls true：块内有对函数g的调用，跳转可以向后形成循环，只能用于冲突检查
+/// false：只向前跳转，可解释执行与模拟执行
+/// @return RandomFunction 函数与变量
+///
+static RandomFunction buildRandomFunction(Module * module, std::mt19937 & rng, bool calls)
+{
+    Type * intType = IntegerType::getTypeInt();
+    Function * callee = calls ? module->newFunction(internSymbol("g"), intType) : nullptr;
+
+    RandomFunction rf;
+
+    // 没有当前函数时新建的变量为全局变量
+    std::vector<Value *> globals;
+    int globalCount = (int) (rng() % 4);
+    for (int k = 0; k < globalCount; k++) {
+        globals.push_back(module->newVarValue(intType, internSymbol("gv" + std::to_string(k))));
+    }
+
+    rf.func = module->newFunction(internSymbol("main"), intType);
+    Function * func = rf.func;
+
+    int localCount = 1 + (int) (rng() % 24);
+    for (int k = 0; k < localCount; k++) {
+        rf.locals.push_back(func->newLocalVarValue(intType));
+        rf.vars.push_back(rf.locals.back());
+    }
+
+    rf.vars.insert(rf.vars.end(), globals.begin(), globals.end());
+
+    auto randomVar = [&rf, &rng]() { return rf.vars[rng() % rf.vars.size()]; };
+
+    InstList & insts = func->getInterCode().getInsts();
+    insts.push_back(new (func) EntryInstruction(func));
+
+    int blockCount = 1 + (int) (rng() % 8);
+    std::vector<LabelInstruction *> labels;
+    for (int i = 0; i < blockCount; i++) {
+        labels.push_back(new (func) LabelInstruction(func));
+    }
+
+    for (Value * var: rf.vars) {
+        insts.push_back(new (func) MoveInstruction(func, var, module->newConstInt((int32_t) (rng() % 1000))));
+    }
+
+    int maxArgs = 0;
+
+    for (int i = 0; i < blockCount; i++) {
+
+        insts.push_back(labels[i]);
+
+        int instCount = (int) (rng() % 12);
+        for (int k = 0; k < instCount; k++) {
+
+            Value * dst = randomVar();
+
+            switch (rng() % 5) {
+                case 0:
+                    insts.push_back(new (func) MoveInstruction(func, dst, module->newConstInt((int32_t) (rng() % 100000))));
+                    break;
+                case 1:
+                    if (calls) {
+                        // 实参多于4个时经栈传递，调用的结果赋值给变量
+                        std::vector<Value *> args;
+                        int argCount = (int) (rng() % 7);
+                        for (int a = 0; a < argCount; a++) {
+                            args.push_back(rf.locals[rng() % rf.locals.size()]);
+                        }
+                        maxArgs = std::max(maxArgs, argCount);
+
+                        auto * call = new (func) FuncCallInstruction(func, callee, args, intType);
+                        insts.push_back(call);
+                        insts.push_back(new (func) MoveInstruction(func, dst, call));
+                        func->setExistFuncCall(true);
+                        break;
+                    }
+                    [[fallthrough]];
+                default:
+                    insts.push_back(new (func) MoveInstruction(func, dst, randomVar()));
+                    break;
+            }
+        }
+
+        if (rng() % 3 == 0) {
+
+            int target = calls ? (int) (rng() % blockCount) : i + 1 + (int) (rng() % (blockCount - i));
+            if (target < blockCount) {
+                insts.push_back(new (func) GotoInstruction(func, labels[target]));
+
+                int deadCount = (int) (rng() % 3);
+                for (int k = 0; k < deadCount; k++) {
+                    insts.push_back(new (func) MoveInstruction(func, randomVar(), randomVar()));
+                }
+            }
+        }
+    }
+
+    insts.push_back(new (func) ExitInstruction(func, rf.locals[rng() % rf.locals.size()]));
+
+    func->setMaxFuncCallArgCnt(maxArgs);
+
+    return rf;
+}
+
+///
+/// @brief 解释执行只有赋值与向前跳转的函数
+/// @param func 函数
+/// @return int64_t 返回值
+///
+static int64_t interpretFunction(Function * func)
+{
+    InstList & list = func->getInterCode().getInsts();
+    std::vector<Instruction *> insts(list.begin(), list.end());
+
+    std::unordered_map<Instruction *, std::size_t> position;
+    for (std::size_t k = 0; k < insts.size(); k++) {
+        position[insts[k]] = k;
+    }
+
+    std::unordered_map<Value *, int64_t> env;
+    auto value = [&env](Value * val) {
+        auto * constInt = dyn_cast<ConstInt>(val);
+        return constInt ? (int64_t) constInt->getVal() : env[val];
+    };
+
+    for (std::size_t pc = 0; pc < insts.size(); pc++) {
+        Instruction * inst = insts[pc];
+        if (auto * move = dyn_cast<MoveInstruction>(inst)) {
+            env[move->getOperand(0)] = value(move->getOperand(1));
+        } else if (auto * jump = dyn_cast<GotoInstruction>(inst)) {
+            pc = position[jump->getTarget()];
+        } else if (isa<ExitInstruction>(inst)) {
+            return value(inst->getOperand(0));
+        }
+    }
+
+    return 0;
+}
+
+///
+/// @brief 执行检查：随机函数在给定的优化级别下生成汇编，在模拟器上执行，返回值须与解释执行的结果相同，
+/// 且被调用者保护的寄存器与sp恢复为进入时的值
+/// @param seed 种子
+/// @param optLevel 优化级别
+/// @param error 不一致的原因
+/// @return true：一致 false：不一致
+///
+static bool checkExecution(uint32_t seed, int32_t optLevel, std::string & error)
+{
+    std::mt19937 rng(seed);
+
+    Module * module = new Module("check");
+    RandomFunction rf = buildRandomFunction(module, rng, false);
+
+    int64_t expected = interpretFunction(rf.func);
+
+    std::string file = benchFilePath("regalloc.s");
+
+    CodeGenerator * generator = new CodeGeneratorArm32(module);
+    generator->setOptLevel(optLevel);
+    bool result = generator->run(file);
+    delete generator;
+
+    module->Delete();
+    delete module;
+
+    if (!result) {
+        error = "code generation failed";
+        return false;
+    }
+
+    std::ifstream in(file);
+    std::stringstream text;
+    text << in.rdbuf();
+
+    int64_t got = 0;
+    if (!ArmSimulator(text.str()).run(got, error)) {
+        return false;
+    }
+
+    if ((int32_t) got != (int32_t) expected) {
+        error = "returned " + std::to_string(got) + ", expected " + std::to_string(expected);
+        return false;
+    }
+
+    return true;
+}
+
+///
+/// @brief 值在寄存器分配后的位置
+/// @param val 值
+/// @return std::string 寄存器为r编号，栈槽为基址寄存器与偏移，没有位置时为空串
+///
+static std::string locationOf(Value * val)
+{
+    if (val->getRegId() >= 0) {
+        return "r" + std::to_string(val->getRegId());
+    }
+
+    int32_t base;
+    int64_t offset;
+    if (val->getMemoryAddr(&base, &offset)) {
+        return "[r" + std::to_string(base) + ", #" + std::to_string(offset) + "]";
+    }
+
+    return "";
+}
+
+///
+/// @brief 是否为冲突检查关心的值：局部变量、寄存器变量以及有值的指令
+/// @param val 值
+/// @return true：关心 false：不关心
+///
+static bool isTracked(Value * val)
+{
+    if (isa<LocalVariable>(val) || isa<RegVariable>(val)) {
+        return true;
+    }
+
+    auto * inst = dyn_cast<Instruction>(val);
+
+    return inst && inst->hasResultValue();
+}
+
+///
+/// @brief 冲突检查：随机函数含函数调用与循环，寄存器分配后在线性IR上计算活跃变量，
+/// 定值的位置不能与之后仍活跃的其它值相同（同一位置间的赋值除外），调用之后仍活跃的值不能在r0-r3中
+/// @param seed 种子
+/// @param optLevel 优化级别
+/// @param error 冲突的原因
+/// @return true：没有冲突 false：有冲突
+///
+static bool checkInterference(uint32_t seed, int32_t optLevel, std::string & error)
+{
+    std::mt19937 rng(seed);
+
+    Module * module = new Module("check");
+    RandomFunction rf = buildRandomFunction(module, rng, true);
+    Function * func = rf.func;
+
+    {
+        BenchCodeGeneratorArm32 generator(module);
+        generator.setOptLevel(optLevel);
+        generator.registerAllocation(func);
+    }
+    func->renameIR();
+
+    InstList & list = func->getInterCode().getInsts();
+    std::vector<Instruction *> insts(list.begin(), list.end());
+    std::size_t n = insts.size();
+
+    std::unordered_map<Instruction *, std::size_t> position;
+    for (std::size_t k = 0; k < n; k++) {
+        position[insts[k]] = k;
+    }
+
+    // 每条指令的使用、定值与后继，函数调用定值r0-r3
+    std::vector<std::vector<Value *>> uses(n), defs(n);
+    std::vector<std::vector<std::size_t>> succs(n);
+
+    for (std::size_t k = 0; k < n; k++) {
+
+        Instruction * inst = insts[k];
+
+        if (auto * move = dyn_cast<MoveInstruction>(inst)) {
+            if (isTracked(move->getOperand(1))) {
+                uses[k].push_back(move->getOperand(1));
+            }
+            if (isTracked(move->getOperand(0))) {
+                defs[k].push_back(move->getOperand(0));
+            }
+        } else {
+            for (int32_t i = 0; i < inst->getOperandsNum(); i++) {
+                if (isTracked(inst->getOperand(i))) {
+                    uses[k].push_back(inst->getOperand(i));
+                }
+            }
+            if (isa<FuncCallInstruction>(inst)) {
+                for (int32_t reg = 0; reg < 4; reg++) {
+                    defs[k].push_back(PlatformArm32::intRegVal(func, reg));
+                }
+            }
+        }
+
+        if (auto * jump = dyn_cast<GotoInstruction>(inst)) {
+            succs[k].push_back(position[jump->getTarget()]);
+        } else if (!isa<ExitInstruction>(inst) && k + 1 < n) {
+            succs[k].push_back(k + 1);
+        }
+    }
+
+    // 逆序迭代到不动点，函数很小，直接用集合
+    std::vector<std::set<Value *>> liveIn(n), liveOut(n);
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (std::size_t k = n; k-- > 0;) {
+            std::set<Value *> out;
+            for (std::size_t s: succs[k]) {
+                out.insert(liveIn[s].begin(), liveIn[s].end());
+            }
+            std::set<Value *> in = out;
+            for (Value * def: defs[k]) {
+                in.erase(def);
+            }
+            in.insert(uses[k].begin(), uses[k].end());
+            if (out != liveOut[k] || in != liveIn[k]) {
+                liveOut[k] = std::move(out);
+                liveIn[k] = std::move(in);
+                changed = true;
+            }
+        }
+    }
+
+    bool ok = true;
+
+    for (std::size_t k = 0; ok && k < n; k++) {
+
+        Instruction * inst = insts[k];
+        auto * move = dyn_cast<MoveInstruction>(inst);
+
+        for (Value * def: defs[k]) {
+            for (Value * live: liveOut[k]) {
+
+                if (live == def) {
+                    continue;
+                }
+
+                std::string defLoc = locationOf(def);
+                std::string liveLoc = locationOf(live);
+                if (defLoc.empty() || liveLoc.empty()) {
+                    error = "no register or stack slot for " + (defLoc.empty() ? def : live)->getIRName();
+                    ok = false;
+                } else if (defLoc == liveLoc && !(move && locationOf(move->getOperand(1)) == liveLoc)) {
+                    error = def->getIRName() + " and " + live->getIRName() + " share " + defLoc + " at instruction " +
+                            std::to_string(k);
+                    ok = false;
+                }
+            }
+        }
+
+        if (isa<FuncCallInstruction>(inst)) {
+            for (Value * live: liveOut[k]) {
+                int32_t reg = live->getRegId();
+                if (!isa<RegVariable>(live) && reg >= 0 && reg < 4) {
+                    error = live->getIRName() + " is live across a call in r" + std::to_string(reg);
+                    ok = false;
+                }
+            }
+        }
+    }
+
+    module->Delete();
+    delete module;
+
+    return ok;
+}
+
+///
+/// @brief 登记寄存器分配的随机检查项
+/// @param runner 测试运行框架
+///
+void registerRegAllocChecks(BenchRunner & runner)
+{
+    runner.addCheck("codegen/linear-scan/execution",
+                    [](uint32_t seed, std::string & error) { return checkExecution(seed, 1, error); });
+    runner.addCheck("codegen/linear-scan/interference",
+                    [](uint32_t seed, std::string & error) { return checkInterference(seed, 1, error); });
+    runner.addCheck("codegen/graph-coloring/execution",
+                    [](uint32_t seed, std::string & error) { return checkExecution(seed, 2, error); });
+    runner.addCheck("codegen/graph-coloring/interference",
+                    [](uint32_t seed, std::string & error) { return checkInterference(seed, 2, error); });
+}
@@ -0,0 +1,128 @@
+///
+/// @file StdioLexer.cpp
+/// @brief 按fgetc/ungetc逐字符读入的词法分析，仅作为性能测试的对照
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#include <cctype>
+#include <cstring>
+
+#include "Common.h"
+#include "RecursiveDescentParser.h"
+#include "StdioLexer.h"
+
+/// @brief 关键字与Token类别的数据结构
+struct StdioKeywordToken {
+    std::string name;
+    enum RDTokenType type;
+};
+
+/// @brief 关键字与Token对应表
+static StdioKeywordToken allKeywords[] = {
+    {"int", RDTokenType::T_INT},
+    {"return", RDTokenType::T_RETURN},
+};
+
+/// @brief 在标识符中检查是否时关键字，若是关键字则返回对应关键字的Token，否则返回T_ID
+/// @param id 标识符
+/// @return Token
+static RDTokenType getKeywordToken(std::string id)
+{
+    for (auto & keyword: allKeywords) {
+        if (keyword.name == id) {
+            return keyword.type;
+        }
+    }
+
+    return RDTokenType::T_ID;
+}
+
+/// @brief 获取下一个Token
+/// @param lexer 词法分析的状态
+/// @return int Token的类别
+int stdio_flex(StdioLexer & lexer)
+{
+    int c;
+    int tokenKind = -1;
+
+    // 忽略空白符号，\r\n、\r与\n都算作换行
+    while ((c = fgetc(lexer.fp)) == ' ' || c == '\t' || c == '\n' || c == '\r') {
+
+        if (c == '\r') {
+            c = fgetc(lexer.fp);
+            lexer.lineno++;
+            if (c != '\n') {
+                ungetc(c, lexer.fp);
+            }
+        } else if (c == '\n') {
+            lexer.lineno++;
+        }
+    }
+
+    if (c == EOF) {
+        return RDTokenType::T_EOF;
+    }
+
+    if (isdigit(c)) {
+
+        lexer.integerValue = (uint32_t) (c - '0');
+
+        // 最长匹配，直到非数字结束
+        while (isdigit(c = fgetc(lexer.fp))) {
+            lexer.integerValue = lexer.integerValue * 10 + (uint32_t) (c - '0');
+        }
+
+        lexer.tokenValue = std::to_string(lexer.integerValue);
+
+        // 多读的字符回退
+        ungetc(c, lexer.fp);
+
+        tokenKind = RDTokenType::T_DIGIT;
+    } else if (c == '(') {
+        tokenKind = RDTokenType::T_L_PAREN;
+        lexer.tokenValue = "(";
+    } else if (c == ')') {
+        tokenKind = RDTokenType::T_R_PAREN;
+        lexer.tokenValue = ")";
+    } else if (c == '{') {
+        tokenKind = RDTokenType::T_L_BRACE;
+        lexer.tokenValue = "{";
+    } else if (c == '}') {
+        tokenKind = RDTokenType::T_R_BRACE;
+        lexer.tokenValue = "}";
+    } else if (c == ';') {
+        tokenKind = RDTokenType::T_SEMICOLON;
+        lexer.tokenValue = ";";
+    } else if (isLetterUnderLine((char) c)) {
+
+        // 最长匹配标识符
+        std::string name;
+
+        do {
+            name.push_back((char) c);
+            c = fgetc(lexer.fp);
+        } while (isLetterDigitalUnderLine((char) c));
+
+        lexer.tokenValue = name;
+
+        ungetc(c, lexer.fp);
+
+        tokenKind = getKeywordToken(name);
+        if (tokenKind == RDTokenType::T_ID) {
+            lexer.id = strdup(name.c_str());
+        }
+    } else {
+        tokenKind = RDTokenType::T_ERR;
+    }
+
+    return tokenKind;
+}
@@ -0,0 +1,51 @@
+///
+/// @file StdioLexer.h
+/// @brief 按fgetc/ungetc逐字符读入的词法分析，仅作为性能测试的对照
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+/// 递归下降前端改为按内存映射扫描之前的实现，保留原有的逐字符读入、Token值的字符串构造以及
+/// 标识符的strdup，只把全局变量收进StdioLexer中，以便与rd_flex、rd_flex_dfa比较吞吐率。
+///
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+///
+/// @brief 对照用词法分析的状态
+///
+struct StdioLexer {
+
+    /// @brief 输入源文件指针
+    FILE * fp = nullptr;
+
+    /// @brief 行号
+    int64_t lineno = 1;
+
+    /// @brief Token对应的字符串
+    std::string tokenValue;
+
+    /// @brief 无符号整数的值
+    uint32_t integerValue = 0;
+
+    /// @brief 标识符的名字，由strdup申请，调用者释放
+    char * id = nullptr;
+};
+
+///
+/// @brief 获取下一个Token
+/// @param lexer 词法分析的状态
+/// @return int Token的类别，同RDTokenType
+///
+int stdio_flex(StdioLexer & lexer);
@@ -16,20 +16,31 @@
 #include <cstdarg>
 #include <cstdint>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "AST.h"
 #include "AttrType.h"
 #include "Types/IntegerType.h"
 #include "Types/VoidType.h"
 
-/* 整个AST的根节点 */
-ast_node * ast_root = nullptr;
+///
+/// @brief 获取当前线程创建AST节点所用的内存池
+/// @return Arena& 内存池
+///
+Arena & ast_arena()
+{
+    // 每个线程一个，多个编译可在不同线程中同时进行
+    static thread_local Arena arena;
+
+    return arena;
+}
 
 /// @brief 创建指定节点类型的节点
 /// @param _node_type 节点类型
 /// @param _line_no 行号
 ast_node::ast_node(ast_operator_type _node_type, Type * _type, int64_t _line_no)
-    : node_type(_node_type), line_no(-1), type(_type)
+    : node_type(_node_type), line_no(-1), type(_type), sons(ArenaAllocator<ast_node *>(ast_arena()))
 {}
 
 /// @brief 构造函数
@@ -54,9 +65,9 @@ ast_node::ast_node(var_id_attr attr) : ast_node(ast_operator_type::AST_OP_LEAF_V
 }
 
 /// @brief 针对标识符ID的叶子构造函数
-/// @param _id 标识符ID
+/// @param _id 标识符ID在字符串池中的编号
 /// @param _line_no 行号
-ast_node::ast_node(std::string _id, int64_t _line_no)
+ast_node::ast_node(Symbol _id, int64_t _line_no)
     : ast_node(ast_operator_type::AST_OP_LEAF_VAR_ID, VoidType::getType(), _line_no)
 {
     name = _id;
@@ -91,7 +102,7 @@ bool ast_node::isLeafNode()
 /// @return 创建的节点
 ast_node * ast_node::New(ast_operator_type type, ...)
 {
-    ast_node * parent_node = new ast_node(type);
+    ast_node * parent_node = ast_arena().create<ast_node>(type);
 
     va_list valist;
 
@@ -135,7 +146,7 @@ ast_node * ast_node::insert_son_node(ast_node * node)
 /// @param attr 无符号整数字面量
 ast_node * ast_node::New(digit_int_attr attr)
 {
-    ast_node * node = new ast_node(attr);
+    ast_node * node = ast_arena().create<ast_node>(attr);
 
     return node;
 }
@@ -144,17 +155,17 @@ ast_node * ast_node::New(digit_int_attr attr)
 /// @param attr 字符型字面量
 ast_node * ast_node::New(var_id_attr attr)
 {
-    ast_node * node = new ast_node(attr);
+    ast_node * node = ast_arena().create<ast_node>(attr);
 
     return node;
 }
 
 /// @brief 创建标识符的叶子节点
-/// @param id 词法值
+/// @param id 标识符在字符串池中的编号
 /// @param line_no 行号
-ast_node * ast_node::New(std::string id, int64_t lineno)
+ast_node * ast_node::New(Symbol id, int64_t lineno)
 {
-    ast_node * node = new ast_node(id, lineno);
+    ast_node * node = ast_arena().create<ast_node>(id, lineno);
 
     return node;
 }
@@ -165,35 +176,60 @@ ast_node * ast_node::New(std::string id, int64_t lineno)
 /// @return 创建的节点
 ast_node * ast_node::New(Type * type)
 {
-    ast_node * node = new ast_node(type);
+    ast_node * node = ast_arena().create<ast_node>(type);
 
     return node;
 }
 
-/// @brief 递归清理抽象语法树
-/// @param node AST的节点
-void ast_node::Delete(ast_node * node)
+///
+/// @brief AST资源清理。所有节点都在AST内存池中，整体复位即可，不需要递归遍历逐个释放
+/// @param root 抽象语法树的根节点
+///
+void free_ast(ast_node * root)
 {
-    if (node) {
-
-        for (auto child: node->sons) {
-            ast_node::Delete(child);
-        }
-
-        // 这里没有必要清理孩子，由于下面就要删除该节点
-        // node->sons.clear();
-    }
+    (void) root;
 
-    // 清理node资源
-    delete node;
+    ast_arena().reset();
 }
 
 ///
-/// @brief AST资源清理
+/// @brief 把抽象语法树按先序遍历输出为文本，每个节点一行，缩进表示层次
+/// @param root 抽象语法树的根节点
+/// @param out 输出的文本，追加到其后
 ///
-void free_ast(ast_node * root)
+void dump_ast(ast_node * root, std::string & out)
 {
-    ast_node::Delete(root);
+    // 显式栈代替递归，第二个元素为节点的深度
+    std::vector<std::pair<ast_node *, int>> stack;
+    stack.emplace_back(root, 0);
+
+    while (!stack.empty()) {
+
+        auto [node, depth] = stack.back();
+        stack.pop_back();
+
+        out.append((std::size_t) depth * 2, ' ');
+
+        if (node == nullptr) {
+            out += "null\n";
+            continue;
+        }
+
+        out += std::to_string((int) node->node_type);
+        out += " line=" + std::to_string(node->line_no);
+        if (node->node_type == ast_operator_type::AST_OP_LEAF_LITERAL_UINT) {
+            out += " val=" + std::to_string(node->integer_val);
+        }
+        out += " name=";
+        out += symbolName(node->name);
+        out += " type=" + (node->type ? node->type->toString() : std::string("null"));
+        out += '\n';
+
+        // 逆序入栈，保证孩子按从左到右的次序输出
+        for (auto it = node->sons.rbegin(); it != node->sons.rend(); ++it) {
+            stack.emplace_back(*it, depth + 1);
+        }
+    }
 }
 
 /// @brief 创建函数定义类型的内部AST节点
@@ -204,19 +240,20 @@ void free_ast(ast_node * root)
 /// @return 创建的节点
 ast_node * create_func_def(ast_node * type_node, ast_node * name_node, ast_node * block_node, ast_node * params_node)
 {
-    ast_node * node = new ast_node(ast_operator_type::AST_OP_FUNC_DEF, type_node->type, name_node->line_no);
+    ast_node * node =
+        ast_arena().create<ast_node>(ast_operator_type::AST_OP_FUNC_DEF, type_node->type, name_node->line_no);
 
     // 设置函数名
     node->name = name_node->name;
 
     // 如果没有参数，则创建参数节点
     if (!params_node) {
-        params_node = new ast_node(ast_operator_type::AST_OP_FUNC_FORMAL_PARAMS);
+        params_node = ast_arena().create<ast_node>(ast_operator_type::AST_OP_FUNC_FORMAL_PARAMS);
     }
 
     // 如果没有函数体，则创建函数体，也就是语句块
     if (!block_node) {
-        block_node = new ast_node(ast_operator_type::AST_OP_BLOCK);
+        block_node = ast_arena().create<ast_node>(ast_operator_type::AST_OP_BLOCK);
     }
 
     (void) node->insert_son_node(type_node);
@@ -241,10 +278,6 @@ ast_node * create_func_def(type_attr & type, var_id_attr & id, ast_node * block_
     // 创建标识符终结符节点
     ast_node * id_node = ast_node::New(id.id, id.lineno);
 
-    // 对于字符型字面量的字符串空间需要释放，因词法用到了strdup进行了字符串复制
-    free(id.id);
-    id.id = nullptr;
-
     return create_func_def(type_node, id_node, block_node, params_node);
 }
 
@@ -259,7 +292,7 @@ ast_node * create_contain_node(ast_operator_type node_type,
                                ast_node * second_child,
                                ast_node * third_child)
 {
-    ast_node * node = new ast_node(node_type);
+    ast_node * node = ast_arena().create<ast_node>(node_type);
 
     if (first_child) {
         (void) node->insert_son_node(first_child);
@@ -20,6 +20,7 @@
 #include <string>
 #include <vector>
 
+#include "Arena.h"
 #include "AttrType.h"
 #include "IRCode.h"
 #include "Value.h"
@@ -70,9 +71,18 @@ enum class ast_operator_type : int {
     AST_OP_MAX,
 };
 
+class ast_node;
+
+///
+/// @brief AST节点的孩子列表，空间从AST内存池中分配，随内存池整体释放
+///
+using ast_node_list = std::vector<ast_node *, ArenaAllocator<ast_node *>>;
+
 ///
 /// @brief 抽象语法树AST的节点描述类
 ///
+/// 所有节点都从AST内存池中创建，不能单独delete，通过free_ast整体释放
+///
 class ast_node {
 public:
     /// @brief 节点类型
@@ -90,14 +100,14 @@ public:
     /// @brief float类型字面量值
     float float_val;
 
-    /// @brief 变量名，或者函数名
-    std::string name;
+    /// @brief 变量名，或者函数名，为字符串池中的编号
+    Symbol name = emptySymbol;
 
     /// @brief 父节点
     ast_node * parent = nullptr;
 
     /// @brief 孩子节点
-    std::vector<ast_node *> sons;
+    ast_node_list sons;
 
     /// @brief 线性IR指令块，可包含多条IR指令，用于线性IR指令产生用
     InterCode blockInsts;
@@ -127,9 +137,9 @@ public:
     ast_node(var_id_attr attr);
 
     /// @brief 针对标识符ID的叶子构造函数
-    /// @param _id 标识符ID
+    /// @param _id 标识符ID在字符串池中的编号
     /// @param _line_no 行号
-    ast_node(std::string id, int64_t _line_no);
+    ast_node(Symbol _id, int64_t _line_no);
 
     /// @brief 判断是否是叶子节点
     /// @param type 节点类型
@@ -158,28 +168,31 @@ public:
     static ast_node * New(var_id_attr attr);
 
     /// @brief 创建标识符的叶子节点
-    /// @param id 词法值
+    /// @param id 标识符在字符串池中的编号
     /// @param line_no 行号
-    static ast_node * New(std::string id, int64_t lineno);
+    static ast_node * New(Symbol id, int64_t lineno);
 
     /// @brief 创建具备指定类型的节点
     /// @param type 节点值类型
     /// @param line_no 行号
     /// @return 创建的节点
     static ast_node * New(Type * type);
-
-    ///
-    /// @brief 释放节点
-    /// @param node
-    ///
-    static void Delete(ast_node * node);
 };
 
-/// @brief AST资源清理
+///
+/// @brief 获取当前线程创建AST节点所用的内存池。每次编译的AST都在其中创建，由free_ast整体复位
+/// @return Arena& 内存池
+///
+Arena & ast_arena();
+
+/// @brief AST资源清理，整体复位AST内存池，root及其所有子孙节点都会失效
+/// @param root 抽象语法树的根节点
 void free_ast(ast_node * root);
 
-/// @brief抽象语法树的根节点指针
-extern ast_node * ast_root;
+/// @brief 把抽象语法树按先序遍历输出为文本，包含节点类型、行号、值、名字以及类型，可用于比较两棵AST是否相同
+/// @param root 抽象语法树的根节点
+/// @param out 输出的文本，追加到其后
+void dump_ast(ast_node * root, std::string & out);
 
 /// @brief 创建AST的内部节点，请注意可追加孩子节点，请按次序依次加入，最多3个
 /// @param node_type 节点类型
@@ -39,7 +39,7 @@ string getNodeName(ast_node * astnode)
             nodeName = to_string(astnode->float_val);
             break;
         case ast_operator_type::AST_OP_LEAF_VAR_ID:
-            nodeName = astnode->name;
+            nodeName = std::string(symbolName(astnode->name));
             break;
         case ast_operator_type::AST_OP_LEAF_TYPE:
             nodeName = astnode->type->toString();
@@ -121,7 +121,7 @@ Agnode_t * genInternalGraphNode(Agraph_t * g, ast_node * astnode)
 
     // 遍历AST内部结点的孩子，获取创建孩子的图形结点，递归
     // 这里用到了C++向量的容器遍历方法之一，从头开始到尾部
-    std::vector<ast_node *>::iterator pIter;
+    ast_node_list::iterator pIter;
     for (pIter = astnode->sons.begin(); pIter != astnode->sons.end(); ++pIter) {
 
         Agnode_t * son_node = graph_visit_ast_node(g, *pIter);
@@ -61,7 +61,7 @@ std::any MiniCCSTVisitor::visitFuncDef(MiniCParser::FuncDefContext * ctx)
     type_attr funcReturnType{BasicType::TYPE_INT, (int64_t) ctx->T_INT()->getSymbol()->getLine()};
 
     // 创建函数名的标识符终结符节点，终结符
-    char * id = strdup(ctx->T_ID()->getText().c_str());
+    Symbol id = internSymbol(ctx->T_ID()->getText());
 
     var_id_attr funcId{id, (int64_t) ctx->T_ID()->getSymbol()->getLine()};
 
@@ -72,7 +72,7 @@ std::any MiniCCSTVisitor::visitFuncDef(MiniCParser::FuncDefContext * ctx)
     auto blockNode = std::any_cast<ast_node *>(visitBlock(ctx->block()));
 
     // 创建函数定义的节点，孩子有类型，函数名，语句块和形参(实际上无)
-    // create_func_def函数内会释放funcId中指向的标识符空间，切记，之后不要再释放，之前一定要是通过strdup函数或者malloc分配的空间
+    // 函数名已驻留在字符串池中，funcId中只是其编号，不需要释放
     return create_func_def(funcReturnType, funcId, blockNode, formalParamsNode);
 }
 
@@ -21,6 +21,23 @@
 #include "MiniCLexer.h"
 #include "Common.h"
 
+///
+/// @brief Antlr4的错误监听器，把词法与语法错误经由minic_log_common输出，编译服务时可收集返回给客户端
+///
+class MiniCErrorListener : public antlr4::BaseErrorListener {
+public:
+    void syntaxError(antlr4::Recognizer * recognizer,
+                     antlr4::Token * offendingSymbol,
+                     size_t line,
+                     size_t charPositionInLine,
+                     const std::string & msg,
+                     std::exception_ptr e) override
+    {
+        std::string str = "line " + std::to_string(line) + ":" + std::to_string(charPositionInLine) + " " + msg;
+        minic_log_common(LOG_ERROR, str.c_str());
+    }
+};
+
 /// @brief 前端词法与语法解析生成AST
 /// @return true: 成功 false：错误
 bool Antlr4Executor::run()
@@ -35,14 +52,21 @@ bool Antlr4Executor::run()
     // antlr4的输入流类实例
     antlr4::ANTLRInputStream input{ifs};
 
+    // 默认的错误监听器直接输出到标准错误，这里替换为自定义的监听器
+    MiniCErrorListener errorListener;
+
     // 词法分析器实例
     MiniCLexer lexer{&input};
+    lexer.removeErrorListeners();
+    lexer.addErrorListener(&errorListener);
 
     // 词法分析器实例转化成记号(Token)流
     antlr4::CommonTokenStream tokenStream{&lexer};
 
     // 利用antlr4进行分析，从compileUnit开始分析输入字符串
     MiniCParser parser{&tokenStream};
+    parser.removeErrorListeners();
+    parser.addErrorListener(&errorListener);
 
     // 从具体语法树的根结点进行深度优先遍历，生成抽象语法树
     auto cstRoot = parser.compileUnit();
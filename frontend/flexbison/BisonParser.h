@@ -17,19 +17,5 @@
 
 #include "AttrType.h"
 
-/// @brief yyparse的类型声明
-#ifdef YYPARSE_PARAM
-#if defined __STDC__ || defined __cplusplus
-int yyparse(void * YYPARSE_PARAM);
-#else
-int yyparse();
-#endif
-#else /* ! YYPARSE_PARAM */
-#if defined __STDC__ || defined __cplusplus
-int yyparse(void);
-#else
-int yyparse();
-#endif
-#endif /* ! YYPARSE_PARAM */
-
+// yyparse的类型声明在bison产生的头文件中，为纯分析器，词法分析器实例作为参数
 #include "MiniCBison.h"
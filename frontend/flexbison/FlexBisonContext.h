@@ -0,0 +1,54 @@
+///
+/// @file FlexBisonContext.h
+/// @brief Flex+Bison一次分析的上下文，代替原来的全局变量，使多个线程可同时分析不同的文件
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "AST.h"
+#include "Common.h"
+
+// 可重入的词法分析器实例的类型，与flex产生的头文件中的定义一致
+#ifndef YY_TYPEDEF_YY_SCANNER_T
+#define YY_TYPEDEF_YY_SCANNER_T
+typedef void * yyscan_t;
+#endif
+
+///
+/// @brief 分析上下文，作为flex扫描器的附加数据(yyextra)，语法分析的动作中通过yyget_extra获取
+///
+struct FlexBisonContext {
+
+    /// @brief 词法分析器实例
+    yyscan_t scanner = nullptr;
+
+    /// @brief 抽象语法树的根，编译单元归约时设置
+    ast_node * astRoot = nullptr;
+
+    /// @brief 诊断信息，每条为一行
+    std::vector<std::string> diagnostics;
+
+    ///
+    /// @brief 记录一个词法或语法错误，同时输出
+    /// @param lineno 行号
+    /// @param msg 错误信息
+    ///
+    void error(int lineno, const std::string & msg)
+    {
+        diagnostics.push_back("Line " + std::to_string(lineno) + ": " + msg);
+        minic_log_common(LOG_ERROR, diagnostics.back().c_str());
+    }
+};
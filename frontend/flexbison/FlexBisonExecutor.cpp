@@ -16,39 +16,48 @@
 #include "FlexBisonExecutor.h"
 #include "BisonParser.h"
 #include "FlexLexer.h"
+#include "Common.h"
 
 /// @brief 前端词法与语法解析生成AST
 /// @return true: 成功 false：错误
 bool FlexBisonExecutor::run()
 {
     // 若指定有参数，则作为词法分析的输入文件
-    yyin = fopen(filename.c_str(), "r");
-    if (yyin == nullptr) {
-        printf("Can't open file %s\n", filename.c_str());
+    FILE * fp = fopen(filename.c_str(), "r");
+    if (fp == nullptr) {
+        minic_log_common(LOG_ERROR, ("Can't open file " + filename).c_str());
         return false;
     }
 
+    // 每次分析创建独立的词法分析器实例，分析状态都在实例与上下文中，不同线程可同时分析
+    if (0 != yylex_init_extra(&context, &context.scanner)) {
+        minic_log_common(LOG_ERROR, "yylex_init_extra failed");
+        fclose(fp);
+        return false;
+    }
+
+    yyset_in(fp, context.scanner);
+
     // 如果要查看LALR的移进与归约过程，请设置yydebug为1
 #ifdef BISON_DEBUG_ENABLE
     yydebug = 1;
 #endif
 
     // 词法、语法分析生成抽象语法树AST
-    bool result = yyparse();
-    if (0 != result) {
-        printf("yyparse failed\n");
+    int result = yyparse(context.scanner);
 
-        // 关闭文件
-        fclose(yyin);
+    // 释放词法分析器实例，关闭文件
+    yylex_destroy(context.scanner);
+    context.scanner = nullptr;
+    fclose(fp);
 
+    if (0 != result) {
+        minic_log_common(LOG_ERROR, "yyparse failed");
         return false;
     }
 
     // 设置抽象语法树的根节点
-    astRoot = ast_root;
-
-    // 关闭文件
-    fclose(yyin);
+    astRoot = context.astRoot;
 
     return true;
-}
\ No newline at end of file
+}
@@ -14,6 +14,7 @@
 /// </table>
 ///
 #include "FrontEndExecutor.h"
+#include "FlexBisonContext.h"
 
 class FlexBisonExecutor : public FrontEndExecutor {
 public:
@@ -25,4 +26,15 @@ public:
     /// @brief 前端词法与语法解析生成AST
     /// @return true: 成功 false：错误
     bool run() override;
+
+    /// @brief 获取分析上下文，可查看收集到的诊断信息
+    /// @return 分析上下文
+    const FlexBisonContext & getContext() const
+    {
+        return context;
+    }
+
+protected:
+    /// @brief 本次分析的上下文，作为词法分析器实例的附加数据
+    FlexBisonContext context;
 };
@@ -10,4 +10,8 @@
  */
 #pragma once
 
+// 可重入的词法分析器接口中用到了YYSTYPE与分析上下文，需先包含
+#include "BisonParser.h"
+#include "FlexBisonContext.h"
+
 #include "MiniCFlex.h"
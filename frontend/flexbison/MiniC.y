@@ -2,22 +2,36 @@
 #include <cstdio>
 #include <cstring>
 
-// 词法分析头文件
-#include "FlexLexer.h"
-
 // bison生成的头文件
 #include "BisonParser.h"
 
+// 词法分析头文件
+#include "FlexLexer.h"
+
 // 抽象语法树函数定义原型头文件
 #include "AST.h"
 
 #include "IntegerType.h"
 
 // LR分析失败时所调用函数的原型声明
-void yyerror(char * msg);
+void yyerror(yyscan_t scanner, const char * msg);
 
 %}
 
+// 头文件中需要词法分析器实例的类型
+%code requires {
+#ifndef YY_TYPEDEF_YY_SCANNER_T
+#define YY_TYPEDEF_YY_SCANNER_T
+typedef void * yyscan_t;
+#endif
+}
+
+// 纯分析器，不使用全局变量，多个线程可同时分析
+%define api.pure full
+
+// 词法分析器实例作为yyparse与yylex的参数，分析上下文通过yyget_extra获取
+%param {yyscan_t scanner}
+
 // 联合体声明，用于后续终结符和非终结符号属性指定使用
 %union {
 	class ast_node * node;
@@ -64,8 +78,8 @@ CompileUnit : FuncDef {
 		// 创建一个编译单元的节点AST_OP_COMPILE_UNIT
 		$$ = create_contain_node(ast_operator_type::AST_OP_COMPILE_UNIT, $1);
 
-		// 设置到全局变量中
-		ast_root = $$;
+		// 设置到分析上下文中
+		yyget_extra(scanner)->astRoot = $$;
 	}
 	;
 
@@ -85,7 +99,7 @@ FuncDef : T_INT T_ID T_L_PAREN T_R_PAREN Block  {
 		ast_node * formalParamsNode = nullptr;
 
 		// 创建函数定义的节点，孩子有类型，函数名，语句块和形参(实际上无)
-		// create_func_def函数内会释放funcId中指向的标识符空间，切记，之后不要再释放，之前一定要是通过strdup函数或者malloc分配的空间
+		// 函数名已驻留在字符串池中，funcId中只是其编号，不需要释放
 		$$ = create_func_def(funcReturnType, funcId, blockNode, formalParamsNode);
 	}
 	;
@@ -153,7 +167,7 @@ Expr : T_DIGIT {
 %%
 
 // 语法识别错误要调用函数的定义
-void yyerror(char * msg)
+void yyerror(yyscan_t scanner, const char * msg)
 {
-    printf("Line %d: %s\n", yylineno, msg);
+    yyget_extra(scanner)->error(yyget_lineno(scanner), msg);
 }
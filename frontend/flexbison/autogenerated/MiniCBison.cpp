@@ -55,7 +55,7 @@
 #define YYSKELETON_NAME "yacc.c"
 
 /* Pure parsers.  */
-#define YYPURE 0
+#define YYPURE 2
 
 /* Push parsers.  */
 #define YYPUSH 0
@@ -72,19 +72,19 @@
 #include <cstdio>
 #include <cstring>
 
-// 词法分析头文件
-#include "FlexLexer.h"
-
 // bison生成的头文件
 #include "BisonParser.h"
 
+// 词法分析头文件
+#include "FlexLexer.h"
+
 // 抽象语法树函数定义原型头文件
 #include "AST.h"
 
 #include "IntegerType.h"
 
 // LR分析失败时所调用函数的原型声明
-void yyerror(char * msg);
+void yyerror(yyscan_t scanner, const char * msg);
 
 
 #line 91 "/home/code/exp03-minic-basic/frontend/flexbison/autogenerated/MiniCBison.cpp"
@@ -521,8 +521,8 @@ static const yytype_int8 yytranslate[] =
 /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
 static const yytype_uint8 yyrline[] =
 {
-       0,    62,    62,    73,    96,   102,   113,   118,   127,   135,
-     144
+       0,    76,    76,    87,   110,   116,   127,   132,   141,   149,
+     158
 };
 #endif
 
@@ -653,7 +653,7 @@ enum { YYENOMEM = -2 };
       }                                                           \
     else                                                          \
       {                                                           \
-        yyerror (YY_("syntax error: cannot back up")); \
+        yyerror (scanner, YY_("syntax error: cannot back up")); \
         YYERROR;                                                  \
       }                                                           \
   while (0)
@@ -686,7 +686,7 @@ do {                                                                      \
     {                                                                     \
       YYFPRINTF (stderr, "%s ", Title);                                   \
       yy_symbol_print (stderr,                                            \
-                  Kind, Value); \
+                  Kind, Value, scanner); \
       YYFPRINTF (stderr, "\n");                                           \
     }                                                                     \
 } while (0)
@@ -698,10 +698,11 @@ do {                                                                      \
 
 static void
 yy_symbol_value_print (FILE *yyo,
-                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep)
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, yyscan_t scanner)
 {
   FILE *yyoutput = yyo;
   YY_USE (yyoutput);
+  YY_USE (scanner);
   if (!yyvaluep)
     return;
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
@@ -716,12 +717,12 @@ yy_symbol_value_print (FILE *yyo,
 
 static void
 yy_symbol_print (FILE *yyo,
-                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep)
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, yyscan_t scanner)
 {
   YYFPRINTF (yyo, "%s %s (",
              yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  yy_symbol_value_print (yyo, yykind, yyvaluep);
+  yy_symbol_value_print (yyo, yykind, yyvaluep, scanner);
   YYFPRINTF (yyo, ")");
 }
 
@@ -755,7 +756,7 @@ do {                                                            \
 
 static void
 yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
-                 int yyrule)
+                 int yyrule, yyscan_t scanner)
 {
   int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
@@ -768,7 +769,7 @@ yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
       YYFPRINTF (stderr, "   $%d = ", yyi + 1);
       yy_symbol_print (stderr,
                        YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
-                       &yyvsp[(yyi + 1) - (yynrhs)]);
+                       &yyvsp[(yyi + 1) - (yynrhs)], scanner);
       YYFPRINTF (stderr, "\n");
     }
 }
@@ -776,7 +777,7 @@ yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
 # define YY_REDUCE_PRINT(Rule)          \
 do {                                    \
   if (yydebug)                          \
-    yy_reduce_print (yyssp, yyvsp, Rule); \
+    yy_reduce_print (yyssp, yyvsp, Rule, scanner); \
 } while (0)
 
 /* Nonzero means print parse trace.  It is left uninitialized so that
@@ -817,9 +818,10 @@ int yydebug;
 
 static void
 yydestruct (const char *yymsg,
-            yysymbol_kind_t yykind, YYSTYPE *yyvaluep)
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, yyscan_t scanner)
 {
   YY_USE (yyvaluep);
+  YY_USE (scanner);
   if (!yymsg)
     yymsg = "Deleting";
   YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
@@ -830,13 +832,6 @@ yydestruct (const char *yymsg,
 }
 
 
-/* Lookahead token kind.  */
-int yychar;
-
-/* The semantic value of the lookahead symbol.  */
-YYSTYPE yylval;
-/* Number of syntax errors so far.  */
-int yynerrs;
 
 
 
@@ -846,8 +841,21 @@ int yynerrs;
 `----------*/
 
 int
-yyparse (void)
+yyparse (yyscan_t scanner)
 {
+/* Lookahead token kind.  */
+int yychar;
+
+
+/* The semantic value of the lookahead symbol.  */
+/* Default value used for initialization, for pacifying older GCCs
+   or non-GCC compilers.  */
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
+
+    /* Number of syntax errors so far.  */
+    int yynerrs = 0;
+
     yy_state_fast_t yystate = 0;
     /* Number of tokens to shift before error messages enabled.  */
     int yyerrstatus = 0;
@@ -1000,7 +1008,7 @@ yybackup:
   if (yychar == YYEMPTY)
     {
       YYDPRINTF ((stderr, "Reading a token\n"));
-      yychar = yylex ();
+      yychar = yylex (&yylval, scanner);
     }
 
   if (yychar <= YYEOF)
@@ -1088,20 +1096,20 @@ yyreduce:
   switch (yyn)
     {
   case 2: /* CompileUnit: FuncDef  */
-#line 62 "/home/code/exp03-minic-basic/frontend/flexbison/MiniC.y"
+#line 76 "/home/code/exp03-minic-basic/frontend/flexbison/MiniC.y"
                       {
 
 		// 创建一个编译单元的节点AST_OP_COMPILE_UNIT
 		(yyval.node) = create_contain_node(ast_operator_type::AST_OP_COMPILE_UNIT, (yyvsp[0].node));
 
-		// 设置到全局变量中
-		ast_root = (yyval.node);
+		// 设置到分析上下文中
+		yyget_extra(scanner)->astRoot = (yyval.node);
 	}
-#line 1101 "/home/code/exp03-minic-basic/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1109 "/home/code/exp03-minic-basic/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 3: /* FuncDef: T_INT T_ID T_L_PAREN T_R_PAREN Block  */
-#line 73 "/home/code/exp03-minic-basic/frontend/flexbison/MiniC.y"
+#line 87 "/home/code/exp03-minic-basic/frontend/flexbison/MiniC.y"
                                                 {
 
 		// 函数返回类型
@@ -1117,86 +1125,86 @@ yyreduce:
 		ast_node * formalParamsNode = nullptr;
 
 		// 创建函数定义的节点，孩子有类型，函数名，语句块和形参(实际上无)
-		// create_func_def函数内会释放funcId中指向的标识符空间，切记，之后不要再释放，之前一定要是通过strdup函数或者malloc分配的空间
+		// 函数名已驻留在字符串池中，funcId中只是其编号，不需要释放
 		(yyval.node) = create_func_def(funcReturnType, funcId, blockNode, formalParamsNode);
 	}
-#line 1124 "/home/code/exp03-minic-basic/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1132 "/home/code/exp03-minic-basic/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 4: /* Block: T_L_BRACE T_R_BRACE  */
-#line 96 "/home/code/exp03-minic-basic/frontend/flexbison/MiniC.y"
+#line 110 "/home/code/exp03-minic-basic/frontend/flexbison/MiniC.y"
                             {
 		// 语句块没有语句
 
 		// 为了方便创建一个空的Block节点
 		(yyval.node) = create_contain_node(ast_operator_type::AST_OP_BLOCK);
 	}
-#line 1135 "/home/code/exp03-minic-basic/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1143 "/home/code/exp03-minic-basic/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 5: /* Block: T_L_BRACE BlockItemList T_R_BRACE  */
-#line 102 "/home/code/exp03-minic-basic/frontend/flexbison/MiniC.y"
+#line 116 "/home/code/exp03-minic-basic/frontend/flexbison/MiniC.y"
                                             {
 		// 语句块含有语句
 
 		// BlockItemList归约时内部创建Block节点，并把语句加入，这里不创建Block节点
 		(yyval.node) = (yyvsp[-1].node);
 	}
-#line 1146 "/home/code/exp03-minic-basic/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1154 "/home/code/exp03-minic-basic/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 6: /* BlockItemList: BlockItem  */
-#line 113 "/home/code/exp03-minic-basic/frontend/flexbison/MiniC.y"
+#line 127 "/home/code/exp03-minic-basic/frontend/flexbison/MiniC.y"
                           {
 		// 第一个左侧的孩子节点归约成Block节点，后续语句可持续作为孩子追加到Block节点中
 		// 创建一个AST_OP_BLOCK类型的中间节点，孩子为Statement($1)
 		(yyval.node) = create_contain_node(ast_operator_type::AST_OP_BLOCK, (yyvsp[0].node));
 	}
-#line 1156 "/home/code/exp03-minic-basic/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1164 "/home/code/exp03-minic-basic/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 7: /* BlockItemList: BlockItemList BlockItem  */
-#line 118 "/home/code/exp03-minic-basic/frontend/flexbison/MiniC.y"
+#line 132 "/home/code/exp03-minic-basic/frontend/flexbison/MiniC.y"
                                   {
 		// 把BlockItem归约的节点加入到BlockItemList的节点中
 		(yyval.node) = (yyvsp[-1].node)->insert_son_node((yyvsp[0].node));
 	}
-#line 1165 "/home/code/exp03-minic-basic/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1173 "/home/code/exp03-minic-basic/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 8: /* BlockItem: Statement  */
-#line 127 "/home/code/exp03-minic-basic/frontend/flexbison/MiniC.y"
+#line 141 "/home/code/exp03-minic-basic/frontend/flexbison/MiniC.y"
                        {
 		// 语句节点传递给归约后的节点上，综合属性
 		(yyval.node) = (yyvsp[0].node);
 	}
-#line 1174 "/home/code/exp03-minic-basic/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1182 "/home/code/exp03-minic-basic/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 9: /* Statement: T_RETURN Expr T_SEMICOLON  */
-#line 135 "/home/code/exp03-minic-basic/frontend/flexbison/MiniC.y"
+#line 149 "/home/code/exp03-minic-basic/frontend/flexbison/MiniC.y"
                                       {
 		// 返回语句
 
 		// 创建返回节点AST_OP_RETURN，其孩子为Expr，即$2
 		(yyval.node) = create_contain_node(ast_operator_type::AST_OP_RETURN, (yyvsp[-1].node));
 	}
-#line 1185 "/home/code/exp03-minic-basic/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1193 "/home/code/exp03-minic-basic/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 10: /* Expr: T_DIGIT  */
-#line 144 "/home/code/exp03-minic-basic/frontend/flexbison/MiniC.y"
+#line 158 "/home/code/exp03-minic-basic/frontend/flexbison/MiniC.y"
                {
 		// 无符号整型字面量
 
 		// 创建一个无符号整型的终结符节点
 		(yyval.node) = ast_node::New((yyvsp[0].integer_num));
 	}
-#line 1196 "/home/code/exp03-minic-basic/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1204 "/home/code/exp03-minic-basic/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
 
-#line 1200 "/home/code/exp03-minic-basic/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1208 "/home/code/exp03-minic-basic/frontend/flexbison/autogenerated/MiniCBison.cpp"
 
       default: break;
     }
@@ -1243,7 +1251,7 @@ yyerrlab:
   if (!yyerrstatus)
     {
       ++yynerrs;
-      yyerror (YY_("syntax error"));
+      yyerror (scanner, YY_("syntax error"));
     }
 
   if (yyerrstatus == 3)
@@ -1260,7 +1268,7 @@ yyerrlab:
       else
         {
           yydestruct ("Error: discarding",
-                      yytoken, &yylval);
+                      yytoken, &yylval, scanner);
           yychar = YYEMPTY;
         }
     }
@@ -1316,7 +1324,7 @@ yyerrlab1:
 
 
       yydestruct ("Error: popping",
-                  YY_ACCESSING_SYMBOL (yystate), yyvsp);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, scanner);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
@@ -1354,7 +1362,7 @@ yyabortlab:
 | yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
 `-----------------------------------------------------------*/
 yyexhaustedlab:
-  yyerror (YY_("memory exhausted"));
+  yyerror (scanner, YY_("memory exhausted"));
   yyresult = 2;
   goto yyreturnlab;
 
@@ -1369,7 +1377,7 @@ yyreturnlab:
          user semantic actions for why this is necessary.  */
       yytoken = YYTRANSLATE (yychar);
       yydestruct ("Cleanup: discarding lookahead",
-                  yytoken, &yylval);
+                  yytoken, &yylval, scanner);
     }
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYABORT or YYACCEPT.  */
@@ -1378,7 +1386,7 @@ yyreturnlab:
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, scanner);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
@@ -1389,11 +1397,11 @@ yyreturnlab:
   return yyresult;
 }
 
-#line 153 "/home/code/exp03-minic-basic/frontend/flexbison/MiniC.y"
+#line 167 "/home/code/exp03-minic-basic/frontend/flexbison/MiniC.y"
 
 
 // 语法识别错误要调用函数的定义
-void yyerror(char * msg)
+void yyerror(yyscan_t scanner, const char * msg)
 {
-    printf("Line %d: %s\n", yylineno, msg);
+    yyget_extra(scanner)->error(yyget_lineno(scanner), msg);
 }
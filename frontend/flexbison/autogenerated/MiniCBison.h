@@ -44,6 +44,15 @@
 #if YYDEBUG
 extern int yydebug;
 #endif
+/* "%code requires" blocks.  */
+#line 22 "/home/code/exp03-minic-basic/frontend/flexbison/MiniC.y"
+
+#ifndef YY_TYPEDEF_YY_SCANNER_T
+#define YY_TYPEDEF_YY_SCANNER_T
+typedef void * yyscan_t;
+#endif
+
+#line 56 "/home/code/exp03-minic-basic/frontend/flexbison/autogenerated/MiniCBison.h"
 
 /* Token kinds.  */
 #ifndef YYTOKENTYPE
@@ -71,7 +80,7 @@ extern int yydebug;
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
 union YYSTYPE
 {
-#line 22 "/home/code/exp03-minic-basic/frontend/flexbison/MiniC.y"
+#line 36 "/home/code/exp03-minic-basic/frontend/flexbison/MiniC.y"
 
 	class ast_node * node;
 
@@ -80,7 +89,7 @@ union YYSTYPE
 	struct var_id_attr var_id;
 	struct type_attr type;
 
-#line 84 "/home/code/exp03-minic-basic/frontend/flexbison/autogenerated/MiniCBison.h"
+#line 93 "/home/code/exp03-minic-basic/frontend/flexbison/autogenerated/MiniCBison.h"
 
 };
 typedef union YYSTYPE YYSTYPE;
@@ -89,10 +98,9 @@ typedef union YYSTYPE YYSTYPE;
 #endif
 
 
-extern YYSTYPE yylval;
 
 
-int yyparse (void);
+int yyparse (yyscan_t scanner);
 
 
 #endif /* !YY_YY_HOME_CODE_EXP03_MINIC_BASIC_FRONTEND_FLEXBISON_AUTOGENERATED_MINICBISON_H_INCLUDED  */
@@ -0,0 +1,51 @@
+///
+/// @file RecursiveDescentContext.h
+/// @brief 递归下降分析一次分析的上下文，代替原来词法与语法分析的全局变量，使多个线程可同时分析不同的文件
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+#include "RecursiveDescentParser.h"
+
+///
+/// @brief 分析上下文，词法分析的扫描位置、Token的值以及语法分析的LookAhead都在这里
+///
+struct RDContext {
+
+    /// @brief 源文件内容中当前的扫描位置
+    const char * inputCur = nullptr;
+
+    /// @brief 源文件内容的结束位置
+    const char * inputEnd = nullptr;
+
+    /// @brief 行号信息
+    int64_t lineNo = 1;
+
+    /// @brief 当前Token的字符串，指向源文件内容中的一段，不另外复制
+    std::string_view tokenValue;
+
+    /// @brief 词法与语法分析数据交互的Token的值
+    RDSType lval;
+
+    /// @brief 语法分析所用的词法分析函数
+    int (*lexer)(RDContext & ctx) = nullptr;
+
+    /// @brief 语法分析过程中的LookAhead，指向下一个Token
+    RDTokenType lookaheadTag = RDTokenType::T_EMPTY;
+
+    /// @brief 语法分析过程中的错误数目
+    int errorNum = 0;
+};
@@ -16,33 +16,29 @@
 #include "RecursiveDescentExecutor.h"
 #include "RecursiveDescentFlex.h"
 #include "RecursiveDescentParser.h"
+#include "Common.h"
 
 /// @brief 前端词法与语法解析生成AST
 /// @return true: 成功 false：错误
 bool RecursiveDescentExecutor::run()
 {
-    // 若指定有参数，则作为词法分析的输入文件
-    rd_filein = fopen(filename.c_str(), "r");
-    if (rd_filein == nullptr) {
-        printf("Can't open file %s\n", filename.c_str());
+    // 整个源文件映射到内存中，词法分析直接按指针扫描
+    if (!input.open(filename)) {
+        minic_log_common(LOG_ERROR, ("Can't open file " + filename).c_str());
         return false;
     }
 
-    // 如果要查看LALR的移进与归约过程，请设置yydebug为1
-    // yydebug = 1;
+    // 分析状态都在本次分析的上下文中，不同线程可同时分析不同的文件
+    RDContext ctx;
+    ctx.inputCur = input.begin();
+    ctx.inputEnd = input.end();
+    ctx.lexer = dfaLexer ? rd_flex_dfa : rd_flex;
 
     // 词法、语法分析生成抽象语法树AST
-    astRoot = rd_parse();
-    if (!astRoot) {
+    astRoot = rd_parse(ctx);
 
-        // 关闭文件
-        fclose(rd_filein);
+    // 分析完毕后源文件内容不再需要，Token的字符串也随之失效
+    input.close();
 
-        return false;
-    }
-
-    // 关闭文件
-    fclose(rd_filein);
-
-    return true;
-}
\ No newline at end of file
+    return astRoot != nullptr;
+}
@@ -14,13 +14,16 @@
 /// </table>
 ///
 #include "FrontEndExecutor.h"
+#include "MappedFile.h"
 
 /// @brief 归下降分析执行器类
 class RecursiveDescentExecutor : public FrontEndExecutor {
 public:
     /// @brief 构造函数
     /// @param filename 输入的源文件
-    RecursiveDescentExecutor(std::string filename) : FrontEndExecutor(filename)
+    /// @param _dfaLexer true：表驱动的SIMD词法分析器 false：逐字符判断的简单词法分析器
+    RecursiveDescentExecutor(std::string filename, bool _dfaLexer = true)
+        : FrontEndExecutor(filename), dfaLexer(_dfaLexer)
     {}
 
     /// @brief 析构函数
@@ -30,4 +33,11 @@ public:
     /// @brief 前端词法与语法解析生成AST
     /// @return true: 成功 false：错误
     bool run() override;
+
+protected:
+    /// @brief 源文件的内存映像
+    MappedFile input;
+
+    /// @brief 是否采用表驱动的SIMD词法分析器
+    bool dfaLexer;
 };
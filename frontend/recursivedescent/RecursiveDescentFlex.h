@@ -15,13 +15,10 @@
 ///
 #pragma once
 
-#include <stdio.h>
+#include "RecursiveDescentContext.h"
 
-// 行号信息
-extern int rd_line_no;
+/// 识别词法，逐字符判断的简单实现
+int rd_flex(RDContext & ctx);
 
-// 输入文件指针
-extern FILE * rd_filein;
-
-/// 识别词法
-int rd_flex();
+/// 识别词法，表驱动并采用SIMD批量扫描的实现，识别结果与rd_flex相同
+int rd_flex_dfa(RDContext & ctx);
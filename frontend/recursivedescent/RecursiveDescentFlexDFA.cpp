@@ -0,0 +1,537 @@
+///
+/// @file RecursiveDescentFlexDFA.cpp
+/// @brief 表驱动的递归下降词法分析器，空白与标识符的扫描采用SIMD加速
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string_view>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RD_LEXER_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(RD_LEXER_SSE2) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define RD_LEXER_AVX2 1
+#include <immintrin.h>
+#endif
+
+#include "RecursiveDescentFlex.h"
+#include "RecursiveDescentParser.h"
+#include "Common.h"
+
+///
+/// @brief 字符类别，按位组合
+///
+enum : uint8_t {
+    /// @brief 空格与TAB
+    CC_BLANK = 1,
+
+    /// @brief 换行符\r与\n
+    CC_NEWLINE = 2,
+
+    /// @brief 数字0-9
+    CC_DIGIT = 4,
+
+    /// @brief 字母与下划线，可作为标识符的开始
+    CC_ID_START = 8,
+
+    /// @brief 单字符的Token，如括号、分号等
+    CC_SINGLE = 16,
+};
+
+///
+/// @brief 256个字符的类别表
+///
+struct CharClassTable {
+    /// @brief 每个字符的类别
+    uint8_t cls[256];
+
+    /// @brief 单字符Token对应的Token类别
+    int8_t single[256];
+
+    constexpr CharClassTable() : cls(), single()
+    {
+        cls[(unsigned char) ' '] = CC_BLANK;
+        cls[(unsigned char) '\t'] = CC_BLANK;
+        cls[(unsigned char) '\n'] = CC_NEWLINE;
+        cls[(unsigned char) '\r'] = CC_NEWLINE;
+
+        for (int c = '0'; c <= '9'; c++) {
+            cls[c] = CC_DIGIT;
+        }
+
+        for (int c = 'a'; c <= 'z'; c++) {
+            cls[c] = CC_ID_START;
+            cls[c - 'a' + 'A'] = CC_ID_START;
+        }
+        cls[(unsigned char) '_'] = CC_ID_START;
+
+        const char singles[] = "(){};";
+        const int8_t tokens[] = {
+            RDTokenType::T_L_PAREN,
+            RDTokenType::T_R_PAREN,
+            RDTokenType::T_L_BRACE,
+            RDTokenType::T_R_BRACE,
+            RDTokenType::T_SEMICOLON,
+        };
+        for (int i = 0; singles[i]; i++) {
+            cls[(unsigned char) singles[i]] = CC_SINGLE;
+            single[(unsigned char) singles[i]] = tokens[i];
+        }
+    }
+};
+
+/// @brief 字符类别表，编译期生成
+static constexpr CharClassTable charClass;
+
+///
+/// @brief 检查字符是否可作为标识符的后续字符，即字母、数字或下划线
+/// @param c 字符
+/// @return true：是 false：不是
+///
+static inline bool isIdContinue(char c)
+{
+    return (charClass.cls[(unsigned char) c] & (CC_ID_START | CC_DIGIT)) != 0;
+}
+
+///
+/// @brief 按长度分派的关键字识别，每个标识符至多一次memcmp
+/// @param s 标识符起始位置
+/// @param len 标识符长度
+/// @return Token，不是关键字时返回T_ID
+///
+static inline RDTokenType getKeywordToken(const char * s, std::size_t len)
+{
+    switch (len) {
+        case 3:
+            if (std::memcmp(s, "int", 3) == 0) {
+                return RDTokenType::T_INT;
+            }
+            break;
+        case 6:
+            if (std::memcmp(s, "return", 6) == 0) {
+                return RDTokenType::T_RETURN;
+            }
+            break;
+        default:
+            break;
+    }
+
+    return RDTokenType::T_ID;
+}
+
+///
+/// @brief 标量方式跳过空白符，同时统计行号。\r\n、\n、\r均算作一行
+/// @param p 起始位置
+/// @param end 结束位置
+/// @param lines 累计的行数
+/// @return const char* 第一个非空白符的位置
+///
+static inline const char * skipBlankScalar(const char * p, const char * end, int64_t & lines)
+{
+    while (p < end && (charClass.cls[(unsigned char) *p] & (CC_BLANK | CC_NEWLINE))) {
+        if (*p == '\n') {
+            lines++;
+        } else if (*p == '\r' && (p + 1 >= end || p[1] != '\n')) {
+            lines++;
+        }
+        p++;
+    }
+
+    return p;
+}
+
+///
+/// @brief 标量方式找到标识符（字母、数字、下划线）串的结束位置
+/// @param p 起始位置
+/// @param end 结束位置
+/// @return const char* 第一个不属于标识符的字符位置
+///
+static inline const char * scanIdScalar(const char * p, const char * end)
+{
+    while (p < end && isIdContinue(*p)) {
+        p++;
+    }
+
+    return p;
+}
+
+///
+/// @brief 标量方式找到数字串的结束位置
+/// @param p 起始位置
+/// @param end 结束位置
+/// @return const char* 第一个非数字的位置
+///
+static inline const char * scanDigitScalar(const char * p, const char * end)
+{
+    while (p < end && (charClass.cls[(unsigned char) *p] & CC_DIGIT)) {
+        p++;
+    }
+
+    return p;
+}
+
+#ifdef RD_LEXER_SSE2
+
+///
+/// @brief 计算掩码中最低位1的位置
+/// @param mask 掩码，不能为0
+/// @return unsigned 位置
+///
+static inline unsigned lowestBit(uint32_t mask)
+{
+#if defined(__GNUC__)
+    return (unsigned) __builtin_ctz(mask);
+#else
+    unsigned index = 0;
+    while (!(mask & 1)) {
+        mask >>= 1;
+        index++;
+    }
+    return index;
+#endif
+}
+
+///
+/// @brief 统计掩码中1的个数
+/// @param mask 掩码
+/// @return unsigned 个数
+///
+static inline unsigned bitCount(uint32_t mask)
+{
+#if defined(__GNUC__)
+    return (unsigned) __builtin_popcount(mask);
+#else
+    unsigned count = 0;
+    for (; mask; mask &= mask - 1) {
+        count++;
+    }
+    return count;
+#endif
+}
+
+///
+/// @brief 16个字节中字符在[lo, hi]范围内的掩码，有符号比较，>=0x80的字符不会命中
+///
+static inline __m128i inRange16(__m128i v, char lo, char hi)
+{
+    return _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8((char) (lo - 1))),
+                         _mm_cmplt_epi8(v, _mm_set1_epi8((char) (hi + 1))));
+}
+
+///
+/// @brief 16个字节中属于标识符字符（字母、数字、下划线）的掩码
+///
+static inline __m128i idMask16(__m128i v)
+{
+    // 大小写字母统一变为小写后判断
+    __m128i lower = _mm_or_si128(v, _mm_set1_epi8(0x20));
+    __m128i m = _mm_or_si128(inRange16(lower, 'a', 'z'), inRange16(v, '0', '9'));
+
+    return _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8('_')));
+}
+
+///
+/// @brief SSE2方式跳过空白符，每次处理16个字节，同时统计行号
+/// @param p 起始位置
+/// @param end 结束位置
+/// @param lines 累计的行数
+/// @return const char* 第一个非空白符的位置
+///
+static const char * skipBlankSSE2(const char * p, const char * end, int64_t & lines)
+{
+    // 需要多读一个字节判断\r之后是否为\n
+    while (end - p >= 17) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        __m128i next = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 1));
+
+        __m128i lf = _mm_cmpeq_epi8(v, _mm_set1_epi8('\n'));
+        __m128i cr = _mm_cmpeq_epi8(v, _mm_set1_epi8('\r'));
+        __m128i blank = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\t')));
+
+        uint32_t wsMask = (uint32_t) _mm_movemask_epi8(_mm_or_si128(blank, _mm_or_si128(lf, cr)));
+
+        // 单独的\r算一行，\r\n中的\r不算
+        uint32_t lineMask = (uint32_t) _mm_movemask_epi8(
+            _mm_or_si128(lf, _mm_andnot_si128(_mm_cmpeq_epi8(next, _mm_set1_epi8('\n')), cr)));
+
+        if (wsMask == 0xFFFF) {
+            lines += bitCount(lineMask);
+            p += 16;
+            continue;
+        }
+
+        unsigned n = lowestBit(~wsMask);
+        lines += bitCount(lineMask & ((1u << n) - 1));
+
+        return p + n;
+    }
+
+    return skipBlankScalar(p, end, lines);
+}
+
+///
+/// @brief SSE2方式找到标识符串的结束位置，每次处理16个字节
+/// @param p 起始位置
+/// @param end 结束位置
+/// @return const char* 第一个不属于标识符的字符位置
+///
+static const char * scanIdSSE2(const char * p, const char * end)
+{
+    while (end - p >= 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        uint32_t mask = (uint32_t) _mm_movemask_epi8(idMask16(v));
+
+        if (mask != 0xFFFF) {
+            return p + lowestBit(~mask);
+        }
+
+        p += 16;
+    }
+
+    return scanIdScalar(p, end);
+}
+
+///
+/// @brief SSE2方式找到数字串的结束位置，每次处理16个字节
+/// @param p 起始位置
+/// @param end 结束位置
+/// @return const char* 第一个非数字的位置
+///
+static const char * scanDigitSSE2(const char * p, const char * end)
+{
+    while (end - p >= 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        uint32_t mask = (uint32_t) _mm_movemask_epi8(inRange16(v, '0', '9'));
+
+        if (mask != 0xFFFF) {
+            return p + lowestBit(~mask);
+        }
+
+        p += 16;
+    }
+
+    return scanDigitScalar(p, end);
+}
+
+#endif
+
+#ifdef RD_LEXER_AVX2
+
+///
+/// @brief 32个字节中字符在[lo, hi]范围内的掩码
+///
+__attribute__((target("avx2"))) static inline __m256i inRange32(__m256i v, char lo, char hi)
+{
+    return _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8((char) (lo - 1))),
+                            _mm256_cmpgt_epi8(_mm256_set1_epi8((char) (hi + 1)), v));
+}
+
+///
+/// @brief AVX2方式跳过空白符，每次处理32个字节，同时统计行号
+/// @param p 起始位置
+/// @param end 结束位置
+/// @param lines 累计的行数
+/// @return const char* 第一个非空白符的位置
+///
+__attribute__((target("avx2"))) static const char * skipBlankAVX2(const char * p, const char * end, int64_t & lines)
+{
+    while (end - p >= 33) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+        __m256i next = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + 1));
+
+        __m256i lf = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n'));
+        __m256i cr = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\r'));
+        __m256i blank =
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\t')));
+
+        uint32_t wsMask = (uint32_t) _mm256_movemask_epi8(_mm256_or_si256(blank, _mm256_or_si256(lf, cr)));
+        uint32_t lineMask = (uint32_t) _mm256_movemask_epi8(
+            _mm256_or_si256(lf, _mm256_andnot_si256(_mm256_cmpeq_epi8(next, _mm256_set1_epi8('\n')), cr)));
+
+        if (wsMask == 0xFFFFFFFFu) {
+            lines += bitCount(lineMask);
+            p += 32;
+            continue;
+        }
+
+        unsigned n = lowestBit(~wsMask);
+        lines += bitCount(lineMask & ((1u << n) - 1));
+
+        return p + n;
+    }
+
+    return skipBlankSSE2(p, end, lines);
+}
+
+///
+/// @brief AVX2方式找到标识符串的结束位置，每次处理32个字节
+/// @param p 起始位置
+/// @param end 结束位置
+/// @return const char* 第一个不属于标识符的字符位置
+///
+__attribute__((target("avx2"))) static const char * scanIdAVX2(const char * p, const char * end)
+{
+    while (end - p >= 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+        __m256i lower = _mm256_or_si256(v, _mm256_set1_epi8(0x20));
+        __m256i m = _mm256_or_si256(inRange32(lower, 'a', 'z'), inRange32(v, '0', '9'));
+        m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('_')));
+
+        uint32_t mask = (uint32_t) _mm256_movemask_epi8(m);
+        if (mask != 0xFFFFFFFFu) {
+            return p + lowestBit(~mask);
+        }
+
+        p += 32;
+    }
+
+    return scanIdSSE2(p, end);
+}
+
+///
+/// @brief AVX2方式找到数字串的结束位置，每次处理32个字节
+/// @param p 起始位置
+/// @param end 结束位置
+/// @return const char* 第一个非数字的位置
+///
+__attribute__((target("avx2"))) static const char * scanDigitAVX2(const char * p, const char * end)
+{
+    while (end - p >= 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+
+        uint32_t mask = (uint32_t) _mm256_movemask_epi8(inRange32(v, '0', '9'));
+        if (mask != 0xFFFFFFFFu) {
+            return p + lowestBit(~mask);
+        }
+
+        p += 32;
+    }
+
+    return scanDigitSSE2(p, end);
+}
+
+#endif
+
+///
+/// @brief 扫描函数表，根据CPU的能力选择AVX2、SSE2或者标量实现
+///
+struct RDScanFunctions {
+    const char * (*skipBlank)(const char *, const char *, int64_t &);
+    const char * (*scanId)(const char *, const char *);
+    const char * (*scanDigit)(const char *, const char *);
+};
+
+///
+/// @brief 选择当前CPU支持的最快的扫描函数
+/// @return RDScanFunctions 扫描函数表
+///
+static RDScanFunctions selectScanFunctions()
+{
+#if defined(RD_LEXER_AVX2)
+    // 静态初始化阶段调用，需先初始化CPU特性的检测
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2")) {
+        return {skipBlankAVX2, scanIdAVX2, scanDigitAVX2};
+    }
+#endif
+
+#if defined(RD_LEXER_SSE2)
+    return {skipBlankSSE2, scanIdSSE2, scanDigitSSE2};
+#else
+    return {skipBlankScalar, scanIdScalar, scanDigitScalar};
+#endif
+}
+
+/// @brief 扫描函数表，程序启动时选定
+static const RDScanFunctions scanFunctions = selectScanFunctions();
+
+/// @brief 词法文法，获取下一个Token。与rd_flex识别的Token完全相同，字符类别查表，空白与标识符批量扫描
+/// @param ctx 分析上下文
+/// @return  Token，值保存在ctx.lval中
+int rd_flex_dfa(RDContext & ctx)
+{
+    const char * end = ctx.inputEnd;
+
+    // 忽略空白符号，主要有空格，TAB键和换行符，同时统计行号
+    const char * p = scanFunctions.skipBlank(ctx.inputCur, end, ctx.lineNo);
+
+    // 文件结束符
+    if (p >= end) {
+        ctx.inputCur = end;
+        ctx.tokenValue = std::string_view();
+
+        return RDTokenType::T_EOF;
+    }
+
+    const char * start = p;
+    unsigned char c = (unsigned char) *p++;
+
+    int tokenKind;
+
+    switch (charClass.cls[c]) {
+        case CC_SINGLE:
+            // 括号、分号等单字符Token
+            tokenKind = charClass.single[c];
+            break;
+
+        case CC_DIGIT: {
+            // 识别无符号数，这里只处理正整数或者0
+            p = scanFunctions.scanDigit(p, end);
+
+            uint32_t val = 0;
+            for (const char * q = start; q < p; q++) {
+                val = val * 10 + (uint32_t) (*q - '0');
+            }
+
+            ctx.lval.integer_num.val = val;
+            ctx.lval.integer_num.lineno = ctx.lineNo;
+
+            tokenKind = RDTokenType::T_DIGIT;
+            break;
+        }
+
+        case CC_ID_START:
+            // 识别标识符，包含关键字/保留字或自定义标识符
+            p = scanFunctions.scanId(p, end);
+
+            tokenKind = getKeywordToken(start, (std::size_t) (p - start));
+            if (tokenKind == RDTokenType::T_ID) {
+                ctx.lval.var_id.id = internSymbol(std::string_view(start, (std::size_t) (p - start)));
+                ctx.lval.var_id.lineno = ctx.lineNo;
+            } else if (tokenKind == RDTokenType::T_INT) {
+                ctx.lval.type.type = BasicType::TYPE_INT;
+                ctx.lval.type.lineno = ctx.lineNo;
+            }
+            break;
+
+        default:
+            char msg[64];
+            snprintf(msg, sizeof(msg), "Line(%lld): Invalid char %c", (long long) ctx.lineNo, (char) c);
+            minic_log_common(LOG_ERROR, msg);
+            tokenKind = RDTokenType::T_ERR;
+            break;
+    }
+
+    // 存储Token的字符串，即源文件内容中的一段
+    ctx.tokenValue = std::string_view(start, (std::size_t) (p - start));
+
+    // 下次从这里继续扫描
+    ctx.inputCur = p;
+
+    return tokenKind;
+}
@@ -17,46 +17,40 @@
 
 #include "AST.h"
 #include "AttrType.h"
+#include "RecursiveDescentContext.h"
 #include "RecursiveDescentFlex.h"
 #include "RecursiveDescentParser.h"
+#include "Common.h"
 
-// 定义全局变量给词法分析使用，用于填充值
-RDSType rd_lval;
-
-// 词法识别的记号值，原始文本字符串
-extern std::string tokenValue;
-
-// 语法分析过程中的错误数目
-static int errno_num = 0;
-
-// 语法分析过程中的LookAhead，指向下一个Token
-static RDTokenType lookaheadTag = RDTokenType::T_EMPTY;
+// 词法与语法分析的状态都在分析上下文ctx中，以下的分析函数都带有该参数
 
 ///
 /// @brief 继续检查LookAhead指向的记号是否是T，用于符号的FIRST集合或Follow集合判断
 ///
-#define _(T) || (lookaheadTag == T)
+#define _(T) || (ctx.lookaheadTag == T)
 
 ///
 /// @brief 第一个检查LookAhead指向的记号是否属于C，用于符号的FIRST集合或Follow集合判断
 /// 如判断是否是T_ID，或者T_INT，可结合F和_两个宏来实现，即F(T_ID) _(T_INT)
 ///
-#define F(C) (lookaheadTag == C)
+#define F(C) (ctx.lookaheadTag == C)
 
 ///
 /// @brief lookahead指向下一个Token
+/// @param ctx 分析上下文
 ///
-static void advance()
+static void advance(RDContext & ctx)
 {
-    lookaheadTag = (RDTokenType) rd_flex();
+    ctx.lookaheadTag = (RDTokenType) ctx.lexer(ctx);
 }
 
 ///
 /// @brief flag若匹配则跳过Token，使得LookAhead指向下一个Token
+/// @param ctx 分析上下文
 /// @param tag 是否匹配指定的Tag
 /// @return true：匹配，false：未匹配
 ///
-static bool match(RDTokenType tag)
+static bool match(RDContext & ctx, RDTokenType tag)
 {
     bool result = false;
 
@@ -65,7 +59,7 @@ static bool match(RDTokenType tag)
         result = true;
 
         // 匹配，则向前获取下一个Token
-        advance();
+        advance(ctx);
     }
 
     return result;
@@ -73,9 +67,10 @@ static bool match(RDTokenType tag)
 
 ///
 /// @brief 语法错误输出
+/// @param ctx 分析上下文
 /// @param format 格式化字符串，和printf的格式化字符串一样
 ///
-static void semerror(const char * format, ...)
+static void semerror(RDContext & ctx, const char * format, ...)
 {
     char logStr[1024];
 
@@ -87,25 +82,28 @@ static void semerror(const char * format, ...)
 
     va_end(ap);
 
-    printf("Line(%d): %s\n", rd_line_no, logStr);
+    char lineStr[1100];
+    snprintf(lineStr, sizeof(lineStr), "Line(%lld): %s", (long long) ctx.lineNo, logStr);
+    minic_log_common(LOG_ERROR, lineStr);
 
-    errno_num++;
+    ctx.errorNum++;
 }
 
 ///
 /// @brief 表达式文法 expr : T_DIGIT的识别，目前只识别无符号整数
+/// @param ctx 分析上下文
 /// @return AST的节点
 ///
-static ast_node * expr()
+static ast_node * expr(RDContext & ctx)
 {
     ast_node * node = nullptr;
     if (F(T_DIGIT)) {
         // 无符号整数
 
-        node = ast_node::New(rd_lval.integer_num);
+        node = ast_node::New(ctx.lval.integer_num);
 
         // 跳过当前记号，指向下一个记号
-        advance();
+        advance(ctx);
     }
 
     return node;
@@ -113,22 +111,23 @@ static ast_node * expr()
 
 ///
 /// @brief 语句的识别，其文法为：statement -> T_RETURN expr T_SEMICOLON
+/// @param ctx 分析上下文
 /// @return AST的节点
 ///
-static ast_node * statement()
+static ast_node * statement(RDContext & ctx)
 {
 
-    if (match(T_RETURN)) {
+    if (match(ctx, T_RETURN)) {
 
         // return语句的First集合元素为T_RETURN
         // 若匹配，则说明是return语句
 
-        ast_node * expr_node = expr();
+        ast_node * expr_node = expr(ctx);
 
-        if (!match(T_SEMICOLON)) {
+        if (!match(ctx, T_SEMICOLON)) {
 
             // 返回语句后没有分号
-            semerror("返回语句后没有分号");
+            semerror(ctx, "返回语句后没有分号");
         }
 
         return create_contain_node(ast_operator_type::AST_OP_RETURN, expr_node);
@@ -139,18 +138,20 @@ static ast_node * statement()
 
 ///
 /// @brief 块中的项目识别，其文法为：blockItem -> statement
+/// @param ctx 分析上下文
 /// @return AST的节点
 ///
-static ast_node * BlockItem()
+static ast_node * BlockItem(RDContext & ctx)
 {
-    return statement();
+    return statement(ctx);
 }
 
 ///
 /// @brief 块内语句列表识别，文法为BlockItemList : BlockItem+
+/// @param ctx 分析上下文
 /// @return AST的节点
 ///
-static void BlockItemList(ast_node * blockNode)
+static void BlockItemList(RDContext & ctx, ast_node * blockNode)
 {
     for (;;) {
 
@@ -160,7 +161,7 @@ static void BlockItemList(ast_node * blockNode)
         }
 
         // 遍历BlockItem
-        ast_node * itemNode = BlockItem();
+        ast_node * itemNode = BlockItem(ctx);
         if (itemNode) {
             blockNode->insert_son_node(itemNode);
         } else {
@@ -172,26 +173,27 @@ static void BlockItemList(ast_node * blockNode)
 
 ///
 /// @brief 语句块识别，文法：Block -> T_L_BRACE BlockItemList? T_R_BRACE
+/// @param ctx 分析上下文
 /// @return AST的节点
 ///
-static ast_node * Block()
+static ast_node * Block(RDContext & ctx)
 {
-    if (match(T_L_BRACE)) {
+    if (match(ctx, T_L_BRACE)) {
 
         // 创建语句块节点
         ast_node * blockNode = create_contain_node(ast_operator_type::AST_OP_BLOCK);
 
         // 空的语句块
-        if (match(T_R_BRACE)) {
+        if (match(ctx, T_R_BRACE)) {
             return blockNode;
         }
 
         // 块内语句列表识别
-        BlockItemList(blockNode);
+        BlockItemList(ctx, blockNode);
 
         // 没有匹配左大括号，则语法错误
-        if (!match(T_R_BRACE)) {
-            semerror("缺少右大括号");
+        if (!match(ctx, T_R_BRACE)) {
+            semerror(ctx, "缺少右大括号");
         }
 
         // 正常
@@ -204,54 +206,55 @@ static ast_node * Block()
 
 ///
 /// @brief 函数定义的识别，其文法为： funcDef -> T_INT T_ID T_L_PAREN T_R_PAREN block
+/// @param ctx 分析上下文
 /// @return ast_node 函数运算符节点
 ///
-static ast_node * funcDef()
+static ast_node * funcDef(RDContext & ctx)
 {
     if (F(T_INT)) {
 
         // 函数返回之后类型
-        type_attr funcReturnType = rd_lval.type;
+        type_attr funcReturnType = ctx.lval.type;
 
         // 跳过当前的记号，指向下一个记号
-        advance();
+        advance(ctx);
 
         // 检测是否是标识符
         if (F(T_ID)) {
 
             // 获取标识符的值和定位信息
-            var_id_attr funcId = rd_lval.var_id;
+            var_id_attr funcId = ctx.lval.var_id;
 
             // 跳过当前的记号，指向下一个记号
-            advance();
+            advance(ctx);
 
             // 函数定义的左右括号识别
-            if (match(T_L_PAREN)) {
+            if (match(ctx, T_L_PAREN)) {
                 // 函数定义
 
                 // 目前函数定义没有形参，因此必须是右小括号
-                if (match(T_R_PAREN)) {
+                if (match(ctx, T_R_PAREN)) {
 
                     // 识别block
-                    ast_node * blockNode = Block();
+                    ast_node * blockNode = Block(ctx);
 
                     // 形参结点没有，设置为空指针
                     ast_node * formalParamsNode = nullptr;
 
                     // 创建函数定义的节点，孩子有类型，函数名，语句块和形参(实际上无)
-                    // create_func_def函数内会释放funcId中指向的标识符空间，切记，之后不要再释放，之前一定要是通过strdup函数或者malloc分配的空间
+                    // 函数名已驻留在字符串池中，funcId中只是其编号，不需要释放
                     return create_func_def(funcReturnType, funcId, blockNode, formalParamsNode);
 
                 } else {
-                    semerror("函数定义缺少右小括号");
+                    semerror(ctx, "函数定义缺少右小括号");
                 }
 
             } else {
 
-                semerror("函数定义缺少左小括号");
+                semerror(ctx, "函数定义缺少左小括号");
             }
         } else {
-            semerror("函数返回值类型后缺少函数名标识符");
+            semerror(ctx, "函数返回值类型后缺少函数名标识符");
         }
     }
 
@@ -261,9 +264,10 @@ static ast_node * funcDef()
 ///
 /// @brief 编译单元识别（C语言文件），其文法为：compileUnit -> funcDef EOF
 /// compileUnit是文法的开始符号
+/// @param ctx 分析上下文
 /// @return ast_node* 抽象语法树根节点
 ///
-static ast_node * compileUnit()
+static ast_node * compileUnit(RDContext & ctx)
 {
     // 创建AST的根节点，编译单元运算符
     ast_node * cu_node = create_contain_node(ast_operator_type::AST_OP_COMPILE_UNIT);
@@ -271,15 +275,15 @@ static ast_node * compileUnit()
     // funcDef的First集合为{T_INT}，根据LL(1)文法可知若LookAhead记号为T_INT，则是函数定义
     if (F(T_INT)) {
 
-        ast_node * node = funcDef();
+        ast_node * node = funcDef(ctx);
 
         // 加入到父节点中，node为空时insert_son_node内部进行了忽略
         (void) cu_node->insert_son_node(node);
     }
 
-    if (!match(T_EOF)) {
+    if (!match(ctx, T_EOF)) {
         // 没有文件结束
-        semerror("文件结束标记不符");
+        semerror(ctx, "文件结束标记不符");
     }
 
     return cu_node;
@@ -287,20 +291,21 @@ static ast_node * compileUnit()
 
 ///
 /// @brief 采用递归下降分析法实现词法与语法分析生成抽象语法树
+/// @param ctx 分析上下文，需设置好源文件内容与词法分析函数
 /// @return ast_node* 空指针失败，否则成功
 ///
-ast_node * rd_parse()
+ast_node * rd_parse(RDContext & ctx)
 {
     // 没有错误信息
-    errno_num = 0;
+    ctx.errorNum = 0;
 
     // lookahead指向第一个Token
-    advance();
+    advance(ctx);
 
-    ast_node * astRoot = compileUnit();
+    ast_node * astRoot = compileUnit(ctx);
 
     // 如果有错误信息，则返回-1，否则返回0
-    if (errno_num != 0) {
+    if (ctx.errorNum != 0) {
         return nullptr;
     }
 
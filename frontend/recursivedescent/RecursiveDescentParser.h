@@ -49,11 +49,11 @@ union RDSType {
     type_attr type;             // 类型
 };
 
-/// @brief 词法与语法分析数据交互的Token的值
-extern RDSType rd_lval;
+struct RDContext;
 
 ///
 /// @brief 采用递归下降分析法实现词法与语法分析生成抽象语法树
+/// @param ctx 分析上下文，需设置好源文件内容与词法分析函数
 /// @return ast_node* 空指针失败，否则成功
 ///
-ast_node * rd_parse();
+ast_node * rd_parse(RDContext & ctx);
@@ -0,0 +1,105 @@
+///
+/// @file BasicBlock.cpp
+/// @brief 基本块的实现
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#include <algorithm>
+
+#include "BasicBlock.h"
+#include "Casting.h"
+#include "ExitInstruction.h"
+#include "GotoInstruction.h"
+#include "LabelInstruction.h"
+
+/// @brief 构造函数
+/// @param _index 块在控制流图中的编号
+BasicBlock::BasicBlock(int32_t _index) : index(_index)
+{}
+
+/// @brief 获取块开头的Label指令
+/// @return LabelInstruction* Label指令，没有时为空指针
+LabelInstruction * BasicBlock::getLabel()
+{
+    InstList & insts = code.getInsts();
+
+    return insts.empty() ? nullptr : dyn_cast<LabelInstruction>(insts.front());
+}
+
+/// @brief 获取块末尾的跳转指令
+/// @return Instruction* 跳转指令，没有时为空指针
+Instruction * BasicBlock::getTerminator()
+{
+    InstList & insts = code.getInsts();
+    if (insts.empty()) {
+        return nullptr;
+    }
+
+    Instruction * last = insts.back();
+
+    return (isa<GotoInstruction>(last) || isa<ExitInstruction>(last)) ? last : nullptr;
+}
+
+/// @brief 增加一条到succ的边
+/// @param succ 后继块
+void BasicBlock::addSuccessor(BasicBlock * succ)
+{
+    succs.push_back(succ);
+    succ->preds.push_back(this);
+}
+
+/// @brief 删除到succ的边
+/// @param succ 后继块
+void BasicBlock::removeSuccessor(BasicBlock * succ)
+{
+    auto succIter = std::find(succs.begin(), succs.end(), succ);
+    if (succIter == succs.end()) {
+        return;
+    }
+    succs.erase(succIter);
+
+    auto predIter = std::find(succ->preds.begin(), succ->preds.end(), this);
+    if (predIter != succ->preds.end()) {
+        succ->preds.erase(predIter);
+    }
+}
+
+/// @brief 把到oldSucc的边改为到newSucc，后继中的位置不变
+/// @param oldSucc 原后继块
+/// @param newSucc 新后继块
+void BasicBlock::replaceSuccessor(BasicBlock * oldSucc, BasicBlock * newSucc)
+{
+    auto succIter = std::find(succs.begin(), succs.end(), oldSucc);
+    if (succIter == succs.end()) {
+        return;
+    }
+    *succIter = newSucc;
+
+    auto predIter = std::find(oldSucc->preds.begin(), oldSucc->preds.end(), this);
+    if (predIter != oldSucc->preds.end()) {
+        oldSucc->preds.erase(predIter);
+    }
+
+    newSucc->preds.push_back(this);
+}
+
+/// @brief 获取块的名字，用于调试输出
+/// @return std::string 名字
+std::string BasicBlock::getName()
+{
+    LabelInstruction * label = getLabel();
+    if (label && !label->getIRName().empty()) {
+        return label->getIRName();
+    }
+
+    return "bb" + std::to_string(index);
+}
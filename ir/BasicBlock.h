@@ -0,0 +1,169 @@
+///
+/// @file BasicBlock.h
+/// @brief 基本块的头文件
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "IRCode.h"
+
+class LabelInstruction;
+
+///
+/// @brief 基本块。块内的指令除最后一条外都不是跳转指令，除第一条外都不是Label指令。
+/// 基本块在控制流图存在期间拥有其指令，控制流图线性化时指令按块的次序交还给函数
+///
+class BasicBlock {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _index 块在控制流图中的编号
+    ///
+    explicit BasicBlock(int32_t _index);
+
+    ///
+    /// @brief 下列操作不被允许，基本块不能拷贝
+    ///
+    BasicBlock(const BasicBlock &) = delete;
+    BasicBlock & operator=(const BasicBlock &) = delete;
+
+    ///
+    /// @brief 获取块内的指令序列
+    /// @return InstList&
+    ///
+    InstList & getInsts()
+    {
+        return code.getInsts();
+    }
+
+    ///
+    /// @brief 获取块内的指令序列管理对象
+    /// @return InterCode&
+    ///
+    InterCode & getInterCode()
+    {
+        return code;
+    }
+
+    ///
+    /// @brief 获取块的编号，在控制流图中唯一，可作为数组的下标
+    /// @return int32_t 编号
+    ///
+    [[nodiscard]] int32_t getIndex() const
+    {
+        return index;
+    }
+
+    ///
+    /// @brief 获取块开头的Label指令
+    /// @return LabelInstruction* Label指令，入口块或不可达的块可能没有Label
+    ///
+    LabelInstruction * getLabel();
+
+    ///
+    /// @brief 获取块末尾的跳转指令，包括无条件跳转与函数出口指令
+    /// @return Instruction* 跳转指令，块直接进入下一个块时为空指针
+    ///
+    Instruction * getTerminator();
+
+    ///
+    /// @brief 获取前驱块
+    /// @return std::vector<BasicBlock *>&
+    ///
+    std::vector<BasicBlock *> & getPredecessors()
+    {
+        return preds;
+    }
+
+    ///
+    /// @brief 获取后继块
+    /// @return std::vector<BasicBlock *>&
+    ///
+    std::vector<BasicBlock *> & getSuccessors()
+    {
+        return succs;
+    }
+
+    ///
+    /// @brief 增加一条到succ的边，同时修改本块的后继与succ的前驱
+    /// @param succ 后继块
+    ///
+    void addSuccessor(BasicBlock * succ);
+
+    ///
+    /// @brief 删除到succ的边，同时修改本块的后继与succ的前驱
+    /// @param succ 后继块
+    ///
+    void removeSuccessor(BasicBlock * succ);
+
+    ///
+    /// @brief 把到oldSucc的边改为到newSucc，后继中的位置不变
+    /// @param oldSucc 原后继块
+    /// @param newSucc 新后继块
+    ///
+    void replaceSuccessor(BasicBlock * oldSucc, BasicBlock * newSucc);
+
+    ///
+    /// @brief 获取块在逆后序中的序号
+    /// @return int32_t 序号，从入口不可达时为-1
+    ///
+    [[nodiscard]] int32_t getRPONumber() const
+    {
+        return rpoNumber;
+    }
+
+    ///
+    /// @brief 设置块在逆后序中的序号
+    /// @param number 序号
+    ///
+    void setRPONumber(int32_t number)
+    {
+        rpoNumber = number;
+    }
+
+    ///
+    /// @brief 是否从入口可达
+    /// @return true：可达 false：不可达
+    ///
+    [[nodiscard]] bool isReachable() const
+    {
+        return rpoNumber >= 0;
+    }
+
+    ///
+    /// @brief 获取块的名字，用于调试输出，有Label时为Label的名字，否则为bb加编号
+    /// @return std::string 名字
+    ///
+    std::string getName();
+
+private:
+    /// @brief 块内的指令
+    InterCode code;
+
+    /// @brief 编号
+    int32_t index;
+
+    /// @brief 逆后序中的序号
+    int32_t rpoNumber = -1;
+
+    /// @brief 前驱块
+    std::vector<BasicBlock *> preds;
+
+    /// @brief 后继块
+    std::vector<BasicBlock *> succs;
+};
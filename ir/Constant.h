@@ -38,7 +38,20 @@ protected:
     ///
     /// @brief 构造函数
     /// @param _type  类型
+    /// @param _kind  具体类别
     ///
-    Constant(Type * _type) : User(_type)
+    Constant(Type * _type, ValueKind _kind) : User(_type, _kind)
     {}
+
+public:
+    ///
+    /// @brief 用于isa/cast/dyn_cast的类型判断
+    /// @param val Value
+    /// @return true：是常量
+    ///
+    static bool classof(const Value * val)
+    {
+        return val->getValueKind() >= ValueKind::VALUE_FIRST_CONSTANT &&
+               val->getValueKind() <= ValueKind::VALUE_LAST_CONSTANT;
+    }
 };
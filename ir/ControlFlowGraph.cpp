@@ -0,0 +1,283 @@
+///
+/// @file ControlFlowGraph.cpp
+/// @brief 控制流图的实现
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+
+#include "ControlFlowGraph.h"
+#include "Casting.h"
+#include "Common.h"
+#include "ExitInstruction.h"
+#include "Function.h"
+#include "GotoInstruction.h"
+#include "LabelInstruction.h"
+
+/// @brief 构造函数，由函数的线性IR构建基本块与边，并计算逆后序
+/// @param _func 函数
+ControlFlowGraph::ControlFlowGraph(Function * _func) : func(_func)
+{
+    InstList & insts = func->getInterCode().getInsts();
+
+    // 划分基本块：Label指令以及跳转指令后的指令开始新的块。一次遍历确定各块的指令区间，整段移入块中
+    auto blockBegin = insts.begin();
+    std::size_t blockSize = 0;
+
+    for (auto iter = insts.begin(); iter != insts.end();) {
+
+        Instruction * inst = *iter;
+
+        if (isa<LabelInstruction>(inst) && (blockSize > 0)) {
+            BasicBlock * block = newBlock();
+            block->getInsts().splice(block->getInsts().end(), insts, blockBegin, iter, blockSize);
+            blockBegin = iter;
+            blockSize = 0;
+        }
+
+        ++iter;
+        blockSize++;
+
+        // 跳转指令结束当前块
+        if (isa<GotoInstruction>(inst) || isa<ExitInstruction>(inst) || (iter == insts.end())) {
+            BasicBlock * block = newBlock();
+            block->getInsts().splice(block->getInsts().end(), insts, blockBegin, iter, blockSize);
+            blockBegin = iter;
+            blockSize = 0;
+        }
+    }
+
+    // Label指令都在块的开头，记录Label指令到所在块的映射，用于确定跳转的目标块
+    std::unordered_map<Instruction *, BasicBlock *> labelBlocks;
+    labelBlocks.reserve(blocks.size());
+
+    for (BasicBlock * block: blocks) {
+        if (LabelInstruction * label = block->getLabel()) {
+            labelBlocks.emplace(label, block);
+        }
+    }
+
+    // 建立边：无条件跳转到目标块，出口指令没有后继，其它情况直接进入布局中的下一个块
+    for (std::size_t k = 0; k < blocks.size(); k++) {
+
+        BasicBlock * block = blocks[k];
+        Instruction * terminator = block->getTerminator();
+
+        if (auto * gotoInst = dyn_cast_or_null<GotoInstruction>(terminator)) {
+
+            auto labelIter = labelBlocks.find(gotoInst->getTarget());
+            if (labelIter == labelBlocks.end()) {
+                minic_log(LOG_ERROR, "函数%s的跳转目标不在函数内", func->getName().c_str());
+                continue;
+            }
+
+            block->addSuccessor(labelIter->second);
+
+        } else if ((terminator == nullptr) && (k + 1 < blocks.size())) {
+            block->addSuccessor(blocks[k + 1]);
+        }
+    }
+
+    computeReversePostOrder();
+}
+
+/// @brief 析构函数，尚未线性化时先线性化
+ControlFlowGraph::~ControlFlowGraph()
+{
+    if (!linearized) {
+        linearize();
+    }
+}
+
+/// @brief 新建一个空的基本块，加入到布局的末尾
+/// @return BasicBlock* 基本块
+BasicBlock * ControlFlowGraph::newBlock()
+{
+    BasicBlock * block = &storage.emplace_back((int32_t) storage.size());
+
+    blocks.push_back(block);
+
+    return block;
+}
+
+/// @brief 重新计算逆后序
+void ControlFlowGraph::computeReversePostOrder()
+{
+    rpo.clear();
+
+    for (BasicBlock & block: storage) {
+        block.setRPONumber(-1);
+    }
+
+    BasicBlock * entry = getEntry();
+    if (entry == nullptr) {
+        return;
+    }
+
+    // 非递归的深度优先遍历，栈中记录块以及下一个要访问的后继的下标，避免长函数的递归过深
+    std::vector<std::pair<BasicBlock *, std::size_t>> stack;
+    std::vector<bool> visited(storage.size(), false);
+
+    visited[(std::size_t) entry->getIndex()] = true;
+    stack.emplace_back(entry, 0);
+
+    while (!stack.empty()) {
+
+        BasicBlock * block = stack.back().first;
+        std::size_t & next = stack.back().second;
+
+        std::vector<BasicBlock *> & succs = block->getSuccessors();
+
+        if (next < succs.size()) {
+
+            BasicBlock * succ = succs[next++];
+
+            if (!visited[(std::size_t) succ->getIndex()]) {
+                visited[(std::size_t) succ->getIndex()] = true;
+                stack.emplace_back(succ, 0);
+            }
+
+            continue;
+        }
+
+        // 所有的后继都已访问，得到后序
+        rpo.push_back(block);
+        stack.pop_back();
+    }
+
+    std::reverse(rpo.begin(), rpo.end());
+
+    for (std::size_t k = 0; k < rpo.size(); k++) {
+        rpo[k]->setRPONumber((int32_t) k);
+    }
+}
+
+/// @brief 删除从入口不可达的块及其指令
+void ControlFlowGraph::removeUnreachableBlocks()
+{
+    std::vector<BasicBlock *> dead;
+    std::size_t kept = 0;
+
+    for (BasicBlock * block: blocks) {
+        if (block->isReachable()) {
+            blocks[kept++] = block;
+        } else {
+            dead.push_back(block);
+        }
+    }
+
+    if (dead.empty()) {
+        return;
+    }
+
+    blocks.resize(kept);
+
+    // 不可达块的后继可能可达，先断开边；不可达块的前驱一定也不可达
+    for (BasicBlock * block: dead) {
+        while (!block->getSuccessors().empty()) {
+            block->removeSuccessor(block->getSuccessors().back());
+        }
+    }
+
+    // 指令之间可能跨块使用，全部解除操作数后再删除
+    for (BasicBlock * block: dead) {
+        for (Instruction * inst: block->getInsts()) {
+            inst->clearOperands();
+
+            if (inst == func->getExitLabel()) {
+                func->setExitLabel(nullptr);
+            }
+        }
+    }
+
+    for (BasicBlock * block: dead) {
+        block->getInterCode().Delete();
+    }
+}
+
+/// @brief 拆分pred到succ的边，在其间插入一个只含Label与跳转的新块
+/// @param pred 前驱块
+/// @param succ 后继块
+/// @return BasicBlock* 新块
+BasicBlock * ControlFlowGraph::splitEdge(BasicBlock * pred, BasicBlock * succ)
+{
+    LabelInstruction * succLabel = succ->getLabel();
+
+    BasicBlock * block = newBlock();
+    LabelInstruction * label = new (func) LabelInstruction(func);
+
+    block->getInsts().push_back(label);
+    block->getInsts().push_back(new (func) GotoInstruction(func, succLabel));
+
+    pred->replaceSuccessor(succ, block);
+    block->addSuccessor(succ);
+
+    // 直接进入的边由线性化补充跳转
+    auto * gotoInst = dyn_cast_or_null<GotoInstruction>(pred->getTerminator());
+    if (gotoInst && (gotoInst->getTarget() == succLabel)) {
+        gotoInst->setTarget(label);
+    }
+
+    return block;
+}
+
+/// @brief 按布局次序把各块的指令交还给函数
+void ControlFlowGraph::linearize()
+{
+    InstList & insts = func->getInterCode().getInsts();
+
+    for (std::size_t k = 0; k < blocks.size(); k++) {
+
+        BasicBlock * block = blocks[k];
+
+        // 直接进入的后继不再紧随其后时，需要显式地跳转
+        if ((block->getTerminator() == nullptr) && !block->getSuccessors().empty()) {
+
+            BasicBlock * succ = block->getSuccessors().front();
+            BasicBlock * next = (k + 1 < blocks.size()) ? blocks[k + 1] : nullptr;
+
+            if (succ != next) {
+                block->getInsts().push_back(new (func) GotoInstruction(func, succ->getLabel()));
+            }
+        }
+    }
+
+    // 块的指令交还给函数后块为空，取不到Label，因此补充完跳转后再统一交还
+    for (BasicBlock * block: blocks) {
+        insts.splice(insts.end(), block->getInsts());
+    }
+
+    linearized = true;
+    rpo.clear();
+}
+
+/// @brief 输出各块的前驱与后继，用于调试
+/// @param str 输出的字符串，追加到尾部
+void ControlFlowGraph::toString(std::string & str)
+{
+    for (BasicBlock * block: blocks) {
+
+        str += block->getName() + ": " + std::to_string(block->getInsts().size()) + " insts, preds";
+        for (BasicBlock * pred: block->getPredecessors()) {
+            str += " " + pred->getName();
+        }
+
+        str += ", succs";
+        for (BasicBlock * succ: block->getSuccessors()) {
+            str += " " + succ->getName();
+        }
+
+        str += block->isReachable() ? "\n" : ", unreachable\n";
+    }
+}
@@ -0,0 +1,156 @@
+///
+/// @file ControlFlowGraph.h
+/// @brief 控制流图的头文件
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+/// 优化的Pass通过控制流图处理函数：
+/// @code
+/// ControlFlowGraph cfg(func);
+/// for (BasicBlock * block: cfg.getReversePostOrder()) {
+///     处理块内的指令...
+/// }
+/// cfg.linearize();
+/// @endcode
+/// 构建时函数的指令移入各基本块，线性化时再按块的次序交还给函数，供指令选择等使用。
+/// 构建与线性化都与指令数成线性关系，每个Pass可重新构建。
+///
+#pragma once
+
+#include <deque>
+#include <vector>
+
+#include "BasicBlock.h"
+
+class Function;
+
+///
+/// @brief 函数的控制流图
+///
+class ControlFlowGraph {
+
+public:
+    ///
+    /// @brief 构造函数，由函数的线性IR构建基本块与边，并计算逆后序
+    /// @param _func 函数
+    ///
+    explicit ControlFlowGraph(Function * _func);
+
+    ///
+    /// @brief 析构函数，尚未线性化时先线性化，保证函数的指令不丢失
+    ///
+    ~ControlFlowGraph();
+
+    ///
+    /// @brief 下列操作不被允许，控制流图不能拷贝
+    ///
+    ControlFlowGraph(const ControlFlowGraph &) = delete;
+    ControlFlowGraph & operator=(const ControlFlowGraph &) = delete;
+
+    ///
+    /// @brief 获取函数
+    /// @return Function*
+    ///
+    Function * getFunction()
+    {
+        return func;
+    }
+
+    ///
+    /// @brief 获取按布局次序排列的基本块，线性化按此次序输出，Pass可调整次序
+    /// @return std::vector<BasicBlock *>&
+    ///
+    std::vector<BasicBlock *> & getBlocks()
+    {
+        return blocks;
+    }
+
+    ///
+    /// @brief 获取入口块
+    /// @return BasicBlock* 入口块，函数没有指令时为空指针
+    ///
+    BasicBlock * getEntry()
+    {
+        return blocks.empty() ? nullptr : blocks.front();
+    }
+
+    ///
+    /// @brief 获取基本块的个数，块的编号小于该值
+    /// @return int32_t 个数
+    ///
+    [[nodiscard]] int32_t getBlockCount() const
+    {
+        return (int32_t) storage.size();
+    }
+
+    ///
+    /// @brief 获取从入口可达的基本块的逆后序，前驱（回边除外）排在后继前面
+    /// @return const std::vector<BasicBlock *>&
+    ///
+    const std::vector<BasicBlock *> & getReversePostOrder() const
+    {
+        return rpo;
+    }
+
+    ///
+    /// @brief 重新计算逆后序，Pass修改了边后调用
+    ///
+    void computeReversePostOrder();
+
+    ///
+    /// @brief 新建一个空的基本块，加入到布局的末尾
+    /// @return BasicBlock* 基本块
+    ///
+    BasicBlock * newBlock();
+
+    ///
+    /// @brief 删除从入口不可达的块及其指令，基于当前的逆后序
+    ///
+    void removeUnreachableBlocks();
+
+    ///
+    /// @brief 拆分pred到succ的边，在其间插入一个只含Label与跳转的新块，用于拆分关键边。
+    /// succ必须以Label开头；pred以跳转指令到达succ时改为跳转到新块
+    /// @param pred 前驱块
+    /// @param succ 后继块
+    /// @return BasicBlock* 新块，加入到布局的末尾
+    ///
+    BasicBlock * splitEdge(BasicBlock * pred, BasicBlock * succ);
+
+    ///
+    /// @brief 按布局次序把各块的指令交还给函数。块直接进入的后继不是布局中的下一个块时，补充跳转指令。
+    /// 线性化后控制流图不再可用
+    ///
+    void linearize();
+
+    ///
+    /// @brief 输出各块的前驱与后继，用于调试
+    /// @param str 输出的字符串，追加到尾部
+    ///
+    void toString(std::string & str);
+
+private:
+    /// @brief 函数
+    Function * func;
+
+    /// @brief 基本块的存储，deque增加元素时已有元素的地址不变
+    std::deque<BasicBlock> storage;
+
+    /// @brief 按布局次序排列的基本块
+    std::vector<BasicBlock *> blocks;
+
+    /// @brief 可达块的逆后序
+    std::vector<BasicBlock *> rpo;
+
+    /// @brief 是否已线性化
+    bool linearized = false;
+};
@@ -0,0 +1,386 @@
+///
+/// @file DominatorTree.cpp
+/// @brief 支配树与支配边界的实现
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#include <algorithm>
+#include <utility>
+
+#include "DominatorTree.h"
+#include "ControlFlowGraph.h"
+
+/// @brief 构造函数，计算直接支配者、支配树的先序区间以及支配边界
+/// @param cfg 控制流图
+/// @param _post true：后支配树 false：支配树
+DominatorTree::DominatorTree(ControlFlowGraph & cfg, bool _post) : post(_post)
+{
+    buildGraph(cfg);
+    computeIDom();
+    computeIntervals();
+    computeFrontiers();
+}
+
+/// @brief 按计算的方向把控制流图转换为以块编号为节点的前驱、后继数组
+/// @param cfg 控制流图
+void DominatorTree::buildGraph(ControlFlowGraph & cfg)
+{
+    int32_t blockCount = cfg.getBlockCount();
+
+    nodeCount = post ? blockCount + 1 : blockCount;
+    root = post ? blockCount : (cfg.getEntry() ? cfg.getEntry()->getIndex() : -1);
+
+    blockOf.assign((std::size_t) nodeCount, nullptr);
+
+    // 计算方向上的边，后支配树时边反向，并由虚拟出口连向所有没有后继的块
+    std::vector<std::pair<int32_t, int32_t>> edges;
+
+    for (BasicBlock * block: cfg.getBlocks()) {
+
+        int32_t v = block->getIndex();
+        blockOf[(std::size_t) v] = block;
+
+        for (BasicBlock * succ: block->getSuccessors()) {
+            if (post) {
+                edges.emplace_back(succ->getIndex(), v);
+            } else {
+                edges.emplace_back(v, succ->getIndex());
+            }
+        }
+
+        if (post && block->getSuccessors().empty()) {
+            edges.emplace_back(root, v);
+        }
+    }
+
+    // 计数后按起点排放，得到紧凑的前驱、后继数组
+    succStart.assign((std::size_t) nodeCount + 1, 0);
+    predStart.assign((std::size_t) nodeCount + 1, 0);
+
+    for (auto & [from, to]: edges) {
+        succStart[(std::size_t) from + 1]++;
+        predStart[(std::size_t) to + 1]++;
+    }
+
+    for (int32_t v = 0; v < nodeCount; v++) {
+        succStart[(std::size_t) v + 1] += succStart[(std::size_t) v];
+        predStart[(std::size_t) v + 1] += predStart[(std::size_t) v];
+    }
+
+    succList.resize(edges.size());
+    predList.resize(edges.size());
+
+    std::vector<int32_t> succPos(succStart.begin(), succStart.end() - 1);
+    std::vector<int32_t> predPos(predStart.begin(), predStart.end() - 1);
+
+    for (auto & [from, to]: edges) {
+        succList[(std::size_t) succPos[(std::size_t) from]++] = to;
+        predList[(std::size_t) predPos[(std::size_t) to]++] = from;
+    }
+}
+
+/// @brief 迭代计算直接支配者
+void DominatorTree::computeIDom()
+{
+    postNumber.assign((std::size_t) nodeCount, -1);
+    idom.assign((std::size_t) nodeCount, -1);
+    rpo.clear();
+
+    if (root < 0) {
+        return;
+    }
+
+    // 非递归的深度优先遍历求后序，栈中记录节点以及下一个要访问的后继在succList中的位置
+    std::vector<std::pair<int32_t, int32_t>> stack;
+    std::vector<bool> visited((std::size_t) nodeCount, false);
+
+    visited[(std::size_t) root] = true;
+    stack.emplace_back(root, succStart[(std::size_t) root]);
+
+    while (!stack.empty()) {
+
+        int32_t v = stack.back().first;
+        int32_t & next = stack.back().second;
+
+        if (next < succStart[(std::size_t) v + 1]) {
+
+            int32_t succ = succList[(std::size_t) next++];
+
+            if (!visited[(std::size_t) succ]) {
+                visited[(std::size_t) succ] = true;
+                stack.emplace_back(succ, succStart[(std::size_t) succ]);
+            }
+
+            continue;
+        }
+
+        postNumber[(std::size_t) v] = (int32_t) rpo.size();
+        rpo.push_back(v);
+        stack.pop_back();
+    }
+
+    std::reverse(rpo.begin(), rpo.end());
+
+    // 按逆后序迭代，每个节点的直接支配者为已处理的前驱的公共支配者
+    idom[(std::size_t) root] = root;
+
+    bool changed = true;
+    while (changed) {
+
+        changed = false;
+
+        for (int32_t v: rpo) {
+
+            if (v == root) {
+                continue;
+            }
+
+            int32_t newIDom = -1;
+
+            for (int32_t k = predStart[(std::size_t) v]; k < predStart[(std::size_t) v + 1]; k++) {
+
+                int32_t pred = predList[(std::size_t) k];
+
+                if (idom[(std::size_t) pred] < 0) {
+                    // 前驱尚未处理或不可达
+                    continue;
+                }
+
+                newIDom = (newIDom < 0) ? pred : intersect(pred, newIDom);
+            }
+
+            if (idom[(std::size_t) v] != newIDom) {
+                idom[(std::size_t) v] = newIDom;
+                changed = true;
+            }
+        }
+    }
+}
+
+/// @brief 沿直接支配者向上求两个节点的最近公共支配者
+/// @param a 节点
+/// @param b 节点
+/// @return int32_t 公共支配者
+int32_t DominatorTree::intersect(int32_t a, int32_t b) const
+{
+    // 支配者的后序号比被支配者的大，后序号小的一方向上走
+    while (a != b) {
+
+        while (postNumber[(std::size_t) a] < postNumber[(std::size_t) b]) {
+            a = idom[(std::size_t) a];
+        }
+
+        while (postNumber[(std::size_t) b] < postNumber[(std::size_t) a]) {
+            b = idom[(std::size_t) b];
+        }
+    }
+
+    return a;
+}
+
+/// @brief 建立支配树的子节点并计算先序区间
+void DominatorTree::computeIntervals()
+{
+    childStart.assign((std::size_t) nodeCount + 1, 0);
+    childList.resize(rpo.empty() ? 0 : rpo.size() - 1);
+    dfsIn.assign((std::size_t) nodeCount, -1);
+    dfsOut.assign((std::size_t) nodeCount, -1);
+    preOrder.clear();
+
+    if (root < 0) {
+        return;
+    }
+
+    // 按直接支配者计数后排放子节点，按逆后序加入使子节点的次序稳定
+    for (int32_t v: rpo) {
+        if (v != root) {
+            childStart[(std::size_t) idom[(std::size_t) v] + 1]++;
+        }
+    }
+
+    for (int32_t v = 0; v < nodeCount; v++) {
+        childStart[(std::size_t) v + 1] += childStart[(std::size_t) v];
+    }
+
+    std::vector<int32_t> childPos(childStart.begin(), childStart.end() - 1);
+
+    for (int32_t v: rpo) {
+        if (v != root) {
+            childList[(std::size_t) childPos[(std::size_t) idom[(std::size_t) v]]++] = blockOf[(std::size_t) v];
+        }
+    }
+
+    // 非递归的先序遍历，进入与离开时分别编号，栈中记录节点以及下一个要访问的子节点在childList中的位置。
+    // 虚拟出口不是块，不出现在先序中
+    std::vector<std::pair<int32_t, int32_t>> stack;
+    int32_t counter = 0;
+
+    if (!post) {
+        preOrder.push_back(blockOf[(std::size_t) root]);
+    }
+
+    dfsIn[(std::size_t) root] = counter++;
+    stack.emplace_back(root, childStart[(std::size_t) root]);
+
+    while (!stack.empty()) {
+
+        int32_t v = stack.back().first;
+        int32_t & next = stack.back().second;
+
+        if (next < childStart[(std::size_t) v + 1]) {
+
+            BasicBlock * child = childList[(std::size_t) next++];
+            int32_t c = child->getIndex();
+
+            dfsIn[(std::size_t) c] = counter++;
+            preOrder.push_back(child);
+            stack.emplace_back(c, childStart[(std::size_t) c]);
+
+            continue;
+        }
+
+        dfsOut[(std::size_t) v] = counter++;
+        stack.pop_back();
+    }
+}
+
+/// @brief 计算支配边界
+void DominatorTree::computeFrontiers()
+{
+    // 汇合点的每个前驱沿直接支配者向上，直到汇合点的直接支配者，途经的节点的支配边界都包含该汇合点。
+    // 先记录(节点, 汇合点)对，再按节点排放
+    std::vector<std::pair<int32_t, int32_t>> pairs;
+
+    // 节点最近加入的汇合点，同一汇合点在处理完之前不会重复加入
+    std::vector<int32_t> lastJoin((std::size_t) nodeCount, -1);
+
+    for (int32_t v: rpo) {
+
+        if (predStart[(std::size_t) v + 1] - predStart[(std::size_t) v] < 2) {
+            continue;
+        }
+
+        for (int32_t k = predStart[(std::size_t) v]; k < predStart[(std::size_t) v + 1]; k++) {
+
+            int32_t runner = predList[(std::size_t) k];
+
+            if (idom[(std::size_t) runner] < 0) {
+                continue;
+            }
+
+            while (runner != idom[(std::size_t) v]) {
+
+                if (lastJoin[(std::size_t) runner] != v) {
+                    lastJoin[(std::size_t) runner] = v;
+                    pairs.emplace_back(runner, v);
+                }
+
+                runner = idom[(std::size_t) runner];
+            }
+        }
+    }
+
+    frontierStart.assign((std::size_t) nodeCount + 1, 0);
+    frontierList.resize(pairs.size());
+
+    for (auto & [v, join]: pairs) {
+        frontierStart[(std::size_t) v + 1]++;
+    }
+
+    for (int32_t v = 0; v < nodeCount; v++) {
+        frontierStart[(std::size_t) v + 1] += frontierStart[(std::size_t) v];
+    }
+
+    std::vector<int32_t> frontierPos(frontierStart.begin(), frontierStart.end() - 1);
+
+    for (auto & [v, join]: pairs) {
+        frontierList[(std::size_t) frontierPos[(std::size_t) v]++] = blockOf[(std::size_t) join];
+    }
+}
+
+/// @brief 获取支配树的根
+/// @return BlockRange 支配树时为入口块，后支配树时为所有出口块
+BlockRange DominatorTree::getRoots() const
+{
+    if (root < 0) {
+        return {nullptr, nullptr};
+    }
+
+    if (post) {
+        return getChildrenOf(root);
+    }
+
+    return {blockOf.data() + root, blockOf.data() + root + 1};
+}
+
+/// @brief 获取直接支配者
+/// @param block 基本块
+/// @return BasicBlock* 直接支配者，根或不可达的块为空指针
+BasicBlock * DominatorTree::getIDom(BasicBlock * block) const
+{
+    int32_t v = block->getIndex();
+
+    if ((v == root) || (idom[(std::size_t) v] < 0)) {
+        return nullptr;
+    }
+
+    return blockOf[(std::size_t) idom[(std::size_t) v]];
+}
+
+/// @brief 获取节点在支配树中的子节点
+/// @param v 节点
+/// @return BlockRange
+BlockRange DominatorTree::getChildrenOf(int32_t v) const
+{
+    return {childList.data() + childStart[(std::size_t) v], childList.data() + childStart[(std::size_t) v + 1]};
+}
+
+/// @brief 获取支配树中的子节点
+/// @param block 基本块
+/// @return BlockRange
+BlockRange DominatorTree::getChildren(BasicBlock * block) const
+{
+    return getChildrenOf(block->getIndex());
+}
+
+/// @brief 获取支配边界
+/// @param block 基本块
+/// @return BlockRange
+BlockRange DominatorTree::getFrontier(BasicBlock * block) const
+{
+    auto v = (std::size_t) block->getIndex();
+
+    return {frontierList.data() + frontierStart[v], frontierList.data() + frontierStart[v + 1]};
+}
+/// @brief 块是否在支配树中
+/// @param block 基本块
+/// @return true：在 false：不在
+bool DominatorTree::contains(BasicBlock * block) const
+{
+    return dfsIn[(std::size_t) block->getIndex()] >= 0;
+}
+
+/// @brief a是否支配b
+/// @param a 基本块
+/// @param b 基本块
+/// @return true：支配 false：不支配
+bool DominatorTree::dominates(BasicBlock * a, BasicBlock * b) const
+{
+    auto va = (std::size_t) a->getIndex();
+    auto vb = (std::size_t) b->getIndex();
+
+    if ((dfsIn[va] < 0) || (dfsIn[vb] < 0)) {
+        return false;
+    }
+
+    return (dfsIn[va] <= dfsIn[vb]) && (dfsOut[vb] <= dfsOut[va]);
+}
@@ -0,0 +1,242 @@
+///
+/// @file DominatorTree.h
+/// @brief 支配树与支配边界的头文件
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+/// 支配树采用Cooper、Harvey与Kennedy的迭代算法计算，按逆后序迭代直到直接支配者不再变化，
+/// 可归约的控制流图通常两遍即收敛。所有的结果都存放在以块编号为下标的数组中，
+/// dominates按支配树的先序区间判断，为O(1)。
+///
+/// 后支配树在反向的控制流图上计算，以一个虚拟的出口作为根，所有没有后继的块都是它的子节点，
+/// 因而多个出口的函数也只有一棵后支配树。
+///
+/// 控制流图的块或边变化后支配树失效，需重新构建。
+///
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class BasicBlock;
+class ControlFlowGraph;
+
+///
+/// @brief 支配树中一段连续存放的块，子节点、支配边界等查询的结果
+///
+class BlockRange {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _first 第一个块的位置
+    /// @param _last 最后一个块之后的位置
+    ///
+    BlockRange(BasicBlock * const * _first, BasicBlock * const * _last) : first(_first), last(_last)
+    {}
+
+    [[nodiscard]] BasicBlock * const * begin() const
+    {
+        return first;
+    }
+
+    [[nodiscard]] BasicBlock * const * end() const
+    {
+        return last;
+    }
+
+    [[nodiscard]] std::size_t size() const
+    {
+        return (std::size_t) (last - first);
+    }
+
+    [[nodiscard]] bool empty() const
+    {
+        return first == last;
+    }
+
+    BasicBlock * operator[](std::size_t index) const
+    {
+        return first[index];
+    }
+
+private:
+    BasicBlock * const * first;
+    BasicBlock * const * last;
+};
+
+///
+/// @brief 控制流图的支配树或后支配树，以及相应的支配边界
+///
+class DominatorTree {
+
+public:
+    ///
+    /// @brief 构造函数，计算直接支配者、支配树的先序区间以及支配边界
+    /// @param cfg 控制流图
+    /// @param _post true：后支配树 false：支配树
+    ///
+    explicit DominatorTree(ControlFlowGraph & cfg, bool _post = false);
+
+    ///
+    /// @brief 是否为后支配树
+    /// @return true：后支配树 false：支配树
+    ///
+    [[nodiscard]] bool isPostDominator() const
+    {
+        return post;
+    }
+
+    ///
+    /// @brief 获取支配树的根，支配树时为入口块，后支配树时为所有出口块（虚拟出口的子节点）
+    /// @return BlockRange
+    ///
+    [[nodiscard]] BlockRange getRoots() const;
+
+    ///
+    /// @brief 获取直接支配者（后支配树时为直接后支配者）
+    /// @param block 基本块
+    /// @return BasicBlock* 直接支配者，根或不可达的块为空指针
+    ///
+    BasicBlock * getIDom(BasicBlock * block) const;
+
+    ///
+    /// @brief 获取支配树中的子节点，即直接支配者为block的块
+    /// @param block 基本块
+    /// @return BlockRange
+    ///
+    [[nodiscard]] BlockRange getChildren(BasicBlock * block) const;
+
+    ///
+    /// @brief 获取支配边界（后支配树时为后支配边界），块只出现一次，次序不确定
+    /// @param block 基本块
+    /// @return BlockRange
+    ///
+    [[nodiscard]] BlockRange getFrontier(BasicBlock * block) const;
+
+    ///
+    /// @brief 获取按支配树先序排列的可达块，父节点排在子节点之前
+    /// @return const std::vector<BasicBlock *>&
+    ///
+    const std::vector<BasicBlock *> & getPreOrder() const
+    {
+        return preOrder;
+    }
+
+    ///
+    /// @brief 块是否在支配树中，即从入口可达（后支配树时为可到达出口）
+    /// @param block 基本块
+    /// @return true：在 false：不在
+    ///
+    [[nodiscard]] bool contains(BasicBlock * block) const;
+
+    ///
+    /// @brief a是否支配b，每个块都支配自身。任一块不在支配树中时为false
+    /// @param a 基本块
+    /// @param b 基本块
+    /// @return true：支配 false：不支配
+    ///
+    [[nodiscard]] bool dominates(BasicBlock * a, BasicBlock * b) const;
+
+    ///
+    /// @brief a是否严格支配b，即a支配b且a不是b
+    /// @param a 基本块
+    /// @param b 基本块
+    /// @return true：严格支配 false：不严格支配
+    ///
+    [[nodiscard]] bool strictlyDominates(BasicBlock * a, BasicBlock * b) const
+    {
+        return (a != b) && dominates(a, b);
+    }
+
+private:
+    ///
+    /// @brief 按计算的方向把控制流图转换为以块编号为节点的前驱、后继数组
+    /// @param cfg 控制流图
+    ///
+    void buildGraph(ControlFlowGraph & cfg);
+
+    ///
+    /// @brief 迭代计算直接支配者
+    ///
+    void computeIDom();
+
+    ///
+    /// @brief 建立支配树的子节点并计算先序区间
+    ///
+    void computeIntervals();
+
+    ///
+    /// @brief 计算支配边界
+    ///
+    void computeFrontiers();
+
+    ///
+    /// @brief 沿直接支配者向上求两个节点的最近公共支配者
+    /// @param a 节点
+    /// @param b 节点
+    /// @return int32_t 公共支配者
+    ///
+    [[nodiscard]] int32_t intersect(int32_t a, int32_t b) const;
+
+    ///
+    /// @brief 获取节点在支配树中的子节点，节点可以是虚拟出口
+    /// @param v 节点
+    /// @return BlockRange
+    ///
+    [[nodiscard]] BlockRange getChildrenOf(int32_t v) const;
+
+    /// @brief 是否为后支配树
+    bool post;
+
+    /// @brief 节点数，后支配树时包含虚拟出口
+    int32_t nodeCount = 0;
+
+    /// @brief 根节点，后支配树时为虚拟出口，编号为块数
+    int32_t root = 0;
+
+    /// @brief 节点对应的块，虚拟出口为空指针
+    std::vector<BasicBlock *> blockOf;
+
+    /// @brief 计算方向上的后继，succList[succStart[v], succStart[v + 1])为节点v的后继
+    std::vector<int32_t> succStart;
+    std::vector<int32_t> succList;
+
+    /// @brief 计算方向上的前驱，格式同后继
+    std::vector<int32_t> predStart;
+    std::vector<int32_t> predList;
+
+    /// @brief 计算方向上可达节点的逆后序
+    std::vector<int32_t> rpo;
+
+    /// @brief 节点的后序号，不可达时为-1
+    std::vector<int32_t> postNumber;
+
+    /// @brief 直接支配者，根为自身，不可达时为-1
+    std::vector<int32_t> idom;
+
+    /// @brief 节点在支配树先序中的进入序号与离开序号，a支配b当且仅当b的区间包含在a的区间内
+    std::vector<int32_t> dfsIn;
+    std::vector<int32_t> dfsOut;
+
+    /// @brief 支配树中的子节点，格式同后继
+    std::vector<int32_t> childStart;
+    std::vector<BasicBlock *> childList;
+
+    /// @brief 支配边界，格式同后继
+    std::vector<int32_t> frontierStart;
+    std::vector<BasicBlock *> frontierList;
+
+    /// @brief 支配树的先序
+    std::vector<BasicBlock *> preOrder;
+};
@@ -16,6 +16,7 @@
 
 #include <cstdlib>
 #include <string>
+#include <new>
 
 #include "IRConstant.h"
 #include "Function.h"
@@ -25,7 +26,7 @@
 /// @param _type 函数类型
 /// @param _builtin 是否是内置函数
 Function::Function(std::string _name, FunctionType * _type, bool _builtin)
-    : GlobalValue(_type, _name), builtIn(_builtin)
+    : GlobalValue(_type, _name, ValueKind::VALUE_FUNCTION), builtIn(_builtin)
 {
     returnType = _type->getReturnType();
 
@@ -40,6 +41,13 @@ Function::Function(std::string _name, FunctionType * _type, bool _builtin)
 Function::~Function()
 {
     Delete();
+
+    // 形参与函数类型由Module::newFunction创建，随函数释放
+    for (auto param: params) {
+        delete param;
+    }
+
+    delete getType();
 }
 
 /// @brief 获取函数返回类型
@@ -117,7 +125,7 @@ void Function::toString(std::string & str)
 
     // 输出临时变量的declare形式
     // 遍历所有的线性IR指令，文本输出
-    for (auto & inst: code.getInsts()) {
+    for (auto inst: code.getInsts()) {
 
         if (inst->hasResultValue()) {
 
@@ -127,7 +135,7 @@ void Function::toString(std::string & str)
     }
 
     // 遍历所有的线性IR指令，文本输出
-    for (auto & inst: code.getInsts()) {
+    for (auto inst: code.getInsts()) {
 
         std::string instStr;
         inst->toString(instStr);
@@ -241,7 +249,9 @@ void Function::setExistFuncCall(bool exist)
 LocalVariable * Function::newLocalVarValue(Type * type, std::string name, int32_t scope_level)
 {
     // 创建变量并加入符号表
-    LocalVariable * varValue = new LocalVariable(type, name, scope_level);
+    // 构造函数私有，只能在这里通过定位new在内存池中创建
+    void * mem = irArena.allocate(sizeof(LocalVariable), alignof(LocalVariable));
+    LocalVariable * varValue = new (mem) LocalVariable(type, name, scope_level);
 
     // varsVector表中可能存在变量重名的信息
     varsVector.push_back(varValue);
@@ -249,31 +259,90 @@ LocalVariable * Function::newLocalVarValue(Type * type, std::string name, int32_
     return varValue;
 }
 
+/// @brief 删除不再被使用的局部变量，返回值变量被删除时一并清空
+void Function::removeUnusedVarValues()
+{
+    std::size_t kept = 0;
+
+    for (auto var: varsVector) {
+
+        if (var->hasUses()) {
+            varsVector[kept++] = var;
+            continue;
+        }
+
+        if (var == returnValue) {
+            returnValue = nullptr;
+        }
+
+        // 内存随IR内存池整体释放，这里只析构
+        var->~LocalVariable();
+    }
+
+    varsVector.resize(kept);
+}
+
 /// @brief 新建一个内存型的Value，并加入到符号表，用于后续释放空间
 /// \param type 变量类型
 /// \return 临时变量Value
 MemVariable * Function::newMemVariable(Type * type)
 {
     // 肯定唯一存在，直接插入即可
-    MemVariable * memValue = new MemVariable(type);
+    void * mem = irArena.allocate(sizeof(MemVariable), alignof(MemVariable));
+    MemVariable * memValue = new (mem) MemVariable(type);
 
     memVector.push_back(memValue);
 
     return memValue;
 }
 
+/// @brief 获取代表物理寄存器的Value，同一个寄存器在本函数内只创建一份
+/// @param type 寄存器的类型
+/// @param name 寄存器的名字
+/// @param regId 寄存器编号
+/// @return RegVariable* 寄存器Value
+RegVariable * Function::getRegVariable(Type * type, const std::string & name, int32_t regId)
+{
+    if ((std::size_t) regId >= regVector.size()) {
+        regVector.resize((std::size_t) regId + 1, nullptr);
+    }
+
+    RegVariable *& regValue = regVector[(std::size_t) regId];
+    if (!regValue) {
+        void * mem = irArena.allocate(sizeof(RegVariable), alignof(RegVariable));
+        regValue = new (mem) RegVariable(type, name, regId);
+    }
+
+    return regValue;
+}
+
 /// @brief 清理函数内申请的资源
 void Function::Delete()
 {
-    // 清理IR指令
+    // 清理IR指令，这里只析构指令，并解除与其它Value的使用关系
     code.Delete();
 
-    // 清理Value
-    for (auto & var: varsVector) {
-        delete var;
+    // 变量只析构，不单独释放内存
+    for (auto var: varsVector) {
+        var->~LocalVariable();
+    }
+
+    for (auto var: memVector) {
+        var->~MemVariable();
+    }
+
+    for (auto var: regVector) {
+        if (var) {
+            var->~RegVariable();
+        }
     }
 
     varsVector.clear();
+    memVector.clear();
+    regVector.clear();
+
+    // 函数内的IR内存一次性释放
+    irArena.reset();
 }
 
 ///
@@ -18,11 +18,13 @@
 #include <string>
 #include <vector>
 
+#include "Arena.h"
 #include "GlobalValue.h"
 #include "FunctionType.h"
 #include "FormalParam.h"
 #include "LocalVariable.h"
 #include "MemVariable.h"
+#include "RegVariable.h"
 #include "IRCode.h"
 
 ///
@@ -96,6 +98,16 @@ public:
         return true;
     }
 
+    ///
+    /// @brief 用于isa/cast/dyn_cast的类型判断
+    /// @param val Value
+    /// @return true：是函数
+    ///
+    static bool classof(const Value * val)
+    {
+        return val->getValueKind() == ValueKind::VALUE_FUNCTION;
+    }
+
     /// @brief 获取最大栈帧深度
     /// @return 栈帧深度
     int getMaxDep();
@@ -141,11 +153,30 @@ public:
     /// @param existInit 缺省为true。若真，则已存在需要进行初始化，否则什么都不做
     LocalVariable * newLocalVarValue(Type * type, std::string name = "", int32_t scope_level = 1);
 
+    /// @brief 删除不再被使用的局部变量，优化把变量提升为SSA值后调用，被删除的变量不再分配栈空间。
+    /// 返回值变量被删除时一并清空
+    void removeUnusedVarValues();
+
     /// @brief 新建一个内存型的Value，并加入到符号表，用于后续释放空间
     /// \param type 变量类型
     /// \return 临时变量Value
     MemVariable * newMemVariable(Type * type);
 
+    /// @brief 获取代表物理寄存器的Value，同一个寄存器在本函数内只创建一份，首次获取时创建。
+    /// 寄存器Value作为本函数指令的操作数，其使用关系只涉及本函数，不同函数可在不同的线程中处理
+    /// @param type 寄存器的类型
+    /// @param name 寄存器的名字
+    /// @param regId 寄存器编号
+    /// @return RegVariable* 寄存器Value
+    RegVariable * getRegVariable(Type * type, const std::string & name, int32_t regId);
+
+    /// @brief 获取函数的IR内存池，函数内的指令、变量都从这里申请
+    /// @return IR内存池
+    Arena & getIRArena()
+    {
+        return irArena;
+    }
+
     /// @brief 清理函数内申请的资源
     void Delete();
 
@@ -186,6 +217,12 @@ private:
     ///
     bool builtIn = false;
 
+    ///
+    /// @brief 函数的IR内存池，指令、局部变量与内存变量从中连续分配，Delete时整体释放。
+    /// 必须定义在code之前，保证析构时指令先于内存池被析构
+    ///
+    Arena irArena{16 * 1024};
+
     ///
     /// @brief 线性IR指令块，可包含多条IR指令
     ///
@@ -201,6 +238,11 @@ private:
     ///
     std::vector<MemVariable *> memVector;
 
+    ///
+    /// @brief 寄存器型Value，按寄存器编号索引，没有创建的为空指针
+    ///
+    std::vector<RegVariable *> regVector;
+
     ///
     /// @brief 函数出口Label指令
     ///
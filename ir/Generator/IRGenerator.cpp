@@ -30,6 +30,7 @@
 #include "ExitInstruction.h"
 #include "MoveInstruction.h"
 #include "GotoInstruction.h"
+#include "TimeReport.h"
 
 /// @brief 构造函数
 /// @param _root AST的根
@@ -151,6 +152,8 @@ bool IRGenerator::ir_function_define(ast_node * node)
     ast_node * param_node = node->sons[2];
     ast_node * block_node = node->sons[3];
 
+    TimeScope scope("function definition", [name_node] { return std::string(symbolName(name_node->name)); });
+
     // 创建一个新的函数定义
     Function * newFunc = module->newFunction(name_node->name, type_node->type);
     if (!newFunc) {
@@ -171,10 +174,10 @@ bool IRGenerator::ir_function_define(ast_node * node)
     // 这里也可增加一个函数入口Label指令，便于后续基本块划分
 
     // 创建并加入Entry入口指令
-    irCode.addInst(new EntryInstruction(newFunc));
+    irCode.addInst(new (newFunc) EntryInstruction(newFunc));
 
     // 创建出口指令并不加入出口指令，等函数内的指令处理完毕后加入出口指令
-    LabelInstruction * exitLabelInst = new LabelInstruction(newFunc);
+    LabelInstruction * exitLabelInst = new (newFunc) LabelInstruction(newFunc);
 
     // 函数出口指令保存到函数信息中，因为在语义分析函数体时return语句需要跳转到函数尾部，需要这个label指令
     newFunc->setExitLabel(exitLabelInst);
@@ -220,7 +223,7 @@ bool IRGenerator::ir_function_define(ast_node * node)
     irCode.addInst(exitLabelInst);
 
     // 函数出口指令
-    irCode.addInst(new ExitInstruction(newFunc, retValue));
+    irCode.addInst(new (newFunc) ExitInstruction(newFunc, retValue));
 
     // 恢复成外部函数
     module->setCurrentFunction(nullptr);
@@ -256,7 +259,7 @@ bool IRGenerator::ir_block(ast_node * node)
         module->enterScope();
     }
 
-    std::vector<ast_node *>::iterator pIter;
+    ast_node_list::iterator pIter;
     for (pIter = node->sons.begin(); pIter != node->sons.end(); ++pIter) {
 
         // 遍历Block的每个语句，进行显示或者运算
@@ -307,7 +310,7 @@ bool IRGenerator::ir_return(ast_node * node)
         node->blockInsts.addInst(right->blockInsts);
 
         // 返回值赋值到函数返回值变量上，然后跳转到函数的尾部
-        node->blockInsts.addInst(new MoveInstruction(currentFunc, currentFunc->getReturnValue(), right->val));
+        node->blockInsts.addInst(new (currentFunc) MoveInstruction(currentFunc, currentFunc->getReturnValue(), right->val));
 
         node->val = right->val;
     } else {
@@ -316,7 +319,7 @@ bool IRGenerator::ir_return(ast_node * node)
     }
 
     // 跳转到函数的尾部出口指令上
-    node->blockInsts.addInst(new GotoInstruction(currentFunc, currentFunc->getExitLabel()));
+    node->blockInsts.addInst(new (currentFunc) GotoInstruction(currentFunc, currentFunc->getExitLabel()));
 
     node->val = right->val;
 
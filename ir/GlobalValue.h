@@ -62,13 +62,25 @@ public:
     /// @brief 构造函数
     /// @param _type  类型
     /// @param _name  全局符号名
+    /// @param _kind  具体类别
     ///
-    GlobalValue(Type * _type, std::string _name) : Constant(_type)
+    GlobalValue(Type * _type, std::string _name, ValueKind _kind) : Constant(_type, _kind)
     {
         this->name = _name;
         this->IRName = IR_GLOBAL_VARNAME_PREFIX + this->name;
     }
 
+    ///
+    /// @brief 用于isa/cast/dyn_cast的类型判断
+    /// @param val Value
+    /// @return true：是全局对象
+    ///
+    static bool classof(const Value * val)
+    {
+        return val->getValueKind() >= ValueKind::VALUE_FIRST_GLOBAL_VALUE &&
+               val->getValueKind() <= ValueKind::VALUE_LAST_GLOBAL_VALUE;
+    }
+
     /// @brief 获取名字
     /// @return 变量名
     [[nodiscard]] std::string getIRName() const override
@@ -25,13 +25,8 @@ InterCode::~InterCode()
 /// @param block 指令块，请注意加入后会自动清空block的指令
 void InterCode::addInst(InterCode & block)
 {
-    std::vector<Instruction *> & insert = block.getInsts();
-
-    code.insert(code.end(), insert.begin(), insert.end());
-
-    // InterCode析构会清理资源，因此移动指令到code中后必须清理，否则会释放多次导致程序例外
-    // 当然，这里也可不清理，但InterCode的析构函数不能清理，需专门的函数清理即可。
-    insert.clear();
+    // 整个链表拼接到尾部，block变为空，InterCode析构时就不会重复释放
+    code.splice(code.end(), block.getInsts());
 }
 
 /// @brief 添加一条中间指令
@@ -43,7 +38,7 @@ void InterCode::addInst(Instruction * inst)
 
 /// @brief 获取指令序列
 /// @return 指令序列
-std::vector<Instruction *> & InterCode::getInsts()
+InstList & InterCode::getInsts()
 {
     return code;
 }
@@ -56,10 +51,10 @@ void InterCode::Delete()
         inst->clearOperands();
     }
 
-    // 资源清理
-    for (auto inst: code) {
+    // 资源清理，先从链表中摘下再析构，内存由所属函数的IR内存池整体释放
+    while (!code.empty()) {
+        Instruction * inst = code.front();
+        code.remove(inst);
         delete inst;
     }
-
-    code.clear();
 }
@@ -16,16 +16,20 @@
 
 #pragma once
 
-#include <vector>
-
+#include "IntrusiveList.h"
 #include "Instruction.h"
 
+///
+/// @brief 指令序列，侵入式双向链表，插入与删除都是O(1)，迭代器在指令删除前一直有效
+///
+using InstList = IntrusiveList<Instruction>;
+
 /// @brief 中间IR指令序列管理类
 class InterCode {
 
 protected:
     /// @brief 指令块的指令序列
-    std::vector<Instruction *> code;
+    InstList code;
 
 public:
     /// @brief 构造函数
@@ -34,7 +38,7 @@ public:
     /// @brief 析构函数
     ~InterCode();
 
-    /// @brief 添加一个指令块，添加到尾部，并清除原来指令块的内容
+    /// @brief 添加一个指令块，添加到尾部，并清除原来指令块的内容，O(1)
     /// @param block 指令块，请注意加入后会自动清空block的指令
     void addInst(InterCode & block);
 
@@ -44,7 +48,7 @@ public:
 
     /// @brief 获取指令序列
     /// @return 指令序列
-    std::vector<Instruction *> & getInsts();
+    InstList & getInsts();
 
     /// @brief 删除所有指令
     void Delete();
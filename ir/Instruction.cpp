@@ -17,20 +17,32 @@
 
 #include "Instruction.h"
 #include "Function.h"
+#include "TraceEvent.h"
 
 /// @brief 构造函数
 /// @param op
 /// @param result
 /// @param srcVal1
 /// @param srcVal2
-Instruction::Instruction(Function * _func, IRInstOperator _op, Type * _type) : User(_type), op(_op), func(_func)
-{}
+Instruction::Instruction(Function * _func, IRInstOperator _op, Type * _type)
+    : User(_type, ValueKind::VALUE_INSTRUCTION), op(_op), func(_func)
+{
+    TraceEvent::adjustCounter(TraceCounter::IRInstructions, 1);
+}
+
+/// @brief 析构函数
+Instruction::~Instruction()
+{
+    TraceEvent::adjustCounter(TraceCounter::IRInstructions, -1);
+}
 
-/// @brief 获取指令操作码
-/// @return 指令操作码
-IRInstOperator Instruction::getOp()
+/// @brief 从所属函数的IR内存池中申请指令的内存
+/// @param size 字节数
+/// @param _func 所属函数
+/// @return void* 申请的内存
+void * Instruction::operator new(std::size_t size, Function * _func)
 {
-    return op;
+    return _func->getIRArena().allocate(size);
 }
 
 /// @brief 转换成字符串
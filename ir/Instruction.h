@@ -15,6 +15,9 @@
 ///
 #pragma once
 
+#include <cstddef>
+
+#include "IntrusiveList.h"
 #include "User.h"
 
 class Function;
@@ -49,6 +52,9 @@ enum class IRInstOperator : std::int8_t {
     /// @brief 实参ARG指令，单目运算
     IRINST_OP_ARG,
 
+    /// @brief PHI指令，SSA形式下汇合点处按前驱块选择值，只在控制流图存在期间出现
+    IRINST_OP_PHI,
+
     /* 后续可追加其他的IR指令 */
 
     /// @brief 最大指令码，也是无效指令
@@ -56,9 +62,9 @@ enum class IRInstOperator : std::int8_t {
 };
 
 ///
-/// @brief IR指令的基类, 指令自带值，也就是常说的临时变量
+/// @brief IR指令的基类, 指令自带值，也就是常说的临时变量。指令通过侵入式链表组织在InterCode中
 ///
-class Instruction : public User {
+class Instruction : public User, public IntrusiveListNode<Instruction> {
 
 public:
     /// @brief 构造函数
@@ -67,11 +73,46 @@ public:
     explicit Instruction(Function * _func, IRInstOperator op, Type * _type);
 
     /// @brief 析构函数
-    virtual ~Instruction() = default;
+    ~Instruction() override;
+
+    ///
+    /// @brief 指令的内存从所属函数的IR内存池中申请，用法为new (func) XxxInstruction(func, ...)。
+    /// 不提供普通的new，避免指令游离于函数内存池之外
+    /// @param size 字节数
+    /// @param _func 所属函数
+    /// @return void* 申请的内存
+    ///
+    static void * operator new(std::size_t size, Function * _func);
+    static void * operator new(std::size_t size) = delete;
+
+    ///
+    /// @brief delete指令时只调用析构函数，内存随函数的IR内存池整体释放
+    ///
+    static void operator delete(void *)
+    {}
+
+    ///
+    /// @brief 与带函数参数的new配对，构造函数抛出异常时使用，同样什么都不做
+    ///
+    static void operator delete(void *, Function *)
+    {}
 
     /// @brief 获取指令操作码
     /// @return 指令操作码
-    IRInstOperator getOp();
+    [[nodiscard]] IRInstOperator getOp() const
+    {
+        return op;
+    }
+
+    ///
+    /// @brief 用于isa/cast/dyn_cast的类型判断
+    /// @param val Value
+    /// @return true：是指令
+    ///
+    static bool classof(const Value * val)
+    {
+        return val->getValueKind() == ValueKind::VALUE_INSTRUCTION;
+    }
 
     ///
     /// @brief 转换成IR指令文本形式
@@ -166,6 +207,15 @@ public:
         this->loadRegNo = regId;
     }
 
+    ///
+    /// @brief 设置寄存器编号，寄存器分配时使用
+    /// @param _regId 寄存器编号
+    ///
+    void setRegId(int32_t _regId)
+    {
+        this->regId = _regId;
+    }
+
 protected:
     ///
     /// @brief IR指令操作码
@@ -31,6 +31,26 @@ public:
     /// @param _srcVal2 源操作数2
     BinaryInstruction(Function * _func, IRInstOperator _op, Value * _srcVal1, Value * _srcVal2, Type * _type);
 
+    ///
+    /// @brief 用于isa/cast/dyn_cast的类型判断，指令类别由操作码区分
+    /// @param inst 指令
+    /// @return true：是二元运算指令
+    ///
+    static bool classof(const Instruction * inst)
+    {
+        return inst->getOp() == IRInstOperator::IRINST_OP_ADD_I || inst->getOp() == IRInstOperator::IRINST_OP_SUB_I;
+    }
+
+    ///
+    /// @brief 用于isa/cast/dyn_cast的类型判断
+    /// @param val Value
+    /// @return true：是二元运算指令
+    ///
+    static bool classof(const Value * val)
+    {
+        return Instruction::classof(val) && classof(static_cast<const Instruction *>(val));
+    }
+
     /// @brief 转换成字符串
     void toString(std::string & str) override;
 };
@@ -29,6 +29,26 @@ public:
     ///
     EntryInstruction(Function * _func);
 
+    ///
+    /// @brief 用于isa/cast/dyn_cast的类型判断，指令类别由操作码区分
+    /// @param inst 指令
+    /// @return true：是函数入口指令
+    ///
+    static bool classof(const Instruction * inst)
+    {
+        return inst->getOp() == IRInstOperator::IRINST_OP_ENTRY;
+    }
+
+    ///
+    /// @brief 用于isa/cast/dyn_cast的类型判断
+    /// @param val Value
+    /// @return true：是函数入口指令
+    ///
+    static bool classof(const Value * val)
+    {
+        return Instruction::classof(val) && classof(static_cast<const Instruction *>(val));
+    }
+
     ///
     /// @brief 转换成IR指令字符串
     ///
@@ -30,6 +30,26 @@ public:
     /// @param result 函数的返回值
     ExitInstruction(Function * _func, Value * result = nullptr);
 
+    ///
+    /// @brief 用于isa/cast/dyn_cast的类型判断，指令类别由操作码区分
+    /// @param inst 指令
+    /// @return true：是函数出口指令
+    ///
+    static bool classof(const Instruction * inst)
+    {
+        return inst->getOp() == IRInstOperator::IRINST_OP_EXIT;
+    }
+
+    ///
+    /// @brief 用于isa/cast/dyn_cast的类型判断
+    /// @param val Value
+    /// @return true：是函数出口指令
+    ///
+    static bool classof(const Value * val)
+    {
+        return Instruction::classof(val) && classof(static_cast<const Instruction *>(val));
+    }
+
     /// @brief 转换成字符串
     void toString(std::string & str) override;
 };
@@ -29,7 +29,8 @@ FuncCallInstruction::FuncCallInstruction(Function * _func,
 {
     name = calledFunc->getName();
 
-    // 实参拷贝
+    // 实参拷贝，超出内嵌空间时一次性申请
+    reserveOperands((int32_t) _srcVal.size());
     for (auto & val: _srcVal) {
         addOperand(val);
     }
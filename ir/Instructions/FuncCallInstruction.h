@@ -40,6 +40,26 @@ public:
     /// @param result 保存返回值的Value
     FuncCallInstruction(Function * _func, Function * calledFunc, std::vector<Value *> & _srcVal, Type * _type);
 
+    ///
+    /// @brief 用于isa/cast/dyn_cast的类型判断，指令类别由操作码区分
+    /// @param inst 指令
+    /// @return true：是函数调用指令
+    ///
+    static bool classof(const Instruction * inst)
+    {
+        return inst->getOp() == IRInstOperator::IRINST_OP_FUNC_CALL;
+    }
+
+    ///
+    /// @brief 用于isa/cast/dyn_cast的类型判断
+    /// @param val Value
+    /// @return true：是函数调用指令
+    ///
+    static bool classof(const Value * val)
+    {
+        return Instruction::classof(val) && classof(static_cast<const Instruction *>(val));
+    }
+
     ///
     /// @brief 转换成IR指令文本
     /// @param str IR指令
@@ -44,3 +44,12 @@ LabelInstruction * GotoInstruction::getTarget() const
 {
     return target;
 }
+
+///
+/// @brief 修改目标Label指令
+/// @param _target 新的目标Label指令
+///
+void GotoInstruction::setTarget(LabelInstruction * _target)
+{
+    target = _target;
+}
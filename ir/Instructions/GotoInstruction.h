@@ -34,6 +34,26 @@ public:
     ///
     GotoInstruction(Function * _func, Instruction * _target);
 
+    ///
+    /// @brief 用于isa/cast/dyn_cast的类型判断，指令类别由操作码区分
+    /// @param inst 指令
+    /// @return true：是无条件跳转指令
+    ///
+    static bool classof(const Instruction * inst)
+    {
+        return inst->getOp() == IRInstOperator::IRINST_OP_GOTO;
+    }
+
+    ///
+    /// @brief 用于isa/cast/dyn_cast的类型判断
+    /// @param val Value
+    /// @return true：是无条件跳转指令
+    ///
+    static bool classof(const Value * val)
+    {
+        return Instruction::classof(val) && classof(static_cast<const Instruction *>(val));
+    }
+
     /// @brief 转换成字符串
     void toString(std::string & str) override;
 
@@ -43,6 +63,12 @@ public:
     ///
     [[nodiscard]] LabelInstruction * getTarget() const;
 
+    ///
+    /// @brief 修改目标Label指令
+    /// @param _target 新的目标Label指令
+    ///
+    void setTarget(LabelInstruction * _target);
+
 private:
     ///
     /// @brief 跳转到的目标Label指令
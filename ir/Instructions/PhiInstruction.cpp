@@ -0,0 +1,59 @@
+///
+/// @file PhiInstruction.cpp
+/// @brief PHI指令，SSA形式下汇合点处的值选择
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+
+#include "BasicBlock.h"
+#include "PhiInstruction.h"
+
+/// @brief 构造函数
+/// @param _func 所属的函数
+/// @param _type 值的类型
+PhiInstruction::PhiInstruction(Function * _func, Type * _type) : Instruction(_func, IRInstOperator::IRINST_OP_PHI, _type)
+{}
+
+/// @brief 增加一条入边
+/// @param val 从block进入时的值
+/// @param block 前驱块
+void PhiInstruction::addIncoming(Value * val, BasicBlock * block)
+{
+    addOperand(val);
+    incomingBlocks.push_back(block);
+}
+
+/// @brief 获取从block进入时的值
+/// @param block 前驱块
+/// @return Value* 值，block不是入边的前驱时为空指针
+Value * PhiInstruction::getIncomingValueForBlock(BasicBlock * block)
+{
+    for (std::size_t k = 0; k < incomingBlocks.size(); k++) {
+        if (incomingBlocks[k] == block) {
+            return getOperand((int32_t) k);
+        }
+    }
+
+    return nullptr;
+}
+
+/// @brief 转换成字符串显示
+/// @param str 转换后的字符串
+void PhiInstruction::toString(std::string & str)
+{
+    str = getIRName() + " = phi " + getType()->toString();
+
+    for (std::size_t k = 0; k < incomingBlocks.size(); k++) {
+        str += (k == 0 ? " [" : ", [") + getOperand((int32_t) k)->getIRName() + ", " + incomingBlocks[k]->getName() + "]";
+    }
+}
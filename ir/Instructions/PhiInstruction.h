@@ -0,0 +1,124 @@
+///
+/// @file PhiInstruction.h
+/// @brief PHI指令，SSA形式下汇合点处的值选择
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Instruction.h"
+
+class BasicBlock;
+
+///
+/// @brief PHI指令，位于块开头的Label之后，值为从哪个前驱块进入时对应的操作数。
+/// 前驱以BasicBlock表示，因此PHI指令只能在控制流图存在期间出现，线性化前须由出SSA消除
+///
+class PhiInstruction final : public Instruction {
+
+public:
+    ///
+    /// @brief 构造函数，入边在之后逐个加入
+    /// @param _func 所属的函数
+    /// @param _type 值的类型
+    ///
+    PhiInstruction(Function * _func, Type * _type);
+
+    ///
+    /// @brief 用于isa/cast/dyn_cast的类型判断，指令类别由操作码区分
+    /// @param inst 指令
+    /// @return true：是PHI指令
+    ///
+    static bool classof(const Instruction * inst)
+    {
+        return inst->getOp() == IRInstOperator::IRINST_OP_PHI;
+    }
+
+    ///
+    /// @brief 用于isa/cast/dyn_cast的类型判断
+    /// @param val Value
+    /// @return true：是PHI指令
+    ///
+    static bool classof(const Value * val)
+    {
+        return Instruction::classof(val) && classof(static_cast<const Instruction *>(val));
+    }
+
+    ///
+    /// @brief 增加一条入边
+    /// @param val 从block进入时的值
+    /// @param block 前驱块
+    ///
+    void addIncoming(Value * val, BasicBlock * block);
+
+    ///
+    /// @brief 获取入边的条数
+    /// @return int32_t 条数
+    ///
+    int32_t getIncomingCount()
+    {
+        return getOperandsNum();
+    }
+
+    ///
+    /// @brief 获取第k条入边的值
+    /// @param k 入边的序号
+    /// @return Value* 值
+    ///
+    Value * getIncomingValue(int32_t k)
+    {
+        return getOperand(k);
+    }
+
+    ///
+    /// @brief 获取第k条入边的前驱块
+    /// @param k 入边的序号
+    /// @return BasicBlock* 前驱块
+    ///
+    BasicBlock * getIncomingBlock(int32_t k)
+    {
+        return incomingBlocks[(std::size_t) k];
+    }
+
+    ///
+    /// @brief 修改第k条入边的前驱块，拆分关键边时使用
+    /// @param k 入边的序号
+    /// @param block 新的前驱块
+    ///
+    void setIncomingBlock(int32_t k, BasicBlock * block)
+    {
+        incomingBlocks[(std::size_t) k] = block;
+    }
+
+    ///
+    /// @brief 获取从block进入时的值
+    /// @param block 前驱块
+    /// @return Value* 值，block不是入边的前驱时为空指针
+    ///
+    Value * getIncomingValueForBlock(BasicBlock * block);
+
+    ///
+    /// @brief 转换成字符串
+    /// @param str 返回指令字符串
+    ///
+    void toString(std::string & str) override;
+
+private:
+    ///
+    /// @brief 各入边的前驱块，与操作数一一对应
+    ///
+    std::vector<BasicBlock *> incomingBlocks;
+};
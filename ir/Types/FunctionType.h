@@ -29,9 +29,20 @@ public:
     /// @param retType 函数返回值类型
     /// @param argTypes 函数形参类型
     ///
-    FunctionType(Type * _retType, std::vector<Type *> _argTypes) : retType{_retType}, argTypes{std::move(_argTypes)}
+    FunctionType(Type * _retType, std::vector<Type *> _argTypes)
+        : Type(FunctionTyID), retType{_retType}, argTypes{std::move(_argTypes)}
     {}
 
+    ///
+    /// @brief 用于isa/cast/dyn_cast的类型判断
+    /// @param type 类型
+    /// @return true：是函数类型
+    ///
+    static bool classof(const Type * type)
+    {
+        return type->isFunctionType();
+    }
+
     ///
     /// @brief 函数类型的IR字符串
     /// @return std::string
@@ -24,6 +24,16 @@
 class IntegerType final : public Type {
 
 public:
+    ///
+    /// @brief 用于isa/cast/dyn_cast的类型判断
+    /// @param type 类型
+    /// @return true：是整数类型
+    ///
+    static bool classof(const Type * type)
+    {
+        return type->isIntegerType();
+    }
+
     ///
     /// @brief 获取类型，全局只有一份
     /// @return VoidType*
@@ -90,16 +100,6 @@ private:
     explicit IntegerType(int32_t _bitWidth) : Type(Type::IntegerTyID), bitWidth(_bitWidth)
     {}
 
-    ///
-    /// @brief 唯一的VOID类型实例
-    ///
-    static IntegerType * oneInstanceBool;
-
-    ///
-    /// @brief 唯一的VOID类型实例
-    ///
-    static IntegerType * oneInstanceInt;
-
     ///
     /// @brief 位宽
     ///
@@ -17,16 +17,14 @@
 
 #include "LabelType.h"
 
-///
-/// @brief 唯一的VOID类型实例
-///
-LabelType * LabelType::oneInstance = new LabelType();
-
 ///
 /// @brief 获取类型
 /// @return VoidType*
 ///
 LabelType * LabelType::getType()
 {
+    // 只维持一份，首次使用时创建
+    static LabelType * oneInstance = new LabelType();
+
     return oneInstance;
 }
\ No newline at end of file
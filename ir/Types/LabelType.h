@@ -25,6 +25,16 @@
 class LabelType final : public Type {
 
 public:
+    ///
+    /// @brief 用于isa/cast/dyn_cast的类型判断
+    /// @param type 类型
+    /// @return true：是Label类型
+    ///
+    static bool classof(const Type * type)
+    {
+        return type->isLabelType();
+    }
+
     ///
     /// @brief 获取类型，全局只有一份
     /// @return VoidType*
@@ -46,9 +56,4 @@ private:
     ///
     explicit LabelType() : Type(Type::LabelTyID)
     {}
-
-    ///
-    /// @brief 唯一的VOID类型实例
-    ///
-    static LabelType * oneInstance;
 };
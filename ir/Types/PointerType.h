@@ -58,6 +58,16 @@ class PointerType : public Type {
     };
 
 public:
+    ///
+    /// @brief 用于isa/cast/dyn_cast的类型判断
+    /// @param type 类型
+    /// @return true：是指针类型
+    ///
+    static bool classof(const Type * type)
+    {
+        return type->isPointerType();
+    }
+
     /// @brief PointerType的构造函数
     /// @param[in] pointeeType 指针所指向的类型
     ///
@@ -69,7 +79,7 @@ public:
 
         if (pointeeType->isPointerType()) {
 
-            Instanceof(pType, const PointerType *, pointeeType);
+            const PointerType * pType = cast<PointerType>(pointeeType);
             this->rootType = pType->getRootType();
             this->depth = pType->getDepth() + 1;
         } else {
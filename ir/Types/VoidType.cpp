@@ -17,16 +17,14 @@
 
 #include "VoidType.h"
 
-///
-/// @brief 唯一的VOID类型实例
-///
-VoidType * VoidType::oneInstance = new VoidType();
-
 ///
 /// @brief 获取类型
 /// @return VoidType*
 ///
 VoidType * VoidType::getType()
 {
+    // 首次使用时创建，不依赖静态变量的初始化次序，且局部静态变量的初始化是线程安全的
+    static VoidType * oneInstance = new VoidType();
+
     return oneInstance;
 }
\ No newline at end of file
@@ -21,6 +21,16 @@
 class VoidType : public Type {
 
 public:
+    ///
+    /// @brief 用于isa/cast/dyn_cast的类型判断
+    /// @param type 类型
+    /// @return true：是Void类型
+    ///
+    static bool classof(const Type * type)
+    {
+        return type->isVoidType();
+    }
+
     ///
     /// @brief 获取类型，全局只有一份
     /// @return VoidType*
@@ -42,9 +52,4 @@ private:
     ///
     explicit VoidType() : Type(Type::VoidTyID)
     {}
-
-    ///
-    /// @brief 唯一的VOID类型实例
-    ///
-    static VoidType * oneInstance;
 };
@@ -31,7 +31,7 @@ void Use::setUsee(Value * newVal)
 
 ///
 /// @brief 移除def-use边，需要两头分别清理
-/// ! 请注意该函数并没有删除Use，需要自行清理资源
+/// ! 请注意调用后该Use从User的操作数中移除，不能再使用
 ///
 void Use::remove()
 {
@@ -29,11 +29,14 @@ class Value;
 /// Use可以跟踪每个Value的所有使用情况，并且当Value被修改或删除时，可以更新所有引用它的地方
 ///
 /// User和Use之间存在一个双向关系：
-/// User持有一个Use链表(成员uses)，每个Use指向一个Value
-/// Value持有一个User链表(成员uses)，每个User指向一个使用该Value的User对象
+/// User持有一个Use列表(成员operands)，每个Use指向一个Value
+/// Value持有一个Use链表(成员useList)，链表通过Use内嵌的指针串联，加入与摘除都是O(1)
 ///
 class Use {
 
+    friend class Value;
+    friend class User;
+
 protected:
     ///
     /// @brief 指向要使用的value
@@ -45,6 +48,16 @@ protected:
     ///
     User * user = nullptr;
 
+    ///
+    /// @brief usee的使用链表中的下一条边
+    ///
+    Use * nextUse = nullptr;
+
+    ///
+    /// @brief 指向链表中前一条边的nextUse或者链表头，摘除时不需要查找，为空表示不在链表中
+    ///
+    Use ** prevUse = nullptr;
+
 public:
     /**
      * 构建函数，构建一条define-use的边
@@ -84,6 +97,15 @@ public:
         return usee;
     }
 
+    ///
+    /// @brief 获取usee的使用链表中的下一条边
+    /// @return Use* 下一条边，没有时为空指针
+    ///
+    [[nodiscard]] Use * getNextUse() const
+    {
+        return nextUse;
+    }
+
     ///
     /// @brief 不再使用Use原来的Value，更新为新的Value
     /// @param newVal 新的Value
@@ -91,7 +113,7 @@ public:
     void setUsee(Value * newVal);
 
     ///
-    /// @brief def-use边取消，但不会删除该Use
+    /// @brief def-use边取消。Use存放在User的操作数空间中，取消后该Use即失效，不需要释放
     ///
     void remove();
 };
\ No newline at end of file
@@ -15,7 +15,7 @@
 /// </table>
 ///
 
-#include <algorithm>
+#include <new>
 
 #include "User.h"
 
@@ -23,9 +23,65 @@
 /// @brief 构造函数
 /// @param _type  类型
 ///
-User::User(Type * _type) : Value(_type)
+User::User(Type * _type, ValueKind _kind) : Value(_type, _kind), operands(reinterpret_cast<Use *>(inlineOperands))
 {}
 
+///
+/// @brief 析构函数，解除所有操作数的define-use边
+///
+User::~User()
+{
+    clearOperands();
+
+    if (operands != reinterpret_cast<Use *>(inlineOperands)) {
+        ::operator delete(operands);
+    }
+}
+
+///
+/// @brief 把Use从src移动到dst，并修正被使用者链表中的链接
+/// @param dst 目的位置，未构造
+/// @param src 源位置
+///
+void User::relocateUse(Use * dst, Use * src)
+{
+    new (dst) Use(src->usee, src->user);
+
+    // 在被使用者的链表中用dst顶替src的位置
+    if (src->prevUse) {
+        dst->prevUse = src->prevUse;
+        dst->nextUse = src->nextUse;
+        *dst->prevUse = dst;
+        if (dst->nextUse) {
+            dst->nextUse->prevUse = &dst->nextUse;
+        }
+    }
+}
+
+///
+/// @brief 预留操作数的空间，已知操作数个数时可避免多次扩容
+/// @param capacity 操作数个数
+///
+void User::reserveOperands(int32_t capacity)
+{
+    if (capacity <= operandsCapacity) {
+        return;
+    }
+
+    Use * newOperands = static_cast<Use *>(::operator new(sizeof(Use) * (std::size_t) capacity));
+
+    for (int32_t k = 0; k < operandsNum; k++) {
+        relocateUse(&newOperands[k], &operands[k]);
+    }
+
+    if (operands != reinterpret_cast<Use *>(inlineOperands)) {
+        ::operator delete(operands);
+    }
+
+    operands = newOperands;
+    operandsCapacity = capacity;
+}
+
 ///
 /// @brief 更新指定Pos的Value
 /// @param pos 位置
@@ -33,8 +89,8 @@ User::User(Type * _type) : Value(_type)
 ///
 void User::setOperand(int32_t pos, Value * val)
 {
-    if (pos < (int32_t) operands.size()) {
-        operands[pos]->setUsee(val);
+    if (pos < operandsNum) {
+        operands[pos].setUsee(val);
     }
 }
 
@@ -45,11 +101,13 @@ void User::setOperand(int32_t pos, Value * val)
 ///
 void User::addOperand(Value * val)
 {
-    // If not, add the given Value as a new use.
-    auto use = new Use(val, this);
+    if (operandsNum == operandsCapacity) {
+        reserveOperands(operandsCapacity * 2);
+    }
 
-    // 增加到操作数中
-    operands.push_back(use);
+    // 直接在操作数空间中构造Use
+    Use * use = new (&operands[operandsNum]) Use(val, this);
+    operandsNum++;
 
     // 该val被使用
     val->addUse(use);
@@ -61,11 +119,10 @@ void User::addOperand(Value * val)
 ///
 void User::removeOperand(Value * val)
 {
-    for (auto & use: operands) {
-        if (use->getUsee() == val) {
+    for (int32_t pos = 0; pos < operandsNum; pos++) {
+        if (operands[pos].getUsee() == val) {
             // 找到了就删除这个Use
-            use->remove();
-            delete use;
+            operands[pos].remove();
             break;
         }
     }
@@ -78,26 +135,26 @@ void User::removeOperand(Value * val)
 void User::removeOperand(int pos)
 {
     // 检索并清除边，使得边的两头都会自动减少
-    if (pos < (int32_t) operands.size()) {
-
-        // 必须先暂存后释放，不能直接delete uses[pos]
-        // 这是因为use->remove会删除operands的元素，使得operands[pos]的对象不再是原来的对象
-        Use * use = operands[pos];
-        use->remove();
-        delete use;
+    if (pos < operandsNum) {
+        operands[pos].remove();
     }
 }
 
 ///
-/// @brief 清除指定的操作数
-/// @param pos 操作数的索引
+/// @brief 直接清除操作数的元素，后面的操作数依次前移
+/// @param use 指定的元素use
 ///
 void User::removeOperandRaw(Use * use)
 {
-    auto pIter = std::find(operands.begin(), operands.end(), use);
-    if (pIter != operands.end()) {
-        operands.erase(pIter);
+    if (use < operands || use >= operands + operandsNum) {
+        return;
+    }
+
+    for (Use * p = use; p + 1 < operands + operandsNum; p++) {
+        relocateUse(p, p + 1);
     }
+
+    operandsNum--;
 }
 
 ///
@@ -106,8 +163,7 @@ void User::removeOperandRaw(Use * use)
 ///
 void User::removeUse(Use * use)
 {
-    auto pIter = std::find(operands.begin(), operands.end(), use);
-    if (pIter != operands.end()) {
+    if (use >= operands && use < operands + operandsNum) {
         use->remove();
     }
 }
@@ -117,36 +173,29 @@ void User::removeUse(Use * use)
 ///
 void User::clearOperands()
 {
-    for (int32_t pos = 0; pos < (int32_t) operands.size();) {
-
-        // 必须先暂存后释放，不能直接delete uses[pos]
-        // 这是因为use->remove会删除operands的元素，使得operands[pos]的对象不再是原来的对象
-
-        Use * use = operands[pos];
-        use->remove();
-        delete use;
+    for (int32_t pos = 0; pos < operandsNum; pos++) {
+        operands[pos].getUsee()->removeUse(&operands[pos]);
     }
+
+    operandsNum = 0;
 }
+
 ///
 /// @brief Get the Operands object
-/// @return std::vector<Use *>&
+/// @return UseRange 操作数的Use区间
 ///
-std::vector<Use *> & User::getOperands()
+User::UseRange User::getOperands()
 {
-    return operands;
+    return {operands, operands + operandsNum};
 }
 
 ///
-/// @brief 取得操作数
-/// @return std::vector<Value *>
+/// @brief 取得操作数，不复制
+/// @return ValueRange 操作数Value的视图
 ///
-std::vector<Value *> User::getOperandsValue()
+User::ValueRange User::getOperandsValue()
 {
-    std::vector<Value *> operandsVec;
-    for (auto & use: operands) {
-        operandsVec.emplace_back(use->getUsee());
-    }
-    return operandsVec;
+    return {operands, operands + operandsNum};
 }
 
 ///
@@ -155,7 +204,7 @@ std::vector<Value *> User::getOperandsValue()
 ///
 int32_t User::getOperandsNum()
 {
-    return (int32_t) operands.size();
+    return operandsNum;
 }
 
 ///
@@ -165,8 +214,8 @@ int32_t User::getOperandsNum()
 ///
 Value * User::getOperand(int32_t pos)
 {
-    if (pos < (int32_t) operands.size()) {
-        return operands[pos]->getUsee();
+    if (pos < operandsNum) {
+        return operands[pos].getUsee();
     }
 
     return nullptr;
@@ -16,8 +16,8 @@
 ///
 #pragma once
 
-#include <unordered_map>
-#include <list>
+#include <cstddef>
+#include <iterator>
 
 #include "Value.h"
 #include "Use.h"
@@ -29,32 +29,206 @@
 /// User可以是指令(Instruction)、常量表达式(ConstantExpr)、全局变量(GlobalVariable)等。
 /// User持有对Value的引用，并且可以有多个Value作为其操作数(Operands)
 ///
+/// 操作数的Use直接存放在User中：不超过inlineOperandCapacity个操作数时放在User内嵌的空间里，
+/// 固定操作数个数的指令因此只需申请一次内存；超过时（如函数调用）整体移到一块连续的堆空间中。
+///
 class User : public Value {
 
+public:
     ///
-    /// @brief 操作数列表，指向当前Value的所有操作数
+    /// @brief 内嵌的操作数个数，固定操作数个数的指令都不超过该值
     ///
-    std::vector<Use *> operands;
+    static constexpr int32_t inlineOperandCapacity = 2;
+
+    ///
+    /// @brief 操作数Use的连续区间，可用于范围for遍历
+    ///
+    class UseRange {
+    public:
+        UseRange(Use * _first, Use * _last) : first(_first), last(_last)
+        {}
+
+        [[nodiscard]] Use * begin() const
+        {
+            return first;
+        }
+
+        [[nodiscard]] Use * end() const
+        {
+            return last;
+        }
+
+        [[nodiscard]] std::size_t size() const
+        {
+            return (std::size_t) (last - first);
+        }
+
+    private:
+        Use * first;
+        Use * last;
+    };
+
+    ///
+    /// @brief 操作数Value的只读视图，直接在Use上迭代，不复制
+    ///
+    class ValueRange {
+    public:
+        ///
+        /// @brief 迭代器，解引用得到操作数Value
+        ///
+        class iterator {
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = Value *;
+            using difference_type = std::ptrdiff_t;
+            using pointer = Value **;
+            using reference = Value *;
+
+            explicit iterator(const Use * _use = nullptr) : use(_use)
+            {}
+
+            Value * operator*() const
+            {
+                return use->getUsee();
+            }
+
+            iterator & operator++()
+            {
+                ++use;
+                return *this;
+            }
+
+            iterator operator++(int)
+            {
+                iterator tmp = *this;
+                ++use;
+                return tmp;
+            }
+
+            iterator & operator--()
+            {
+                --use;
+                return *this;
+            }
+
+            iterator operator--(int)
+            {
+                iterator tmp = *this;
+                --use;
+                return tmp;
+            }
+
+            iterator operator+(difference_type n) const
+            {
+                return iterator(use + n);
+            }
+
+            iterator operator-(difference_type n) const
+            {
+                return iterator(use - n);
+            }
+
+            difference_type operator-(const iterator & other) const
+            {
+                return use - other.use;
+            }
+
+            Value * operator[](difference_type n) const
+            {
+                return use[n].getUsee();
+            }
+
+            bool operator==(const iterator & other) const
+            {
+                return use == other.use;
+            }
+
+            bool operator!=(const iterator & other) const
+            {
+                return use != other.use;
+            }
+
+            bool operator<(const iterator & other) const
+            {
+                return use < other.use;
+            }
+
+        private:
+            const Use * use;
+        };
+
+        ValueRange(const Use * _first, const Use * _last) : first(_first), last(_last)
+        {}
+
+        [[nodiscard]] iterator begin() const
+        {
+            return iterator(first);
+        }
+
+        [[nodiscard]] iterator end() const
+        {
+            return iterator(last);
+        }
+
+        [[nodiscard]] std::size_t size() const
+        {
+            return (std::size_t) (last - first);
+        }
+
+        [[nodiscard]] bool empty() const
+        {
+            return first == last;
+        }
+
+        Value * operator[](std::size_t pos) const
+        {
+            return first[pos].getUsee();
+        }
+
+    private:
+        const Use * first;
+        const Use * last;
+    };
 
-public:
     ///
     /// @brief 构造函数
     /// @param _type  类型
-    /// @param _name  名称
+    /// @param _kind  具体类别
+    ///
+    User(Type * _type, ValueKind _kind);
+
+    ///
+    /// @brief 用于isa/cast/dyn_cast的类型判断
+    /// @param val Value
+    /// @return true：是User
     ///
-    User(Type * _type);
+    static bool classof(const Value * val)
+    {
+        return val->getValueKind() >= ValueKind::VALUE_FIRST_USER && val->getValueKind() <= ValueKind::VALUE_LAST_USER;
+    }
+
+    ///
+    /// @brief 析构函数，解除所有操作数的define-use边
+    ///
+    ~User() override;
+
+    ///
+    /// @brief 下列操作不被允许，Use的地址登记在被使用者的链表中，User不能拷贝
+    ///
+    User(const User &) = delete;
+    User & operator=(const User &) = delete;
 
     ///
     /// @brief Get the Operands object
-    /// @return std::vector<Use *>&
+    /// @return UseRange 操作数的Use区间
     ///
-    std::vector<Use *> & getOperands();
+    UseRange getOperands();
 
     ///
-    /// @brief 取得操作数
-    /// @return std::vector<Value *>
+    /// @brief 取得操作数，不复制
+    /// @return ValueRange 操作数Value的视图，增删操作数后失效
     ///
-    std::vector<Value *> getOperandsValue();
+    ValueRange getOperandsValue();
 
     ///
     /// @brief 获取操作数的个数
@@ -83,6 +257,12 @@ public:
     ///
     void addOperand(Value * val);
 
+    ///
+    /// @brief 预留操作数的空间，已知操作数个数时可避免多次扩容
+    /// @param capacity 操作数个数
+    ///
+    void reserveOperands(int32_t capacity);
+
     ///
     /// @brief 清除指定的操作数
     /// @param pos 操作数的索引
@@ -111,4 +291,32 @@ public:
     /// @brief 清除所有的操作数
     ///
     void clearOperands();
-};
\ No newline at end of file
+
+private:
+    ///
+    /// @brief 把Use从src移动到dst，并修正被使用者链表中的链接
+    /// @param dst 目的位置，未构造
+    /// @param src 源位置
+    ///
+    static void relocateUse(Use * dst, Use * src);
+
+    ///
+    /// @brief 操作数空间，指向inlineOperands或者堆空间
+    ///
+    Use * operands;
+
+    ///
+    /// @brief 操作数个数
+    ///
+    int32_t operandsNum = 0;
+
+    ///
+    /// @brief 操作数空间可容纳的个数
+    ///
+    int32_t operandsCapacity = inlineOperandCapacity;
+
+    ///
+    /// @brief 内嵌的操作数空间
+    ///
+    alignas(Use) unsigned char inlineOperands[sizeof(Use) * inlineOperandCapacity];
+};
@@ -15,14 +15,13 @@
 /// </table>
 ///
 
-#include <algorithm>
-
 #include "Value.h"
 #include "Use.h"
 
 /// @brief 构造函数
-/// @param _type
-Value::Value(Type * _type) : type(_type)
+/// @param _type 类型
+/// @param _kind 具体类别
+Value::Value(Type * _type, ValueKind _kind) : type(_type), kind(_kind)
 {
     // 不需要增加代码
 }
@@ -73,23 +72,55 @@ Type * Value::getType()
 }
 
 ///
-/// @brief 增加一条边，增加Value被使用次数
+/// @brief 增加一条边，增加Value被使用次数。加入到链表头部
 /// @param use
 ///
 void Value::addUse(Use * use)
 {
-    uses.push_back(use);
+    use->nextUse = useList;
+    if (useList) {
+        useList->prevUse = &use->nextUse;
+    }
+    use->prevUse = &useList;
+    useList = use;
+
+    useCount++;
 }
 
 ///
-/// @brief 消除一条边，减少Value被使用次数
+/// @brief 消除一条边，减少Value被使用次数。通过prevUse直接摘除，不需要查找
 /// @param use
 ///
 void Value::removeUse(Use * use)
 {
-    auto pIter = std::find(uses.begin(), uses.end(), use);
-    if (pIter != uses.end()) {
-        uses.erase(pIter);
+    if (use->prevUse == nullptr) {
+        // 不在链表中
+        return;
+    }
+
+    *use->prevUse = use->nextUse;
+    if (use->nextUse) {
+        use->nextUse->prevUse = use->prevUse;
+    }
+    use->nextUse = nullptr;
+    use->prevUse = nullptr;
+
+    useCount--;
+}
+
+///
+/// @brief 所有使用该Value的地方都改为使用newVal，完成后该Value不再被使用
+/// @param newVal 新的Value
+///
+void Value::replaceAllUsesWith(Value * newVal)
+{
+    if (newVal == this) {
+        return;
+    }
+
+    // 每次setUsee都会把链表头的边从本链表摘下，加入到newVal的链表中
+    while (useList) {
+        useList->setUsee(newVal);
     }
 }
 
@@ -19,9 +19,59 @@
 #include <cstdint>
 #include <string>
 
+#include "Casting.h"
 #include "Use.h"
 #include "Type.h"
 
+///
+/// @brief Value的具体类别，用于isa/cast/dyn_cast的类型判断。
+/// 同一基类的子类必须连续排列，以便通过区间判断是否属于该基类
+///
+enum class ValueKind : std::int8_t {
+
+    /// @brief 形式参数
+    VALUE_FORMAL_PARAM,
+
+    /// @brief 局部变量
+    VALUE_LOCAL_VARIABLE,
+
+    /// @brief 内存变量
+    VALUE_MEM_VARIABLE,
+
+    /// @brief 寄存器变量
+    VALUE_REG_VARIABLE,
+
+    /* 以下为User的子类 */
+
+    /// @brief 指令，具体的指令类别通过IRInstOperator区分
+    VALUE_INSTRUCTION,
+
+    /* 以下为Constant的子类 */
+
+    /// @brief 整型常量
+    VALUE_CONST_INT,
+
+    /* 以下为GlobalValue的子类 */
+
+    /// @brief 函数
+    VALUE_FUNCTION,
+
+    /// @brief 全局变量
+    VALUE_GLOBAL_VARIABLE,
+
+    /// @brief User子类的区间
+    VALUE_FIRST_USER = VALUE_INSTRUCTION,
+    VALUE_LAST_USER = VALUE_GLOBAL_VARIABLE,
+
+    /// @brief Constant子类的区间
+    VALUE_FIRST_CONSTANT = VALUE_CONST_INT,
+    VALUE_LAST_CONSTANT = VALUE_GLOBAL_VARIABLE,
+
+    /// @brief GlobalValue子类的区间
+    VALUE_FIRST_GLOBAL_VALUE = VALUE_FUNCTION,
+    VALUE_LAST_GLOBAL_VALUE = VALUE_GLOBAL_VARIABLE,
+};
+
 ///
 /// @brief 值类，每个值都要有一个类型，全局变量和局部变量可以有名字，
 /// 但通过运算得到的指令类值没有名字，只有在需要输出时给定名字即可
@@ -44,18 +94,38 @@ protected:
     Type * type;
 
     ///
-    /// @brief define-use链，这个定值被使用的所有边，即所有的User
+    /// @brief define-use链，这个定值被使用的所有边，即所有的User。侵入式单链表，通过Use::nextUse串联
     ///
-    std::vector<Use *> uses;
+    Use * useList = nullptr;
+
+    ///
+    /// @brief 被使用的次数，即useList中边的条数
+    ///
+    int32_t useCount = 0;
+
+    ///
+    /// @brief Value的具体类别，创建后不再改变
+    ///
+    const ValueKind kind;
 
 public:
     /// @brief 构造函数
-    /// @param _type
-    explicit Value(Type * _type);
+    /// @param _type 类型
+    /// @param _kind 具体类别
+    Value(Type * _type, ValueKind _kind);
 
     /// @brief 析构函数
     virtual ~Value();
 
+    ///
+    /// @brief 获取Value的具体类别
+    /// @return ValueKind
+    ///
+    [[nodiscard]] ValueKind getValueKind() const
+    {
+        return kind;
+    }
+
     /// @brief 获取名字
     /// @return 变量名
     [[nodiscard]] virtual std::string getName() const;
@@ -81,17 +151,50 @@ public:
     virtual Type * getType();
 
     ///
-    /// @brief 增加一条边，增加Value被使用次数
+    /// @brief 增加一条边，增加Value被使用次数，O(1)
     /// @param use
     ///
     void addUse(Use * use);
 
     ///
-    /// @brief 消除一条边，减少Value被使用次数
+    /// @brief 消除一条边，减少Value被使用次数，O(1)
     /// @param use
     ///
     void removeUse(Use * use);
 
+    ///
+    /// @brief 获取使用链表的第一条边，可通过Use::getNextUse遍历，遍历时不能修改链表
+    /// @return Use* 第一条边，没有被使用时为空指针
+    ///
+    [[nodiscard]] Use * getFirstUse() const
+    {
+        return useList;
+    }
+
+    ///
+    /// @brief 获取被使用的次数
+    /// @return int32_t 次数
+    ///
+    [[nodiscard]] int32_t getNumUses() const
+    {
+        return useCount;
+    }
+
+    ///
+    /// @brief 是否被使用
+    /// @return true：有使用者 false：没有
+    ///
+    [[nodiscard]] bool hasUses() const
+    {
+        return useList != nullptr;
+    }
+
+    ///
+    /// @brief 所有使用该Value的地方都改为使用newVal，完成后该Value不再被使用
+    /// @param newVal 新的Value
+    ///
+    void replaceAllUsesWith(Value * newVal);
+
     ///
     /// @brief 取得变量所在的作用域层级
     /// @return int32_t 层级
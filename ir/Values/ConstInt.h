@@ -30,12 +30,22 @@ public:
     ///
     /// @brief 指定值的常量
     /// \param val
-    explicit ConstInt(int32_t val) : Constant(IntegerType::getTypeInt())
+    explicit ConstInt(int32_t val) : Constant(IntegerType::getTypeInt(), ValueKind::VALUE_CONST_INT)
     {
         name = std::to_string(val);
         intVal = val;
     }
 
+    ///
+    /// @brief 用于isa/cast/dyn_cast的类型判断
+    /// @param val Value
+    /// @return true：是整型常量
+    ///
+    static bool classof(const Value * val)
+    {
+        return val->getValueKind() == ValueKind::VALUE_CONST_INT;
+    }
+
     /// @brief 获取名字
     /// @return 变量名
     [[nodiscard]] std::string getIRName() const override
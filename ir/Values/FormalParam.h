@@ -26,11 +26,21 @@ public:
     /// @brief 基本类型的参数
     /// @param _name 形参的名字
     /// @param _type 基本类型
-    FormalParam(Type * _type, std::string _name) : Value(_type)
+    FormalParam(Type * _type, std::string _name) : Value(_type, ValueKind::VALUE_FORMAL_PARAM)
     {
         this->name = _name;
     };
 
+    ///
+    /// @brief 用于isa/cast/dyn_cast的类型判断
+    /// @param val Value
+    /// @return true：是形参
+    ///
+    static bool classof(const Value * val)
+    {
+        return val->getValueKind() == ValueKind::VALUE_FORMAL_PARAM;
+    }
+
     // /// @brief 输出字符串
     // /// @param str
     // std::string toString() override
@@ -30,12 +30,23 @@ public:
     /// @param _type 类型
     /// @param _name 名字
     ///
-    explicit GlobalVariable(Type * _type, std::string _name) : GlobalValue(_type, _name)
+    explicit GlobalVariable(Type * _type, std::string _name)
+        : GlobalValue(_type, _name, ValueKind::VALUE_GLOBAL_VARIABLE)
     {
         // 设置对齐大小
         setAlignment(4);
     }
 
+    ///
+    /// @brief 用于isa/cast/dyn_cast的类型判断
+    /// @param val Value
+    /// @return true：是全局变量
+    ///
+    static bool classof(const Value * val)
+    {
+        return val->getValueKind() == ValueKind::VALUE_GLOBAL_VARIABLE;
+    }
+
     ///
     /// @brief  检查是否是函数
     /// @return true 是函数
@@ -34,12 +34,21 @@ private:
     /// @param _scope_level 作用域层级
     ///
     explicit LocalVariable(Type * _type, std::string _name, int32_t _scope_level)
-        : Value(_type), scope_level(_scope_level)
+        : Value(_type, ValueKind::VALUE_LOCAL_VARIABLE), scope_level(_scope_level)
     {
         this->name = _name;
     }
 
 public:
+    ///
+    /// @brief 用于isa/cast/dyn_cast的类型判断
+    /// @param val Value
+    /// @return true：是局部变量
+    ///
+    static bool classof(const Value * val)
+    {
+        return val->getValueKind() == ValueKind::VALUE_LOCAL_VARIABLE;
+    }
     ///
     /// @brief 取得变量所在的作用域层级
     /// @return int32_t 层级
@@ -110,6 +119,15 @@ public:
         this->loadRegNo = regId;
     }
 
+    ///
+    /// @brief 设置寄存器编号，寄存器分配时使用
+    /// @param _regId 寄存器编号
+    ///
+    void setRegId(int32_t _regId)
+    {
+        this->regId = _regId;
+    }
+
 private:
     ///
     /// @brief 当前变量所在作用域的层号，全局变量在第0层
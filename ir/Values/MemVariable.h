@@ -27,10 +27,19 @@ class MemVariable : public Value {
 private:
     /// @brief 创建内存Value
     /// \param val
-    explicit MemVariable(Type * _type) : Value(_type)
+    explicit MemVariable(Type * _type) : Value(_type, ValueKind::VALUE_MEM_VARIABLE)
     {}
 
 public:
+    ///
+    /// @brief 用于isa/cast/dyn_cast的类型判断
+    /// @param val Value
+    /// @return true：是内存变量
+    ///
+    static bool classof(const Value * val)
+    {
+        return val->getValueKind() == ValueKind::VALUE_MEM_VARIABLE;
+    }
     ///
     /// @brief @brief 如是内存变量型Value，则获取基址寄存器和偏移
     /// @param regId 寄存器编号
@@ -24,12 +24,23 @@ class RegVariable : public Value {
 public:
     /// @brief 整型寄存器型Value
     /// \param val
-    explicit RegVariable(Type * _type, std::string _name, int32_t _reg_no) : Value(_type)
+    explicit RegVariable(Type * _type, std::string _name, int32_t _reg_no)
+        : Value(_type, ValueKind::VALUE_REG_VARIABLE)
     {
         this->name = _name;
         regId = _reg_no;
     }
 
+    ///
+    /// @brief 用于isa/cast/dyn_cast的类型判断
+    /// @param val Value
+    /// @return true：是寄存器变量
+    ///
+    static bool classof(const Value * val)
+    {
+        return val->getValueKind() == ValueKind::VALUE_REG_VARIABLE;
+    }
+
     ///
     /// @brief 获得分配的寄存器编号或ID
     /// @return int32_t 寄存器编号
@@ -9,12 +9,25 @@
  *
  */
 
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <iterator>
+#include <mutex>
+#include <set>
 #include <string>
+#include <vector>
 #include <getopt.h>
 
 #ifdef _WIN32
 #include <Windows.h>
+#else
+#include <unistd.h>
 #endif
 
 #include "Common.h"
@@ -28,6 +41,12 @@
 #include "IRGenerator.h"
 #include "RecursiveDescentExecutor.h"
 #include "Module.h"
+#include "Optimizer.h"
+#include "ParallelFor.h"
+#include "TimeReport.h"
+#ifndef _WIN32
+#include "CompileServer.h"
+#endif
 
 ///
 /// @brief 是否显示帮助信息
@@ -35,57 +54,106 @@
 static bool gShowHelp = false;
 
 ///
-/// @brief 显示抽象语法树，非线性IR
+/// @brief 输出中间IR，含汇编或者自定义IR等，默认输出线性IR
 ///
-static bool gShowAST = false;
+static bool gShowSymbol = false;
 
 ///
-/// @brief 产生线性IR，线性IR，默认输出
+/// @brief 单个源文件的编译选项。编译服务时每个请求带有各自的选项，因此不能直接用全局变量
 ///
-static bool gShowLineIR = false;
+struct CompileOptions {
+
+    ///
+    /// @brief 显示抽象语法树，非线性IR
+    ///
+    bool showAST = false;
+
+    ///
+    /// @brief 产生线性IR，线性IR，默认输出
+    ///
+    bool showLineIR = false;
+
+    ///
+    /// @brief 显示汇编
+    ///
+    bool showASM = false;
+
+    ///
+    /// @brief 前端分析器，默认选Flex和Bison
+    ///
+    bool frontEndFlexBison = true;
+
+    ///
+    /// @brief 前端分析器Antlr4，是否选中
+    ///
+    bool frontEndAntlr4 = false;
+
+    ///
+    /// @brief 前端分析器用递归下降分析法，是否选中
+    ///
+    bool frontEndRecursiveDescentParsing = false;
+
+    ///
+    /// @brief 递归下降分析时是否采用表驱动的SIMD词法分析器，false时采用逐字符判断的简单实现
+    ///
+    bool rdLexerDFA = true;
+
+    ///
+    /// @brief 在输出汇编时是否输出中间IR作为注释
+    ///
+    bool asmAlsoShowIR = false;
+
+    /// @brief 优化的级别，即-O后面的数字，默认为0
+    int optLevel = 0;
+
+    /// @brief 指定CPU目标架构，这里默认为ARM32
+    std::string cpuTarget = "ARM32";
+};
 
 ///
-/// @brief 显示汇编
+/// @brief 命令行指定的编译选项，编译服务时作为各请求的缺省选项
 ///
-static bool gShowASM = false;
+static CompileOptions gOptions;
 
-///
-/// @brief 输出中间IR，含汇编或者自定义IR等，默认输出线性IR
-///
-static bool gShowSymbol = false;
+/// @brief 线程数，即-j后面的数字，默认为1。批量模式下为同时编译的文件数，否则为后端代码生成的线程数
+static int gThreadNum = 1;
 
-///
-/// @brief 前端分析器，默认选Flex和Bison
-///
-static bool gFrontEndFlexBison = true;
+/// @brief 批量模式，一个进程内编译多个源文件
+static bool gBatch = false;
 
-///
-/// @brief 前端分析器Antlr4，是否选中
-///
-static bool gFrontEndAntlr4 = false;
+/// @brief 编译服务的套接字路径，非空时以编译服务的方式运行
+static std::string gServerSocket;
 
-///
-/// @brief 前端分析器用递归下降分析法，是否选中
-///
-static bool gFrontEndRecursiveDescentParsing = false;
+/// @brief 前端可重入检查的轮数，大于0时只做检查，不编译
+static int gCheckFrontEndRounds = 0;
 
-///
-/// @brief 在输出汇编时是否输出中间IR作为注释
-///
-static bool gAsmAlsoShowIR = false;
+/// @brief 是否输出各阶段的时间与内存统计报告
+static bool gTimeReport = false;
 
-/// @brief 优化的级别，即-O后面的数字，默认为0
-static int gOptLevel = 0;
+/// @brief 统计报告的JSON输出文件，为空时以表格形式输出到标准错误
+static std::string gTimeReportFile;
 
-/// @brief 指定CPU目标架构，这里默认为ARM32
-static std::string gCPUTarget = "ARM32";
+/// @brief Chrome跟踪事件格式的输出文件，非空时记录编译过程的跟踪
+static std::string gTraceFile;
 
-/// @brief 输入源文件
-static std::string gInputFile;
+/// @brief 输入源文件，非批量模式时只能有一个
+static std::vector<std::string> gInputFiles;
 
-/// @brief 输出文件，不同的选项输出的内容不同
+/// @brief 输出文件，不同的选项输出的内容不同。批量模式时为输出目录
 static std::string gOutputFile;
 
+///
+/// @brief Antlr4前端与AST图形输出所用的库未经多线程验证，批量模式下多个文件同时编译时需串行执行这些阶段
+///
+static std::mutex gFrontEndMutex;
+static std::mutex gGraphMutex;
+
+/// @brief 只有长格式的选项的编号，不能与短选项的字符重复
+#define OPTION_SERVER 256
+#define OPTION_CHECK_FRONTEND 257
+#define OPTION_TIME_REPORT 258
+#define OPTION_TRACE 259
+
 static struct option long_options[] = {
     {"help", no_argument, 0, 'h'},
     {"output", required_argument, 0, 'o'},
@@ -97,14 +165,39 @@ static struct option long_options[] = {
     {"optimize", required_argument, 0, 'O'},
     {"target", required_argument, 0, 't'},
     {"asmir", no_argument, 0, 'c'},
+    {"rd-lexer", required_argument, 0, 'L'},
+    {"jobs", required_argument, 0, 'j'},
+    {"batch", no_argument, 0, 'B'},
+    {"server", required_argument, 0, OPTION_SERVER},
+    {"check-frontend", required_argument, 0, OPTION_CHECK_FRONTEND},
+    {"time-report", optional_argument, 0, OPTION_TIME_REPORT},
+    {"trace", required_argument, 0, OPTION_TRACE},
     {0, 0, 0, 0}
 };
 
+///
+/// @brief 短格式的选项，可识别-h、-o、-S、-T、-I、-A、-D等选项
+/// -S必须项，输出中间IR、抽象语法树或汇编
+/// -T指定时输出AST，-I输出中间IR，不指定则默认输出汇编
+/// -A指定按照antlr4进行词法与语法分析，-D指定按照递归下降分析法执行，不指定时按flex+bison执行
+/// -o要求必须带有附加参数，指定输出的文件
+/// -O要求必须带有附加整数，指明优化的级别
+/// -t要求必须带有目标CPU，指明目标CPU的汇编
+/// -c选项在输出汇编时有效，附带输出IR指令内容
+/// -L要求必须带有dfa或simple，指明递归下降分析时所用的词法分析器
+/// -j要求必须带有正整数，指明后端代码生成的线程数，批量模式下为同时编译的文件数
+/// -B批量模式，可指定多个源文件，@开头的参数为源文件清单
+///
+static const char gShortOptions[] = "ho:STIADO:t:cL:j:B";
+
 /// @brief 显示帮助
 /// @param exeName
 static void showHelp(const std::string & exeName)
 {
     std::cout << exeName + " -S [--symbol] [-A | --antlr4 | -D | --recursive-descent] [-T | --ast | -I | --ir] [-o output | --output=output] source\n";
+    std::cout << exeName + " -S --batch [-j N] [options] [-o outdir] source... | @listfile\n";
+    std::cout << exeName + " --server=SOCKET [-j N] [options]\n";
+    std::cout << exeName + " --check-frontend=ROUNDS [-j N] [-A | -D] source... | @listfile\n";
     std::cout << "Options:\n";
     std::cout << "  -h, --help                 Show this help message\n";
     std::cout << "  -o, --output=FILE          Specify output file\n";
@@ -116,6 +209,96 @@ static void showHelp(const std::string & exeName)
     std::cout << "  -O, --optimize=LEVEL       Set optimization level\n";
     std::cout << "  -t, --target=CPU           Specify target CPU architecture\n";
     std::cout << "  -c, --asmir                Show IR instructions as comments in assembly output\n";
+    std::cout << "  -L, --rd-lexer=KIND        Lexer for recursive descent parsing: dfa (default) or simple\n";
+    std::cout << "  -j, --jobs=N               Generate code for functions on N threads, or compile N files at once in batch mode\n";
+    std::cout << "                             or serve N requests at once in server mode\n";
+    std::cout << "  -B, --batch                Compile all source files in one process, outputs go to the directory given by -o\n";
+    std::cout << "                             @listfile reads source file names from listfile, one per line\n";
+    std::cout << "      --server=SOCKET        Run as a compile server on the Unix domain socket SOCKET\n";
+    std::cout << "                             the options given here are the defaults of every request\n";
+    std::cout << "      --check-frontend=ROUNDS\n";
+    std::cout << "                             Parse every source on N threads for ROUNDS rounds at once and compare\n";
+    std::cout << "                             the ASTs with those of a serial run, no output files are produced\n";
+    std::cout << "      --time-report[=FILE]   Print the time and memory of every compile phase to stderr,\n";
+    std::cout << "                             or write them to FILE as JSON\n";
+    std::cout << "      --trace=FILE           Write the phases of every function and the IR instruction and arena memory\n";
+    std::cout << "                             counters to FILE in Chrome trace event format (chrome://tracing, Perfetto)\n";
+}
+
+///
+/// @brief 设置与单个源文件编译相关的选项，命令行与编译服务的请求共用
+/// @param opts 编译选项
+/// @param ch 选项字符
+/// @param arg 选项的附加参数，没有时为空指针
+/// @return true：成功 false：不是编译选项或者参数有误
+///
+static bool applyCompileOption(CompileOptions & opts, int ch, const char * arg)
+{
+    switch (ch) {
+        case 'T':
+            opts.showAST = true;
+            break;
+        case 'I':
+            // 产生中间IR
+            opts.showLineIR = true;
+            break;
+        case 'A':
+            // 选用antlr4
+            opts.frontEndAntlr4 = true;
+            opts.frontEndFlexBison = false;
+            opts.frontEndRecursiveDescentParsing = false;
+            break;
+        case 'D':
+            // 选用递归下降分析法与词法手动实现
+            opts.frontEndAntlr4 = false;
+            opts.frontEndFlexBison = false;
+            opts.frontEndRecursiveDescentParsing = true;
+            break;
+        case 'O':
+            // 优化级别，1及以上开启中间代码优化
+            opts.optLevel = std::stoi(arg);
+            break;
+        case 't':
+            opts.cpuTarget = arg;
+            break;
+        case 'c':
+            opts.asmAlsoShowIR = true;
+            break;
+        case 'L':
+            // 递归下降分析时的词法分析器
+            if (std::string(arg) == "dfa") {
+                opts.rdLexerDFA = true;
+            } else if (std::string(arg) == "simple") {
+                opts.rdLexerDFA = false;
+            } else {
+                return false;
+            }
+            break;
+        default:
+            return false;
+    }
+
+    return true;
+}
+
+///
+/// @brief 确定输出的内容，线性中间IR、抽象语法树只能同时选择一个，都不选时输出汇编
+/// @param opts 编译选项
+/// @return true：成功 false：选项冲突
+///
+static bool checkOutputKind(CompileOptions & opts)
+{
+    int flag = (int) opts.showLineIR + (int) opts.showAST;
+
+    if (0 == flag) {
+        // 没有指定，则输出汇编指令
+        opts.showASM = true;
+    } else if (flag != 1) {
+        // 线性中间IR、抽象语法树只能同时选择一个
+        return false;
+    }
+
+    return true;
 }
 
 /// @brief 参数解析与有效性检查
@@ -126,21 +309,12 @@ static int ArgsAnalysis(int argc, char * argv[])
 {
     int ch;
 
-    // 指定参数解析的选项，可识别-h、-o、-S、-T、-I、-A、-D等选项
-    // -S必须项，输出中间IR、抽象语法树或汇编
-    // -T指定时输出AST，-I输出中间IR，不指定则默认输出汇编
-    // -A指定按照antlr4进行词法与语法分析，-D指定按照递归下降分析法执行，不指定时按flex+bison执行
-    // -o要求必须带有附加参数，指定输出的文件
-    // -O要求必须带有附加整数，指明优化的级别
-    // -t要求必须带有目标CPU，指明目标CPU的汇编
-    // -c选项在输出汇编时有效，附带输出IR指令内容
-    const char options[] = "ho:STIADO:t:c";
     int option_index = 0;
 
     opterr = 1;
 
 lb_check:
-    while ((ch = getopt_long(argc, argv, options, long_options, &option_index)) != -1) {
+    while ((ch = getopt_long(argc, argv, gShortOptions, long_options, &option_index)) != -1) {
         switch (ch) {
             case 'h':
                 gShowHelp = true;
@@ -151,39 +325,41 @@ lb_check:
             case 'S':
                 gShowSymbol = true;
                 break;
-            case 'T':
-                gShowAST = true;
-                break;
-            case 'I':
-                // 产生中间IR
-                gShowLineIR = true;
-                break;
+            case 'j':
+                // 后端代码生成的线程数
+                gThreadNum = std::stoi(optarg);
+                if (gThreadNum < 1) {
+                    return -1;
+                }
                 break;
-            case 'A':
-                // 选用antlr4
-                gFrontEndAntlr4 = true;
-                gFrontEndFlexBison = false;
-                gFrontEndRecursiveDescentParsing = false;
+            case 'B':
+                gBatch = true;
                 break;
-            case 'D':
-                // 选用递归下降分析法与词法手动实现
-                gFrontEndAntlr4 = false;
-                gFrontEndFlexBison = false;
-                gFrontEndRecursiveDescentParsing = true;
+            case OPTION_SERVER:
+                gServerSocket = optarg;
                 break;
-            case 'O':
-                // 优化级别分析，暂时没有用，如开启优化时请使用
-                gOptLevel = std::stoi(optarg);
+            case OPTION_CHECK_FRONTEND:
+                gCheckFrontEndRounds = std::stoi(optarg);
+                if (gCheckFrontEndRounds < 1) {
+                    return -1;
+                }
                 break;
-            case 't':
-                gCPUTarget = optarg;
+            case OPTION_TIME_REPORT:
+                // 可选的参数为JSON格式报告的输出文件
+                gTimeReport = true;
+                gTimeReportFile = optarg ? optarg : "";
+                TimeReport::setEnabled(true);
                 break;
-            case 'c':
-                gAsmAlsoShowIR = true;
+            case OPTION_TRACE:
+                gTraceFile = optarg;
+                TraceEvent::setEnabled(true);
                 break;
             default:
-                return -1;
-                break; /* no break */
+                // 单个源文件的编译选项
+                if (!applyCompileOption(gOptions, ch, optarg)) {
+                    return -1;
+                }
+                break;
         }
     }
 
@@ -192,13 +368,23 @@ lb_check:
 
     if (argc >= 1) {
 
-        // 第一次设置
-        if (gInputFile.empty()) {
+        std::string arg = argv[0];
 
-            gInputFile = argv[0];
+        if (arg[0] == '@') {
+            // 源文件清单，每行一个文件名
+            std::ifstream listFile(arg.substr(1));
+            if (!listFile) {
+                return -1;
+            }
+
+            std::string line;
+            while (std::getline(listFile, line)) {
+                if (!line.empty()) {
+                    gInputFiles.push_back(line);
+                }
+            }
         } else {
-            // 重复设置则出错
-            return -1;
+            gInputFiles.push_back(arg);
         }
 
         if (argc > 1) {
@@ -208,8 +394,18 @@ lb_check:
         }
     }
 
-    // 必须指定要进行编译的输入文件
-    if (gInputFile.empty()) {
+    // 编译服务时源文件与输出内容由各请求指定
+    if (!gServerSocket.empty()) {
+        return (gInputFiles.empty() && !gBatch) ? 0 : -1;
+    }
+
+    // 前端检查可指定多个源文件，不需要输出
+    if (gCheckFrontEndRounds > 0) {
+        return gInputFiles.empty() ? -1 : 0;
+    }
+
+    // 必须指定要进行编译的输入文件，非批量模式只能有一个
+    if (gInputFiles.empty() || (!gBatch && gInputFiles.size() != 1)) {
         return -1;
     }
 
@@ -218,23 +414,26 @@ lb_check:
         return -1;
     }
 
-    int flag = (int) gShowLineIR + (int) gShowAST;
-
-    if (0 == flag) {
-        // 没有指定，则输出汇编指令
-        gShowASM = true;
-    } else if (flag != 1) {
-        // 线性中间IR、抽象语法树只能同时选择一个
+    if (!checkOutputKind(gOptions)) {
         return -1;
     }
 
+    // 批量模式时输出目录默认为当前目录
+    if (gBatch) {
+        if (gOutputFile.empty()) {
+            gOutputFile = ".";
+        }
+
+        return 0;
+    }
+
     // 没有指定输出文件则产生默认文件
     if (gOutputFile.empty()) {
 
         // 默认文件名
-        if (gShowAST) {
+        if (gOptions.showAST) {
             gOutputFile = "output.png";
-        } else if (gShowLineIR) {
+        } else if (gOptions.showLineIR) {
             gOutputFile = "output.ir";
         } else {
             gOutputFile = "output.s";
@@ -244,12 +443,57 @@ lb_check:
     return 0;
 }
 
+///
+/// @brief 按选项指定的前端对源文件进行词法与语法分析
+/// @param opts 编译选项
+/// @param inputFile 源文件
+/// @param astRoot 成功时返回抽象语法树的根节点
+/// @return true：成功 false：失败
+///
+static bool runFrontEnd(const CompileOptions & opts, const std::string & inputFile, ast_node *& astRoot)
+{
+    // Flex+Bison与递归下降的分析状态都在各自的上下文中，可同时分析；
+    // Antlr4运行时的多线程使用未经验证，同一时刻只能有一个文件用其分析
+    std::unique_lock<std::mutex> lock(gFrontEndMutex, std::defer_lock);
+    if (opts.frontEndAntlr4) {
+        lock.lock();
+    }
+
+    // 创建词法语法分析器
+    FrontEndExecutor * frontEndExecutor;
+    if (opts.frontEndAntlr4) {
+        // Antlr4
+        frontEndExecutor = new Antlr4Executor(inputFile);
+    } else if (opts.frontEndRecursiveDescentParsing) {
+        // 递归下降分析法
+        frontEndExecutor = new RecursiveDescentExecutor(inputFile, opts.rdLexerDFA);
+    } else {
+        // 默认为Flex+Bison
+        frontEndExecutor = new FlexBisonExecutor(inputFile);
+    }
+
+    // 前端执行：词法分析、语法分析后产生抽象语法树
+    bool result = frontEndExecutor->run();
+
+    // 获取抽象语法树的根节点
+    astRoot = frontEndExecutor->getASTRoot();
+
+    // 清理前端资源
+    delete frontEndExecutor;
+
+    return result;
+}
+
 ///
 /// @brief 对源文件进行编译处理生成汇编
-/// @return true 成功
-/// @return false 失败
+/// @param opts 编译选项
+/// @param inputFile 源文件
+/// @param outputFile 输出文件
+/// @param codeGenThreadNum 后端代码生成的线程数
+/// @return 0 成功
+/// @return -1 失败
 ///
-static int compile(std::string inputFile, std::string outputFile)
+static int compile(const CompileOptions & opts, std::string inputFile, std::string outputFile, int codeGenThreadNum)
 {
     // 函数返回值，默认-1
     int result = -1;
@@ -259,6 +503,9 @@ static int compile(std::string inputFile, std::string outputFile)
 
     Module * module = nullptr;
 
+    // 整个源文件的编译，跟踪的区间上附带源文件名
+    TimeScope compileScope("compile", [&inputFile] { return inputFile; });
+
     // 这里采用do {} while(0)架构的目的是如果处理出错可通过break退出循环，出口唯一
     // 在编译器编译优化时会自动去除，因为while恒假的缘故
     do {
@@ -269,21 +516,15 @@ static int compile(std::string inputFile, std::string outputFile)
         // 3) 对线性IR进行优化：目前不支持
         // 4) 把线性IR转换成汇编
 
-        // 创建词法语法分析器
-        FrontEndExecutor * frontEndExecutor;
-        if (gFrontEndAntlr4) {
-            // Antlr4
-            frontEndExecutor = new Antlr4Executor(inputFile);
-        } else if (gFrontEndRecursiveDescentParsing) {
-            // 递归下降分析法
-            frontEndExecutor = new RecursiveDescentExecutor(inputFile);
-        } else {
-            // 默认为Flex+Bison
-            frontEndExecutor = new FlexBisonExecutor(inputFile);
+        ast_node * astRoot = nullptr;
+
+        // 前端执行：词法分析、语法分析后产生抽象语法树
+        // 语法分析的动作中直接构建AST，三者无法分开计时，统计为一个阶段
+        {
+            TimeScope scope("frontend (lex+parse+AST)");
+            subResult = runFrontEnd(opts, inputFile, astRoot);
         }
 
-        // 前端执行：词法分析、语法分析后产生抽象语法树，其root为全局变量ast_root
-        subResult = frontEndExecutor->run();
         if (!subResult) {
 
             minic_log(LOG_ERROR, "前端分析错误");
@@ -291,18 +532,19 @@ static int compile(std::string inputFile, std::string outputFile)
             break;
         }
 
-        // 获取抽象语法树的根节点
-        ast_node * astRoot = frontEndExecutor->getASTRoot();
+        // 这里可进行非线性AST的优化
 
-        // 清理前端资源
-        delete frontEndExecutor;
+        if (opts.showAST) {
 
-        // 这里可进行非线性AST的优化
+            {
+                // Graphviz不支持多线程
+                std::lock_guard<std::mutex> lock(gGraphMutex);
 
-        if (gShowAST) {
+                TimeScope scope("AST graph output");
 
-            // 遍历抽象语法树，生成抽象语法树图片
-            OutputAST(astRoot, outputFile);
+                // 遍历抽象语法树，生成抽象语法树图片
+                OutputAST(astRoot, outputFile);
+            }
 
             // 清理抽象语法树
             free_ast(astRoot);
@@ -317,23 +559,38 @@ static int compile(std::string inputFile, std::string outputFile)
         // 都需要遍历AST转换成线性IR指令
 
         // 符号表，保存所有的变量以及函数等信息
-        Module * module = new Module(inputFile);
+        module = new Module(inputFile);
 
         // 遍历抽象语法树产生线性IR，相关信息保存到符号表中
         IRGenerator ast2IR(astRoot, module);
-        subResult = ast2IR.run();
+        {
+            TimeScope scope("IR generation");
+            subResult = ast2IR.run();
+        }
         if (!subResult) {
 
             // 输出错误信息
             minic_log(LOG_ERROR, "中间IR生成错误");
 
+            // AST节点上残留的指令来自函数的IR内存池，必须在符号表释放前清理
+            free_ast(astRoot);
+
             break;
         }
 
         // 清理抽象语法树
         free_ast(astRoot);
 
-        if (gShowLineIR) {
+        // 中间代码优化，体系结构无关的优化等，输出的线性IR也是优化后的
+        if (opts.optLevel > 0) {
+            TimeScope scope("IR optimization");
+
+            Optimizer(module, opts.optLevel).run();
+        }
+
+        if (opts.showLineIR) {
+
+            TimeScope scope("IR output");
 
             // 对IR的名字重命名
             module->renameIR();
@@ -348,47 +605,358 @@ static int compile(std::string inputFile, std::string outputFile)
         }
 
         // 要使得汇编能输出IR指令作为注释，必须对IR的名字进行命名，否则为空值
-        if (gAsmAlsoShowIR) {
+        if (opts.asmAlsoShowIR) {
+            TimeScope scope("IR rename");
+
             // 对IR的名字重命名
             module->renameIR();
         }
 
-        // 这里可追加中间代码优化，体系结果无关的优化等
-
         // 后端处理，体系结果相关的操作
         // 这里提供一种面向ARM32的汇编产生器CodeGeneratorArm32作为参考
         // 需要时可根据需要修改或追加新的目标体系架构
-        if (gShowASM) {
+        if (opts.showASM) {
 
             CodeGenerator * generator = nullptr;
 
-            if (gCPUTarget == "ARM32") {
+            if (opts.cpuTarget == "ARM32") {
                 // 输出面向ARM32的汇编指令
                 generator = new CodeGeneratorArm32(module);
-                generator->setShowLinearIR(gAsmAlsoShowIR);
+                generator->setShowLinearIR(opts.asmAlsoShowIR);
+                generator->setThreadNum(codeGenThreadNum);
+                generator->setOptLevel(opts.optLevel);
+
+                TimeScope scope("codegen");
                 generator->run(outputFile);
             } else {
                 // 不支持指定的CPU架构
-                minic_log(LOG_ERROR, "指定的目标CPU架构(%s)不支持", gCPUTarget.c_str());
+                minic_log(LOG_ERROR, "指定的目标CPU架构(%s)不支持", opts.cpuTarget.c_str());
                 break;
             }
 
             delete generator;
         }
 
-        // 清理符号表
-        module->Delete();
-
         // 成功执行
         result = 0;
 
     } while (false);
 
-    delete module;
+    // 清理符号表，出错提前退出时也要释放各函数的IR内存池
+    if (module) {
+        module->Delete();
+        delete module;
+    }
 
     return result;
 }
 
+///
+/// @brief 批量编译，所有源文件在一个进程内由gThreadNum个线程同时编译。
+/// 每个文件有各自的Module与输出文件，单个文件的失败不影响其它文件
+/// @return 0 全部成功
+/// @return -1 存在失败的文件
+///
+static int batchCompile()
+{
+    // 输出文件的扩展名
+    const char * ext = gOptions.showAST ? ".png" : (gOptions.showLineIR ? ".ir" : ".s");
+
+    // 输出文件为输出目录下同名的文件，文件名不能重复
+    std::vector<std::string> outputFiles;
+    std::set<std::string> names;
+    for (auto & inputFile: gInputFiles) {
+        std::filesystem::path outputFile = std::filesystem::path(gOutputFile) / std::filesystem::path(inputFile).stem();
+        outputFile += ext;
+
+        if (!names.insert(outputFile.string()).second) {
+            minic_log(LOG_ERROR, "输出文件(%s)重名，请检查源文件(%s)", outputFile.string().c_str(), inputFile.c_str());
+            return -1;
+        }
+
+        outputFiles.push_back(outputFile.string());
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(gOutputFile, ec);
+    if (ec) {
+        minic_log(LOG_ERROR, "输出目录(%s)创建失败", gOutputFile.c_str());
+        return -1;
+    }
+
+    // 各文件的编译结果
+    std::vector<int> results(gInputFiles.size(), -1);
+
+    // 文件之间已并行，后端单线程执行
+    parallelFor(gInputFiles.size(), gThreadNum, [&](std::size_t i) {
+        try {
+            results[i] = compile(gOptions, gInputFiles[i], outputFiles[i], 1);
+        } catch (const std::exception & e) {
+            minic_log(LOG_ERROR, "%s: %s", gInputFiles[i].c_str(), e.what());
+            results[i] = -1;
+        }
+    });
+
+    int failed = 0;
+    for (std::size_t i = 0; i < gInputFiles.size(); i++) {
+        if (results[i] != 0) {
+            minic_log(LOG_ERROR, "编译失败：%s", gInputFiles[i].c_str());
+            failed++;
+        }
+    }
+
+    if (failed) {
+        minic_log(LOG_ERROR, "共%zu个文件，失败%d个", gInputFiles.size(), failed);
+        return -1;
+    }
+
+    return 0;
+}
+
+///
+/// @brief 前端可重入检查。先串行分析每个源文件得到基准的AST，
+/// 再由gThreadNum个线程同时对所有源文件分析gCheckFrontEndRounds轮，每次的AST都需与基准一致
+/// @return 0 全部一致
+/// @return -1 分析失败或者存在不一致
+///
+static int checkFrontEnd()
+{
+    // 串行分析的AST文本作为基准
+    std::vector<std::string> expected(gInputFiles.size());
+    for (std::size_t i = 0; i < gInputFiles.size(); i++) {
+        ast_node * astRoot = nullptr;
+        bool ok = runFrontEnd(gOptions, gInputFiles[i], astRoot);
+        if (ok) {
+            dump_ast(astRoot, expected[i]);
+        }
+        free_ast(astRoot);
+
+        if (!ok) {
+            minic_log(LOG_ERROR, "前端分析错误：%s", gInputFiles[i].c_str());
+            return -1;
+        }
+    }
+
+    std::atomic<int> mismatches{0};
+
+    // 各线程的文件次序错开，使同一时刻不同线程分析的文件尽量不同
+    parallelFor((std::size_t) gThreadNum, gThreadNum, [&](std::size_t t) {
+        std::string actual;
+        for (int round = 0; round < gCheckFrontEndRounds; round++) {
+            for (std::size_t k = 0; k < gInputFiles.size(); k++) {
+                std::size_t i = (k + t) % gInputFiles.size();
+
+                ast_node * astRoot = nullptr;
+                bool ok = runFrontEnd(gOptions, gInputFiles[i], astRoot);
+
+                actual.clear();
+                if (ok) {
+                    dump_ast(astRoot, actual);
+                }
+                free_ast(astRoot);
+
+                if (!ok || actual != expected[i]) {
+                    minic_log(LOG_ERROR, "线程%zu第%d轮的AST与串行分析不一致：%s", t, round, gInputFiles[i].c_str());
+                    mismatches++;
+                }
+            }
+        }
+    });
+
+    std::cout << "frontend check: " << gInputFiles.size() << " files, " << gThreadNum << " threads, "
+              << gCheckFrontEndRounds << " rounds, " << mismatches.load() << " mismatches\n";
+
+    return mismatches.load() == 0 ? 0 : -1;
+}
+
+#ifndef _WIN32
+///
+/// @brief 解析编译请求中的选项，格式与命令行一致。getopt使用全局变量，不能在多个线程中同时使用，因此这里单独解析
+/// @param args 选项
+/// @param opts 编译选项
+/// @param error 出错时的错误信息
+/// @return true：成功 false：选项有误
+///
+static bool parseRequestOptions(const std::vector<std::string> & args, CompileOptions & opts, std::string & error)
+{
+    for (std::size_t i = 0; i < args.size(); i++) {
+
+        const std::string & arg = args[i];
+
+        if (arg.size() < 2 || arg[0] != '-') {
+            error = "不支持的参数：" + arg;
+            return false;
+        }
+
+        if (arg[1] == '-') {
+            // 长格式选项：--name或--name=value
+            std::string::size_type eq = arg.find('=');
+            std::string name = arg.substr(2, eq == std::string::npos ? std::string::npos : eq - 2);
+
+            const struct option * opt = long_options;
+            while (opt->name && name != opt->name) {
+                opt++;
+            }
+
+            if (!opt->name) {
+                error = "不支持的选项：" + arg;
+                return false;
+            }
+
+            std::string value;
+            if (opt->has_arg == required_argument) {
+                if (eq != std::string::npos) {
+                    value = arg.substr(eq + 1);
+                } else if (i + 1 < args.size()) {
+                    value = args[++i];
+                } else {
+                    error = "选项缺少参数：" + arg;
+                    return false;
+                }
+            } else if (eq != std::string::npos) {
+                error = "选项不能带参数：" + arg;
+                return false;
+            }
+
+            // -S可以省略，和命令行兼容
+            if (opt->val != 'S' && !applyCompileOption(opts, opt->val, value.c_str())) {
+                error = "不支持的选项：" + arg;
+                return false;
+            }
+
+            continue;
+        }
+
+        // 短格式选项，可以合并，如-SI，附加参数可紧跟或者为下一个参数
+        for (std::size_t k = 1; k < arg.size(); k++) {
+
+            char ch = arg[k];
+            const char * spec = std::strchr(gShortOptions, ch);
+            if (ch == ':' || spec == nullptr) {
+                error = std::string("不支持的选项：-") + ch;
+                return false;
+            }
+
+            std::string value;
+            bool hasArg = spec[1] == ':';
+            if (hasArg) {
+                if (k + 1 < arg.size()) {
+                    value = arg.substr(k + 1);
+                } else if (i + 1 < args.size()) {
+                    value = args[++i];
+                } else {
+                    error = std::string("选项缺少参数：-") + ch;
+                    return false;
+                }
+            }
+
+            if (ch != 'S' && !applyCompileOption(opts, ch, value.c_str())) {
+                error = std::string("不支持的选项：-") + ch;
+                return false;
+            }
+
+            if (hasArg) {
+                break;
+            }
+        }
+    }
+
+    return true;
+}
+
+///
+/// @brief 处理一个编译请求。源代码写入临时目录后按命令行的方式编译，输出文件的内容与诊断信息返回给客户端
+/// @param req 请求
+/// @param resp 响应
+///
+static void serveRequest(const CompileRequest & req, CompileResponse & resp)
+{
+    // 前端、优化级别等继承命令行的选项，输出的内容由请求决定
+    CompileOptions opts = gOptions;
+    opts.showAST = opts.showLineIR = opts.showASM = false;
+
+    std::string error;
+    if (!parseRequestOptions(req.args, opts, error) || !checkOutputKind(opts)) {
+        resp.status = -1;
+        resp.diagnostics = error.empty() ? "线性中间IR、抽象语法树只能同时选择一个\n" : error + "\n";
+        return;
+    }
+
+    // 每个请求的临时目录由mkdtemp创建，名字不可预测且只有本用户可访问，
+    // 不能沿用已存在的目录，否则其他用户可预先创建或放置符号链接，读取源代码或替换输出
+    std::error_code ec;
+    std::filesystem::path tempDir = std::filesystem::temp_directory_path(ec);
+    std::string dirTemplate = (tempDir / "minic-XXXXXX").string();
+    if (ec || (mkdtemp(dirTemplate.data()) == nullptr)) {
+        resp.status = -1;
+        resp.diagnostics = "临时目录创建失败：" + (ec ? ec.message() : std::string(std::strerror(errno))) + "\n";
+        return;
+    }
+
+    std::filesystem::path dir = dirTemplate;
+
+    std::filesystem::path inputFile = dir / "source.c";
+    std::filesystem::path outputFile = dir / (opts.showAST ? "output.png" : (opts.showLineIR ? "output.ir" : "output.s"));
+
+    {
+        std::ofstream ofs(inputFile, std::ios::binary);
+        ofs.write(req.source.data(), (std::streamsize) req.source.size());
+    }
+
+    // 本线程的日志收集到响应中
+    minic_log_set_sink(&resp.diagnostics);
+
+    try {
+        resp.status = compile(opts, inputFile.string(), outputFile.string(), 1);
+    } catch (const std::exception & e) {
+        minic_log(LOG_ERROR, "%s", e.what());
+        resp.status = -1;
+    }
+
+    minic_log_set_sink(nullptr);
+
+    if (resp.status == 0) {
+        std::ifstream ifs(outputFile, std::ios::binary);
+        resp.output.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+    }
+
+    std::filesystem::remove_all(dir, ec);
+}
+
+///
+/// @brief 以编译服务的方式运行，gThreadNum个线程同时处理请求
+/// @return 0 正常退出
+/// @return -1 服务启动失败
+///
+static int runServer()
+{
+    CompileServer server(gServerSocket, gThreadNum, serveRequest);
+
+    return server.run();
+}
+#endif
+
+///
+/// @brief 输出各阶段的时间与内存统计报告
+///
+static void printTimeReport()
+{
+    if (gTimeReportFile.empty()) {
+        TimeReport::getInstance().print(stderr);
+        return;
+    }
+
+    FILE * fp = fopen(gTimeReportFile.c_str(), "w");
+    if (fp == nullptr) {
+        minic_log(LOG_ERROR, "统计报告文件(%s)不能打开", gTimeReportFile.c_str());
+        return;
+    }
+
+    TimeReport::getInstance().printJSON(fp);
+
+    fclose(fp);
+}
+
 /// @brief 主程序
 /// @param argc
 /// @param argv
@@ -421,8 +989,31 @@ int main(int argc, char * argv[])
         return 0;
     }
 
-    // 参数解析正确，进行编译处理，目前只支持一个文件的编译。
-    result = compile(gInputFile, gOutputFile);
+    if (!gServerSocket.empty()) {
+#ifndef _WIN32
+        // 编译服务，常驻进程处理客户端的编译请求
+        result = runServer();
+#else
+        minic_log(LOG_ERROR, "编译服务不支持Windows");
+#endif
+    } else if (gCheckFrontEndRounds > 0) {
+        // 前端可重入检查
+        result = checkFrontEnd();
+    } else if (gBatch) {
+        // 批量模式，一个进程内编译所有的源文件
+        result = batchCompile();
+    } else {
+        // 单个文件的编译
+        result = compile(gOptions, gInputFiles[0], gOutputFile, gThreadNum);
+    }
+
+    if (gTimeReport) {
+        printTimeReport();
+    }
+
+    if (!gTraceFile.empty() && !TraceEvent::getInstance().write(gTraceFile)) {
+        minic_log(LOG_ERROR, "跟踪文件(%s)不能打开", gTraceFile.c_str());
+    }
 
     return result;
 }
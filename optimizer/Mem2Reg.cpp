@@ -0,0 +1,399 @@
+///
+/// @file Mem2Reg.cpp
+/// @brief 局部变量提升为SSA值的实现
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#include <tuple>
+#include <utility>
+
+#include "Mem2Reg.h"
+#include "Casting.h"
+#include "ControlFlowGraph.h"
+#include "DominatorTree.h"
+#include "Function.h"
+#include "LabelInstruction.h"
+#include "Module.h"
+#include "MoveInstruction.h"
+#include "PhiInstruction.h"
+#include "Use.h"
+#include "Values/ConstInt.h"
+#include "Values/LocalVariable.h"
+
+/// @brief 构造函数
+/// @param _module 符号表
+/// @param _cfg 函数的控制流图
+/// @param _domTree 控制流图的支配树
+Mem2Reg::Mem2Reg(Module * _module, ControlFlowGraph & _cfg, DominatorTree & _domTree)
+    : module(_module), cfg(_cfg), domTree(_domTree)
+{}
+
+/// @brief 运行提升
+void Mem2Reg::run()
+{
+    collectVariables();
+
+    if (vars.empty()) {
+        return;
+    }
+
+    placePhis();
+    rename();
+    removeDeadPhis();
+}
+
+/// @brief 获取操作数对应的被提升变量的编号
+/// @param val 操作数
+/// @return int32_t 变量编号，不是被提升的变量时为-1
+int32_t Mem2Reg::varIndexOf(Value * val)
+{
+    if (!isa<LocalVariable>(val)) {
+        return -1;
+    }
+
+    auto iter = varIndex.find(val);
+
+    return (iter == varIndex.end()) ? -1 : iter->second;
+}
+
+/// @brief 获取变量当前到达的定值
+/// @param var 变量编号
+/// @return Value* 定值，尚未定值时为常量0
+Value * Mem2Reg::currentValue(int32_t var)
+{
+    if (current[(std::size_t) var]) {
+        return current[(std::size_t) var];
+    }
+
+    if (zero == nullptr) {
+        zero = module->newConstInt(0);
+    }
+
+    return zero;
+}
+
+/// @brief 确定可提升的变量，并记录各变量定值所在的块
+void Mem2Reg::collectVariables()
+{
+    // 候选为整型的局部变量
+    for (LocalVariable * var: cfg.getFunction()->getVarValues()) {
+        if (var->getType()->isInt32Type()) {
+            varIndex.emplace(var, (int32_t) vars.size());
+            vars.push_back(var);
+        }
+    }
+
+    if (vars.empty()) {
+        return;
+    }
+
+    // 源操作数不能转发的变量不提升；源操作数为其它候选变量时，该变量不提升则本变量也不提升
+    std::vector<bool> promotable(vars.size(), true);
+    std::vector<std::vector<int32_t>> copiedTo(vars.size());
+
+    for (BasicBlock * block: cfg.getBlocks()) {
+        for (Instruction * inst: block->getInsts()) {
+
+            auto * move = dyn_cast<MoveInstruction>(inst);
+            if (move == nullptr) {
+                continue;
+            }
+
+            int32_t dst = varIndexOf(move->getOperand(0));
+            if (dst < 0) {
+                continue;
+            }
+
+            Value * src = move->getOperand(1);
+            int32_t srcVar = varIndexOf(src);
+
+            if (srcVar >= 0) {
+                copiedTo[(std::size_t) srcVar].push_back(dst);
+            } else if (!isa<ConstInt>(src) && !isa<Instruction>(src)) {
+                promotable[(std::size_t) dst] = false;
+            }
+        }
+    }
+
+    std::vector<int32_t> worklist;
+    for (std::size_t v = 0; v < vars.size(); v++) {
+        if (!promotable[v]) {
+            worklist.push_back((int32_t) v);
+        }
+    }
+
+    while (!worklist.empty()) {
+
+        int32_t v = worklist.back();
+        worklist.pop_back();
+
+        for (int32_t dst: copiedTo[(std::size_t) v]) {
+            if (promotable[(std::size_t) dst]) {
+                promotable[(std::size_t) dst] = false;
+                worklist.push_back(dst);
+            }
+        }
+    }
+
+    // 只保留可提升的变量并重新编号
+    std::size_t kept = 0;
+    varIndex.clear();
+
+    for (std::size_t v = 0; v < vars.size(); v++) {
+        if (promotable[v]) {
+            varIndex.emplace(vars[v], (int32_t) kept);
+            vars[kept++] = vars[v];
+        }
+    }
+
+    vars.resize(kept);
+
+    // 记录定值所在的块，按块遍历，同一变量在一块内的多次定值只记录一次
+    defBlocks.assign(vars.size(), {});
+
+    for (BasicBlock * block: cfg.getBlocks()) {
+        for (Instruction * inst: block->getInsts()) {
+
+            auto * move = dyn_cast<MoveInstruction>(inst);
+            if (move == nullptr) {
+                continue;
+            }
+
+            int32_t dst = varIndexOf(move->getOperand(0));
+            if (dst < 0) {
+                continue;
+            }
+
+            std::vector<BasicBlock *> & blocks = defBlocks[(std::size_t) dst];
+            if (blocks.empty() || (blocks.back() != block)) {
+                blocks.push_back(block);
+            }
+        }
+    }
+}
+
+/// @brief 在定值块的迭代支配边界处放置PHI指令
+void Mem2Reg::placePhis()
+{
+    Function * func = cfg.getFunction();
+
+    // 以变量编号作为标记，避免每个变量重新清空
+    std::vector<int32_t> hasPhi((std::size_t) cfg.getBlockCount(), -1);
+    std::vector<int32_t> inWork((std::size_t) cfg.getBlockCount(), -1);
+    std::vector<BasicBlock *> worklist;
+
+    for (std::size_t v = 0; v < vars.size(); v++) {
+
+        for (BasicBlock * block: defBlocks[v]) {
+            inWork[(std::size_t) block->getIndex()] = (int32_t) v;
+            worklist.push_back(block);
+        }
+
+        while (!worklist.empty()) {
+
+            BasicBlock * block = worklist.back();
+            worklist.pop_back();
+
+            for (BasicBlock * join: domTree.getFrontier(block)) {
+
+                auto y = (std::size_t) join->getIndex();
+
+                if (hasPhi[y] == (int32_t) v) {
+                    continue;
+                }
+
+                hasPhi[y] = (int32_t) v;
+
+                // PHI指令放在Label之后
+                auto * phi = new (func) PhiInstruction(func, vars[v]->getType());
+                InstList & insts = join->getInsts();
+                LabelInstruction * label = join->getLabel();
+
+                if (label) {
+                    (void) insts.insertAfter(InstList::iteratorOf(label), phi);
+                } else {
+                    insts.push_front(phi);
+                }
+
+                phiVars.emplace(phi, (int32_t) v);
+                phis.emplace_back(phi, join);
+
+                // PHI指令也是定值
+                if (inWork[y] != (int32_t) v) {
+                    inWork[y] = (int32_t) v;
+                    worklist.push_back(join);
+                }
+            }
+        }
+    }
+}
+
+/// @brief 沿支配树先序重命名，替换读取并删除赋值
+void Mem2Reg::rename()
+{
+    current.assign(vars.size(), nullptr);
+
+    // 进入块时改变的定值记入日志，离开块时按日志恢复
+    std::vector<std::pair<int32_t, Value *>> undoLog;
+    std::vector<std::pair<MoveInstruction *, BasicBlock *>> deadMoves;
+
+    // 非递归的支配树遍历，栈中记录块、下一个要访问的子节点的下标以及进入时日志的长度
+    std::vector<std::tuple<BasicBlock *, std::size_t, std::size_t>> stack;
+
+    BasicBlock * entry = cfg.getEntry();
+    if (entry == nullptr) {
+        return;
+    }
+
+    stack.emplace_back(entry, 0, 0);
+
+    bool entering = true;
+
+    while (!stack.empty()) {
+
+        BasicBlock * block = std::get<0>(stack.back());
+
+        if (entering) {
+
+            for (Instruction * inst: block->getInsts()) {
+
+                if (auto * phi = dyn_cast<PhiInstruction>(inst)) {
+                    int32_t v = phiVars[phi];
+                    undoLog.emplace_back(v, current[(std::size_t) v]);
+                    current[(std::size_t) v] = phi;
+                    continue;
+                }
+
+                auto * move = dyn_cast<MoveInstruction>(inst);
+                int32_t dst = move ? varIndexOf(move->getOperand(0)) : -1;
+
+                if (dst >= 0) {
+
+                    // 被提升变量的赋值：记录源操作数作为新的定值，指令之后删除
+                    Value * src = move->getOperand(1);
+                    int32_t srcVar = varIndexOf(src);
+
+                    undoLog.emplace_back(dst, current[(std::size_t) dst]);
+                    current[(std::size_t) dst] = (srcVar >= 0) ? currentValue(srcVar) : src;
+                    deadMoves.emplace_back(move, block);
+                    continue;
+                }
+
+                for (int32_t k = 0; k < inst->getOperandsNum(); k++) {
+                    int32_t v = varIndexOf(inst->getOperand(k));
+                    if (v >= 0) {
+                        inst->setOperand(k, currentValue(v));
+                    }
+                }
+            }
+
+            // 后继块的PHI指令都在Label之后连续存放
+            for (BasicBlock * succ: block->getSuccessors()) {
+                for (Instruction * inst: succ->getInsts()) {
+
+                    if (isa<LabelInstruction>(inst)) {
+                        continue;
+                    }
+
+                    auto * phi = dyn_cast<PhiInstruction>(inst);
+                    if (phi == nullptr) {
+                        break;
+                    }
+
+                    phi->addIncoming(currentValue(phiVars[phi]), block);
+                }
+            }
+        }
+
+        BlockRange children = domTree.getChildren(block);
+        std::size_t & next = std::get<1>(stack.back());
+
+        if (next < children.size()) {
+            stack.emplace_back(children[next++], 0, undoLog.size());
+            entering = true;
+            continue;
+        }
+
+        // 离开块，恢复进入前的定值
+        std::size_t mark = std::get<2>(stack.back());
+
+        while (undoLog.size() > mark) {
+            current[(std::size_t) undoLog.back().first] = undoLog.back().second;
+            undoLog.pop_back();
+        }
+
+        stack.pop_back();
+        entering = false;
+    }
+
+    for (auto & [move, moveBlock]: deadMoves) {
+        move->clearOperands();
+        moveBlock->getInsts().remove(move);
+        delete move;
+    }
+}
+
+/// @brief 删除结果最终没有被非PHI指令使用的PHI指令
+void Mem2Reg::removeDeadPhis()
+{
+    // 被非PHI指令使用的PHI指令是活跃的，活跃PHI指令的PHI操作数也是活跃的
+    std::unordered_map<PhiInstruction *, bool> live;
+    std::vector<PhiInstruction *> worklist;
+
+    for (auto & [phi, block]: phis) {
+
+        bool used = false;
+
+        for (Use * use = phi->getFirstUse(); use; use = use->getNextUse()) {
+            if (!isa<PhiInstruction>(use->getUser())) {
+                used = true;
+                break;
+            }
+        }
+
+        live.emplace(phi, used);
+
+        if (used) {
+            worklist.push_back(phi);
+        }
+    }
+
+    while (!worklist.empty()) {
+
+        PhiInstruction * phi = worklist.back();
+        worklist.pop_back();
+
+        for (int32_t k = 0; k < phi->getIncomingCount(); k++) {
+
+            auto * operand = dyn_cast<PhiInstruction>(phi->getIncomingValue(k));
+
+            if (operand && !live[operand]) {
+                live[operand] = true;
+                worklist.push_back(operand);
+            }
+        }
+    }
+
+    // 死PHI指令之间可能互相使用，全部解除操作数后再删除
+    for (auto & [phi, block]: phis) {
+        if (!live[phi]) {
+            phi->clearOperands();
+        }
+    }
+
+    for (auto & [phi, block]: phis) {
+        if (!live[phi]) {
+            block->getInsts().remove(phi);
+            delete phi;
+        }
+    }
+}
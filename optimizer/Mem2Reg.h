@@ -0,0 +1,131 @@
+///
+/// @file Mem2Reg.h
+/// @brief 局部变量提升为SSA值的头文件
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+/// 按Cytron等人的方法构造SSA：在变量定值块的迭代支配边界处放置PHI指令，
+/// 再沿支配树先序重命名，变量的读取替换为到达该处的定值，变量的赋值指令删除。
+///
+/// 变量的每次定值都是一条Move指令，源操作数会被直接转发给后续的读取。
+/// 源操作数为全局变量、形参、内存变量或未提升的局部变量时，它们在两次读取之间可能被修改，
+/// 转发会改变语义，这样的变量不提升。
+///
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class BasicBlock;
+class ControlFlowGraph;
+class DominatorTree;
+class Instruction;
+class LocalVariable;
+class Module;
+class PhiInstruction;
+class Value;
+
+///
+/// @brief 把函数中的整型局部变量提升为SSA值
+///
+class Mem2Reg {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _module 符号表，用于创建未定值读取时的常量0
+    /// @param _cfg 函数的控制流图，不可达的块需事先删除
+    /// @param _domTree 控制流图的支配树
+    ///
+    Mem2Reg(Module * _module, ControlFlowGraph & _cfg, DominatorTree & _domTree);
+
+    ///
+    /// @brief 运行提升，被提升的变量不再有使用者，由调用者删除
+    ///
+    void run();
+
+    ///
+    /// @brief 获取被提升的变量个数
+    /// @return int32_t 个数
+    ///
+    [[nodiscard]] int32_t getPromotedCount() const
+    {
+        return (int32_t) vars.size();
+    }
+
+private:
+    ///
+    /// @brief 确定可提升的变量，并记录各变量定值所在的块
+    ///
+    void collectVariables();
+
+    ///
+    /// @brief 在定值块的迭代支配边界处放置PHI指令
+    ///
+    void placePhis();
+
+    ///
+    /// @brief 沿支配树先序重命名，替换读取并删除赋值
+    ///
+    void rename();
+
+    ///
+    /// @brief 删除结果最终没有被非PHI指令使用的PHI指令
+    ///
+    void removeDeadPhis();
+
+    ///
+    /// @brief 获取操作数对应的被提升变量的编号
+    /// @param val 操作数
+    /// @return int32_t 变量编号，不是被提升的变量时为-1
+    ///
+    int32_t varIndexOf(Value * val);
+
+    ///
+    /// @brief 获取变量当前到达的定值，尚未定值时为常量0
+    /// @param var 变量编号
+    /// @return Value* 定值
+    ///
+    Value * currentValue(int32_t var);
+
+    /// @brief 符号表
+    Module * module;
+
+    /// @brief 控制流图
+    ControlFlowGraph & cfg;
+
+    /// @brief 支配树
+    DominatorTree & domTree;
+
+    /// @brief 被提升的变量
+    std::vector<LocalVariable *> vars;
+
+    /// @brief 变量到编号的映射
+    std::unordered_map<Value *, int32_t> varIndex;
+
+    /// @brief 各变量定值所在的块，每块只出现一次
+    std::vector<std::vector<BasicBlock *>> defBlocks;
+
+    /// @brief 放置的PHI指令对应的变量编号
+    std::unordered_map<PhiInstruction *, int32_t> phiVars;
+
+    /// @brief 放置的PHI指令及其所在的块
+    std::vector<std::pair<PhiInstruction *, BasicBlock *>> phis;
+
+    /// @brief 重命名时各变量当前到达的定值
+    std::vector<Value *> current;
+
+    /// @brief 未定值的读取使用的常量0
+    Value * zero = nullptr;
+};
@@ -0,0 +1,73 @@
+///
+/// @file Optimizer.cpp
+/// @brief 中间IR优化的实现
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#include "Optimizer.h"
+#include "ControlFlowGraph.h"
+#include "DominatorTree.h"
+#include "Function.h"
+#include "Mem2Reg.h"
+#include "Module.h"
+#include "OutOfSSA.h"
+#include "TimeReport.h"
+
+/// @brief 构造函数
+/// @param _module 符号表
+/// @param _optLevel 优化级别
+Optimizer::Optimizer(Module * _module, int _optLevel) : module(_module), optLevel(_optLevel)
+{}
+
+/// @brief 对所有的自定义函数进行优化
+void Optimizer::run()
+{
+    if (optLevel < 1) {
+        return;
+    }
+
+    for (Function * func: module->getFunctionList()) {
+        if (!func->isBuiltin()) {
+            optimizeFunction(func);
+        }
+    }
+}
+
+/// @brief 对一个函数进行优化
+/// @param func 函数
+void Optimizer::optimizeFunction(Function * func)
+{
+    {
+        ControlFlowGraph cfg(func);
+
+        {
+            TimeScope scope("unreachable block removal", [func] { return func->getName(); });
+            cfg.removeUnreachableBlocks();
+        }
+
+        {
+            TimeScope scope("mem2reg", [func] { return func->getName(); });
+            DominatorTree domTree(cfg);
+            Mem2Reg(module, cfg, domTree).run();
+        }
+
+        {
+            TimeScope scope("out of SSA", [func] { return func->getName(); });
+            OutOfSSA(cfg).run();
+        }
+
+        // 析构时线性化
+    }
+
+    // 被提升的变量不再被使用，删除后不再分配栈空间
+    func->removeUnusedVarValues();
+}
@@ -0,0 +1,56 @@
+///
+/// @file Optimizer.h
+/// @brief 中间IR优化的头文件
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+/// 按优化级别对每个函数依次运行各Pass，优化后函数仍为线性IR，后端无需区分是否优化过。
+///
+/// -O1：删除不可达块，局部变量提升为SSA值（Mem2Reg），再消除PHI指令（OutOfSSA）。
+/// 提升后的变量不再分配栈空间，读取直接使用常量或指令的结果，减少了栈的读写。
+///
+#pragma once
+
+class Function;
+class Module;
+
+///
+/// @brief 中间IR优化
+///
+class Optimizer {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _module 符号表
+    /// @param _optLevel 优化级别，即-O后面的数字
+    ///
+    Optimizer(Module * _module, int _optLevel);
+
+    ///
+    /// @brief 对所有的自定义函数进行优化
+    ///
+    void run();
+
+private:
+    ///
+    /// @brief 对一个函数进行优化
+    /// @param func 函数
+    ///
+    void optimizeFunction(Function * func);
+
+    /// @brief 符号表
+    Module * module;
+
+    /// @brief 优化级别
+    int optLevel;
+};
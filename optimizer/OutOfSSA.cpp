@@ -0,0 +1,195 @@
+///
+/// @file OutOfSSA.cpp
+/// @brief 消除PHI指令的实现
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#include "OutOfSSA.h"
+#include "Casting.h"
+#include "ControlFlowGraph.h"
+#include "Function.h"
+#include "LabelInstruction.h"
+#include "MoveInstruction.h"
+#include "PhiInstruction.h"
+
+/// @brief 构造函数
+/// @param _cfg 函数的控制流图
+OutOfSSA::OutOfSSA(ControlFlowGraph & _cfg) : cfg(_cfg)
+{}
+
+/// @brief 获取块开头的PHI指令
+/// @param block 基本块
+/// @param phis 返回的PHI指令
+void OutOfSSA::collectPhis(BasicBlock * block, std::vector<PhiInstruction *> & phis)
+{
+    phis.clear();
+
+    for (Instruction * inst: block->getInsts()) {
+
+        if (isa<LabelInstruction>(inst)) {
+            continue;
+        }
+
+        auto * phi = dyn_cast<PhiInstruction>(inst);
+        if (phi == nullptr) {
+            break;
+        }
+
+        phis.push_back(phi);
+    }
+}
+
+/// @brief 运行转换
+void OutOfSSA::run()
+{
+    Function * func = cfg.getFunction();
+
+    std::vector<PhiInstruction *> phis;
+    std::vector<BasicBlock *> preds;
+    std::vector<std::pair<Value *, Value *>> copies;
+
+    // 拆分关键边时新块加入到末尾，新块没有PHI指令，只处理原有的块
+    std::size_t blockCount = cfg.getBlocks().size();
+
+    for (std::size_t b = 0; b < blockCount; b++) {
+
+        BasicBlock * block = cfg.getBlocks()[b];
+
+        collectPhis(block, phis);
+        if (phis.empty()) {
+            continue;
+        }
+
+        // 拆分关键边，PHI指令的入边改为新块
+        preds = block->getPredecessors();
+
+        for (BasicBlock * pred: preds) {
+
+            if (pred->getSuccessors().size() < 2) {
+                continue;
+            }
+
+            BasicBlock * split = cfg.splitEdge(pred, block);
+
+            for (PhiInstruction * phi: phis) {
+                for (int32_t k = 0; k < phi->getIncomingCount(); k++) {
+                    if (phi->getIncomingBlock(k) == pred) {
+                        phi->setIncomingBlock(k, split);
+                    }
+                }
+            }
+        }
+
+        // PHI指令的结果改为变量，其它PHI指令的入边值随之变为该变量，在入边上读取的是赋值前的值
+        std::vector<Value *> vars;
+
+        for (PhiInstruction * phi: phis) {
+            LocalVariable * var = func->newLocalVarValue(phi->getType());
+            phi->replaceAllUsesWith(var);
+            vars.push_back(var);
+        }
+
+        for (BasicBlock * pred: block->getPredecessors()) {
+
+            copies.clear();
+
+            for (std::size_t k = 0; k < phis.size(); k++) {
+
+                Value * val = phis[k]->getIncomingValueForBlock(pred);
+
+                if (val && (val != vars[k])) {
+                    copies.emplace_back(vars[k], val);
+                }
+            }
+
+            insertParallelCopy(pred, copies);
+        }
+
+        for (PhiInstruction * phi: phis) {
+            phi->clearOperands();
+        }
+
+        for (PhiInstruction * phi: phis) {
+            block->getInsts().remove(phi);
+            delete phi;
+        }
+    }
+}
+
+/// @brief 把一组并行赋值串行化后插入到块末尾的跳转之前
+/// @param block 基本块
+/// @param copies 并行赋值，每项为(目标, 源)，目标互不相同
+void OutOfSSA::insertParallelCopy(BasicBlock * block, std::vector<std::pair<Value *, Value *>> & copies)
+{
+    Function * func = cfg.getFunction();
+
+    while (!copies.empty()) {
+
+        // 目标不再被其它赋值读取的赋值可以先执行
+        bool progress = false;
+
+        for (std::size_t k = 0; k < copies.size();) {
+
+            Value * dst = copies[k].first;
+            bool read = false;
+
+            for (auto & [otherDst, otherSrc]: copies) {
+                if (otherSrc == dst) {
+                    read = true;
+                    break;
+                }
+            }
+
+            if (read) {
+                k++;
+                continue;
+            }
+
+            insertBeforeTerminator(block, new (func) MoveInstruction(func, dst, copies[k].second));
+
+            copies[k] = copies.back();
+            copies.pop_back();
+            progress = true;
+        }
+
+        if (progress || copies.empty()) {
+            continue;
+        }
+
+        // 剩下的赋值构成环，把其中一个目标的旧值存入临时变量，读取它的赋值改读临时变量
+        Value * dst = copies.front().first;
+        LocalVariable * temp = func->newLocalVarValue(dst->getType());
+
+        insertBeforeTerminator(block, new (func) MoveInstruction(func, temp, dst));
+
+        for (auto & [otherDst, otherSrc]: copies) {
+            if (otherSrc == dst) {
+                otherSrc = temp;
+            }
+        }
+    }
+}
+
+/// @brief 在块末尾的跳转之前插入指令
+/// @param block 基本块
+/// @param inst 指令
+void OutOfSSA::insertBeforeTerminator(BasicBlock * block, Instruction * inst)
+{
+    InstList & insts = block->getInsts();
+    Instruction * terminator = block->getTerminator();
+
+    if (terminator) {
+        (void) insts.insert(InstList::iteratorOf(terminator), inst);
+    } else {
+        insts.push_back(inst);
+    }
+}
@@ -0,0 +1,74 @@
+///
+/// @file OutOfSSA.h
+/// @brief 消除PHI指令的头文件
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+/// 每条PHI指令改为一个新的局部变量，在各前驱块的末尾（跳转之前）赋值。
+/// 同一块的所有PHI指令在入边上并行赋值，需串行化：先赋值目标不再被读取的，
+/// 剩下的都在环上，借助一个临时变量打破环。
+///
+/// 前驱有多个后继时，赋值放在前驱末尾会影响其它后继，因此先拆分这样的关键边。
+///
+#pragma once
+
+#include <utility>
+#include <vector>
+
+class BasicBlock;
+class ControlFlowGraph;
+class Instruction;
+class PhiInstruction;
+class Value;
+
+///
+/// @brief 把函数从SSA形式转换回普通的变量赋值，之后控制流图可以线性化
+///
+class OutOfSSA {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _cfg 函数的控制流图
+    ///
+    explicit OutOfSSA(ControlFlowGraph & _cfg);
+
+    ///
+    /// @brief 运行转换
+    ///
+    void run();
+
+private:
+    ///
+    /// @brief 获取块开头的PHI指令
+    /// @param block 基本块
+    /// @param phis 返回的PHI指令
+    ///
+    static void collectPhis(BasicBlock * block, std::vector<PhiInstruction *> & phis);
+
+    ///
+    /// @brief 把一组并行赋值串行化后插入到块末尾的跳转之前
+    /// @param block 基本块
+    /// @param copies 并行赋值，每项为(目标, 源)，目标互不相同
+    ///
+    void insertParallelCopy(BasicBlock * block, std::vector<std::pair<Value *, Value *>> & copies);
+
+    ///
+    /// @brief 在块末尾的跳转之前插入指令
+    /// @param block 基本块
+    /// @param inst 指令
+    ///
+    static void insertBeforeTerminator(BasicBlock * block, Instruction * inst);
+
+    /// @brief 控制流图
+    ControlFlowGraph & cfg;
+};
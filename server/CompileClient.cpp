@@ -0,0 +1,264 @@
+///
+/// @file CompileClient.cpp
+/// @brief 编译服务的客户端，把源文件发给编译服务并保存返回的输出，也可测试每个请求的时延
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+/// 用法：minic-client SOCKET [options] source [-o output] [--bench=N [--minic=PATH]]
+///
+/// options与minic的命令行选项一致，如-A、-D、-I、-T、-O1等。不指定-o时输出到标准输出。
+/// 指定--bench时同一请求发送N次，统计每个请求时延的p50与p99，
+/// 同时指定--minic时再用fork/exec的方式执行N次命令行的编译器作为对比
+///
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "CompileProtocol.h"
+
+///
+/// @brief 连接编译服务
+/// @param path 套接字路径
+/// @return 套接字，失败时为-1
+///
+static int connectServer(const std::string & path)
+{
+    sockaddr_un addr{};
+    if (path.size() >= sizeof(addr.sun_path)) {
+        return -1;
+    }
+
+    addr.sun_family = AF_UNIX;
+    std::strcpy(addr.sun_path, path.c_str());
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return -1;
+    }
+
+    if (connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0) {
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+///
+/// @brief 用fork/exec执行一次命令行的编译器
+/// @param argv 参数
+/// @return 编译器的退出码，执行失败时为-1
+///
+static int runProcess(const std::vector<std::string> & argv)
+{
+    std::vector<char *> args;
+    for (auto & arg: argv) {
+        args.push_back(const_cast<char *>(arg.c_str()));
+    }
+    args.push_back(nullptr);
+
+    pid_t pid = fork();
+    if (pid < 0) {
+        return -1;
+    }
+
+    if (pid == 0) {
+        execv(args[0], args.data());
+        _exit(127);
+    }
+
+    int status;
+    if (waitpid(pid, &status, 0) < 0 || !WIFEXITED(status)) {
+        return -1;
+    }
+
+    return WEXITSTATUS(status);
+}
+
+///
+/// @brief 输出时延的统计结果
+/// @param name 名称
+/// @param samples 每次的时延，单位微秒
+///
+static void report(const char * name, std::vector<double> & samples)
+{
+    std::sort(samples.begin(), samples.end());
+
+    auto percentile = [&](double p) {
+        std::size_t idx = (std::size_t) (p * (double) (samples.size() - 1) + 0.5);
+        return samples[idx];
+    };
+
+    double sum = 0;
+    for (double v: samples) {
+        sum += v;
+    }
+
+    std::printf("%-10s n=%zu  p50=%.1fus  p99=%.1fus  mean=%.1fus\n",
+                name,
+                samples.size(),
+                percentile(0.50),
+                percentile(0.99),
+                sum / (double) samples.size());
+}
+
+///
+/// @brief 显示帮助
+/// @param exeName 程序名
+///
+static void showHelp(const char * exeName)
+{
+    std::cerr << exeName << " SOCKET [options] source [-o output] [--bench=N [--minic=PATH]]\n";
+    std::cerr << "  options are those of minic, e.g. -A, -D, -I, -T, -O1, -t ARM32\n";
+    std::cerr << "  --bench=N     send the request N times and report p50/p99 latency\n";
+    std::cerr << "  --minic=PATH  with --bench, also run PATH N times by fork/exec for comparison\n";
+}
+
+int main(int argc, char * argv[])
+{
+    if (argc < 3) {
+        showHelp(argv[0]);
+        return -1;
+    }
+
+    std::string socketPath = argv[1];
+    std::string sourceFile, outputFile, minicPath;
+    std::vector<std::string> args;
+    int benchCount = 0;
+
+    for (int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+
+        if (arg == "-o" && i + 1 < argc) {
+            outputFile = argv[++i];
+        } else if (arg.rfind("--bench=", 0) == 0) {
+            benchCount = std::stoi(arg.substr(8));
+        } else if (arg.rfind("--minic=", 0) == 0) {
+            minicPath = arg.substr(8);
+        } else if (arg.size() > 1 && arg[0] == '-') {
+            args.push_back(arg);
+
+            // 附加参数是下一个参数时一起传递
+            if ((arg == "-O" || arg == "-t" || arg == "-L") && i + 1 < argc) {
+                args.push_back(argv[++i]);
+            }
+        } else if (sourceFile.empty()) {
+            sourceFile = arg;
+        } else {
+            showHelp(argv[0]);
+            return -1;
+        }
+    }
+
+    if (sourceFile.empty()) {
+        showHelp(argv[0]);
+        return -1;
+    }
+
+    CompileRequest req;
+    req.args = args;
+
+    std::ifstream ifs(sourceFile, std::ios::binary);
+    if (!ifs) {
+        std::cerr << "Can't open file " << sourceFile << "\n";
+        return -1;
+    }
+    req.source.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+
+    int fd = connectServer(socketPath);
+    if (fd < 0) {
+        std::cerr << "Can't connect to " << socketPath << ": " << std::strerror(errno) << "\n";
+        return -1;
+    }
+
+    CompileResponse resp;
+
+    if (benchCount > 0) {
+
+        // 每次请求的时延，同一个连接上依次发送
+        std::vector<double> server;
+        for (int i = 0; i < benchCount; i++) {
+            auto begin = std::chrono::steady_clock::now();
+            if (!sendCompileRequest(fd, req) || !recvCompileResponse(fd, resp)) {
+                std::cerr << "connection closed by server\n";
+                close(fd);
+                return -1;
+            }
+            auto end = std::chrono::steady_clock::now();
+            server.push_back(std::chrono::duration<double, std::micro>(end - begin).count());
+        }
+        report("server", server);
+
+        if (!minicPath.empty()) {
+            std::string tmpOutput = "/tmp/minic-client-" + std::to_string(getpid()) + ".out";
+
+            std::vector<std::string> cmd{minicPath, "-S"};
+            cmd.insert(cmd.end(), args.begin(), args.end());
+            cmd.insert(cmd.end(), {"-o", tmpOutput, sourceFile});
+
+            std::vector<double> process;
+            for (int i = 0; i < benchCount; i++) {
+                auto begin = std::chrono::steady_clock::now();
+                int status = runProcess(cmd);
+                auto end = std::chrono::steady_clock::now();
+                if (status != 0) {
+                    std::cerr << minicPath << " failed with status " << status << "\n";
+                    break;
+                }
+                process.push_back(std::chrono::duration<double, std::micro>(end - begin).count());
+            }
+            unlink(tmpOutput.c_str());
+
+            if (!process.empty()) {
+                report("fork/exec", process);
+            }
+        }
+
+        close(fd);
+
+        return resp.status == 0 ? 0 : -1;
+    }
+
+    if (!sendCompileRequest(fd, req) || !recvCompileResponse(fd, resp)) {
+        std::cerr << "connection closed by server\n";
+        close(fd);
+        return -1;
+    }
+
+    close(fd);
+
+    // 诊断信息输出到标准错误
+    std::cerr << resp.diagnostics;
+
+    if (resp.status == 0) {
+        if (outputFile.empty()) {
+            std::cout << resp.output;
+        } else {
+            std::ofstream ofs(outputFile, std::ios::binary);
+            ofs.write(resp.output.data(), (std::streamsize) resp.output.size());
+        }
+    }
+
+    return resp.status == 0 ? 0 : -1;
+}
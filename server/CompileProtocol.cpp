@@ -0,0 +1,229 @@
+///
+/// @file CompileProtocol.cpp
+/// @brief 编译服务的请求与响应在套接字上的收发
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#include <cerrno>
+
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "CompileProtocol.h"
+
+/// @brief 一个请求中最多的参数个数
+static constexpr uint32_t maxArgCount = 1024;
+
+///
+/// @brief 写入全部数据，被信号中断时继续写
+/// @param fd 套接字
+/// @param data 数据
+/// @param len 长度
+/// @return true：成功 false：失败
+///
+static bool writeAll(int fd, const void * data, std::size_t len)
+{
+    const char * p = static_cast<const char *>(data);
+
+    while (len > 0) {
+        // 对方关闭时不产生SIGPIPE信号，而是返回错误
+        ssize_t n = send(fd, p, len, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+
+        p += n;
+        len -= (std::size_t) n;
+    }
+
+    return true;
+}
+
+///
+/// @brief 读取指定长度的数据，被信号中断时继续读
+/// @param fd 套接字
+/// @param data 缓冲区
+/// @param len 长度
+/// @return true：成功 false：失败或者对方已关闭
+///
+static bool readAll(int fd, void * data, std::size_t len)
+{
+    char * p = static_cast<char *>(data);
+
+    while (len > 0) {
+        ssize_t n = recv(fd, p, len, 0);
+        if (n == 0) {
+            return false;
+        }
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+
+        p += n;
+        len -= (std::size_t) n;
+    }
+
+    return true;
+}
+
+///
+/// @brief 追加网络字节序的32位整数
+/// @param buf 缓冲区
+/// @param val 整数
+///
+static void putU32(std::string & buf, uint32_t val)
+{
+    uint32_t net = htonl(val);
+    buf.append(reinterpret_cast<const char *>(&net), sizeof(net));
+}
+
+///
+/// @brief 追加字符串，先长度后内容
+/// @param buf 缓冲区
+/// @param str 字符串
+///
+static void putString(std::string & buf, const std::string & str)
+{
+    putU32(buf, (uint32_t) str.size());
+    buf.append(str);
+}
+
+///
+/// @brief 读取网络字节序的32位整数
+/// @param fd 套接字
+/// @param val 整数
+/// @return true：成功 false：失败
+///
+static bool readU32(int fd, uint32_t & val)
+{
+    uint32_t net;
+    if (!readAll(fd, &net, sizeof(net))) {
+        return false;
+    }
+
+    val = ntohl(net);
+
+    return true;
+}
+
+///
+/// @brief 读取字符串，长度超过限制时认为数据有误
+/// @param fd 套接字
+/// @param str 字符串
+/// @return true：成功 false：失败
+///
+static bool readString(int fd, std::string & str)
+{
+    uint32_t len;
+    if (!readU32(fd, len) || len > compileProtocolMaxString) {
+        return false;
+    }
+
+    str.resize(len);
+
+    return len == 0 || readAll(fd, str.data(), len);
+}
+
+///
+/// @brief 发送请求
+/// @param fd 套接字
+/// @param req 请求
+/// @return true：成功 false：失败
+///
+bool sendCompileRequest(int fd, const CompileRequest & req)
+{
+    // 组装后一次发送，避免小包
+    std::string buf;
+
+    putU32(buf, compileProtocolMagic);
+    putU32(buf, (uint32_t) req.args.size());
+    for (auto & arg: req.args) {
+        putString(buf, arg);
+    }
+    putString(buf, req.source);
+
+    return writeAll(fd, buf.data(), buf.size());
+}
+
+///
+/// @brief 接收请求
+/// @param fd 套接字
+/// @param req 请求
+/// @return true：成功 false：对方已关闭连接或数据有误
+///
+bool recvCompileRequest(int fd, CompileRequest & req)
+{
+    uint32_t magic, argc;
+    if (!readU32(fd, magic) || magic != compileProtocolMagic) {
+        return false;
+    }
+
+    if (!readU32(fd, argc) || argc > maxArgCount) {
+        return false;
+    }
+
+    req.args.resize(argc);
+    for (auto & arg: req.args) {
+        if (!readString(fd, arg)) {
+            return false;
+        }
+    }
+
+    return readString(fd, req.source);
+}
+
+///
+/// @brief 发送响应
+/// @param fd 套接字
+/// @param resp 响应
+/// @return true：成功 false：失败
+///
+bool sendCompileResponse(int fd, const CompileResponse & resp)
+{
+    std::string buf;
+
+    putU32(buf, compileProtocolMagic);
+    putU32(buf, (uint32_t) resp.status);
+    putString(buf, resp.output);
+    putString(buf, resp.diagnostics);
+
+    return writeAll(fd, buf.data(), buf.size());
+}
+
+///
+/// @brief 接收响应
+/// @param fd 套接字
+/// @param resp 响应
+/// @return true：成功 false：对方已关闭连接或数据有误
+///
+bool recvCompileResponse(int fd, CompileResponse & resp)
+{
+    uint32_t magic, status;
+    if (!readU32(fd, magic) || magic != compileProtocolMagic) {
+        return false;
+    }
+
+    if (!readU32(fd, status)) {
+        return false;
+    }
+
+    resp.status = (int32_t) status;
+
+    return readString(fd, resp.output) && readString(fd, resp.diagnostics);
+}
@@ -0,0 +1,91 @@
+///
+/// @file CompileProtocol.h
+/// @brief 编译服务的请求与响应格式，以及在套接字上的收发
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+/// 所有整数均为网络字节序的32位整数，字符串为长度加内容。一个连接上可依次发送多个请求。
+///
+/// 请求：魔数 参数个数 参数1 ... 参数n 源代码
+///
+/// 响应：魔数 状态 输出内容 诊断信息
+///
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// @brief 请求与响应的魔数，即"MNC1"
+constexpr uint32_t compileProtocolMagic = 0x4d4e4331;
+
+/// @brief 单个字符串的最大长度，超过时认为数据有误
+constexpr uint32_t compileProtocolMaxString = 256u * 1024 * 1024;
+
+///
+/// @brief 编译请求
+///
+struct CompileRequest {
+
+    /// @brief 编译选项，和命令行的形式一样，如-A、-I、-O1等，不含源文件与输出文件
+    std::vector<std::string> args;
+
+    /// @brief 源代码的内容
+    std::string source;
+};
+
+///
+/// @brief 编译响应
+///
+struct CompileResponse {
+
+    /// @brief 编译的结果，0为成功，与命令行的退出码一致
+    int32_t status = -1;
+
+    /// @brief 输出内容，即汇编、IR或者AST图片
+    std::string output;
+
+    /// @brief 编译过程中的诊断信息
+    std::string diagnostics;
+};
+
+///
+/// @brief 发送请求
+/// @param fd 套接字
+/// @param req 请求
+/// @return true：成功 false：失败
+///
+bool sendCompileRequest(int fd, const CompileRequest & req);
+
+///
+/// @brief 接收请求
+/// @param fd 套接字
+/// @param req 请求
+/// @return true：成功 false：对方已关闭连接或数据有误
+///
+bool recvCompileRequest(int fd, CompileRequest & req);
+
+///
+/// @brief 发送响应
+/// @param fd 套接字
+/// @param resp 响应
+/// @return true：成功 false：失败
+///
+bool sendCompileResponse(int fd, const CompileResponse & resp);
+
+///
+/// @brief 接收响应
+/// @param fd 套接字
+/// @param resp 响应
+/// @return true：成功 false：对方已关闭连接或数据有误
+///
+bool recvCompileResponse(int fd, CompileResponse & resp);
@@ -0,0 +1,238 @@
+///
+/// @file CompileServer.cpp
+/// @brief 常驻的编译服务的实现
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <exception>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "Common.h"
+#include "CompileServer.h"
+
+/// @brief 信号处理函数通知主线程退出所用的管道，信号处理函数中只能写管道
+static int stopPipe[2] = {-1, -1};
+
+///
+/// @brief SIGINT与SIGTERM的处理函数
+/// @param sig 信号
+///
+static void onStopSignal(int sig)
+{
+    int savedErrno = errno;
+
+    char ch = (char) sig;
+    (void) !write(stopPipe[1], &ch, 1);
+
+    errno = savedErrno;
+}
+
+///
+/// @brief 构造函数
+/// @param _socketPath 套接字文件的路径
+/// @param _threadNum 工作线程数
+/// @param _handler 请求的处理函数
+///
+CompileServer::CompileServer(std::string _socketPath, int32_t _threadNum, Handler _handler)
+    : socketPath(std::move(_socketPath)), threadNum(_threadNum < 1 ? 1 : _threadNum), handler(std::move(_handler))
+{}
+
+///
+/// @brief 运行服务，直到收到退出信号
+/// @return 0：正常退出 -1：套接字创建失败
+///
+int CompileServer::run()
+{
+    sockaddr_un addr{};
+    if (socketPath.size() >= sizeof(addr.sun_path)) {
+        minic_log(LOG_ERROR, "套接字路径(%s)过长", socketPath.c_str());
+        return -1;
+    }
+
+    addr.sun_family = AF_UNIX;
+    std::strcpy(addr.sun_path, socketPath.c_str());
+
+    int listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listenFd < 0) {
+        minic_log(LOG_ERROR, "套接字创建失败：%s", std::strerror(errno));
+        return -1;
+    }
+
+    // 上次异常退出可能残留套接字文件
+    (void) unlink(socketPath.c_str());
+
+    if (bind(listenFd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0 || listen(listenFd, SOMAXCONN) < 0) {
+        minic_log(LOG_ERROR, "套接字(%s)绑定失败：%s", socketPath.c_str(), std::strerror(errno));
+        close(listenFd);
+        return -1;
+    }
+
+    if (pipe2(stopPipe, O_CLOEXEC | O_NONBLOCK) < 0) {
+        minic_log(LOG_ERROR, "管道创建失败：%s", std::strerror(errno));
+        close(listenFd);
+        (void) unlink(socketPath.c_str());
+        return -1;
+    }
+
+    // 不设置SA_RESTART，被信号中断的系统调用返回EINTR
+    struct sigaction sa {};
+    sa.sa_handler = onStopSignal;
+    sigemptyset(&sa.sa_mask);
+    struct sigaction oldInt, oldTerm;
+    sigaction(SIGINT, &sa, &oldInt);
+    sigaction(SIGTERM, &sa, &oldTerm);
+
+    std::vector<std::thread> workers;
+    for (int32_t i = 0; i < threadNum; i++) {
+        workers.emplace_back(&CompileServer::worker, this);
+    }
+
+    minic_log(LOG_INFO, "编译服务已启动：%s，工作线程%d个", socketPath.c_str(), threadNum);
+
+    pollfd fds[2] = {{listenFd, POLLIN, 0}, {stopPipe[0], POLLIN, 0}};
+
+    for (;;) {
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            minic_log(LOG_ERROR, "poll失败：%s", std::strerror(errno));
+            break;
+        }
+
+        if (fds[1].revents) {
+            // 收到退出信号
+            break;
+        }
+
+        if (fds[0].revents & POLLIN) {
+            int fd = accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+            if (fd < 0) {
+                continue;
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            pending.push_back(fd);
+            cond.notify_one();
+        }
+    }
+
+    // 停止接受新连接，等待工作线程退出
+    close(listenFd);
+    (void) unlink(socketPath.c_str());
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        cond.notify_all();
+    }
+    shutdownConnections();
+
+    for (auto & t: workers) {
+        t.join();
+    }
+
+    // 未处理的连接直接关闭
+    for (int fd: pending) {
+        close(fd);
+    }
+    pending.clear();
+
+    sigaction(SIGINT, &oldInt, nullptr);
+    sigaction(SIGTERM, &oldTerm, nullptr);
+    close(stopPipe[0]);
+    close(stopPipe[1]);
+    stopPipe[0] = stopPipe[1] = -1;
+
+    minic_log(LOG_INFO, "编译服务已退出");
+
+    return 0;
+}
+
+///
+/// @brief 工作线程，从队列中取出连接并处理
+///
+void CompileServer::worker()
+{
+    for (;;) {
+        int fd;
+
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cond.wait(lock, [this] { return stopping || !pending.empty(); });
+            if (stopping) {
+                return;
+            }
+
+            fd = pending.front();
+            pending.pop_front();
+            active.insert(fd);
+        }
+
+        serve(fd);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            active.erase(fd);
+        }
+
+        close(fd);
+    }
+}
+
+///
+/// @brief 处理一个连接上的全部请求，直到对方关闭连接
+/// @param fd 连接的套接字
+///
+void CompileServer::serve(int fd)
+{
+    CompileRequest req;
+
+    while (recvCompileRequest(fd, req)) {
+
+        CompileResponse resp;
+
+        try {
+            handler(req, resp);
+        } catch (const std::exception & e) {
+            resp.status = -1;
+            resp.diagnostics += e.what();
+            resp.diagnostics += '\n';
+        }
+
+        if (!sendCompileResponse(fd, resp)) {
+            break;
+        }
+    }
+}
+
+///
+/// @brief 退出时关闭正在处理的连接，使阻塞在接收上的工作线程返回
+///
+void CompileServer::shutdownConnections()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (int fd: active) {
+        (void) shutdown(fd, SHUT_RDWR);
+    }
+}
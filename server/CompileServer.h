@@ -0,0 +1,94 @@
+///
+/// @file CompileServer.h
+/// @brief 常驻的编译服务，在Unix域套接字上接收编译请求，由线程池并发处理
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <string>
+
+#include "CompileProtocol.h"
+
+///
+/// @brief 编译服务。主线程接受连接，连接放入队列后由工作线程处理，
+/// 一个连接上可依次发送多个请求。收到SIGINT或SIGTERM后退出，并删除套接字文件
+///
+class CompileServer {
+
+public:
+    ///
+    /// @brief 请求的处理函数，在工作线程中执行，需可重入
+    ///
+    using Handler = std::function<void(const CompileRequest & req, CompileResponse & resp)>;
+
+    ///
+    /// @brief 构造函数
+    /// @param _socketPath 套接字文件的路径
+    /// @param _threadNum 工作线程数
+    /// @param _handler 请求的处理函数
+    ///
+    CompileServer(std::string _socketPath, int32_t _threadNum, Handler _handler);
+
+    ///
+    /// @brief 运行服务，直到收到退出信号
+    /// @return 0：正常退出 -1：套接字创建失败
+    ///
+    int run();
+
+private:
+    ///
+    /// @brief 工作线程，从队列中取出连接并处理
+    ///
+    void worker();
+
+    ///
+    /// @brief 处理一个连接上的全部请求，直到对方关闭连接
+    /// @param fd 连接的套接字
+    ///
+    void serve(int fd);
+
+    ///
+    /// @brief 退出时关闭正在处理的连接，使阻塞在接收上的工作线程返回
+    ///
+    void shutdownConnections();
+
+    /// @brief 套接字文件的路径
+    std::string socketPath;
+
+    /// @brief 工作线程数
+    int32_t threadNum;
+
+    /// @brief 请求的处理函数
+    Handler handler;
+
+    /// @brief 保护下列成员的互斥锁
+    std::mutex mutex;
+
+    /// @brief 有新连接或退出时通知工作线程
+    std::condition_variable cond;
+
+    /// @brief 待处理的连接
+    std::deque<int> pending;
+
+    /// @brief 工作线程正在处理的连接
+    std::set<int> active;
+
+    /// @brief 是否退出
+    bool stopping = false;
+};
@@ -28,8 +28,17 @@ Module::Module(std::string _name) : name(_name)
     scopeStack->enterScope();
 
     // 加入内置函数putint
-    (void) newFunction("putint", VoidType::getType(), {new FormalParam{IntegerType::getTypeInt(), ""}}, true);
-    (void) newFunction("getint", IntegerType::getTypeInt(), {}, true);
+    (void) newFunction(internSymbol("putint"),
+                       VoidType::getType(),
+                       {new FormalParam{IntegerType::getTypeInt(), ""}},
+                       true);
+    (void) newFunction(internSymbol("getint"), IntegerType::getTypeInt(), {}, true);
+}
+
+/// @brief 析构函数，释放作用域栈
+Module::~Module()
+{
+    delete scopeStack;
 }
 
 /// @brief 进入作用域，如进入函数体块、语句块等
@@ -63,12 +72,12 @@ void Module::setCurrentFunction(Function * current)
 }
 
 /// @brief 新建函数并放到函数列表中
-/// @param name 函数名
+/// @param name 函数名在字符串池中的编号
 /// @param returnType 返回值类型
 /// @param params 形参列表
 /// @param builtin 是否内置函数
 /// @return 新建的函数对象实例
-Function * Module::newFunction(std::string name, Type * returnType, std::vector<FormalParam *> params, bool builtin)
+Function * Module::newFunction(Symbol name, Type * returnType, std::vector<FormalParam *> params, bool builtin)
 {
     // 先根据函数名查找函数，若找到则出错
     Function * tempFunc = findFunction(name);
@@ -88,20 +97,20 @@ Function * Module::newFunction(std::string name, Type * returnType, std::vector<
     FunctionType * type = new FunctionType(returnType, paramsType);
 
     // 新建函数对象
-    tempFunc = new Function(name, type, builtin);
+    tempFunc = new Function(std::string(symbolName(name)), type, builtin);
 
     // 设置参数
     tempFunc->getParams().assign(params.begin(), params.end());
 
-    insertFunctionDirectly(tempFunc);
+    insertFunctionDirectly(name, tempFunc);
 
     return tempFunc;
 }
 
 /// @brief 根据函数名查找函数信息
-/// @param name 函数名
+/// @param name 函数名在字符串池中的编号
 /// @return 函数信息
-Function * Module::findFunction(std::string name)
+Function * Module::findFunction(Symbol name)
 {
     // 根据名字查找
     auto pIter = funcMap.find(name);
@@ -115,20 +124,21 @@ Function * Module::findFunction(std::string name)
 
 ///
 /// @brief 直接向函数的符号表中加入函数。需外部检查函数的存在性
+/// @param name 函数名在字符串池中的编号
 /// @param func 要加入的函数
 ///
-void Module::insertFunctionDirectly(Function * func)
+void Module::insertFunctionDirectly(Symbol name, Function * func)
 {
-    funcMap.insert({func->getName(), func});
+    funcMap.insert({name, func});
     funcVector.emplace_back(func);
 }
 
 /// @brief Value直接插入到符号表中的全局变量中
-/// @param name Value的名称
+/// @param name Value的名称在字符串池中的编号
 /// @param val Value信息
-void Module::insertGlobalValueDirectly(GlobalVariable * val)
+void Module::insertGlobalValueDirectly(Symbol name, GlobalVariable * val)
 {
-    globalVariableMap.emplace(val->getName(), val);
+    globalVariableMap.emplace(name, val);
     globalVariableVector.push_back(val);
 }
 
@@ -179,18 +189,17 @@ ConstInt * Module::findConstInt(int32_t val)
 /// @param type 变量类型
 /// @param name 变量ID 局部变量时可以为空，目的为了SSA时创建临时的局部变量，
 /// @return nullptr则说明变量已存在，否则为新建的变量
-Value * Module::newVarValue(Type * type, std::string name)
+Value * Module::newVarValue(Type * type, Symbol name)
 {
     Value * retVal;
-    std::string varName;
 
     // 若变量名有效，检查当前作用域中是否存在变量，如存在则语义错误
     // 反之，因无效需创建新的变量名，肯定不现在的不同，不需要查找
-    if (!name.empty()) {
+    if (name != emptySymbol) {
         Value * tempValue = scopeStack->findCurrentScope(name);
         if (tempValue) {
             // 变量存在，语义错误
-            minic_log(LOG_ERROR, "变量(%s)已经存在", name.c_str());
+            minic_log(LOG_ERROR, "变量(%s)已经存在", symbolName(name).data());
             return nullptr;
         }
     } else if (!currentFunc) {
@@ -203,20 +212,20 @@ Value * Module::newVarValue(Type * type, std::string name)
 
         // 获取变量作用域的层级
         int32_t scope_level;
-        if (name.empty()) {
+        if (name == emptySymbol) {
             scope_level = 1;
         } else {
             scope_level = scopeStack->getCurrentScopeLevel();
         }
 
-        retVal = currentFunc->newLocalVarValue(type, name, scope_level);
+        retVal = currentFunc->newLocalVarValue(type, std::string(symbolName(name)), scope_level);
 
     } else {
         retVal = newGlobalVariable(type, name);
     }
 
     // 增加做作用域中
-    scopeStack->insertValue(retVal);
+    scopeStack->insertValue(name, retVal);
 
     return retVal;
 }
@@ -224,9 +233,9 @@ Value * Module::newVarValue(Type * type, std::string name)
 /// @brief 查找变量，会根据作用域栈进行逐级查找。
 /// ! 该函数只有在AST遍历生成线性IR中使用，其它地方不能使用
 ///
-/// @param name 变量ID
+/// @param name 变量ID在字符串池中的编号
 /// @return 指针有效则找到，空指针未找到
-Value * Module::findVarValue(std::string name)
+Value * Module::findVarValue(Symbol name)
 {
     // 逐层级作用域查找
     Value * tempValue = scopeStack->findAllScope(name);
@@ -237,23 +246,23 @@ Value * Module::findVarValue(std::string name)
 ///
 /// @brief 新建全局变量，要求name必须有效，并且加入到全局符号表中。不检查是否现有的符号表中是否存在。
 /// @param type 类型
-/// @param name 名字
+/// @param name 名字在字符串池中的编号
 /// @return Value* 全局变量
 ///
-GlobalVariable * Module::newGlobalVariable(Type * type, std::string name)
+GlobalVariable * Module::newGlobalVariable(Type * type, Symbol name)
 {
-    GlobalVariable * val = new GlobalVariable(type, name);
+    GlobalVariable * val = new GlobalVariable(type, std::string(symbolName(name)));
 
-    insertGlobalValueDirectly(val);
+    insertGlobalValueDirectly(name, val);
 
     return val;
 }
 
 /// @brief 根据变量名获取当前符号(只管理全局变量和常量)
-/// @param name 变量名或者常量名
+/// @param name 变量名或者常量名在字符串池中的编号
 /// @param create 变量查找不到时若为true则自动创建变量型Value，否则不创建
 /// @return 变量对应的值
-GlobalVariable * Module::findGlobalVariable(std::string name)
+GlobalVariable * Module::findGlobalVariable(Symbol name)
 {
     GlobalVariable * temp = nullptr;
 
@@ -279,6 +288,13 @@ void Module::Delete()
         delete var;
     }
 
+    // 清理整数常量，读取它们的指令已随函数释放
+    for (auto & [intVal, val]: constIntMap) {
+        delete val;
+    }
+
+    constIntMap.clear();
+
     // 相关列表清空
     globalVariableMap.clear();
     globalVariableVector.clear();
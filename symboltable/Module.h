@@ -20,6 +20,7 @@
 #include <unordered_map>
 
 #include "ConstInt.h"
+#include "StringInterner.h"
 #include "Type.h"
 #include "GlobalVariable.h"
 #include "Function.h"
@@ -39,9 +40,9 @@ public:
     Module(std::string _name);
 
     ///
-    /// @brief 缺省的析构函数
+    /// @brief 析构函数，释放作用域栈。函数与全局变量等由Delete释放
     ///
-    virtual ~Module() = default;
+    virtual ~Module();
 
     ///
     /// @brief 输出IR代码
@@ -77,18 +78,17 @@ public:
     void setCurrentFunction(Function * current);
 
     /// @brief 新建函数并放到函数列表中
-    /// @param name 函数名
+    /// @param name 函数名在字符串池中的编号
     /// @param returnType 返回值类型
     /// @param params 形参列表
     /// @param builtin 是否内置函数
     /// @return 新建的函数对象实例
-    Function *
-    newFunction(std::string name, Type * returnType, std::vector<FormalParam *> params = {}, bool builtin = false);
+    Function * newFunction(Symbol name, Type * returnType, std::vector<FormalParam *> params = {}, bool builtin = false);
 
     /// @brief 根据函数名查找函数信息
-    /// @param name 函数名
+    /// @param name 函数名在字符串池中的编号
     /// @return 函数信息
-    Function * findFunction(std::string name);
+    Function * findFunction(Symbol name);
 
     ///
     /// @brief 获取全局变量列表，用于外部遍历全局变量
@@ -112,15 +112,15 @@ public:
 
     /// @brief 新建变量型Value，会根据currentFunc的值进行判断创建全局或者局部变量
     /// ! 该函数只有在AST遍历生成线性IR中使用，其它地方不能使用
-    /// @param name 变量ID
+    /// @param name 变量ID在字符串池中的编号
     /// @param type 变量类型
-    Value * newVarValue(Type * type, std::string name = "");
+    Value * newVarValue(Type * type, Symbol name = emptySymbol);
 
     /// @brief 查找变量（全局变量或局部变量），会根据作用域栈进行逐级查找。
     /// ! 该函数只有在AST遍历生成线性IR中使用，其它地方不能使用
-    /// @param name 变量ID
+    /// @param name 变量ID在字符串池中的编号
     /// @return 指针有效则找到，空指针未找到
-    Value * findVarValue(std::string name);
+    Value * findVarValue(Symbol name);
 
     /// @brief 清理Module中管理的所有信息资源
     void Delete();
@@ -143,23 +143,25 @@ protected:
     ///
     /// @brief 新建全局变量，要求name必须有效，并且加入到全局符号表中。
     /// @param type 类型
-    /// @param name 名字
+    /// @param name 名字在字符串池中的编号
     /// @return Value* 全局变量
     ///
-    GlobalVariable * newGlobalVariable(Type * type, std::string name);
+    GlobalVariable * newGlobalVariable(Type * type, Symbol name);
 
     /// @brief 根据变量名获取当前符号（只管理全局变量）
-    /// \param name 变量名
+    /// \param name 变量名在字符串池中的编号
     /// \return 变量对应的值
-    GlobalVariable * findGlobalVariable(std::string name);
+    GlobalVariable * findGlobalVariable(Symbol name);
 
     /// @brief 直接插入函数到符号表中，不考虑现有的表中是否存在
+    /// @param name 函数名在字符串池中的编号
     /// @param func 函数对象
-    void insertFunctionDirectly(Function * func);
+    void insertFunctionDirectly(Symbol name, Function * func);
 
     /// @brief Value插入到符号表中
+    /// @param name 变量名在字符串池中的编号
     /// @param val Value信息
-    void insertGlobalValueDirectly(GlobalVariable * val);
+    void insertGlobalValueDirectly(Symbol name, GlobalVariable * val);
 
     /// @brief ConstInt插入到符号表中
     /// @param val Value信息
@@ -182,14 +184,14 @@ private:
     /// @brief 遍历抽象树过程中的当前处理函数
     Function * currentFunc = nullptr;
 
-    /// @brief 函数映射表，函数名-函数，便于检索
-    std::unordered_map<std::string, Function *> funcMap;
+    /// @brief 函数映射表，函数名编号-函数，便于检索
+    std::unordered_map<Symbol, Function *> funcMap;
 
     /// @brief  函数列表
     std::vector<Function *> funcVector;
 
-    /// @brief 变量名映射表，变量名-变量，只保存全局变量
-    std::unordered_map<std::string, GlobalVariable *> globalVariableMap;
+    /// @brief 变量名映射表，变量名编号-变量，只保存全局变量
+    std::unordered_map<Symbol, GlobalVariable *> globalVariableMap;
 
     /// @brief 只保存全局变量
     std::vector<GlobalVariable *> globalVariableVector;
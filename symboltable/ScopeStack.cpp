@@ -21,7 +21,7 @@
 void ScopeStack::enterScope()
 {
     // 在栈顶新加入一层，没有变量
-    std::unordered_map<std::string, Value *> valueMap;
+    std::unordered_map<Symbol, Value *> valueMap;
     valueStack.emplace_back(valueMap);
 }
 
@@ -35,19 +35,20 @@ void ScopeStack::leaveScope()
 
 ///
 /// @brief 向当前的作用域中加入变量
+/// @param name 变量名在字符串池中的编号
 /// @param value 变量
 ///
-void ScopeStack::insertValue(Value * value)
+void ScopeStack::insertValue(Symbol name, Value * value)
 {
-    valueStack.back().insert(make_pair(value->getName(), value));
+    valueStack.back().insert(std::make_pair(name, value));
 }
 
 ///
 /// @brief 从当前的作用域中查找指定的变量名
-/// @param  name 变量名
+/// @param  name 变量名在字符串池中的编号
 /// @return Value* 变量对象，若没有，则返回空指针
 ///
-Value * ScopeStack::findCurrentScope(std::string name)
+Value * ScopeStack::findCurrentScope(Symbol name)
 {
     // 在栈顶的作用域中查找，即当前作用域
     auto it = valueStack.back().find(name);
@@ -59,10 +60,10 @@ Value * ScopeStack::findCurrentScope(std::string name)
 
 ///
 /// @brief 逐层级遍历作用域检查变量是否存在
-/// @param  name 变量名
+/// @param  name 变量名在字符串池中的编号
 /// @return Value* 变量对象。若没有，则返回空指针
 ///
-Value * ScopeStack::findAllScope(std::string name)
+Value * ScopeStack::findAllScope(Symbol name)
 {
     // 模拟栈操作，从栈顶开始查找
     for (auto it = valueStack.rbegin(); it != valueStack.rend(); ++it) {
@@ -18,6 +18,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "StringInterner.h"
 #include "Value.h"
 
 ///
@@ -29,16 +30,17 @@ class ScopeStack {
 public:
     ///
     /// @brief 向当前的作用域中加入变量
+    /// @param name 变量名在字符串池中的编号
     /// @param value 变量
     ///
-    void insertValue(Value * value);
+    void insertValue(Symbol name, Value * value);
 
     ///
     /// @brief 从当前的作用域中查找指定的变量名
-    /// @param  name 变量名
+    /// @param  name 变量名在字符串池中的编号
     /// @return Value* 变量对象，若没有，则返回空指针
     ///
-    Value * findCurrentScope(std::string name);
+    Value * findCurrentScope(Symbol name);
 
     ///
     /// @brief 获取当前的作用域栈的层号
@@ -48,10 +50,10 @@ public:
 
     ///
     /// @brief 逐层级遍历作用域检查变量是否存在
-    /// @param  name 变量名
+    /// @param  name 变量名在字符串池中的编号
     /// @return Value* 变量对象。若没有，则返回空指针
     ///
-    Value * findAllScope(std::string name);
+    Value * findAllScope(Symbol name);
 
     ///
     /// @brief 进入作用域
@@ -65,7 +67,7 @@ public:
 
 protected:
     ///
-    /// @brief 变量作用域栈，最外层用vector来模拟栈，每一层用unordered_map来实现，变量名为key，变量为value
+    /// @brief 变量作用域栈，最外层用vector来模拟栈，每一层用unordered_map来实现，变量名编号为key，变量为value
     ///
-    std::vector<std::unordered_map<std::string, Value *>> valueStack;
+    std::vector<std::unordered_map<Symbol, Value *>> valueStack;
 };
@@ -0,0 +1,83 @@
+///
+/// @file AllocCounter.cpp
+/// @brief 按线程统计的内存申请，替换全局的operator new以便计数
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#include <cstdlib>
+#include <new>
+
+#include "AllocCounter.h"
+
+/// @brief 本线程的申请次数，常量初始化，线程创建前后的任何时刻都可访问
+static thread_local uint64_t threadAllocCount = 0;
+
+/// @brief 本线程申请的字节数
+static thread_local uint64_t threadAllocBytes = 0;
+
+///
+/// @brief 记录一次申请
+/// @param size 字节数
+///
+void AllocCounter::record(std::size_t size)
+{
+    threadAllocCount++;
+    threadAllocBytes += size;
+}
+
+///
+/// @brief 获取本线程累计的申请
+/// @return AllocCounter 当前的值
+///
+AllocCounter AllocCounter::current()
+{
+    AllocCounter counter;
+    counter.count = threadAllocCount;
+    counter.bytes = threadAllocBytes;
+
+    return counter;
+}
+
+///
+/// @brief 替换全局的operator new，计数后按malloc申请。数组以及nothrow版本的默认实现都调用该函数
+/// @param size 字节数
+/// @return void* 申请的内存
+///
+void * operator new(std::size_t size)
+{
+    AllocCounter::record(size);
+
+    void * p = std::malloc(size ? size : 1);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+
+    return p;
+}
+
+///
+/// @brief 与operator new配对的释放
+/// @param p 内存
+///
+void operator delete(void * p) noexcept
+{
+    std::free(p);
+}
+
+///
+/// @brief 与operator new配对的带大小的释放
+/// @param p 内存
+///
+void operator delete(void * p, std::size_t) noexcept
+{
+    std::free(p);
+}
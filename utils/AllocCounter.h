@@ -0,0 +1,43 @@
+///
+/// @file AllocCounter.h
+/// @brief 按线程统计的内存申请次数与字节数，用于各阶段的内存开销报告
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+///
+/// @brief 本线程累计的内存申请，只增不减。全局的operator new以及内存池向系统申请的块都计入其中
+///
+struct AllocCounter {
+
+    /// @brief 申请次数
+    uint64_t count = 0;
+
+    /// @brief 申请的字节数
+    uint64_t bytes = 0;
+
+    ///
+    /// @brief 记录一次申请
+    /// @param size 字节数
+    ///
+    static void record(std::size_t size);
+
+    ///
+    /// @brief 获取本线程累计的申请
+    /// @return AllocCounter 当前的值
+    ///
+    static AllocCounter current();
+};
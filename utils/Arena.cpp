@@ -0,0 +1,166 @@
+///
+/// @file Arena.cpp
+/// @brief 分块的线性(bump)内存池的实现
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#include <cstdlib>
+#include <cstring>
+
+#include "AllocCounter.h"
+#include "Arena.h"
+#include "TraceEvent.h"
+
+/// @brief 块头部所占的空间，保证块内第一个对象按最大对齐
+static constexpr std::size_t slabHeaderSize =
+    (sizeof(void *) * 2 + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+
+///
+/// @brief 构造函数
+/// @param _slabSize 每块的默认大小
+///
+Arena::Arena(std::size_t _slabSize) : slabSize(_slabSize)
+{}
+
+///
+/// @brief 析构函数，释放所有的块
+///
+Arena::~Arena()
+{
+    reset();
+
+    // reset保留了当前块，这里释放
+    while (slabs) {
+        Slab * next = slabs->next;
+        TraceEvent::adjustCounter(TraceCounter::ArenaBytes, -(int64_t) slabs->size);
+        std::free(slabs);
+        slabs = next;
+    }
+}
+
+///
+/// @brief 当前块空间不足时申请新块并分配
+/// @param size 字节数
+/// @param align 对齐字节数
+/// @return void* 申请的内存
+///
+void * Arena::allocateSlow(std::size_t size, std::size_t align)
+{
+    // 需要的空间：头部 + 对齐填充 + 对象
+    std::size_t need = slabHeaderSize + align + size;
+    std::size_t total = need > slabSize ? need : slabSize;
+
+    Slab * slab = static_cast<Slab *>(std::malloc(total));
+    if (slab == nullptr) {
+        throw std::bad_alloc();
+    }
+
+    slab->size = total;
+
+    // 向系统申请的块计入本线程的内存申请统计以及跟踪的计数器
+    AllocCounter::record(total);
+    TraceEvent::adjustCounter(TraceCounter::ArenaBytes, (int64_t) total);
+
+    slabCount++;
+    reservedBytes += total;
+
+    char * begin = reinterpret_cast<char *>(slab) + slabHeaderSize;
+    char * slabEnd = reinterpret_cast<char *>(slab) + total;
+
+    std::uintptr_t p = (reinterpret_cast<std::uintptr_t>(begin) + align - 1) & ~(std::uintptr_t) (align - 1);
+
+    if (total == slabSize || slabs == nullptr) {
+        // 标准大小的块作为当前块继续分配
+        slab->next = slabs;
+        slabs = slab;
+        cur = reinterpret_cast<char *>(p + size);
+        end = slabEnd;
+    } else {
+        // 超大的块单独使用，插入到当前块的后面，当前块仍可继续分配
+        slab->next = slabs->next;
+        slabs->next = slab;
+    }
+
+    return reinterpret_cast<void *>(p);
+}
+
+///
+/// @brief 登记对象的析构函数
+/// @param obj 对象
+/// @param destroy 析构函数
+///
+void Arena::registerDestructor(void * obj, void (*destroy)(void *))
+{
+    auto * entry = static_cast<DestructorEntry *>(allocate(sizeof(DestructorEntry), alignof(DestructorEntry)));
+
+    entry->destroy = destroy;
+    entry->obj = obj;
+    entry->prev = destructors;
+
+    destructors = entry;
+}
+
+///
+/// @brief 复制一个字符串到内存池中，以'\0'结尾
+/// @param str 字符串
+/// @param len 字符串长度
+/// @return char* 内存池中的字符串
+///
+char * Arena::strdup(const char * str, std::size_t len)
+{
+    char * mem = static_cast<char *>(allocate(len + 1, 1));
+
+    std::memcpy(mem, str, len);
+    mem[len] = '\0';
+
+    return mem;
+}
+
+///
+/// @brief 整体复位：调用登记的析构函数，保留当前块供下次使用，其余的块归还系统
+///
+void Arena::reset()
+{
+    // 按创建的逆序析构
+    for (DestructorEntry * entry = destructors; entry; entry = entry->prev) {
+        entry->destroy(entry->obj);
+    }
+    destructors = nullptr;
+
+    if (slabs == nullptr) {
+        return;
+    }
+
+    // 链表的头部为当前块，只保留该块
+    Slab * keep = slabs;
+    while (keep->next) {
+        Slab * next = keep->next;
+        keep->next = next->next;
+        reservedBytes -= next->size;
+        TraceEvent::adjustCounter(TraceCounter::ArenaBytes, -(int64_t) next->size);
+        std::free(next);
+    }
+
+    // 保留的块需为标准大小，否则也释放
+    if (keep->size != slabSize) {
+        reservedBytes -= keep->size;
+        TraceEvent::adjustCounter(TraceCounter::ArenaBytes, -(int64_t) keep->size);
+        std::free(keep);
+        slabs = nullptr;
+        cur = end = nullptr;
+        return;
+    }
+
+    slabs = keep;
+    cur = reinterpret_cast<char *>(keep) + slabHeaderSize;
+    end = reinterpret_cast<char *>(keep) + keep->size;
+}
@@ -0,0 +1,284 @@
+///
+/// @file Arena.h
+/// @brief 分块的线性(bump)内存池，用于批量申请、整体释放的对象
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+///
+/// @brief 线性内存池。内存以块(slab)为单位向系统申请，块内顺序分配，不支持单个对象的释放，
+/// 只能通过reset进行整体的复位，适合AST等生命周期一致的大量小对象。
+///
+/// 对于析构函数不平凡的对象，通过create创建时会在内存池内记录一个析构项，
+/// 在reset时统一调用，调用过程不涉及任何系统内存的释放。
+///
+class Arena {
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _slabSize 每块的默认大小，单个申请超过该大小时按实际大小申请独立的块
+    ///
+    explicit Arena(std::size_t _slabSize = 64 * 1024);
+
+    ///
+    /// @brief 析构函数，释放所有的块
+    ///
+    ~Arena();
+
+    ///
+    /// @brief 下列操作不被允许，内存池不能拷贝
+    ///
+    Arena(const Arena &) = delete;
+    Arena & operator=(const Arena &) = delete;
+
+    ///
+    /// @brief 从内存池中申请内存
+    /// @param size 字节数
+    /// @param align 对齐字节数，必须是2的幂
+    /// @return void* 申请的内存，不会失败
+    ///
+    void * allocate(std::size_t size, std::size_t align = alignof(std::max_align_t))
+    {
+        std::uintptr_t p = (reinterpret_cast<std::uintptr_t>(cur) + align - 1) & ~(std::uintptr_t) (align - 1);
+
+        if (cur == nullptr || p + size > reinterpret_cast<std::uintptr_t>(end)) {
+            // 当前块空间不足，申请新块
+            p = reinterpret_cast<std::uintptr_t>(allocateSlow(size, align));
+        } else {
+            cur = reinterpret_cast<char *>(p + size);
+        }
+
+        allocCount++;
+        allocBytes += size;
+
+        return reinterpret_cast<void *>(p);
+    }
+
+    ///
+    /// @brief 在内存池中创建对象，析构函数不平凡时由reset统一析构
+    /// @tparam T 对象类型
+    /// @param args 构造函数的参数
+    /// @return T* 创建的对象
+    ///
+    template <typename T, typename... Args>
+    T * create(Args &&... args)
+    {
+        void * mem = allocate(sizeof(T), alignof(T));
+
+        T * obj = new (mem) T(std::forward<Args>(args)...);
+
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            registerDestructor(obj, [](void * p) { static_cast<T *>(p)->~T(); });
+        }
+
+        return obj;
+    }
+
+    ///
+    /// @brief 复制一个字符串到内存池中，以'\0'结尾
+    /// @param str 字符串
+    /// @param len 字符串长度
+    /// @return char* 内存池中的字符串
+    ///
+    char * strdup(const char * str, std::size_t len);
+
+    ///
+    /// @brief 整体复位：调用登记的析构函数，保留当前块供下次使用，其余的块归还系统
+    ///
+    void reset();
+
+    ///
+    /// @brief 累计的申请次数
+    /// @return uint64_t 次数
+    ///
+    [[nodiscard]] uint64_t getAllocCount() const
+    {
+        return allocCount;
+    }
+
+    ///
+    /// @brief 累计申请的字节数
+    /// @return uint64_t 字节数
+    ///
+    [[nodiscard]] uint64_t getAllocBytes() const
+    {
+        return allocBytes;
+    }
+
+    ///
+    /// @brief 向系统申请块的次数
+    /// @return uint64_t 次数
+    ///
+    [[nodiscard]] uint64_t getSlabCount() const
+    {
+        return slabCount;
+    }
+
+    ///
+    /// @brief 当前持有的系统内存字节数
+    /// @return uint64_t 字节数
+    ///
+    [[nodiscard]] uint64_t getReservedBytes() const
+    {
+        return reservedBytes;
+    }
+
+    ///
+    /// @brief 统计计数清零，不影响已分配的内存
+    ///
+    void resetStatistics()
+    {
+        allocCount = 0;
+        allocBytes = 0;
+        slabCount = 0;
+    }
+
+protected:
+    ///
+    /// @brief 内存块的头部，块之间通过单链表链接
+    ///
+    struct Slab {
+        /// @brief 下一块
+        Slab * next;
+
+        /// @brief 块的总大小，含头部
+        std::size_t size;
+    };
+
+    ///
+    /// @brief 析构项，保存在内存池中，按创建的逆序析构
+    ///
+    struct DestructorEntry {
+        /// @brief 析构函数
+        void (*destroy)(void *);
+
+        /// @brief 要析构的对象
+        void * obj;
+
+        /// @brief 前一个析构项
+        DestructorEntry * prev;
+    };
+
+    ///
+    /// @brief 当前块空间不足时申请新块并分配
+    /// @param size 字节数
+    /// @param align 对齐字节数
+    /// @return void* 申请的内存
+    ///
+    void * allocateSlow(std::size_t size, std::size_t align);
+
+    ///
+    /// @brief 登记对象的析构函数
+    /// @param obj 对象
+    /// @param destroy 析构函数
+    ///
+    void registerDestructor(void * obj, void (*destroy)(void *));
+
+    /// @brief 块的默认大小
+    std::size_t slabSize;
+
+    /// @brief 当前块中下一个可分配的位置
+    char * cur = nullptr;
+
+    /// @brief 当前块的结束位置
+    char * end = nullptr;
+
+    /// @brief 块链表，头部为最新申请的块
+    Slab * slabs = nullptr;
+
+    /// @brief 最后登记的析构项
+    DestructorEntry * destructors = nullptr;
+
+    /// @brief 累计的申请次数
+    uint64_t allocCount = 0;
+
+    /// @brief 累计申请的字节数
+    uint64_t allocBytes = 0;
+
+    /// @brief 向系统申请块的次数
+    uint64_t slabCount = 0;
+
+    /// @brief 当前持有的系统内存字节数
+    uint64_t reservedBytes = 0;
+};
+
+///
+/// @brief 基于Arena的STL分配器，deallocate为空操作，内存随内存池整体释放
+/// @tparam T 元素类型
+///
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    ///
+    /// @brief 构造函数
+    /// @param _arena 内存池
+    ///
+    explicit ArenaAllocator(Arena & _arena) : arena(&_arena)
+    {}
+
+    ///
+    /// @brief 不同元素类型之间的转换构造，供容器rebind使用
+    ///
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U> & other) : arena(other.getArena())
+    {}
+
+    ///
+    /// @brief 申请n个元素的空间
+    /// @param n 元素个数
+    /// @return T* 空间
+    ///
+    T * allocate(std::size_t n)
+    {
+        return static_cast<T *>(arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    ///
+    /// @brief 释放空间，什么都不做
+    ///
+    void deallocate(T *, std::size_t)
+    {}
+
+    ///
+    /// @brief 获取内存池
+    /// @return Arena*
+    ///
+    [[nodiscard]] Arena * getArena() const
+    {
+        return arena;
+    }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U> & other) const
+    {
+        return arena == other.getArena();
+    }
+
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U> & other) const
+    {
+        return arena != other.getArena();
+    }
+
+private:
+    /// @brief 所属的内存池
+    Arena * arena;
+};
@@ -0,0 +1,92 @@
+///
+/// @file Casting.h
+/// @brief 基于类型标记的isa/cast/dyn_cast，替代dynamic_cast，不依赖RTTI
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+/// 目标类型To需要提供静态函数classof，根据基类中保存的类型标记判断对象是否是To类型：
+/// @code
+/// static bool classof(const Value * val);
+/// @endcode
+/// 例如Value通过ValueKind区分，指令通过IRInstOperator区分，Type通过TypeID区分。
+///
+#pragma once
+
+#include <cassert>
+#include <type_traits>
+
+///
+/// @brief 判断对象是否是To类型，对象不能为空指针
+/// @tparam To 目标类型
+/// @tparam From 源类型
+/// @param val 对象
+/// @return true：是 false：不是
+///
+template <typename To, typename From>
+[[nodiscard]] inline bool isa(const From * val)
+{
+    assert(val && "isa<> used on a null pointer");
+
+    if constexpr (std::is_base_of_v<To, From>) {
+        // 向上转换总是成立
+        return true;
+    } else {
+        return To::classof(val);
+    }
+}
+
+///
+/// @brief 转换后的指针类型，保持源类型的const属性
+///
+template <typename To, typename From>
+using cast_result_t = std::conditional_t<std::is_const_v<From>, const To *, To *>;
+
+///
+/// @brief 确定是To类型时的转换，类型不符时断言失败
+/// @tparam To 目标类型
+/// @tparam From 源类型
+/// @param val 对象，不能为空指针
+/// @return 转换后的指针
+///
+template <typename To, typename From>
+[[nodiscard]] inline cast_result_t<To, From> cast(From * val)
+{
+    assert(isa<To>(val) && "cast<> argument of incompatible type");
+
+    return static_cast<cast_result_t<To, From>>(val);
+}
+
+///
+/// @brief 检查并转换，不是To类型时返回空指针
+/// @tparam To 目标类型
+/// @tparam From 源类型
+/// @param val 对象，不能为空指针
+/// @return 转换后的指针或空指针
+///
+template <typename To, typename From>
+[[nodiscard]] inline cast_result_t<To, From> dyn_cast(From * val)
+{
+    return isa<To>(val) ? static_cast<cast_result_t<To, From>>(val) : nullptr;
+}
+
+///
+/// @brief 同dyn_cast，但允许对象为空指针
+/// @tparam To 目标类型
+/// @tparam From 源类型
+/// @param val 对象，可为空指针
+/// @return 转换后的指针或空指针
+///
+template <typename To, typename From>
+[[nodiscard]] inline cast_result_t<To, From> dyn_cast_or_null(From * val)
+{
+    return (val && isa<To>(val)) ? static_cast<cast_result_t<To, From>>(val) : nullptr;
+}
@@ -95,9 +95,20 @@ std::string trim(const std::string & str)
     return str.substr(pos);
 }
 
+/// @brief 当前线程的日志收集缓冲区，编译服务用于把诊断信息返回给客户端
+static thread_local std::string * logSink = nullptr;
+
+void minic_log_set_sink(std::string * sink)
+{
+    logSink = sink;
+}
+
 void minic_log_common(int level, const char * content)
 {
-    if (level != LOG_ERROR) {
+    if (logSink) {
+        logSink->append(content);
+        logSink->push_back('\n');
+    } else if (level != LOG_ERROR) {
         std::cerr << content << std::endl;
     } else {
         std::cout << content << std::endl;
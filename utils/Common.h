@@ -63,6 +63,10 @@ std::string trim(const std::string & str);
 
 void minic_log_common(int level, const char * content);
 
+/// @brief 设置当前线程的日志收集缓冲区，设置后本线程的日志追加到缓冲区而不输出到终端
+/// @param sink 缓冲区，为空指针时恢复输出到终端
+void minic_log_set_sink(std::string * sink);
+
 #define minic_log(level, fmt, args...)                                                                                 \
     do {                                                                                                               \
         char max_buf[1024];                                                                                            \
@@ -0,0 +1,371 @@
+///
+/// @file IntrusiveList.h
+/// @brief 侵入式双向链表，链接指针嵌入在元素内部，插入与删除都是O(1)且不申请内存
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+
+template <typename T>
+class IntrusiveList;
+
+///
+/// @brief 侵入式链表的节点，元素类型需公有继承该类。一个元素同一时刻只能在一个链表中
+/// @tparam T 元素类型
+///
+template <typename T>
+class IntrusiveListNode {
+
+    friend class IntrusiveList<T>;
+
+public:
+    IntrusiveListNode() = default;
+
+    ///
+    /// @brief 下列操作不被允许，拷贝不能复制链接关系
+    ///
+    IntrusiveListNode(const IntrusiveListNode &) = delete;
+    IntrusiveListNode & operator=(const IntrusiveListNode &) = delete;
+
+    ///
+    /// @brief 是否在某个链表中
+    /// @return true：在 false：不在
+    ///
+    [[nodiscard]] bool isLinked() const
+    {
+        return listNext != nullptr;
+    }
+
+    ///
+    /// @brief 获取链表中的下一个元素
+    /// @return T* 下一个元素，最后一个或不在链表中时为空指针
+    ///
+    [[nodiscard]] T * getNextNode() const
+    {
+        return (listNext && !listNext->sentinel) ? static_cast<T *>(listNext) : nullptr;
+    }
+
+    ///
+    /// @brief 获取链表中的前一个元素
+    /// @return T* 前一个元素，第一个或不在链表中时为空指针
+    ///
+    [[nodiscard]] T * getPrevNode() const
+    {
+        return (listPrev && !listPrev->sentinel) ? static_cast<T *>(listPrev) : nullptr;
+    }
+
+private:
+    /// @brief 前一个节点
+    IntrusiveListNode * listPrev = nullptr;
+
+    /// @brief 后一个节点
+    IntrusiveListNode * listNext = nullptr;
+
+    /// @brief 是否是链表的哨兵节点
+    bool sentinel = false;
+};
+
+///
+/// @brief 侵入式双向循环链表，带哨兵节点。链表不拥有元素，不负责元素的释放。
+/// 迭代器在元素未被删除前一直有效，插入、删除其它元素不影响已有的迭代器。
+/// @tparam T 元素类型，需继承IntrusiveListNode<T>
+///
+template <typename T>
+class IntrusiveList {
+
+    using Node = IntrusiveListNode<T>;
+
+public:
+    ///
+    /// @brief 双向迭代器，解引用得到元素指针
+    ///
+    class iterator {
+
+        friend class IntrusiveList;
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T *;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T **;
+        using reference = T *;
+
+        iterator() = default;
+
+        T * operator*() const
+        {
+            return static_cast<T *>(node);
+        }
+
+        iterator & operator++()
+        {
+            node = node->listNext;
+            return *this;
+        }
+
+        iterator operator++(int)
+        {
+            iterator tmp = *this;
+            node = node->listNext;
+            return tmp;
+        }
+
+        iterator & operator--()
+        {
+            node = node->listPrev;
+            return *this;
+        }
+
+        iterator operator--(int)
+        {
+            iterator tmp = *this;
+            node = node->listPrev;
+            return tmp;
+        }
+
+        bool operator==(const iterator & other) const
+        {
+            return node == other.node;
+        }
+
+        bool operator!=(const iterator & other) const
+        {
+            return node != other.node;
+        }
+
+    private:
+        explicit iterator(Node * _node) : node(_node)
+        {}
+
+        /// @brief 当前节点
+        Node * node = nullptr;
+    };
+
+    ///
+    /// @brief 构造函数，空链表
+    ///
+    IntrusiveList()
+    {
+        head.listPrev = head.listNext = &head;
+        head.sentinel = true;
+    }
+
+    ///
+    /// @brief 析构函数，只解除链接，不释放元素
+    ///
+    ~IntrusiveList()
+    {
+        clear();
+    }
+
+    ///
+    /// @brief 下列操作不被允许，链表不能拷贝
+    ///
+    IntrusiveList(const IntrusiveList &) = delete;
+    IntrusiveList & operator=(const IntrusiveList &) = delete;
+
+    iterator begin()
+    {
+        return iterator(head.listNext);
+    }
+
+    iterator end()
+    {
+        return iterator(&head);
+    }
+
+    ///
+    /// @brief 获取元素对应的迭代器，元素必须在本链表中
+    /// @param elem 元素
+    /// @return iterator
+    ///
+    static iterator iteratorOf(T * elem)
+    {
+        return iterator(static_cast<Node *>(elem));
+    }
+
+    [[nodiscard]] bool empty() const
+    {
+        return count == 0;
+    }
+
+    [[nodiscard]] std::size_t size() const
+    {
+        return count;
+    }
+
+    T * front()
+    {
+        return static_cast<T *>(head.listNext);
+    }
+
+    T * back()
+    {
+        return static_cast<T *>(head.listPrev);
+    }
+
+    ///
+    /// @brief 在pos的前面插入元素
+    /// @param pos 位置
+    /// @param elem 元素，不能在任何链表中
+    /// @return iterator 指向插入的元素
+    ///
+    iterator insert(iterator pos, T * elem)
+    {
+        Node * n = static_cast<Node *>(elem);
+        Node * next = pos.node;
+
+        n->listPrev = next->listPrev;
+        n->listNext = next;
+        next->listPrev->listNext = n;
+        next->listPrev = n;
+
+        count++;
+
+        return iterator(n);
+    }
+
+    ///
+    /// @brief 在元素pos的后面插入元素
+    /// @param pos 位置
+    /// @param elem 元素，不能在任何链表中
+    /// @return iterator 指向插入的元素
+    ///
+    iterator insertAfter(iterator pos, T * elem)
+    {
+        return insert(std::next(pos), elem);
+    }
+
+    void push_back(T * elem)
+    {
+        (void) insert(end(), elem);
+    }
+
+    void push_front(T * elem)
+    {
+        (void) insert(begin(), elem);
+    }
+
+    ///
+    /// @brief 删除元素（只解除链接，不释放）
+    /// @param pos 要删除的元素位置
+    /// @return iterator 被删除元素的下一个位置
+    ///
+    iterator erase(iterator pos)
+    {
+        Node * n = pos.node;
+        Node * next = n->listNext;
+
+        n->listPrev->listNext = next;
+        next->listPrev = n->listPrev;
+        n->listPrev = n->listNext = nullptr;
+
+        count--;
+
+        return iterator(next);
+    }
+
+    ///
+    /// @brief 删除元素（只解除链接，不释放）
+    /// @param elem 元素，必须在本链表中
+    ///
+    void remove(T * elem)
+    {
+        (void) erase(iteratorOf(elem));
+    }
+
+    ///
+    /// @brief 把other的全部元素移动到pos的前面，other变为空，O(1)
+    /// @param pos 位置
+    /// @param other 另一个链表
+    ///
+    void splice(iterator pos, IntrusiveList & other)
+    {
+        if (other.empty() || &other == this) {
+            return;
+        }
+
+        Node * first = other.head.listNext;
+        Node * last = other.head.listPrev;
+        Node * next = pos.node;
+
+        // 从other中摘下
+        other.head.listPrev = other.head.listNext = &other.head;
+
+        // 链入到pos前面
+        first->listPrev = next->listPrev;
+        last->listNext = next;
+        next->listPrev->listNext = first;
+        next->listPrev = last;
+
+        count += other.count;
+        other.count = 0;
+    }
+
+    ///
+    /// @brief 把other中[first, last)的n个元素移动到pos的前面，O(1)。元素个数由调用者给出，避免遍历
+    /// @param pos 位置
+    /// @param other 另一个链表，不能是本链表
+    /// @param first 区间的开始
+    /// @param last 区间的结束（不含）
+    /// @param n 区间内元素的个数
+    ///
+    void splice(iterator pos, IntrusiveList & other, iterator first, iterator last, std::size_t n)
+    {
+        if (first == last) {
+            return;
+        }
+
+        Node * firstNode = first.node;
+        Node * lastNode = last.node->listPrev;
+        Node * next = pos.node;
+
+        // 从other中摘下
+        firstNode->listPrev->listNext = last.node;
+        last.node->listPrev = firstNode->listPrev;
+
+        // 链入到pos前面
+        firstNode->listPrev = next->listPrev;
+        lastNode->listNext = next;
+        next->listPrev->listNext = firstNode;
+        next->listPrev = lastNode;
+
+        count += n;
+        other.count -= n;
+    }
+
+    ///
+    /// @brief 清空链表，只解除链接，不释放元素
+    ///
+    void clear()
+    {
+        Node * n = head.listNext;
+        while (n != &head) {
+            Node * next = n->listNext;
+            n->listPrev = n->listNext = nullptr;
+            n = next;
+        }
+
+        head.listPrev = head.listNext = &head;
+        count = 0;
+    }
+
+private:
+    /// @brief 哨兵节点
+    Node head;
+
+    /// @brief 元素个数
+    std::size_t count = 0;
+};
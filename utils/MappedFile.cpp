@@ -0,0 +1,155 @@
+///
+/// @file MappedFile.cpp
+/// @brief 文件内存映像的实现
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "MappedFile.h"
+
+///
+/// @brief 析构函数，解除映射或释放缓冲区
+///
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+///
+/// @brief 把整个文件读入到一块缓冲区中
+/// @param fp 文件指针
+/// @param buf 缓冲区，需由调用者free
+/// @param len 读入的字节数
+/// @return true：成功 false：失败
+///
+static bool readWholeFile(FILE * fp, char *& buf, std::size_t & len)
+{
+    std::size_t capacity = 64 * 1024;
+
+    buf = static_cast<char *>(std::malloc(capacity));
+    len = 0;
+
+    while (buf) {
+
+        len += std::fread(buf + len, 1, capacity - len, fp);
+        if (len < capacity) {
+            break;
+        }
+
+        // 缓冲区已满，扩大一倍后继续读
+        capacity *= 2;
+        char * newBuf = static_cast<char *>(std::realloc(buf, capacity));
+        if (newBuf == nullptr) {
+            std::free(buf);
+            buf = nullptr;
+        } else {
+            buf = newBuf;
+        }
+    }
+
+    if (buf == nullptr || std::ferror(fp)) {
+        std::free(buf);
+        buf = nullptr;
+        len = 0;
+        return false;
+    }
+
+    return true;
+}
+
+///
+/// @brief 打开文件并映射到内存
+/// @param filename 文件名
+/// @return true：成功 false：失败
+///
+bool MappedFile::open(const std::string & filename)
+{
+    close();
+
+#ifndef _WIN32
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+
+        void * addr = ::mmap(nullptr, (std::size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr != MAP_FAILED) {
+
+            // 词法分析自前往后顺序扫描，提示内核预读
+            (void) ::madvise(addr, (std::size_t) st.st_size, MADV_SEQUENTIAL);
+
+            ::close(fd);
+
+            data = static_cast<const char *>(addr);
+            length = (std::size_t) st.st_size;
+            mapped = true;
+
+            return true;
+        }
+    }
+
+    ::close(fd);
+#endif
+
+    // 不能映射时一次性读入
+    FILE * fp = std::fopen(filename.c_str(), "rb");
+    if (fp == nullptr) {
+        return false;
+    }
+
+    char * buf;
+    bool result = readWholeFile(fp, buf, length);
+
+    std::fclose(fp);
+
+    data = buf;
+    mapped = false;
+
+    return result;
+}
+
+///
+/// @brief 关闭文件，之前获取的指针失效
+///
+void MappedFile::close()
+{
+    if (data == nullptr) {
+        return;
+    }
+
+#ifndef _WIN32
+    if (mapped) {
+        (void) ::munmap(const_cast<char *>(data), length);
+    } else {
+        std::free(const_cast<char *>(data));
+    }
+#else
+    std::free(const_cast<char *>(data));
+#endif
+
+    data = nullptr;
+    length = 0;
+    mapped = false;
+}
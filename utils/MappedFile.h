@@ -0,0 +1,92 @@
+///
+/// @file MappedFile.h
+/// @brief 只读方式将整个文件映射(或读入)到内存中，供词法分析直接按指针扫描
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+///
+/// @brief 只读的文件内存映像。类Unix系统下使用mmap映射，映射失败（如管道、空文件）
+/// 或者Windows系统下则一次性读入到一块缓冲区中。内容不保证以'\0'结尾，需按大小访问。
+///
+class MappedFile {
+
+public:
+    ///
+    /// @brief 构造函数
+    ///
+    MappedFile() = default;
+
+    ///
+    /// @brief 析构函数，解除映射或释放缓冲区
+    ///
+    ~MappedFile();
+
+    ///
+    /// @brief 下列操作不被允许，映像不能拷贝
+    ///
+    MappedFile(const MappedFile &) = delete;
+    MappedFile & operator=(const MappedFile &) = delete;
+
+    ///
+    /// @brief 打开文件并映射到内存
+    /// @param filename 文件名
+    /// @return true：成功 false：失败
+    ///
+    bool open(const std::string & filename);
+
+    ///
+    /// @brief 关闭文件，之前获取的指针失效
+    ///
+    void close();
+
+    ///
+    /// @brief 文件内容的起始位置
+    /// @return const char*
+    ///
+    [[nodiscard]] const char * begin() const
+    {
+        return data;
+    }
+
+    ///
+    /// @brief 文件内容的结束位置，即最后一个字符的下一个位置
+    /// @return const char*
+    ///
+    [[nodiscard]] const char * end() const
+    {
+        return data + length;
+    }
+
+    ///
+    /// @brief 文件内容的字节数
+    /// @return std::size_t
+    ///
+    [[nodiscard]] std::size_t size() const
+    {
+        return length;
+    }
+
+protected:
+    /// @brief 文件内容
+    const char * data = nullptr;
+
+    /// @brief 文件内容的字节数
+    std::size_t length = 0;
+
+    /// @brief true: 通过mmap映射 false：读入的缓冲区
+    bool mapped = false;
+};
@@ -0,0 +1,73 @@
+///
+/// @file ParallelFor.cpp
+/// @brief 简单的并行循环的实现
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "ParallelFor.h"
+#include "TimeReport.h"
+
+///
+/// @brief 并行执行body(0) ... body(count - 1)，所有任务完成后才返回
+/// @param count 任务个数
+/// @param threadNum 线程数，含当前线程
+/// @param body 任务函数，参数为下标
+///
+void parallelFor(std::size_t count, int32_t threadNum, const std::function<void(std::size_t)> & body)
+{
+    // 线程数不超过任务数
+    std::size_t workers = threadNum > 1 ? static_cast<std::size_t>(threadNum) : 1;
+    if (workers > count) {
+        workers = count;
+    }
+
+    if (workers <= 1) {
+        // 顺序执行
+        for (std::size_t i = 0; i < count; i++) {
+            body(i);
+        }
+        return;
+    }
+
+    // 下一个待领取的下标
+    std::atomic<std::size_t> next{0};
+
+    auto worker = [&]() {
+        for (std::size_t i = next.fetch_add(1, std::memory_order_relaxed); i < count;
+             i = next.fetch_add(1, std::memory_order_relaxed)) {
+            body(i);
+        }
+    };
+
+    // 新线程中的统计阶段作为调用线程当前阶段的子阶段
+    TimeScope * scope = TimeScope::current();
+
+    // 当前线程也参与执行，只需额外创建workers - 1个线程
+    std::vector<std::thread> threads;
+    threads.reserve(workers - 1);
+    for (std::size_t k = 1; k < workers; k++) {
+        threads.emplace_back([&worker, scope]() {
+            TimeScope::Inherit inherit(scope);
+            worker();
+        });
+    }
+
+    worker();
+
+    for (auto & t: threads) {
+        t.join();
+    }
+}
@@ -0,0 +1,30 @@
+///
+/// @file ParallelFor.h
+/// @brief 简单的并行循环，把[0, count)的下标动态分派给多个工作线程执行
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+///
+/// @brief 并行执行body(0) ... body(count - 1)。各下标通过原子计数器动态领取，
+/// 以平衡大小不一的任务；所有任务完成后才返回。threadNum不大于1时在当前线程顺序执行。
+/// body可能被多个线程同时调用，需保证不同下标之间不访问共享的可变数据。
+/// @param count 任务个数
+/// @param threadNum 线程数，含当前线程
+/// @param body 任务函数，参数为下标
+///
+void parallelFor(std::size_t count, int32_t threadNum, const std::function<void(std::size_t)> & body);
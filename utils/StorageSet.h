@@ -15,16 +15,24 @@
 ///
 #pragma once
 
+#include <mutex>
 #include <unordered_set>
 
+///
+/// @brief 存储集合，相同的对象只保存一份。元素的地址在集合中一直不变，获取操作加锁，可在多线程中使用
+///
 template <typename T, typename Hasher, typename Equal>
 class StorageSet final {
     std::unordered_set<T, Hasher, Equal> mStorage;
 
+    /// @brief 保护mStorage的互斥锁
+    std::mutex mMutex;
+
 public:
     template <typename... Args>
     const T * get(Args &&... args)
     {
+        std::lock_guard<std::mutex> lock(mMutex);
         return &*mStorage.emplace(std::forward<Args>(args)...).first;
     }
 };
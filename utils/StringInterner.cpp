@@ -0,0 +1,84 @@
+///
+/// @file StringInterner.cpp
+/// @brief 字符串池的实现
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#include <new>
+
+#include "StringInterner.h"
+
+///
+/// @brief 获取全局唯一的字符串池
+/// @return StringInterner&
+///
+StringInterner & StringInterner::getInstance()
+{
+    static StringInterner instance;
+
+    return instance;
+}
+
+///
+/// @brief 构造函数，预先驻留空串，使其编号为0
+///
+StringInterner::StringInterner()
+{
+    for (auto & chunk: chunks) {
+        chunk.store(nullptr, std::memory_order_relaxed);
+    }
+
+    (void) intern("");
+}
+
+///
+/// @brief 析构函数，字符串与分段都在内存池中，随内存池释放
+///
+StringInterner::~StringInterner() = default;
+
+///
+/// @brief 驻留字符串，已存在时直接返回其编号，不申请内存
+/// @param str 字符串
+/// @return Symbol 编号
+///
+Symbol StringInterner::intern(std::string_view str)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto pIter = symbolMap.find(str);
+    if (pIter != symbolMap.end()) {
+        return pIter->second;
+    }
+
+    Symbol sym = count.load(std::memory_order_relaxed);
+    if (sym / chunkSize >= maxChunks) {
+        throw std::bad_alloc();
+    }
+
+    // 分段不存在则新建
+    std::string_view * chunk = chunks[sym / chunkSize].load(std::memory_order_relaxed);
+    if (chunk == nullptr) {
+        void * mem = arena.allocate(sizeof(std::string_view) * chunkSize, alignof(std::string_view));
+        chunk = static_cast<std::string_view *>(mem);
+        chunks[sym / chunkSize].store(chunk, std::memory_order_release);
+    }
+
+    // 字符串复制到内存池中，保证其地址在整个运行期间不变
+    std::string_view saved(arena.strdup(str.data(), str.size()), str.size());
+
+    new (&chunk[sym % chunkSize]) std::string_view(saved);
+    symbolMap.emplace(saved, sym);
+
+    count.store(sym + 1, std::memory_order_release);
+
+    return sym;
+}
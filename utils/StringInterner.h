@@ -0,0 +1,136 @@
+///
+/// @file StringInterner.h
+/// @brief 字符串池，对标识符等字符串进行驻留(intern)，相同的字符串对应唯一的整数编号
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+
+#include "Arena.h"
+
+///
+/// @brief 字符串在字符串池中的编号，编号0固定为空串
+///
+using Symbol = uint32_t;
+
+///
+/// @brief 空串对应的编号
+///
+constexpr Symbol emptySymbol = 0;
+
+///
+/// @brief 字符串池。字符串只保存一份，存放在内部的内存池中，直到程序结束都不会释放，
+/// 因此编号以及获取的string_view在整个程序运行期间有效。
+///
+/// 各个前端（flex/bison、antlr4、递归下降）的词法分析都通过该类获取标识符的编号，
+/// 符号表等以编号作为键，避免字符串的复制与重复计算散列值。
+/// 驻留操作加锁，获取字符串不加锁，可在多线程中使用。
+///
+class StringInterner {
+
+public:
+    ///
+    /// @brief 获取全局唯一的字符串池
+    /// @return StringInterner&
+    ///
+    static StringInterner & getInstance();
+
+    ///
+    /// @brief 下列操作不被允许，字符串池不能拷贝
+    ///
+    StringInterner(const StringInterner &) = delete;
+    StringInterner & operator=(const StringInterner &) = delete;
+
+    ///
+    /// @brief 驻留字符串，已存在时直接返回其编号，不申请内存
+    /// @param str 字符串
+    /// @return Symbol 编号
+    ///
+    Symbol intern(std::string_view str);
+
+    ///
+    /// @brief 根据编号获取字符串
+    /// @param sym 编号，必须是intern返回的有效编号
+    /// @return std::string_view 字符串，以'\0'结尾
+    ///
+    [[nodiscard]] std::string_view get(Symbol sym) const
+    {
+        return chunks[sym / chunkSize].load(std::memory_order_acquire)[sym % chunkSize];
+    }
+
+    ///
+    /// @brief 已驻留的字符串个数
+    /// @return uint32_t 个数
+    ///
+    [[nodiscard]] uint32_t size() const
+    {
+        return count.load(std::memory_order_acquire);
+    }
+
+protected:
+    ///
+    /// @brief 构造函数，预先驻留空串
+    ///
+    StringInterner();
+
+    ///
+    /// @brief 析构函数
+    ///
+    ~StringInterner();
+
+    /// @brief 每个分段的编号个数
+    static constexpr uint32_t chunkSize = 4096;
+
+    /// @brief 最大的分段数，分段一经申请不再移动，读取时不需要加锁
+    static constexpr uint32_t maxChunks = 4096;
+
+    /// @brief 编号到字符串的分段映射表
+    std::atomic<std::string_view *> chunks[maxChunks];
+
+    /// @brief 已驻留的字符串个数，也就是下一个可用的编号
+    std::atomic<uint32_t> count{0};
+
+    /// @brief 字符串到编号的映射表，键指向内存池中的字符串
+    std::unordered_map<std::string_view, Symbol> symbolMap;
+
+    /// @brief 字符串以及分段的存储空间
+    Arena arena;
+
+    /// @brief 驻留操作的互斥锁
+    std::mutex mutex;
+};
+
+///
+/// @brief 驻留字符串，获取其编号
+/// @param str 字符串
+/// @return Symbol 编号
+///
+inline Symbol internSymbol(std::string_view str)
+{
+    return StringInterner::getInstance().intern(str);
+}
+
+///
+/// @brief 根据编号获取字符串
+/// @param sym 编号
+/// @return std::string_view 字符串
+///
+inline std::string_view symbolName(Symbol sym)
+{
+    return StringInterner::getInstance().get(sym);
+}
@@ -0,0 +1,319 @@
+///
+/// @file TimeReport.cpp
+/// @brief 编译各阶段的时间与内存统计报告的实现
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#include <chrono>
+#include <cinttypes>
+
+#ifdef _WIN32
+#include <Windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#include <time.h>
+#endif
+
+#include "TimeReport.h"
+
+/// @brief 是否开启统计，默认关闭
+std::atomic<bool> TimeReport::enabled{false};
+
+/// @brief 本线程最内层的统计作用域
+static thread_local TimeScope * currentScope = nullptr;
+
+///
+/// @brief 获取单调递增的墙上时间
+/// @return int64_t 纳秒
+///
+static int64_t wallClockNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+///
+/// @brief 获取本线程的CPU时间
+/// @return int64_t 纳秒
+///
+static int64_t threadCpuNs()
+{
+#ifdef _WIN32
+    FILETIME creationTime, exitTime, kernelTime, userTime;
+    if (!GetThreadTimes(GetCurrentThread(), &creationTime, &exitTime, &kernelTime, &userTime)) {
+        return 0;
+    }
+
+    // FILETIME的单位为100纳秒
+    uint64_t kernel = ((uint64_t) kernelTime.dwHighDateTime << 32) | kernelTime.dwLowDateTime;
+    uint64_t user = ((uint64_t) userTime.dwHighDateTime << 32) | userTime.dwLowDateTime;
+
+    return (int64_t) (kernel + user) * 100;
+#else
+    struct timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) {
+        return 0;
+    }
+
+    return (int64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+#endif
+}
+
+///
+/// @brief 获取唯一的统计汇总
+/// @return TimeReport&
+///
+TimeReport & TimeReport::getInstance()
+{
+    static TimeReport instance;
+
+    return instance;
+}
+
+///
+/// @brief 获取阶段的编号，阶段不存在时按首次出现的次序新建
+/// @param path 阶段的路径
+/// @param name 阶段名
+/// @param depth 嵌套深度
+/// @return std::size_t 阶段的编号
+///
+std::size_t TimeReport::registerEntry(const std::string & path, const char * name, int depth)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = entryIndex.find(path);
+    if (it != entryIndex.end()) {
+        return it->second;
+    }
+
+    TimeReportEntry entry;
+    entry.path = path;
+    entry.name = name;
+    entry.depth = depth;
+
+    entries.push_back(entry);
+    entryIndex.emplace(path, entries.size() - 1);
+
+    return entries.size() - 1;
+}
+
+///
+/// @brief 累加阶段的一次执行
+/// @param index 阶段的编号
+/// @param wallNs 墙上时间
+/// @param cpuNs CPU时间
+/// @param allocCount 内存申请次数
+/// @param allocBytes 内存申请的字节数
+///
+void TimeReport::addSample(std::size_t index, int64_t wallNs, int64_t cpuNs, uint64_t allocCount, uint64_t allocBytes)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    TimeReportEntry & entry = entries[index];
+    entry.calls++;
+    entry.wallNs += wallNs;
+    entry.cpuNs += cpuNs;
+    entry.allocCount += allocCount;
+    entry.allocBytes += allocBytes;
+}
+
+///
+/// @brief 以表格的形式输出报告
+/// @param fp 输出的文件
+///
+void TimeReport::print(FILE * fp)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    fprintf(fp, "===-------------------------------------------------------------------------===\n");
+    fprintf(fp, "                          MiniC time report\n");
+    fprintf(fp, "===-------------------------------------------------------------------------===\n");
+    fprintf(fp, "  CPU time and allocations are counted on the thread running the phase;\n");
+    fprintf(fp, "  a phase run on several threads reports the sum over those threads.\n\n");
+    fprintf(fp, "%10s %10s %8s %10s %12s  %s\n", "Wall(ms)", "CPU(ms)", "Calls", "Allocs", "Bytes", "Phase");
+
+    for (auto & entry: entries) {
+        fprintf(fp,
+                "%10.3f %10.3f %8" PRIu64 " %10" PRIu64 " %12" PRIu64 "  %*s%s\n",
+                (double) entry.wallNs / 1e6,
+                (double) entry.cpuNs / 1e6,
+                entry.calls,
+                entry.allocCount,
+                entry.allocBytes,
+                entry.depth * 2,
+                "",
+                entry.name.c_str());
+    }
+
+    fprintf(fp, "\nPeak RSS: %" PRId64 " KB\n", peakRSSKB());
+}
+
+///
+/// @brief 输出JSON字符串，对特殊字符转义
+/// @param fp 输出的文件
+/// @param str 字符串
+///
+static void printJSONString(FILE * fp, const std::string & str)
+{
+    fputc('"', fp);
+
+    for (unsigned char c: str) {
+        if (c == '"' || c == '\\') {
+            fputc('\\', fp);
+            fputc(c, fp);
+        } else if (c < 0x20) {
+            fprintf(fp, "\\u%04x", c);
+        } else {
+            fputc(c, fp);
+        }
+    }
+
+    fputc('"', fp);
+}
+
+///
+/// @brief 以JSON的形式输出报告，便于其它工具处理
+/// @param fp 输出的文件
+///
+void TimeReport::printJSON(FILE * fp)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    fprintf(fp, "{\n  \"phases\": [");
+
+    for (std::size_t i = 0; i < entries.size(); i++) {
+        TimeReportEntry & entry = entries[i];
+
+        fprintf(fp, "%s\n    {\"path\": ", i ? "," : "");
+        printJSONString(fp, entry.path);
+        fprintf(fp, ", \"name\": ");
+        printJSONString(fp, entry.name);
+        fprintf(fp,
+                ", \"depth\": %d, \"calls\": %" PRIu64 ", \"wall_ms\": %.6f, \"cpu_ms\": %.6f, \"allocs\": %" PRIu64
+                ", \"alloc_bytes\": %" PRIu64 "}",
+                entry.depth,
+                entry.calls,
+                (double) entry.wallNs / 1e6,
+                (double) entry.cpuNs / 1e6,
+                entry.allocCount,
+                entry.allocBytes);
+    }
+
+    fprintf(fp, "\n  ],\n  \"peak_rss_kb\": %" PRId64 "\n}\n", peakRSSKB());
+}
+
+///
+/// @brief 获取进程的内存占用峰值(常驻内存集)
+/// @return int64_t 千字节数，不支持时为0
+///
+int64_t TimeReport::peakRSSKB()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return 0;
+    }
+
+    return (int64_t) (counters.PeakWorkingSetSize / 1024);
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+
+#ifdef __APPLE__
+    // macOS下的单位为字节
+    return (int64_t) usage.ru_maxrss / 1024;
+#else
+    return (int64_t) usage.ru_maxrss;
+#endif
+#endif
+}
+
+///
+/// @brief 获取本线程最内层的统计作用域
+/// @return TimeScope* 没有时为空指针
+///
+TimeScope * TimeScope::current()
+{
+    return currentScope;
+}
+
+///
+/// @brief 开始计时
+/// @param _name 阶段名
+///
+void TimeScope::start(const char * _name)
+{
+    name = _name;
+    parent = currentScope;
+
+    if (parent) {
+        path = parent->path + "/" + _name;
+        depth = parent->depth + 1;
+    } else {
+        path = _name;
+        depth = 0;
+    }
+
+    if (TimeReport::isEnabled()) {
+        // 阶段在开始时登记，使外层阶段排在其子阶段的前面
+        index = TimeReport::getInstance().registerEntry(path, _name, depth);
+    }
+
+    currentScope = this;
+    active = true;
+
+    allocStart = AllocCounter::current();
+    cpuStart = threadCpuNs();
+    wallStart = wallClockNs();
+}
+
+///
+/// @brief 结束计时并累加到阶段
+///
+void TimeScope::stop()
+{
+    int64_t wallNs = wallClockNs() - wallStart;
+    int64_t cpuNs = threadCpuNs() - cpuStart;
+    AllocCounter alloc = AllocCounter::current();
+
+    if (TimeReport::isEnabled()) {
+        TimeReport::getInstance().addSample(
+            index, wallNs, cpuNs, alloc.count - allocStart.count, alloc.bytes - allocStart.bytes);
+    }
+
+    if (TraceEvent::isEnabled()) {
+        TraceEvent::getInstance().addSpan(name, detail, wallStart, wallNs);
+    }
+
+    currentScope = parent;
+    active = false;
+}
+
+///
+/// @brief 构造函数
+/// @param parent 外层的作用域，可为空指针
+///
+TimeScope::Inherit::Inherit(TimeScope * parent) : saved(currentScope)
+{
+    currentScope = parent;
+}
+
+///
+/// @brief 析构函数，恢复本线程原来的作用域
+///
+TimeScope::Inherit::~Inherit()
+{
+    currentScope = saved;
+}
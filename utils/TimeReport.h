@@ -0,0 +1,274 @@
+///
+/// @file TimeReport.h
+/// @brief 编译各阶段的时间与内存统计报告，类似于gcc的-ftime-report
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+/// 使用时在要统计的代码块内定义TimeScope对象，作用域内的时间与内存申请计入以其名字命名的阶段：
+/// @code
+/// {
+///     TimeScope scope("IR generation");
+///     ...
+/// }
+/// @endcode
+/// 作用域可以嵌套，内层的阶段作为外层阶段的子阶段。开启跟踪时每个作用域同时记录为一个区间，见TraceEvent.h。
+/// 报告与跟踪都没有开启时TimeScope只有一次分支判断。
+///
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "AllocCounter.h"
+#include "TraceEvent.h"
+
+///
+/// @brief 一个阶段的统计
+///
+struct TimeReportEntry {
+
+    /// @brief 阶段的路径，由外层到内层的阶段名以/连接
+    std::string path;
+
+    /// @brief 阶段名
+    std::string name;
+
+    /// @brief 嵌套的深度，最外层为0
+    int depth = 0;
+
+    /// @brief 执行的次数
+    uint64_t calls = 0;
+
+    /// @brief 墙上时间，纳秒
+    int64_t wallNs = 0;
+
+    /// @brief 执行线程的CPU时间，纳秒
+    int64_t cpuNs = 0;
+
+    /// @brief 内存申请次数
+    uint64_t allocCount = 0;
+
+    /// @brief 内存申请的字节数
+    uint64_t allocBytes = 0;
+};
+
+///
+/// @brief 各阶段统计的汇总，进程内唯一。多个线程中的同名阶段累加在一起
+///
+class TimeReport {
+
+public:
+    ///
+    /// @brief 开启或关闭统计，需在编译开始前设置
+    /// @param enable 是否开启
+    ///
+    static void setEnabled(bool enable)
+    {
+        enabled.store(enable, std::memory_order_relaxed);
+    }
+
+    ///
+    /// @brief 是否开启了统计
+    /// @return true：开启 false：关闭
+    ///
+    static bool isEnabled()
+    {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    ///
+    /// @brief 获取唯一的统计汇总
+    /// @return TimeReport&
+    ///
+    static TimeReport & getInstance();
+
+    ///
+    /// @brief 获取阶段的编号，阶段不存在时按首次出现的次序新建
+    /// @param path 阶段的路径
+    /// @param name 阶段名
+    /// @param depth 嵌套深度
+    /// @return std::size_t 阶段的编号
+    ///
+    std::size_t registerEntry(const std::string & path, const char * name, int depth);
+
+    ///
+    /// @brief 累加阶段的一次执行
+    /// @param index 阶段的编号
+    /// @param wallNs 墙上时间
+    /// @param cpuNs CPU时间
+    /// @param allocCount 内存申请次数
+    /// @param allocBytes 内存申请的字节数
+    ///
+    void addSample(std::size_t index, int64_t wallNs, int64_t cpuNs, uint64_t allocCount, uint64_t allocBytes);
+
+    ///
+    /// @brief 以表格的形式输出报告
+    /// @param fp 输出的文件
+    ///
+    void print(FILE * fp);
+
+    ///
+    /// @brief 以JSON的形式输出报告，便于其它工具处理
+    /// @param fp 输出的文件
+    ///
+    void printJSON(FILE * fp);
+
+    ///
+    /// @brief 获取进程的内存占用峰值(常驻内存集)
+    /// @return int64_t 千字节数，不支持时为0
+    ///
+    static int64_t peakRSSKB();
+
+private:
+    TimeReport() = default;
+
+    /// @brief 是否开启统计
+    static std::atomic<bool> enabled;
+
+    /// @brief 各阶段的统计，按首次出现的次序
+    std::vector<TimeReportEntry> entries;
+
+    /// @brief 阶段路径到编号的映射
+    std::unordered_map<std::string, std::size_t> entryIndex;
+
+    /// @brief 保护entries与entryIndex的互斥锁
+    std::mutex mutex;
+};
+
+///
+/// @brief 统计作用域。构造时开始计时，析构时把时间与内存申请计入对应的阶段
+///
+class TimeScope {
+
+public:
+    ///
+    /// @brief 构造函数，开始计时
+    /// @param _name 阶段名，需为字符串常量
+    ///
+    explicit TimeScope(const char * _name)
+    {
+        if (TimeReport::isEnabled() || TraceEvent::isEnabled()) {
+            start(_name);
+        }
+    }
+
+    ///
+    /// @brief 构造函数，开始计时，并在跟踪的区间上附加信息，如所处理的函数名
+    /// @param _name 阶段名，需为字符串常量
+    /// @param detail 返回附加信息的函数，只在开启跟踪时调用
+    ///
+    template <typename DetailFunc>
+    TimeScope(const char * _name, DetailFunc && detail)
+    {
+        if (TimeReport::isEnabled() || TraceEvent::isEnabled()) {
+            if (TraceEvent::isEnabled()) {
+                this->detail = detail();
+            }
+            start(_name);
+        }
+    }
+
+    ///
+    /// @brief 析构函数，结束计时
+    ///
+    ~TimeScope()
+    {
+        if (active) {
+            stop();
+        }
+    }
+
+    ///
+    /// @brief 下列操作不被允许，作用域不能拷贝
+    ///
+    TimeScope(const TimeScope &) = delete;
+    TimeScope & operator=(const TimeScope &) = delete;
+
+    ///
+    /// @brief 获取本线程最内层的统计作用域
+    /// @return TimeScope* 没有时为空指针
+    ///
+    static TimeScope * current();
+
+    ///
+    /// @brief 在其它线程中继承一个作用域作为外层，使该线程内的阶段成为其子阶段，如并行执行的任务
+    ///
+    class Inherit {
+
+    public:
+        ///
+        /// @brief 构造函数
+        /// @param parent 外层的作用域，可为空指针
+        ///
+        explicit Inherit(TimeScope * parent);
+
+        ///
+        /// @brief 析构函数，恢复本线程原来的作用域
+        ///
+        ~Inherit();
+
+        Inherit(const Inherit &) = delete;
+        Inherit & operator=(const Inherit &) = delete;
+
+    private:
+        /// @brief 本线程原来的作用域
+        TimeScope * saved;
+    };
+
+private:
+    ///
+    /// @brief 开始计时
+    /// @param _name 阶段名
+    ///
+    void start(const char * _name);
+
+    ///
+    /// @brief 结束计时并累加到阶段
+    ///
+    void stop();
+
+    /// @brief 是否在计时
+    bool active = false;
+
+    /// @brief 外层的作用域
+    TimeScope * parent = nullptr;
+
+    /// @brief 阶段名
+    const char * name = nullptr;
+
+    /// @brief 跟踪区间的附加信息
+    std::string detail;
+
+    /// @brief 阶段的路径
+    std::string path;
+
+    /// @brief 嵌套深度
+    int depth = 0;
+
+    /// @brief 阶段的编号
+    std::size_t index = 0;
+
+    /// @brief 开始时的墙上时间
+    int64_t wallStart = 0;
+
+    /// @brief 开始时本线程的CPU时间
+    int64_t cpuStart = 0;
+
+    /// @brief 开始时本线程的内存申请
+    AllocCounter allocStart;
+};
@@ -0,0 +1,161 @@
+///
+/// @file TraceEvent.cpp
+/// @brief 编译过程的跟踪记录的实现
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#include <cinttypes>
+#include <cstdio>
+
+#include "TraceEvent.h"
+
+/// @brief 是否开启跟踪，默认关闭
+std::atomic<bool> TraceEvent::enabled{false};
+
+/// @brief 各计数器的当前值
+std::atomic<int64_t> TraceEvent::counters[(int) TraceCounter::Count];
+
+/// @brief 计数器名，与TraceCounter的次序一致
+static const char * const counterNames[(int) TraceCounter::Count] = {
+    "live IR instructions",
+    "arena bytes",
+};
+
+/// @brief 已分配的线程编号数
+static std::atomic<uint32_t> threadIdCount{0};
+
+///
+/// @brief 获取唯一的跟踪记录
+/// @return TraceEvent&
+///
+TraceEvent & TraceEvent::getInstance()
+{
+    static TraceEvent instance;
+
+    return instance;
+}
+
+///
+/// @brief 获取本线程在跟踪中的编号，按线程首次记录事件的次序从1开始
+/// @return uint32_t 线程编号
+///
+uint32_t TraceEvent::threadId()
+{
+    static thread_local uint32_t tid = ++threadIdCount;
+
+    return tid;
+}
+
+///
+/// @brief 记录一个区间，并对所有计数器采样
+/// @param name 区间名
+/// @param detail 附加信息，如函数名，可为空串
+/// @param startNs 开始时间，纳秒
+/// @param durNs 持续时间，纳秒
+///
+void TraceEvent::addSpan(const char * name, const std::string & detail, int64_t startNs, int64_t durNs)
+{
+    uint32_t tid = threadId();
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    events.push_back(Event{'X', tid, name, detail, startNs, durNs, 0});
+
+    // 计数器在区间结束时采样
+    for (int i = 0; i < (int) TraceCounter::Count; i++) {
+        int64_t value = counters[i].load(std::memory_order_relaxed);
+        events.push_back(Event{'C', tid, counterNames[i], std::string(), startNs + durNs, 0, value});
+    }
+}
+
+///
+/// @brief 输出JSON字符串，对特殊字符转义
+/// @param fp 输出的文件
+/// @param str 字符串
+///
+static void printJSONString(FILE * fp, const char * str)
+{
+    fputc('"', fp);
+
+    for (const unsigned char * p = (const unsigned char *) str; *p; p++) {
+        if (*p == '"' || *p == '\\') {
+            fputc('\\', fp);
+            fputc(*p, fp);
+        } else if (*p < 0x20) {
+            fprintf(fp, "\\u%04x", *p);
+        } else {
+            fputc(*p, fp);
+        }
+    }
+
+    fputc('"', fp);
+}
+
+///
+/// @brief 输出跟踪文件
+/// @param fileName 文件名
+/// @return true：成功 false：文件不能打开
+///
+bool TraceEvent::write(const std::string & fileName)
+{
+    FILE * fp = fopen(fileName.c_str(), "w");
+    if (fp == nullptr) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // 时间以第一个事件的开始为零点，单位为微秒
+    int64_t origin = 0;
+    for (std::size_t i = 0; i < events.size(); i++) {
+        if (i == 0 || events[i].ts < origin) {
+            origin = events[i].ts;
+        }
+    }
+
+    fprintf(fp, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");
+    fprintf(fp, "{\"ph\": \"M\", \"pid\": 1, \"tid\": 0, \"name\": \"process_name\", \"args\": {\"name\": \"minic\"}}");
+
+    uint32_t threadNum = threadIdCount.load();
+    for (uint32_t tid = 1; tid <= threadNum; tid++) {
+        fprintf(fp,
+                ",\n{\"ph\": \"M\", \"pid\": 1, \"tid\": %" PRIu32
+                ", \"name\": \"thread_name\", \"args\": {\"name\": \"thread %" PRIu32 "\"}}",
+                tid,
+                tid);
+    }
+
+    for (auto & event: events) {
+        fprintf(fp, ",\n{\"ph\": \"%c\", \"pid\": 1, \"tid\": %" PRIu32 ", \"name\": ", event.phase, event.tid);
+        printJSONString(fp, event.name);
+        fprintf(fp, ", \"ts\": %.3f", (double) (event.ts - origin) / 1e3);
+
+        if (event.phase == 'X') {
+            fprintf(fp, ", \"dur\": %.3f", (double) event.dur / 1e3);
+            if (!event.detail.empty()) {
+                fprintf(fp, ", \"args\": {\"detail\": ");
+                printJSONString(fp, event.detail.c_str());
+                fprintf(fp, "}");
+            }
+        } else {
+            fprintf(fp, ", \"args\": {\"value\": %" PRId64 "}", event.value);
+        }
+
+        fprintf(fp, "}");
+    }
+
+    fprintf(fp, "\n]}\n");
+
+    fclose(fp);
+
+    return true;
+}
@@ -0,0 +1,147 @@
+///
+/// @file TraceEvent.h
+/// @brief 编译过程的跟踪记录，按Chrome的trace event格式输出，可用chrome://tracing或Perfetto查看
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2024-11-21
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+/// 阶段的区间由TimeScope记录，见TimeReport.h。计数器由各模块通过TraceEvent::adjustCounter增减，
+/// 每个区间结束时对所有计数器采样一次。没有开启跟踪时只有一次分支判断。
+///
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+///
+/// @brief 跟踪的计数器
+///
+enum class TraceCounter : int {
+
+    /// @brief 存活的IR指令数
+    IRInstructions,
+
+    /// @brief 所有内存池持有的系统内存字节数
+    ArenaBytes,
+
+    /// @brief 计数器的个数
+    Count
+};
+
+///
+/// @brief 跟踪记录，进程内唯一，多个线程的事件记录在一起
+///
+class TraceEvent {
+
+public:
+    ///
+    /// @brief 开启或关闭跟踪，需在编译开始前设置
+    /// @param enable 是否开启
+    ///
+    static void setEnabled(bool enable)
+    {
+        enabled.store(enable, std::memory_order_relaxed);
+    }
+
+    ///
+    /// @brief 是否开启了跟踪
+    /// @return true：开启 false：关闭
+    ///
+    static bool isEnabled()
+    {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    ///
+    /// @brief 增减计数器，没有开启跟踪时不做任何事
+    /// @param counter 计数器
+    /// @param delta 增量，可为负数
+    ///
+    static void adjustCounter(TraceCounter counter, int64_t delta)
+    {
+        if (isEnabled()) {
+            counters[(int) counter].fetch_add(delta, std::memory_order_relaxed);
+        }
+    }
+
+    ///
+    /// @brief 获取唯一的跟踪记录
+    /// @return TraceEvent&
+    ///
+    static TraceEvent & getInstance();
+
+    ///
+    /// @brief 获取本线程在跟踪中的编号，按线程首次记录事件的次序从1开始
+    /// @return uint32_t 线程编号
+    ///
+    static uint32_t threadId();
+
+    ///
+    /// @brief 记录一个区间，并对所有计数器采样
+    /// @param name 区间名
+    /// @param detail 附加信息，如函数名，可为空串
+    /// @param startNs 开始时间，纳秒
+    /// @param durNs 持续时间，纳秒
+    ///
+    void addSpan(const char * name, const std::string & detail, int64_t startNs, int64_t durNs);
+
+    ///
+    /// @brief 输出跟踪文件
+    /// @param fileName 文件名
+    /// @return true：成功 false：文件不能打开
+    ///
+    bool write(const std::string & fileName);
+
+private:
+    TraceEvent() = default;
+
+    ///
+    /// @brief 一个事件
+    ///
+    struct Event {
+
+        /// @brief 事件类型，X为区间，C为计数器
+        char phase;
+
+        /// @brief 线程编号
+        uint32_t tid;
+
+        /// @brief 名字，区间名或者计数器名
+        const char * name;
+
+        /// @brief 区间的附加信息
+        std::string detail;
+
+        /// @brief 时间，纳秒
+        int64_t ts;
+
+        /// @brief 区间的持续时间，纳秒
+        int64_t dur;
+
+        /// @brief 计数器的值
+        int64_t value;
+    };
+
+    /// @brief 是否开启跟踪
+    static std::atomic<bool> enabled;
+
+    /// @brief 各计数器的当前值
+    static std::atomic<int64_t> counters[(int) TraceCounter::Count];
+
+    /// @brief 记录的事件
+    std::vector<Event> events;
+
+    /// @brief 保护events的互斥锁
+    std::mutex mutex;
+};